@@ -103,7 +103,7 @@ when application makefile has VFP_SELECT configured as softfloat */
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
-#define configUSE_IDLE_HOOK                     0
+#define configUSE_IDLE_HOOK                     1
 #define configUSE_TICK_HOOK                     0
 #define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_MALLOC_FAILED_HOOK            1
@@ -234,4 +234,9 @@ extern void vApplicationSleep( uint32_t xExpectedIdleTime );
 #define configUSE_NEWLIB_REENTRANT              1
 #endif /* #if defined(__llvm__) && !defined(__ARMCC_VERSION) */
 
+/* Trace hooks of the audio trace recorder, enabled with AUDIO_TRACE_ENABLE */
+#if !defined(__ASSEMBLER__)
+#include "audio_trace.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
@@ -45,6 +45,8 @@
 extern "C" {
 #endif
 
+#include "audio_ipc.h"
+
 /******************************************************************************
 * Constants from USB Audio Descriptor
 ******************************************************************************/
@@ -61,6 +63,89 @@ extern "C" {
 #define AUDIO_IN_BIT_RESOLUTION                 (16U)
 #define AUDIO_IN_SAMPLE_FREQ                    AUDIO_SAMPLING_RATE_48KHZ
 
+/* Alternate settings of the microphone interface. Alternate setting 0 is
+ * the zero-bandwidth setting, the others select one entry of
+ * microphone_formats[] each.
+ */
+#define AUDIO_IN_ALT_STEREO                     (1U)   /* Raw stereo from both microphones */
+#define AUDIO_IN_ALT_BEAM_MONO                  (2U)   /* Beamformed mono channel */
+#define AUDIO_IN_ALT_MONO                       (3U)   /* Mono from one microphone or their downmix */
+
+/* Capture interfaces of the composite device, each with its own Audio IN
+ * endpoint. 1 only exposes the microphone interface above. 2 adds a raw
+ * microphone interface streaming both microphones without the processing
+ * stages, independently of the first one. Both are fed from the same
+ * capture queue.
+ */
+#ifndef AUDIO_IN_NUM_STREAMS
+#define AUDIO_IN_NUM_STREAMS                    (1U)
+#endif
+
+#if ((AUDIO_IN_NUM_STREAMS != 1U) && (AUDIO_IN_NUM_STREAMS != 2U))
+#error "AUDIO_IN_NUM_STREAMS must be 1 or 2."
+#endif
+
+/* Capture interfaces, also the user context of their callbacks */
+#define AUDIO_IN_STREAM_MIC                     (0U)   /* Microphone interface, processed audio */
+#define AUDIO_IN_STREAM_RAW                     (1U)   /* Raw microphone interface, raw stereo */
+
+/* Service interval of the Audio IN endpoint in units of 125us microframes.
+ * 8 sends one packet per 1 ms frame. 1, 2 or 4 select the low-latency mode,
+ * which sends 8, 4 or 2 smaller packets per frame respectively.
+ */
+#define AUDIO_IN_EP_INTERVAL                    (8U)
+
+#if ((AUDIO_IN_EP_INTERVAL != 1U) && (AUDIO_IN_EP_INTERVAL != 2U) && \
+     (AUDIO_IN_EP_INTERVAL != 4U) && (AUDIO_IN_EP_INTERVAL != 8U))
+#error "AUDIO_IN_EP_INTERVAL must be 1, 2, 4 or 8 microframes."
+#endif
+
+/* Number of Audio IN packets sent per 1 ms USB frame */
+#define AUDIO_IN_PACKETS_PER_MS                 ((8U) / (AUDIO_IN_EP_INTERVAL))
+
+/* Audio frame (one sample of every channel) size in bytes */
+#define AUDIO_IN_FRAME_SIZE_BYTES               ((AUDIO_IN_SUB_FRAME_SIZE) * (AUDIO_IN_NUM_CHANNELS))
+
+/* Nominal number of audio frames carried by one packet. For 22.05 and
+ * 44.1 ksps the remainder is absorbed by the extra frame sent when the
+ * PDM-PCM FIFO runs ahead (see audio_in_endpoint_callback()).
+ */
+#define AUDIO_IN_FRAMES_PER_PACKET              ((AUDIO_IN_SAMPLE_FREQ) / (1000U * (AUDIO_IN_PACKETS_PER_MS)))
+
+/* Longest pre-roll: audio captured before the host starts recording and
+ * delivered at the start of the session. 0 removes the pre-roll and only
+ * runs the microphones while recording. Each ms costs
+ * AUDIO_IN_SAMPLE_FREQ / 1000 * AUDIO_IN_FRAME_SIZE_BYTES bytes of RAM.
+ */
+#ifndef AUDIO_IN_PREROLL_MAX_MS
+#define AUDIO_IN_PREROLL_MAX_MS                 (0U)
+#endif
+
+/* Frames added to a packet, on top of the one frame of rate matching, to
+ * catch up to live audio after the pre-roll. A quarter of a packet drains
+ * the pre-roll in four times its length.
+ */
+#if (AUDIO_IN_PREROLL_MAX_MS > 0U)
+#define AUDIO_IN_CATCHUP_FRAMES                 ((AUDIO_IN_FRAMES_PER_PACKET) / 4U)
+#else
+#define AUDIO_IN_CATCHUP_FRAMES                 (0U)
+#endif
+
+/* Largest number of frames in one packet */
+#define AUDIO_IN_MAX_FRAMES_PER_PACKET          ((AUDIO_IN_FRAMES_PER_PACKET) + 1U + (AUDIO_IN_CATCHUP_FRAMES))
+
+/* Period of the Audio Tap Task, which publishes the packets of the capture
+ * tap (see audio_in_tap_enable()) */
+#define AUDIO_IN_TAP_PERIOD_MS                  (1U)
+
+/* Packets of the capture tap waiting for the Audio Tap Task: three periods
+ * of the task */
+#define AUDIO_IN_TAP_QUEUE_PACKETS              ((3U * (AUDIO_IN_TAP_PERIOD_MS)) * (AUDIO_IN_PACKETS_PER_MS))
+
+/* Packets held by the capture tap: the one filled by the PDM-PCM
+ * interrupt, the queued ones, and the one being published */
+#define AUDIO_IN_TAP_PACKETS                    ((AUDIO_IN_TAP_QUEUE_PACKETS) + 2U)
+
 #define AUDIO_VOLUME_SIZE     (2U)
 /**< Volume minimum value MSB */
 #define AUDIO_VOLUME_MIN_MSB  (0x00U)
@@ -96,26 +181,54 @@ extern "C" {
 
 /******************************************************************************
 * Has to match the configured values in Microphone Configuration
-* For a sample rate of 44100, 16 bits per sample, 2 channels:
-* (44100 * ((16/8) * 2)) / 1000 = 176 bytes
-* Additional sample size is added to make sure we can send 
+* For a sample rate of 44100, 16 bits per sample, 2 channels and a 1 ms
+* service interval:
+* 44100 / 1000 = 44 frames per packet, (16/8) * 2 = 4 bytes per frame
+* 44 frames * 4 bytes = 176 bytes
+* One additional frame is added to make sure we can send
 * odd sized frames if necessary:
 * 176 bytes + ((16/8) * 2) = 180
 ******************************************************************************/
 
 /* USB IN Endpoint Audio maximum packet size (in bytes) */
-/* Packet size = ( Sampling frequency * (Bit resolution / 8) * Num of channels ) / (frame duration in ms) */
-#define MAX_AUDIO_IN_PACKET_SIZE_BYTES          ((((AUDIO_IN_SAMPLE_FREQ) * (((AUDIO_IN_BIT_RESOLUTION) / 8U) * (AUDIO_IN_NUM_CHANNELS))) / 1000U))
+/* Packet size = (Frames per packet + 1 + catch-up frames) * (Bit resolution / 8) * Num of channels */
+#define MAX_AUDIO_IN_PACKET_SIZE_BYTES          ((AUDIO_IN_MAX_FRAMES_PER_PACKET) * (AUDIO_IN_FRAME_SIZE_BYTES))
+
+/* High-speed isochronous bandwidth: one transaction of at most 1024 bytes
+ * per endpoint and microframe, and at most 80 % of a microframe for all the
+ * periodic endpoints together. The Audio IN endpoints of every capture
+ * interface may be scheduled in the same microframe.
+ */
+#define USB_HS_ISO_MAX_PACKET_SIZE_BYTES        (1024U)
+#define USB_HS_PERIODIC_BYTES_PER_MICROFRAME    (6000U)
+
+#if (MAX_AUDIO_IN_PACKET_SIZE_BYTES > USB_HS_ISO_MAX_PACKET_SIZE_BYTES)
+#error "The Audio IN packets exceed the isochronous packet size limit."
+#endif
+
+#if (((AUDIO_IN_NUM_STREAMS) * (MAX_AUDIO_IN_PACKET_SIZE_BYTES)) > USB_HS_PERIODIC_BYTES_PER_MICROFRAME)
+#error "The Audio IN endpoints exceed the periodic bandwidth of a microframe."
+#endif
+
+/* USB IN Endpoint Audio nominal packet size (in bytes) */
+#define AUDIO_IN_PACKET_SIZE_BYTES              ((AUDIO_IN_FRAMES_PER_PACKET) * (AUDIO_IN_FRAME_SIZE_BYTES))
 
 /* USB IN Endpoint Audio maximum packet size (in words) */
 /* Number of Words = (Number of bytes / Audio sub-frame size) */
 #define MAX_AUDIO_IN_PACKET_SIZE_WORDS          ((MAX_AUDIO_IN_PACKET_SIZE_BYTES) / (AUDIO_IN_SUB_FRAME_SIZE))
 
+/* Every packet must fit in a block of the CM55 mailbox */
+#if ((MAX_AUDIO_IN_PACKET_SIZE_WORDS) > ((AUDIO_IPC_MAX_FRAMES) * (AUDIO_IPC_MAX_CHANNELS)))
+#error "The Audio IN packets exceed the blocks of the CM55 mailbox."
+#endif
+
 /* PDM-PCM Configuration data */
 #define NUM_CHANNELS                            (2u)
 #define LEFT_CH_INDEX                           (2u)
 #define RIGHT_CH_INDEX                          (3u)
 #define PDM_IRQ                                 pdm_0_CHANNEL_3_IRQ
+#define PDM_IRQ_PRIORITY                        (2u)
+#define PDM_FIFO_DEPTH                          (64u)  /* In words, per channel */
 #define LEFT_CH_CONFIG                          channel_2_config
 #define RIGHT_CH_CONFIG                         channel_3_config
 
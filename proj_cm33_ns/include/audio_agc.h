@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name   : audio_agc.h
+*
+* Description : This file contains the declarations of the automatic gain control
+*               and lookahead peak limiter of the Audio IN path.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_AGC_H
+#define AUDIO_AGC_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Delay added by the limiter lookahead, in samples at any sampling rate */
+#define AUDIO_AGC_LOOKAHEAD_FRAMES          (32u)
+#define AUDIO_AGC_LATENCY_SAMPLES           (AUDIO_AGC_LOOKAHEAD_FRAMES)
+
+/* Largest number of channels processed */
+#define AUDIO_AGC_MAX_CHANNELS              (2u)
+
+/* AGC state at startup */
+#ifndef AUDIO_AGC_DEFAULT_ENABLE
+#define AUDIO_AGC_DEFAULT_ENABLE            (0u)
+#endif
+
+/* Default parameters */
+#define AUDIO_AGC_DEFAULT_TARGET_DBFS       (-18)
+#define AUDIO_AGC_DEFAULT_MAX_GAIN_DB       (24u)
+#define AUDIO_AGC_DEFAULT_LIMIT_DBFS        (-1)
+#define AUDIO_AGC_DEFAULT_ATTACK_MS         (10u)
+#define AUDIO_AGC_DEFAULT_RELEASE_MS        (500u)
+
+/* Valid parameter ranges */
+#define AUDIO_AGC_TARGET_DBFS_MIN           (-40)
+#define AUDIO_AGC_TARGET_DBFS_MAX           (-6)
+#define AUDIO_AGC_MAX_GAIN_DB_MAX           (40u)
+#define AUDIO_AGC_LIMIT_DBFS_MIN            (-12)
+#define AUDIO_AGC_LIMIT_DBFS_MAX            (0)
+#define AUDIO_AGC_ATTACK_MS_MIN             (1u)
+#define AUDIO_AGC_ATTACK_MS_MAX             (1000u)
+#define AUDIO_AGC_RELEASE_MS_MIN            (10u)
+#define AUDIO_AGC_RELEASE_MS_MAX            (10000u)
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* AGC parameters, also the payload of the AUDIO_CTRL_AGC control */
+typedef struct
+{
+    uint8_t  enable;                /* 1 to run the AGC and limiter */
+    int8_t   target_dbfs;           /* Target RMS level */
+    uint8_t  max_gain_db;           /* Largest gain applied to quiet signals */
+    int8_t   limit_dbfs;            /* Ceiling of the peak limiter */
+    uint16_t attack_ms;             /* Time constant of gain reductions */
+    uint16_t release_ms;            /* Time constant of gain increases */
+} audio_agc_params_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_agc_init(void);
+void audio_agc_reset(void);
+bool audio_agc_set_params(const audio_agc_params_t *params);
+void audio_agc_get_params(audio_agc_params_t *params);
+bool audio_agc_is_enabled(void);
+void audio_agc_process(int16_t *samples, uint32_t num_frames, uint32_t num_channels);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_AGC_H */
+
+/* [] END OF FILE */
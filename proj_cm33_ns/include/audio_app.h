@@ -45,12 +45,6 @@
 extern "C" {
 #endif
 
-/******************************************************************************
-* Macros
-******************************************************************************/
-#define WRITE_TIMEOUT_MS               (10u)  /* In milliseconds */
-
-
 /******************************************************************************
 * Functions
 ******************************************************************************/
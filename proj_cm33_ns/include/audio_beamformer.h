@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name   : audio_beamformer.h
+*
+* Description : This file contains the delay-and-sum beamformer that combines
+*               the two PDM microphones into a steered mono channel.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_BEAMFORMER_H
+#define AUDIO_BEAMFORMER_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Length of the fractional delay filters */
+#define AUDIO_BF_NUM_TAPS                   (8u)
+
+/* Resolution of the fractional delay, in steps per sample */
+#define AUDIO_BF_FRAC_STEPS                 (32u)
+
+/* Largest steering delay between the two microphones, in samples */
+#define AUDIO_BF_MAX_DELAY_SAMPLES          (4)
+
+/* Steering delays are given in 1/256 of a sample */
+#define AUDIO_BF_DELAY_Q                    (8u)
+#define AUDIO_BF_DELAY_MAX                  ((AUDIO_BF_MAX_DELAY_SAMPLES) << (AUDIO_BF_DELAY_Q))
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_beamformer_init(void);
+void audio_beamformer_reset(void);
+void audio_beamformer_set_steering(int16_t delay);
+int16_t audio_beamformer_get_steering(void);
+void audio_beamformer_process(int16_t *samples, uint32_t num_frames);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_BEAMFORMER_H */
+
+/* [] END OF FILE */
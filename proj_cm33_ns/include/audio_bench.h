@@ -0,0 +1,73 @@
+/******************************************************************************
+* File Name   : audio_bench.h
+*
+* Description : This file contains the microbenchmarks of the capture path kernels.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_BENCH_H
+#define AUDIO_BENCH_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to benchmark the capture path kernels at startup */
+#ifndef AUDIO_BENCH_ENABLE
+#define AUDIO_BENCH_ENABLE                  (0)
+#endif
+
+/* Runs of each kernel, the fastest one is reported */
+#define AUDIO_BENCH_RUNS                    (32u)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+#if (AUDIO_BENCH_ENABLE)
+void audio_bench_run(void);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_BENCH_H */
+
+/* [] END OF FILE */
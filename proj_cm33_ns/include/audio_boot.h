@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name   : audio_boot.h
+*
+* Description : This file contains the boot profiler, which records when the
+*               device reaches each stage of the boot, and the fast boot option.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_BOOT_H
+#define AUDIO_BOOT_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Fast boot: start the USB stack before the clock tree and the capture path
+ * are set up, so that the host enumerates the device while the DPLL locks.
+ * A session the host starts in the meantime begins once the capture path is
+ * ready. */
+#ifndef AUDIO_BOOT_FAST
+#define AUDIO_BOOT_FAST                     (0)
+#endif
+
+/* Time of a stage not reached yet */
+#define AUDIO_BOOT_NOT_REACHED              (0xFFFFFFFFUL)
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+/* Boot stages, in the order of the default boot */
+typedef enum
+{
+    AUDIO_BOOT_NS_MAIN = 0,         /* Non-secure main() entered, the secure boot is done */
+    AUDIO_BOOT_BSP_INIT,            /* Non-secure board support initialized */
+    AUDIO_BOOT_CM55_START,          /* CM55 released */
+    AUDIO_BOOT_SCHEDULER,           /* Audio App Task running */
+    AUDIO_BOOT_CLOCK_LOCKED,        /* DPLL locked and PDM clock running */
+    AUDIO_BOOT_AUDIO_INIT,          /* Capture path initialized */
+    AUDIO_BOOT_USB_START,           /* USBD_Start() called */
+    AUDIO_BOOT_ENUMERATED,          /* Device configured by the host */
+    AUDIO_BOOT_STREAM_START,        /* First session started by the host */
+    AUDIO_BOOT_FIRST_PACKET,        /* First packet of samples handed to the endpoint */
+    AUDIO_BOOT_NUM_STAGES
+} audio_boot_stage_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Payload of the AUDIO_CTRL_BOOT control */
+typedef struct
+{
+    uint32_t stage_us[AUDIO_BOOT_NUM_STAGES];   /* Time of each stage since the secure main(), in us */
+} audio_boot_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_boot_init(void);
+void audio_boot_mark(audio_boot_stage_t stage);
+void audio_boot_poll(void);
+void audio_boot_get_status(audio_boot_status_t *status);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_BOOT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,161 @@
+/******************************************************************************
+* File Name   : audio_capture.h
+*
+* Description : This file contains the record/replay harness of the words read from
+*               the PDM-PCM FIFOs.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_CAPTURE_H
+#define AUDIO_CAPTURE_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to build the record/replay harness */
+#ifndef AUDIO_CAPTURE_ENABLE
+#define AUDIO_CAPTURE_ENABLE                (0)
+#endif
+
+/* Size of the recording, in 32-bit words. A stereo frame takes two words,
+ * every FIFO drain and packet request two more, and every packet sent two
+ * more plus the packet itself. */
+#ifndef AUDIO_CAPTURE_NUM_WORDS
+#define AUDIO_CAPTURE_NUM_WORDS             (32768u)
+#endif
+
+/* Written in the first word of a complete recording */
+#define AUDIO_CAPTURE_MAGIC                 (0x434D4450UL)
+
+/* Words of the recording header */
+#define AUDIO_CAPTURE_HEADER_WORDS          (8u)
+
+/* Event types, in the top byte of the first word of an event. The second
+ * word is the DWT cycle count of the event. */
+#define AUDIO_CAPTURE_EVENT_FIFO            (1u)    /* Followed by 2 words per frame: left, right */
+#define AUDIO_CAPTURE_EVENT_PACKET          (2u)    /* Audio IN endpoint callback */
+#define AUDIO_CAPTURE_EVENT_OUTPUT          (3u)    /* Packet sent for the last request: the size in
+                                                     * bytes, followed by the packet padded to words */
+
+/* Commands of the AUDIO_CTRL_CAPTURE control */
+#define AUDIO_CAPTURE_CMD_STOP              (0u)    /* Stop recording */
+#define AUDIO_CAPTURE_CMD_RECORD            (1u)    /* Record the next session */
+#define AUDIO_CAPTURE_CMD_REPLAY            (2u)    /* Replay the recording */
+#define AUDIO_CAPTURE_CMD_DUMP              (3u)    /* Print the recording on the debug UART */
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+typedef enum
+{
+    AUDIO_CAPTURE_IDLE      = 0,
+    AUDIO_CAPTURE_ARMED     = 1,    /* Waiting for the next session */
+    AUDIO_CAPTURE_RECORDING = 2,
+    AUDIO_CAPTURE_REPLAYING = 3,
+} audio_capture_state_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Header of a recording, in the first words of the buffer. Restoring a
+ * dumped recording into the buffer restores the header too. */
+typedef struct
+{
+    uint32_t magic;                 /* AUDIO_CAPTURE_MAGIC once complete */
+    uint32_t num_words;             /* Words used, header included */
+    uint32_t alt_setting;           /* Alternate setting of the recorded session */
+    uint32_t packets;               /* Packets sent while recording */
+    uint32_t crc;                   /* CRC-32 of the packets sent while recording */
+    uint32_t duration_cycles;       /* Length of the recording */
+    uint32_t queue_target;          /* Capture queue target level of the session, in frames */
+    uint32_t reserved;
+} audio_capture_header_t;
+
+/* Status, also the payload of the AUDIO_CTRL_CAPTURE control */
+typedef struct
+{
+    uint8_t  state;                 /* audio_capture_state_t */
+    uint8_t  match;                 /* 1 if the last replay matched the recording */
+    uint8_t  reserved[2];
+    uint32_t num_words;             /* Words used by the recording */
+    uint32_t packets;               /* Packets of the last replay */
+    uint32_t crc;                   /* CRC-32 of the packets of the last replay */
+    uint32_t replay_cycles;         /* Duration of the last replay */
+} audio_capture_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+#if (AUDIO_CAPTURE_ENABLE)
+bool audio_capture_command(uint8_t command);
+void audio_capture_get_status(audio_capture_status_t *status);
+void audio_capture_poll(void);
+
+/* Hooks of the capture path */
+void audio_capture_session_start(uint32_t alt_setting, uint32_t queue_target);
+void audio_capture_session_end(void);
+void audio_capture_record_fifo(uint32_t num_frames);
+void audio_capture_record_word(uint32_t word);
+bool audio_capture_record_packet(void);
+void audio_capture_record_output(const uint8_t *packet, uint32_t size);
+
+/* Replay of the recording by audio_in_replay() */
+bool audio_capture_is_replaying(void);
+bool audio_capture_replay_begin(uint32_t *alt_setting, uint32_t *queue_target);
+uint32_t audio_capture_replay_next(void);
+uint32_t audio_capture_replay_fifo(void);
+uint32_t audio_capture_replay_word(void);
+void audio_capture_replay_end(uint32_t packets, uint32_t crc, uint32_t cycles);
+uint32_t audio_capture_crc32(uint32_t crc, const uint8_t *data, uint32_t size);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_CAPTURE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/******************************************************************************
+* File Name   : audio_clock_trim.h
+*
+* Description : This file contains the loop that locks the PDM clock to the
+*               USB clock by trimming the audio DPLL.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_CLOCK_TRIM_H
+#define AUDIO_CLOCK_TRIM_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to lock the PDM clock to the USB clock. The audio DPLL is then
+ * trimmed so that the microphones are sampled at the rate the host reads,
+ * and the capture queue no longer drifts. Without it, the drift is taken
+ * up by the packet size adjustment of the Audio IN endpoint. */
+#ifndef AUDIO_CLOCK_TRIM_ENABLE
+#define AUDIO_CLOCK_TRIM_ENABLE             (0)
+#endif
+
+/* Length of one measurement of the PDM clock error. Each one ends with a
+ * trim of the DPLL. */
+#define AUDIO_CLOCK_TRIM_INTERVAL_MS        (1000u)
+
+/* Packets the timestamp estimator needs before its rate is used */
+#define AUDIO_CLOCK_TRIM_SETTLE_PACKETS     (1000u)
+
+/* Fraction of the measured error removed by each trim. Below 1 so that the
+ * measurement noise is averaged over a few intervals. */
+#define AUDIO_CLOCK_TRIM_GAIN               (0.5f)
+
+/* Largest trim applied, in ppm of the DPLL frequency */
+#define AUDIO_CLOCK_TRIM_MAX_PPM            (500)
+
+/* The clocks are locked while the mean error of the last
+ * AUDIO_CLOCK_TRIM_LOCK_COUNT measurements is below this, in ppb */
+#define AUDIO_CLOCK_TRIM_LOCK_PPB           (2000)
+#define AUDIO_CLOCK_TRIM_LOCK_COUNT         (3u)
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* State of the loop, also the payload of the AUDIO_CTRL_CLOCK_TRIM control */
+typedef struct
+{
+    int32_t  trim_ppb;              /* Trim applied to the DPLL */
+    int32_t  error_ppb;             /* PDM clock error against the USB clock, last measurement */
+    int32_t  pdm_ppb;               /* PDM clock error against the device clock, last measurement */
+    uint32_t max_step_ppb;          /* Largest single change of the trim */
+    uint32_t updates;               /* Trims applied */
+    uint32_t saturations;           /* Trims limited by the range of the DPLL */
+    uint32_t lock_ms;               /* Time from the session start to the lock, 0 if not locked yet */
+    uint8_t  available;             /* The DPLL can be trimmed */
+    uint8_t  locked;                /* The mean error is within AUDIO_CLOCK_TRIM_LOCK_PPB */
+    uint8_t  reserved[2];
+} audio_clock_trim_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_clock_trim_init(void);
+void audio_clock_trim_poll(void);
+void audio_clock_trim_get_status(audio_clock_trim_status_t *status);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_CLOCK_TRIM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name   : audio_ctrl.h
+*
+* Description : This file contains the vendor specific audio controls used to
+*               configure and monitor the device at runtime.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_CTRL_H
+#define AUDIO_CTRL_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "Global.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Vendor specific control selectors of the microphone feature unit. The host
+ * accesses them with the class specific SET_CUR/GET_CUR requests addressed
+ * to the feature unit, using a selector above the ones defined by UAC 1.0.
+ */
+#define AUDIO_CTRL_LATENCY_PROFILE          (0xE0u)  /* R/W, 1 byte: audio_profile_id_t */
+#define AUDIO_CTRL_STREAM_STATS             (0xE1u)  /* R, audio_in_stats_t. SET_CUR clears it */
+#define AUDIO_CTRL_BEAM_STEERING            (0xE2u)  /* R/W, 2 bytes: int16_t delay in 1/256 sample */
+#define AUDIO_CTRL_CM55_STAGES              (0xE3u)  /* R/W, 1 byte: AUDIO_IPC_STAGE_* bits */
+#define AUDIO_CTRL_CM55_STATUS              (0xE4u)  /* R, audio_ipc_status_t */
+#define AUDIO_CTRL_AGC                      (0xE5u)  /* R/W, audio_agc_params_t */
+#define AUDIO_CTRL_VAD_MODE                 (0xE6u)  /* R/W, 1 byte: audio_vad_mode_t */
+#define AUDIO_CTRL_VAD_STATUS               (0xE7u)  /* R, audio_vad_status_t. SET_CUR clears it */
+#define AUDIO_CTRL_LEVELS                   (0xE8u)  /* R, audio_in_levels_t. SET_CUR clears the clip counts */
+#define AUDIO_CTRL_PREROLL                  (0xE9u)  /* R/W, 2 bytes: pre-roll in ms */
+#define AUDIO_CTRL_POOL_STATS               (0xEAu)  /* R, audio_pool_stats_t. SET_CUR clears it */
+#define AUDIO_CTRL_TRACE                    (0xEBu)  /* R, audio_trace_status_t. W, 1 byte: AUDIO_TRACE_CMD_* */
+#define AUDIO_CTRL_CPU_LOAD                 (0xECu)  /* R, audio_load_stats_t */
+#define AUDIO_CTRL_CAPTURE                  (0xEDu)  /* R, audio_capture_status_t. W, 1 byte: AUDIO_CAPTURE_CMD_* */
+#define AUDIO_CTRL_CHANNEL_MATRIX           (0xEEu)  /* R/W, audio_matrix_params_t. W, 1 byte: preset audio_matrix_layout_t */
+#define AUDIO_CTRL_TIMESTAMP                (0xEFu)  /* R, audio_timestamp_status_t. SET_CUR clears the jitter */
+#define AUDIO_CTRL_BOOT                     (0xF0u)  /* R, audio_boot_status_t */
+#define AUDIO_CTRL_WATCHDOG                 (0xF1u)  /* R, audio_watchdog_status_t. SET_CUR clears it */
+#define AUDIO_CTRL_CLOCK_TRIM               (0xF2u)  /* R, audio_clock_trim_status_t */
+#define AUDIO_CTRL_RECORDER                 (0xF3u)  /* R, audio_recorder_status_t */
+#define AUDIO_CTRL_SPECTRUM_CONFIG          (0xF4u)  /* R/W, audio_offload_spectrum_config_t */
+#define AUDIO_CTRL_SPECTRUM                 (0xF5u)  /* R, audio_offload_spectrum_page_t. W, 4 bytes: channel, reserved, first bin */
+#define AUDIO_CTRL_FACTORY_TEST             (0xF6u)  /* R, audio_factory_result_t. W, 2 bytes: tone in Hz, 0 for the default */
+
+/* Return values of the control handlers */
+#define AUDIO_CTRL_HANDLED                  (0)
+#define AUDIO_CTRL_NOT_HANDLED              (1)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+int audio_ctrl_set_cur(U8 ControlSelector, const U8 *pBuffer, U32 NumBytes);
+int audio_ctrl_get_cur(U8 ControlSelector, U8 *pBuffer, U32 NumBytes);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_CTRL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,141 @@
+/******************************************************************************
+* File Name   : audio_factory.h
+*
+* Description : This file contains the factory self-test, which measures the
+*               microphones against a reference tone.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_FACTORY_H
+#define AUDIO_FACTORY_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to build the factory self-test */
+#ifndef AUDIO_FACTORY_ENABLE
+#define AUDIO_FACTORY_ENABLE                (0)
+#endif
+
+/* Frequency of the reference tone when the host does not give one */
+#define AUDIO_FACTORY_TONE_HZ               (1000u)
+
+/* Audio discarded at the start of a test, while the microphones and the
+ * decimation filters settle */
+#define AUDIO_FACTORY_SETTLE_MS             (100u)
+
+/* Audio analyzed by a test */
+#define AUDIO_FACTORY_MEASURE_MS            (250u)
+
+/* Period at which the test drains the capture queue. Within the depth of
+ * the capture queue. */
+#define AUDIO_FACTORY_DRAIN_MS              (2u)
+
+/* Highest harmonic of the tone counted as distortion */
+#define AUDIO_FACTORY_NUM_HARMONICS         (5u)
+
+/* Tone level below which a channel is reported without tone, in dBFS */
+#define AUDIO_FACTORY_MIN_LEVEL_DBFS        (-60)
+
+/* Errors of a test, bits of audio_factory_result_t.errors */
+#define AUDIO_FACTORY_ERROR_BUSY            (1u << 0)   /* A host stream needs the microphones */
+#define AUDIO_FACTORY_ERROR_NO_TONE         (1u << 1)   /* A channel is below AUDIO_FACTORY_MIN_LEVEL_DBFS */
+#define AUDIO_FACTORY_ERROR_CLIPPED         (1u << 2)   /* A channel reached full scale */
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+typedef enum
+{
+    AUDIO_FACTORY_IDLE      = 0,    /* No test since power up */
+    AUDIO_FACTORY_PENDING   = 1,    /* Requested, starts at the next poll */
+    AUDIO_FACTORY_RUNNING   = 2,
+    AUDIO_FACTORY_DONE      = 3,    /* Result valid, see the errors */
+} audio_factory_state_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Measurements of one microphone. Levels and ratios in 1/100 dB. */
+typedef struct
+{
+    int16_t  level;                 /* Tone level, dBFS. A full scale sine reads 0 */
+    int16_t  snr;                   /* Tone against the noise, harmonics excluded */
+    int16_t  thd;                   /* Harmonics against the tone */
+    int16_t  thd_n;                 /* Everything but the tone against the tone */
+    int16_t  noise_floor;           /* Noise, harmonics excluded, dBFS */
+    int16_t  dc_offset;             /* DC offset, in 16-bit full scale units */
+} audio_factory_channel_t;
+
+/* Result, also the payload of the AUDIO_CTRL_FACTORY_TEST control */
+typedef struct
+{
+    uint8_t  state;                 /* audio_factory_state_t */
+    uint8_t  errors;                /* AUDIO_FACTORY_ERROR_* bits */
+    uint16_t tone_hz;               /* Reference tone of the test */
+    uint32_t frames;                /* Frames analyzed */
+    uint32_t duration_ms;           /* From the start of the test to the result */
+    audio_factory_channel_t channel[2];     /* PDM channels 2 (left) and 3 (right) */
+    int16_t  level_mismatch;        /* Left level minus right level, 1/100 dB */
+    int16_t  phase_mismatch;        /* Left phase minus right phase, 1/100 degree */
+} audio_factory_result_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+bool audio_factory_request(uint32_t tone_hz);
+void audio_factory_poll(void);
+void audio_factory_get_result(audio_factory_result_t *result);
+void audio_factory_analyze(const int16_t *samples, uint32_t num_frames, uint32_t tone_hz,
+                           uint32_t sample_rate, audio_factory_result_t *result);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_FACTORY_H */
+
+/* [] END OF FILE */
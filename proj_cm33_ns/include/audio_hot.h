@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name   : audio_hot.h
+*
+* Description : This file contains the placement of the capture and USB hot
+*               path in memory.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_HOT_H
+#define AUDIO_HOT_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "cy_pdl.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to run the functions called for every PDM-PCM interrupt and every
+ * Audio IN packet from SRAM, instead of executing them in place from the
+ * external QSPI flash where a miss of the XIP cache stalls the CPU. They are
+ * copied to SRAM at startup through the .cy_ramfunc section of the BSP
+ * linker script. The constant data they read is moved to SRAM as well.
+ */
+#ifndef AUDIO_HOT_PATH_IN_RAM
+#define AUDIO_HOT_PATH_IN_RAM               (0u)
+#endif
+
+#if (AUDIO_HOT_PATH_IN_RAM)
+/* Surround the definition of a function of the hot path */
+#define AUDIO_HOT_FUNC_BEGIN                CY_RAMFUNC_BEGIN
+#define AUDIO_HOT_FUNC_END                  CY_RAMFUNC_END
+/* Qualifier of the constant data read by the hot path */
+#define AUDIO_HOT_CONST
+#else
+#define AUDIO_HOT_FUNC_BEGIN
+#define AUDIO_HOT_FUNC_END
+#define AUDIO_HOT_CONST                     const
+#endif
+
+/* Where the hot path runs from, for the reports */
+#define AUDIO_HOT_PATH_LOCATION             ((AUDIO_HOT_PATH_IN_RAM) ? "SRAM" : "XIP flash")
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_HOT_H */
+
+/* [] END OF FILE */
@@ -45,22 +45,91 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "Global.h"
 
 
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Length of the level metering window */
+#define AUDIO_IN_METER_WINDOW_MS            (100u)
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Audio IN streaming statistics */
+typedef struct
+{
+    uint32_t packets;               /* Audio packets sent to the host */
+    uint32_t underruns;             /* Packets shortened because the capture queue ran dry */
+    uint32_t overruns;              /* Frames dropped because the capture queue was full */
+    uint32_t fifo_overflows;        /* PDM-PCM FIFO overflow events */
+    uint32_t queue_frames_sum;      /* Sum of the capture queue level at every packet */
+    uint32_t queue_frames_max;      /* Highest capture queue level at a packet */
+    uint32_t bytes;                 /* Bytes sent on the Audio IN endpoint, silence included */
+} audio_in_stats_t;
+
+/* Progress of the capture path, watched by the pipeline watchdog */
+typedef struct
+{
+    uint32_t frames;                /* Frames captured, free running */
+    uint32_t requests;              /* Packet requests of the Audio IN endpoints while recording */
+    bool streaming;                 /* A capture interface is recording */
+    bool capturing;                 /* The microphones are running */
+} audio_in_progress_t;
+
+/* Level of one microphone, in 16-bit full scale units */
+typedef struct
+{
+    uint16_t peak;                  /* Largest magnitude in the metering window */
+    uint16_t rms;                   /* RMS level in the metering window */
+    uint32_t clips;                 /* Full scale samples since the last clear */
+} audio_in_channel_level_t;
+
+/* Microphone levels, also the payload of the AUDIO_CTRL_LEVELS control */
+typedef struct
+{
+    uint32_t frames;                /* Frames in the metering window, 0 before the first one */
+    audio_in_channel_level_t channel[2];    /* Left, right */
+} audio_in_levels_t;
+
+
 /******************************************************************************
 * Externs
 ******************************************************************************/
 extern U8 mic_mute;
+extern U8 raw_mic_mute;
 
 /******************************************************************************
 * Audio In Functions
 ******************************************************************************/
 void audio_in_init(void);
-void audio_in_enable(void);
+void audio_in_enable(U8 alt_setting);
 void audio_in_disable(void);
 void audio_in_process(void *arg);
 void audio_in_endpoint_callback(void *pUserContext, const U8 **ppNextBuffer, U32 *pNextPacketSize);
+void audio_in_get_stats(audio_in_stats_t *stats);
+void audio_in_reset_stats(void);
+void audio_in_get_levels(audio_in_levels_t *levels);
+void audio_in_reset_levels(void);
+bool audio_in_set_preroll(uint32_t preroll_ms);
+uint32_t audio_in_get_preroll(void);
+bool audio_in_replay(void);
+U8 audio_in_get_alt_setting(void);
+void audio_in_get_progress(audio_in_progress_t *progress);
+void audio_in_flush(void);
+void audio_in_rearm(void);
+void audio_in_offline_enable(void);
+void audio_in_offline_disable(void);
+uint32_t audio_in_offline_read(uint16_t *buffer, uint32_t max_frames);
+void audio_in_tap_enable(void);
+void audio_in_tap_disable(void);
+void audio_in_raw_enable(void);
+void audio_in_raw_disable(void);
+void audio_in_raw_endpoint_callback(void *pUserContext, const U8 **ppNextBuffer, U32 *pNextPacketSize);
 
 
 #if defined(__cplusplus)
@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name   : audio_load.h
+*
+* Description : This file contains the CPU load meter of the CM33 and the CM55.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_LOAD_H
+#define AUDIO_LOAD_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Window over which the peak load is taken, in milliseconds */
+#define AUDIO_LOAD_WINDOW_MS                (100u)
+
+/* Interval of the average load, in milliseconds */
+#define AUDIO_LOAD_PERIOD_MS                (1000u)
+
+/* Longest gap between two calls of the idle hook that is counted as idle
+ * time. A longer gap means a task or an interrupt ran in between. */
+#define AUDIO_LOAD_IDLE_LOOP_MAX_CYCLES     (2000u)
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Load of each core in units of 0.01 %, payload of the AUDIO_CTRL_CPU_LOAD
+ * control */
+typedef struct
+{
+    uint16_t cm33_load;                 /* Average over the last period */
+    uint16_t cm33_peak;                 /* Highest window of the last period */
+    uint16_t cm55_load;
+    uint16_t cm55_peak;
+} audio_load_stats_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_load_init(void);
+void audio_load_update(void);
+void audio_load_get_stats(audio_load_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_LOAD_H */
+
+/* [] END OF FILE */
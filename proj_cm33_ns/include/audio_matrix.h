@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name   : audio_matrix.h
+*
+* Description : This file contains the channel matrix stage that maps the
+*               microphones to the channels of the Audio IN packets.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_MATRIX_H
+#define AUDIO_MATRIX_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Unity coefficient of the matrix, Q14 */
+#define AUDIO_MATRIX_UNITY                  (16384)
+
+/* Channels in and out of the matrix: left, right */
+#define AUDIO_MATRIX_NUM_CHANNELS           (2u)
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+/* Layouts with a specialized loop. Also the 1-byte presets of the
+ * AUDIO_CTRL_CHANNEL_MATRIX control, up to AUDIO_MATRIX_LAYOUT_MONO_SUM. */
+typedef enum
+{
+    AUDIO_MATRIX_LAYOUT_IDENTITY = 0,   /* Left and right as captured, no processing */
+    AUDIO_MATRIX_LAYOUT_SWAP,           /* Left and right swapped */
+    AUDIO_MATRIX_LAYOUT_LEFT,           /* Left microphone on both channels */
+    AUDIO_MATRIX_LAYOUT_RIGHT,          /* Right microphone on both channels */
+    AUDIO_MATRIX_LAYOUT_MONO_SUM,       /* Average of both microphones on both channels */
+    AUDIO_MATRIX_LAYOUT_GAIN,           /* Gain per channel, no mixing */
+    AUDIO_MATRIX_LAYOUT_GENERAL,        /* Any other matrix */
+} audio_matrix_layout_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Channel matrix, also the 8-byte payload of the AUDIO_CTRL_CHANNEL_MATRIX
+ * control: out[row] = sum of coeffs[row][col] * in[col], in Q14, with
+ * left = 0 and right = 1. The coefficients range from just above -2 to
+ * just below +2. */
+typedef struct
+{
+    int16_t coeffs[AUDIO_MATRIX_NUM_CHANNELS][AUDIO_MATRIX_NUM_CHANNELS];
+} audio_matrix_params_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_matrix_init(void);
+bool audio_matrix_set(const audio_matrix_params_t *params);
+bool audio_matrix_set_layout(audio_matrix_layout_t layout);
+void audio_matrix_get(audio_matrix_params_t *params);
+void audio_matrix_process(int16_t *samples, uint32_t num_frames);
+void audio_matrix_downmix(int16_t *mono, const int16_t *left, const int16_t *right,
+                          uint32_t stride, uint32_t num_frames);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_MATRIX_H */
+
+/* [] END OF FILE */
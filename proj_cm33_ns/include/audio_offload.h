@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name   : audio_offload.h
+*
+* Description : This file contains the CM33 side of the audio processing
+*               offload to the CM55.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_OFFLOAD_H
+#define AUDIO_OFFLOAD_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "audio_ipc.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Stages enabled at startup, AUDIO_IPC_STAGE_* bits */
+#ifndef AUDIO_OFFLOAD_DEFAULT_STAGES
+#define AUDIO_OFFLOAD_DEFAULT_STAGES        (0u)
+#endif
+
+/* Spectrum analyzer settings at startup */
+#define AUDIO_OFFLOAD_SPECTRUM_FFT_SIZE     (512u)
+#define AUDIO_OFFLOAD_SPECTRUM_HOP_SIZE     (256u)
+#define AUDIO_OFFLOAD_SPECTRUM_NUM_AVERAGE  (16u)
+
+/* Bins returned per page of the spectrum */
+#define AUDIO_OFFLOAD_SPECTRUM_PAGE_BINS    (32u)
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+typedef struct
+{
+    uint32_t dropped;               /* Blocks not sent because the CM55 ring was full */
+    uint32_t late;                  /* Packets without a processed block ready */
+    uint32_t analyzer_dropped;      /* Blocks not sent because the spectrum analyzer ring was full */
+} audio_offload_stats_t;
+
+/* Spectrum analyzer settings, also the payload of the
+ * AUDIO_CTRL_SPECTRUM_CONFIG control */
+typedef struct
+{
+    uint16_t fft_size;              /* Power of 2, AUDIO_IPC_SPECTRUM_MIN_FFT_SIZE to _MAX_FFT_SIZE */
+    uint16_t hop_size;              /* Frames between two analysis frames, fft_size / 4 to fft_size */
+    uint16_t num_average;           /* Analysis frames averaged into one result */
+    uint16_t reserved;
+} audio_offload_spectrum_config_t;
+
+/* Page of the last spectrum, the payload of the AUDIO_CTRL_SPECTRUM control */
+typedef struct
+{
+    uint32_t results;               /* Results published in the session, 0 if none yet */
+    uint16_t fft_size;              /* Settings of the result */
+    uint16_t hop_size;
+    uint16_t num_average;
+    uint16_t num_bins;              /* Bins per channel, fft_size / 2 + 1 */
+    uint32_t avg_cycles;            /* Average CM55 cycles per analysis frame */
+    uint32_t max_cycles;            /* Worst case CM55 cycles per analysis frame */
+    uint8_t  channel;               /* Channel of the page */
+    uint8_t  num_channels;          /* Channels analyzed */
+    uint16_t first_bin;             /* Bin of level[0] */
+    int16_t  level[AUDIO_OFFLOAD_SPECTRUM_PAGE_BINS];  /* 1/100 dBFS, AUDIO_IPC_SPECTRUM_FLOOR past the last bin */
+} audio_offload_spectrum_page_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_offload_init(void);
+void audio_offload_start(void);
+void audio_offload_stop(void);
+void audio_offload_restart(void);
+bool audio_offload_is_active(void);
+void audio_offload_set_stages(uint32_t stages);
+void audio_offload_apply_stages(void);
+uint32_t audio_offload_get_stages(void);
+uint32_t audio_offload_process(int16_t *samples, uint32_t num_frames, uint32_t num_channels);
+void audio_offload_get_status(audio_ipc_status_t *status, audio_offload_stats_t *stats);
+bool audio_offload_set_spectrum_config(const audio_offload_spectrum_config_t *config);
+void audio_offload_get_spectrum_config(audio_offload_spectrum_config_t *config);
+bool audio_offload_select_spectrum_page(uint32_t channel, uint32_t first_bin);
+bool audio_offload_get_spectrum_page(audio_offload_spectrum_page_t *page);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_OFFLOAD_H */
+
+/* [] END OF FILE */
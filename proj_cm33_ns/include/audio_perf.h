@@ -0,0 +1,133 @@
+/******************************************************************************
+* File Name   : audio_perf.h
+*
+* Description : This file contains the cycle counter based profiling helpers
+*               used to measure the CPU cost of the audio path.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_PERF_H
+#define AUDIO_PERF_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "cy_pdl.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to measure the cost of the audio path with the DWT cycle counter
+ * and print a summary on the debug UART while recording.
+ */
+#ifndef AUDIO_PERF_ENABLE
+#define AUDIO_PERF_ENABLE                   (0u)
+#endif
+
+/* Interval between two reports, in milliseconds */
+#define AUDIO_PERF_REPORT_INTERVAL_MS       (1000u)
+
+#if (AUDIO_PERF_ENABLE)
+/* Declare a local holding the cycle count at the start of a measurement */
+#define AUDIO_PERF_BEGIN(start)             uint32_t start = audio_perf_get_cycles()
+/* Account the cycles elapsed since AUDIO_PERF_BEGIN() to a counter */
+#define AUDIO_PERF_END(counter, start)      audio_perf_update(&(counter), audio_perf_get_cycles() - (start))
+#else
+#define AUDIO_PERF_BEGIN(start)
+#define AUDIO_PERF_END(counter, start)
+#endif
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+typedef struct
+{
+    uint32_t count;             /* Number of measurements */
+    uint32_t min_cycles;        /* Best case of a single measurement */
+    uint32_t max_cycles;        /* Worst case of a single measurement */
+    uint64_t total_cycles;      /* Sum of all measurements */
+} audio_perf_counter_t;
+
+
+/******************************************************************************
+* Externs
+******************************************************************************/
+/* Cost of audio_in_endpoint_callback() */
+extern audio_perf_counter_t audio_perf_callback;
+/* Cost of the beamformer per packet */
+extern audio_perf_counter_t audio_perf_beamformer;
+/* Cost of the AGC and limiter per packet */
+extern audio_perf_counter_t audio_perf_agc;
+/* Cost of the voice activity detector per packet */
+extern audio_perf_counter_t audio_perf_vad;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_perf_init(void);
+void audio_perf_update(audio_perf_counter_t *counter, uint32_t cycles);
+void audio_perf_reset(audio_perf_counter_t *counter);
+void audio_perf_report(const char *name, audio_perf_counter_t *counter, uint32_t calls_per_sec);
+
+
+/******************************************************************************
+* Function Name: audio_perf_get_cycles
+*******************************************************************************
+* Summary:
+*  Return the current value of the DWT cycle counter.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: CPU cycle count
+*
+******************************************************************************/
+__STATIC_INLINE uint32_t audio_perf_get_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_PERF_H */
+
+/* [] END OF FILE */
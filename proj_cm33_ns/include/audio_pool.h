@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name   : audio_pool.h
+*
+* Description : This file contains the declarations of the reference counted pool
+*               of Audio IN packets shared between the consumers of the capture.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_POOL_H
+#define AUDIO_POOL_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "audio.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Packets in the pool. Two are held by each Audio IN endpoint and
+ * AUDIO_IN_TAP_PACKETS by the capture tap, the others are available to the
+ * consumers holding on to packets. */
+#ifndef AUDIO_POOL_NUM_PACKETS
+#define AUDIO_POOL_NUM_PACKETS              (6u + (2u * (AUDIO_IN_NUM_STREAMS)) + (AUDIO_IN_TAP_PACKETS))
+#endif
+
+/* Largest number of consumers registered with the pool */
+#define AUDIO_POOL_MAX_CONSUMERS            (4u)
+
+
+/* Sources of the published packets, audio_packet_t.source */
+#define AUDIO_POOL_SOURCE_MIC               (0u)    /* Processed packet of the microphone interface */
+#define AUDIO_POOL_SOURCE_TAP               (1u)    /* Both microphones as captured, from the capture tap */
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* One packet of interleaved captured frames. Read only once published. */
+typedef struct
+{
+    uint32_t refcount;                  /* Owners of the packet, changed through the pool only */
+    uint32_t sequence;                  /* Incremented for every allocated packet */
+    uint32_t position;                  /* Capture position of the first frame, in frames */
+    uint32_t capture_cycles;            /* CM33 cycle count at the capture of the first frame */
+    uint32_t usb_time;                  /* USB time of the first frame, see audio_timestamp.h */
+    uint16_t num_frames;
+    uint16_t num_channels;
+    uint16_t source;                    /* AUDIO_POOL_SOURCE_* */
+    int16_t  samples[MAX_AUDIO_IN_PACKET_SIZE_WORDS];
+} audio_packet_t;
+
+/* Called for every published packet. The packet is only valid during the
+ * call unless the consumer takes a reference with audio_pool_retain(). */
+typedef void (*audio_pool_consumer_t)(audio_packet_t *packet, void *context);
+
+/* Pool occupancy, also the payload of the AUDIO_CTRL_POOL_STATS control */
+typedef struct
+{
+    uint32_t in_use;                    /* Packets currently allocated */
+    uint32_t high_water;                /* Most packets allocated at once since the last clear */
+    uint32_t alloc_failures;            /* Allocations refused because the pool was empty */
+    uint32_t published;                 /* Packets passed to the consumers */
+} audio_pool_stats_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_pool_init(void);
+audio_packet_t *audio_pool_alloc(void);
+void audio_pool_retain(audio_packet_t *packet);
+void audio_pool_release(audio_packet_t *packet);
+bool audio_pool_add_consumer(audio_pool_consumer_t consumer, void *context);
+void audio_pool_publish(audio_packet_t *packet);
+void audio_pool_get_stats(audio_pool_stats_t *stats);
+void audio_pool_reset_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_POOL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name   : audio_profile.h
+*
+* Description : This file contains the latency profile definitions used to
+*               select the buffering depth of the Audio IN path at runtime.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_PROFILE_H
+#define AUDIO_PROFILE_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Deepest capture queue of all the profiles, in packets */
+#define AUDIO_PROFILE_MAX_QUEUE_DEPTH       (4u)
+
+/* Profile used at startup */
+#define AUDIO_PROFILE_DEFAULT               (AUDIO_PROFILE_BALANCED)
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+typedef enum
+{
+    AUDIO_PROFILE_LOW_LATENCY = 0,      /* Conferencing: minimum latency */
+    AUDIO_PROFILE_BALANCED,             /* General purpose */
+    AUDIO_PROFILE_ROBUST,               /* Archival recording: maximum glitch resistance */
+    AUDIO_PROFILE_COUNT
+} audio_profile_id_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint8_t  queue_depth;           /* Packets buffered between capture and USB */
+    uint8_t  fifo_trigger_level;    /* PDM-PCM FIFO entries that raise the capture interrupt */
+    uint16_t write_timeout_ms;      /* Audio IN endpoint write timeout */
+} audio_profile_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+bool audio_profile_set(audio_profile_id_t id);
+audio_profile_id_t audio_profile_get_id(void);
+const audio_profile_t *audio_profile_get(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_PROFILE_H */
+
+/* [] END OF FILE */
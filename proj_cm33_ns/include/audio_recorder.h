@@ -0,0 +1,153 @@
+/******************************************************************************
+* File Name   : audio_recorder.h
+*
+* Description : This file contains the offline recorder, which records the
+*               microphones to a storage device while no USB host is connected.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_RECORDER_H
+#define AUDIO_RECORDER_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to record the microphones while no host is connected */
+#ifndef AUDIO_RECORDER_ENABLE
+#define AUDIO_RECORDER_ENABLE               (0)
+#endif
+
+/* Storage backend, an audio_store_backend_t */
+#ifndef AUDIO_RECORDER_BACKEND
+#define AUDIO_RECORDER_BACKEND              audio_store_ram
+#endif
+
+/* Time without a host before the recording starts. It lets a host that is
+ * connected at power up enumerate the device first. */
+#define AUDIO_RECORDER_START_DELAY_MS       (2000u)
+
+/* Period at which the Audio Rec Task moves the captured frames to the
+ * buffer. Within the depth of the capture queue. */
+#define AUDIO_RECORDER_DRAIN_MS             (2u)
+
+/* Audio buffered between the capture and the storage device. It covers
+ * the longest write of the device, and its longest erase or erase step:
+ * the capture never waits for the device, and the frames that do not fit
+ * are dropped. */
+#define AUDIO_RECORDER_BUFFER_MS            (250u)
+
+/* Largest write to the storage device */
+#define AUDIO_RECORDER_WRITE_BYTES          (4096u)
+
+/* Bytes at the start of a segment for its WAV header. The audio follows. */
+#define AUDIO_RECORDER_HEADER_BYTES         (512u)
+
+/* Most segments of a storage device used by the recorder */
+#define AUDIO_RECORDER_MAX_SEGMENTS         (256u)
+
+/* Written in the segment record of a complete segment */
+#define AUDIO_RECORDER_MAGIC                (0x47455341UL)
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+typedef enum
+{
+    AUDIO_RECORDER_IDLE      = 0,
+    AUDIO_RECORDER_ARMED     = 1,   /* No host, waiting for the start delay */
+    AUDIO_RECORDER_RECORDING = 2,
+    AUDIO_RECORDER_FLUSHING  = 3,   /* Capture stopped, writing the buffered audio */
+    AUDIO_RECORDER_FAILED    = 4,   /* The storage device failed */
+} audio_recorder_state_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Record of a segment, in the "aseg" chunk of its WAV header. WAV readers
+ * skip the chunk. The sequence orders the segments of the log. */
+typedef struct
+{
+    uint32_t magic;                 /* AUDIO_RECORDER_MAGIC */
+    uint32_t sequence;              /* Position of the segment in the log */
+    uint32_t session;               /* Recording session of the segment */
+    uint32_t erase_count;           /* Erases of the segment, this one included */
+    uint32_t frames;                /* Frames in the segment */
+    uint32_t dropped_frames;        /* Frames dropped in the session before the end of the segment */
+} audio_recorder_segment_t;
+
+/* Status, also the payload of the AUDIO_CTRL_RECORDER control */
+typedef struct
+{
+    uint8_t  state;                 /* audio_recorder_state_t */
+    uint8_t  reserved[3];
+    uint32_t sessions;              /* Recording sessions since power up */
+    uint32_t segments;              /* Segments completed */
+    uint32_t frames;                /* Frames written */
+    uint32_t dropped_frames;        /* Frames dropped on a full buffer */
+    uint32_t errors;                /* Failed erases and writes */
+    uint32_t buffer_max_bytes;      /* Largest use of the buffer */
+    uint32_t write_max_us;          /* Longest write */
+    uint32_t erase_max_us;          /* Longest erase, or erase step */
+    uint32_t throughput_kib_s;      /* Bytes written per second of device time, in KiB */
+    uint32_t erase_count_min;       /* Least erased segment */
+    uint32_t erase_count_max;       /* Most erased segment */
+} audio_recorder_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_recorder_init(void);
+void audio_recorder_arm(void);
+void audio_recorder_stop(void);
+void audio_recorder_get_status(audio_recorder_status_t *status);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_RECORDER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name   : audio_store.h
+*
+* Description : This file contains the storage backend interface of the offline
+*               recorder.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_STORE_H
+#define AUDIO_STORE_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Size of the RAM backend. It holds a few seconds at most, and serves to
+ * bring up the recorder and to measure it without a storage device. */
+#ifndef AUDIO_STORE_RAM_SEGMENTS
+#define AUDIO_STORE_RAM_SEGMENTS            (4u)
+#endif
+#ifndef AUDIO_STORE_RAM_SEGMENT_BYTES
+#define AUDIO_STORE_RAM_SEGMENT_BYTES       (32768u)
+#endif
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Storage device of the offline recorder, split in segments that are
+ * erased as a whole. Erased bytes read as 0xFF and a write only programs
+ * erased bytes, as on a NOR flash. Devices that rewrite in place, such as
+ * an SD card, can make erase a no-op. The functions may block: only the
+ * Audio Store Task calls them. They return false on a device error.
+ * A device whose erase outlasts the recorder buffer also provides
+ * erase_step, which erases a segment a slice at a time. It is called with
+ * the same segment until it sets done, and the other segments may be read
+ * and written between the calls. */
+typedef struct
+{
+    const char *name;
+    uint32_t num_segments;
+    uint32_t segment_bytes;
+    bool (*init)(void);
+    bool (*read)(uint32_t segment, uint32_t offset, void *data, uint32_t size);
+    bool (*erase)(uint32_t segment);
+    bool (*erase_step)(uint32_t segment, bool *done);
+    bool (*write)(uint32_t segment, uint32_t offset, const void *data, uint32_t size);
+} audio_store_backend_t;
+
+
+/******************************************************************************
+* Externs
+******************************************************************************/
+extern const audio_store_backend_t audio_store_ram;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_STORE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name   : audio_timestamp.h
+*
+* Description : This file contains the timestamps of the captured audio and
+*               their mapping to the USB time of the host.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_TIMESTAMP_H
+#define AUDIO_TIMESTAMP_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Gains of the alpha-beta filter that tracks the USB time: the phase and
+ * the rate correction applied per packet. Critically damped. The filter
+ * settles in a few hundred packets and averages the scheduling jitter of
+ * the packet requests down to a few ppm of rate noise. */
+#define AUDIO_TIMESTAMP_ALPHA               (0.0078125f)
+#define AUDIO_TIMESTAMP_BETA                ((AUDIO_TIMESTAMP_ALPHA * AUDIO_TIMESTAMP_ALPHA) / (2.0f - AUDIO_TIMESTAMP_ALPHA))
+
+/* Fractional bits of the USB time, in microframes */
+#define AUDIO_TIMESTAMP_USB_FRAC_BITS       (8u)
+
+/* Test only: offset in ppm added to the device clock as seen by the
+ * estimator, to check that it tracks a clock that runs fast or slow. The
+ * rate it reports moves by the same amount. */
+#ifndef AUDIO_TIMESTAMP_TEST_OFFSET_PPM
+#define AUDIO_TIMESTAMP_TEST_OFFSET_PPM     (0)
+#endif
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Timing of the last packet and state of the estimator, also the payload
+ * of the AUDIO_CTRL_TIMESTAMP control */
+typedef struct
+{
+    uint32_t position;              /* Capture position of the first frame of the packet, in frames */
+    uint32_t usb_time;              /* Its USB time since the session start, in 1/256 microframe */
+    int32_t  rate_ppb;              /* Device clock error against the USB clock, in ppb */
+    uint32_t jitter_rms_ns;         /* RMS of the estimator residual */
+    uint32_t jitter_max_ns;         /* Largest estimator residual since the last clear */
+    uint32_t packets;               /* Packets seen by the estimator in the session */
+} audio_timestamp_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_timestamp_init(void);
+void audio_timestamp_capture(uint32_t position, uint32_t cycles);
+void audio_timestamp_start(uint32_t cycles);
+void audio_timestamp_usb_packet(uint32_t cycles);
+void audio_timestamp_stamp(uint32_t position, uint32_t *capture_cycles, uint32_t *usb_time);
+void audio_timestamp_get_anchor(uint32_t *position, uint32_t *cycles);
+uint32_t audio_timestamp_usb_time(uint32_t cycles);
+void audio_timestamp_get_status(audio_timestamp_status_t *status);
+void audio_timestamp_reset_stats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_TIMESTAMP_H */
+
+/* [] END OF FILE */
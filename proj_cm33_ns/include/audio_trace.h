@@ -0,0 +1,150 @@
+/******************************************************************************
+* File Name   : audio_trace.h
+*
+* Description : This file contains the declarations of the trace recorder that logs
+*               task switches, interrupts and audio events into a RAM ring. It is
+*               included by FreeRTOSConfig.h to hook the FreeRTOS trace macros.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_TRACE_H
+#define AUDIO_TRACE_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Set to 1 to build the trace recorder. With 0 all the hooks compile to
+ * nothing. */
+#ifndef AUDIO_TRACE_ENABLE
+#define AUDIO_TRACE_ENABLE                  (0)
+#endif
+
+/* Events kept in the ring, a power of 2. The oldest events are overwritten. */
+#define AUDIO_TRACE_NUM_EVENTS              (2048u)
+
+/* Tasks whose names are recorded */
+#define AUDIO_TRACE_MAX_TASKS               (16u)
+
+/* Event types */
+#define AUDIO_TRACE_TYPE_TASK_SWITCH        (1u)    /* id: task number */
+#define AUDIO_TRACE_TYPE_ISR_ENTER          (2u)    /* id: AUDIO_TRACE_ISR_* */
+#define AUDIO_TRACE_TYPE_ISR_EXIT           (3u)
+#define AUDIO_TRACE_TYPE_BEGIN              (4u)    /* id: AUDIO_TRACE_ID_*, arg: event data */
+#define AUDIO_TRACE_TYPE_END                (5u)
+#define AUDIO_TRACE_TYPE_MARK               (6u)
+
+/* Interrupts */
+#define AUDIO_TRACE_ISR_PDM                 (1u)
+
+/* Audio events */
+#define AUDIO_TRACE_ID_CALLBACK             (1u)    /* audio_in_endpoint_callback(), arg: queue level/frames sent */
+#define AUDIO_TRACE_ID_UNDERRUN             (2u)    /* arg: queue level */
+#define AUDIO_TRACE_ID_OFFLOAD              (3u)    /* CM55 exchange, arg: frames sent/returned */
+
+/* Commands of the AUDIO_CTRL_TRACE control */
+#define AUDIO_TRACE_CMD_STOP                (0u)
+#define AUDIO_TRACE_CMD_START               (1u)
+#define AUDIO_TRACE_CMD_DUMP                (2u)
+
+#if (AUDIO_TRACE_ENABLE)
+#define AUDIO_TRACE_ISR_ENTER(isr)          audio_trace_record(AUDIO_TRACE_TYPE_ISR_ENTER, (isr), 0u)
+#define AUDIO_TRACE_ISR_EXIT(isr)           audio_trace_record(AUDIO_TRACE_TYPE_ISR_EXIT, (isr), 0u)
+#define AUDIO_TRACE_BEGIN(id, arg)          audio_trace_record(AUDIO_TRACE_TYPE_BEGIN, (id), (uint16_t) (arg))
+#define AUDIO_TRACE_END(id, arg)            audio_trace_record(AUDIO_TRACE_TYPE_END, (id), (uint16_t) (arg))
+#define AUDIO_TRACE_MARK(id, arg)           audio_trace_record(AUDIO_TRACE_TYPE_MARK, (id), (uint16_t) (arg))
+
+/* FreeRTOS trace hooks, expanded inside tasks.c */
+#define traceTASK_SWITCHED_IN()             audio_trace_record(AUDIO_TRACE_TYPE_TASK_SWITCH, \
+                                                               (uint8_t) pxCurrentTCB->uxTCBNumber, 0u)
+#define traceTASK_CREATE(pxNewTCB)          audio_trace_task_create((pxNewTCB)->uxTCBNumber, \
+                                                                    (pxNewTCB)->pcTaskName)
+#else
+#define AUDIO_TRACE_ISR_ENTER(isr)
+#define AUDIO_TRACE_ISR_EXIT(isr)
+#define AUDIO_TRACE_BEGIN(id, arg)
+#define AUDIO_TRACE_END(id, arg)
+#define AUDIO_TRACE_MARK(id, arg)
+#endif
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* One trace event */
+typedef struct
+{
+    uint32_t timestamp;                 /* DWT cycle counter */
+    uint8_t  type;                      /* AUDIO_TRACE_TYPE_* */
+    uint8_t  id;
+    uint16_t arg;
+} audio_trace_event_t;
+
+/* Recorder status, also the payload of the AUDIO_CTRL_TRACE control */
+typedef struct
+{
+    uint8_t  running;
+    uint8_t  reserved[3];
+    uint32_t events;                    /* Events recorded since the start */
+    uint32_t capacity;                  /* Events kept in the ring */
+    uint32_t cycles_per_event;          /* Measured cost of recording one event */
+} audio_trace_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+#if (AUDIO_TRACE_ENABLE)
+void audio_trace_init(void);
+void audio_trace_record(uint8_t type, uint8_t id, uint16_t arg);
+void audio_trace_task_create(uint32_t task_number, const char *name);
+int audio_trace_command(uint8_t command);
+void audio_trace_get_status(audio_trace_status_t *status);
+void audio_trace_poll(void);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_TRACE_H */
+
+/* [] END OF FILE */
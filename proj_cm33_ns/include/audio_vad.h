@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name   : audio_vad.h
+*
+* Description : This file contains the declarations of the voice activity detector
+*               of the Audio IN path.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_VAD_H
+#define AUDIO_VAD_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Length of the analysis frames the decision is taken on */
+#define AUDIO_VAD_FRAME_MS                  (10u)
+
+/* Time speech is held after the last speech frame, so that word endings
+ * and short pauses are not cut */
+#define AUDIO_VAD_HANGOVER_MS               (300u)
+
+/* Mode at startup */
+#ifndef AUDIO_VAD_DEFAULT_MODE
+#define AUDIO_VAD_DEFAULT_MODE              (AUDIO_VAD_MODE_MONITOR)
+#endif
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+typedef enum
+{
+    AUDIO_VAD_MODE_MONITOR = 0,     /* Detect and report only */
+    AUDIO_VAD_MODE_GATE,            /* Stream silence and skip the processing stages without speech */
+    AUDIO_VAD_MODE_COUNT
+} audio_vad_mode_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* VAD status, also the payload of the AUDIO_CTRL_VAD_STATUS control */
+typedef struct
+{
+    uint8_t  speech;                /* 1 while speech is detected */
+    uint8_t  mode;                  /* audio_vad_mode_t */
+    uint8_t  reserved[2];
+    uint32_t frames;                /* Analysis frames since the last clear */
+    uint32_t speech_frames;         /* Frames detected as speech, including hangover */
+    uint32_t onsets;                /* Transitions from silence to speech */
+} audio_vad_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_vad_init(void);
+void audio_vad_reset(void);
+bool audio_vad_set_mode(audio_vad_mode_t mode);
+audio_vad_mode_t audio_vad_get_mode(void);
+bool audio_vad_is_speech(void);
+bool audio_vad_is_gated(void);
+void audio_vad_process(const int16_t *samples, uint32_t num_frames, uint32_t num_channels);
+void audio_vad_get_status(audio_vad_status_t *status);
+void audio_vad_clear_status(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_VAD_H */
+
+/* [] END OF FILE */
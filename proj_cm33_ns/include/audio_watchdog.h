@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name   : audio_watchdog.h
+*
+* Description : This file contains the watchdog of the audio pipeline, which
+*               detects stalls of the capture path and recovers from them.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_WATCHDOG_H
+#define AUDIO_WATCHDOG_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* No progress for this long is a stall. Also the time given to each
+ * recovery action before the next tier is tried. */
+#define AUDIO_WATCHDOG_TIMEOUT_MS           (200u)
+
+/* Stream restarts in a row after which the watchdog only retries a restart
+ * every AUDIO_WATCHDOG_RETRY_MS, until the pipeline moves again */
+#define AUDIO_WATCHDOG_MAX_RESTARTS         (3u)
+#define AUDIO_WATCHDOG_RETRY_MS             (5000u)
+
+
+/******************************************************************************
+* Enumerations
+******************************************************************************/
+/* Causes of a stall */
+typedef enum
+{
+    AUDIO_WATCHDOG_FAULT_PACKETS = 0,   /* No packet requested while recording */
+    AUDIO_WATCHDOG_FAULT_FIFO,          /* No frame captured while the microphones run */
+    AUDIO_WATCHDOG_FAULT_WRITE_TASK,    /* USBD_AUDIO_Write_Task() returned */
+    AUDIO_WATCHDOG_NUM_FAULTS
+} audio_watchdog_fault_t;
+
+/* Recovery actions, tried in this order */
+typedef enum
+{
+    AUDIO_WATCHDOG_TIER_FLUSH = 0,      /* Drop the queued frames and prime again */
+    AUDIO_WATCHDOG_TIER_REARM,          /* Restart the PDM-PCM channels */
+    AUDIO_WATCHDOG_TIER_RESTART,        /* Restart the stream on the USB side */
+    AUDIO_WATCHDOG_NUM_TIERS
+} audio_watchdog_tier_t;
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Recovery record, also the payload of the AUDIO_CTRL_WATCHDOG control */
+typedef struct
+{
+    uint32_t faults[AUDIO_WATCHDOG_NUM_FAULTS];     /* Stalls detected, by cause */
+    uint32_t actions[AUDIO_WATCHDOG_NUM_TIERS];     /* Recovery actions taken, by tier */
+    uint32_t recovered;                             /* Stalls that ended */
+    uint32_t given_up;                              /* Stalls that outlasted AUDIO_WATCHDOG_MAX_RESTARTS restarts */
+    uint32_t last_duration_ms;                      /* Length of the last stall that ended */
+    uint32_t max_duration_ms;                       /* Longest stall that ended */
+} audio_watchdog_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_watchdog_start(void);
+bool audio_watchdog_poll(void);
+void audio_watchdog_write_task_returned(void);
+void audio_watchdog_get_status(audio_watchdog_status_t *status);
+void audio_watchdog_reset_status(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_WATCHDOG_H */
+
+/* [] END OF FILE */
@@ -46,12 +46,14 @@ extern "C" {
 #endif
 
 #include "USB_Audio.h"
+#include "audio.h"
 
 
 /******************************************************************************
 * Macros
 ******************************************************************************/
 #define USB_NUM_AUDIO_INTERFACES    (1)
+#define USB_NUM_RAW_AUDIO_INTERFACES (1)
 
 
 /******************************************************************************
@@ -59,6 +61,9 @@ extern "C" {
 ******************************************************************************/
 extern const USB_DEVICE_INFO usb_deviceInfo;
 extern const USBD_AUDIO_IF_CONF audio_interfaces[USB_NUM_AUDIO_INTERFACES];
+#if (AUDIO_IN_NUM_STREAMS > 1U)
+extern const USBD_AUDIO_IF_CONF raw_audio_interfaces[USB_NUM_RAW_AUDIO_INTERFACES];
+#endif
 
 
 #if defined(__cplusplus)
@@ -57,6 +57,9 @@ extern "C" {
 ******************************************************************************/
 #define AUDIO_APP_TASK_PRIORITY     (2)
 #define AUDIO_WRITE_TASK_PRIORITY   (1)
+#define AUDIO_REC_TASK_PRIORITY     (3)
+#define AUDIO_STORE_TASK_PRIORITY   (1)
+#define AUDIO_TAP_TASK_PRIORITY     (3)
 
 #define AUDIO_TASK_STACK_DEPTH      (512U) /* In bytes */
 
@@ -0,0 +1,441 @@
+/*****************************************************************************
+* File Name        : audio_agc.c
+*
+* Description      : This file contains the automatic gain control and lookahead peak
+*                    limiter of the Audio IN path.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_agc.h"
+#include "audio.h"
+#include "audio_hot.h"
+#include "cybsp.h"
+#include <math.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Sliding window of the limiter: a peak is seen this many frames before it
+ * leaves the delay line */
+#define AUDIO_AGC_WINDOW             ((AUDIO_AGC_LOOKAHEAD_FRAMES) + 1u)
+
+/* Blocks quieter than this do not change the gain, so that the AGC does
+ * not pump up the background noise in pauses */
+#define AUDIO_AGC_GATE_DBFS          (-60.0f)
+
+/* Time constant of the limiter release after the lookahead ramp */
+#define AUDIO_AGC_LIMITER_RELEASE_MS (50.0f)
+
+/* Capacity of the sliding minimum queue, a power of 2 of at least the window */
+#define AUDIO_AGC_MIN_QUEUE_SIZE     (64u)
+#define AUDIO_AGC_MIN_QUEUE_MASK     ((AUDIO_AGC_MIN_QUEUE_SIZE) - 1u)
+
+/* Limiter gains are handled in Q15 so that the running sum stays exact */
+#define AUDIO_AGC_Q15_ONE            (32768u)
+
+#define AUDIO_AGC_FULL_SCALE         (32768.0f)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static audio_agc_params_t agc_params =
+{
+    .enable      = AUDIO_AGC_DEFAULT_ENABLE,
+    .target_dbfs = AUDIO_AGC_DEFAULT_TARGET_DBFS,
+    .max_gain_db = AUDIO_AGC_DEFAULT_MAX_GAIN_DB,
+    .limit_dbfs  = AUDIO_AGC_DEFAULT_LIMIT_DBFS,
+    .attack_ms   = AUDIO_AGC_DEFAULT_ATTACK_MS,
+    .release_ms  = AUDIO_AGC_DEFAULT_RELEASE_MS,
+};
+
+/* Parameters set by the host, picked up at the next block */
+static audio_agc_params_t agc_pending_params;
+static volatile bool agc_params_pending;
+
+/* Parameters converted to linear values */
+static float agc_target_rms;
+static float agc_max_gain;
+static float agc_gate_rms;
+static float agc_limit;
+static float agc_limiter_release;
+
+/* Current AGC gain */
+static float agc_gain;
+
+/* Delay line of gained samples */
+static float agc_delay[AUDIO_AGC_LOOKAHEAD_FRAMES][AUDIO_AGC_MAX_CHANNELS];
+static uint32_t agc_delay_index;
+
+/* Sliding minimum of the required limiter gains: monotonic queue of gains
+ * and the frame they were computed for, free-running head and tail */
+static uint32_t agc_min_gain[AUDIO_AGC_MIN_QUEUE_SIZE];
+static uint32_t agc_min_frame[AUDIO_AGC_MIN_QUEUE_SIZE];
+static uint32_t agc_min_head;
+static uint32_t agc_min_tail;
+static uint32_t agc_frame;
+
+/* Moving average of the sliding minimum */
+static uint32_t agc_box[AUDIO_AGC_WINDOW];
+static uint32_t agc_box_index;
+static uint32_t agc_box_sum;
+
+/* Limiter gain after release smoothing */
+static float agc_limiter_gain;
+
+
+/*****************************************************************************
+* Function Name: audio_agc_db_to_linear
+******************************************************************************
+* Summary:
+*  Convert a level in dB to a linear factor.
+*
+* Parameters:
+*  db: Level in dB
+*
+* Return:
+*  float: Linear factor
+*
+*****************************************************************************/
+static float audio_agc_db_to_linear(float db)
+{
+    return powf(10.0f, db / 20.0f);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_agc_apply_params
+******************************************************************************
+* Summary:
+*  Convert the parameters to the linear values used by the processing.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_agc_apply_params(void)
+{
+    agc_target_rms = audio_agc_db_to_linear((float) agc_params.target_dbfs) * AUDIO_AGC_FULL_SCALE;
+    agc_max_gain = audio_agc_db_to_linear((float) agc_params.max_gain_db);
+    agc_gate_rms = audio_agc_db_to_linear(AUDIO_AGC_GATE_DBFS) * AUDIO_AGC_FULL_SCALE;
+    agc_limit = audio_agc_db_to_linear((float) agc_params.limit_dbfs) * (AUDIO_AGC_FULL_SCALE - 1.0f);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_agc_init
+******************************************************************************
+* Summary:
+*  Initialize the AGC with the default parameters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_agc_init(void)
+{
+    agc_limiter_release = expf(-1000.0f / (AUDIO_AGC_LIMITER_RELEASE_MS * (float) AUDIO_IN_SAMPLE_FREQ));
+
+    audio_agc_apply_params();
+    audio_agc_reset();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_agc_reset
+******************************************************************************
+* Summary:
+*  Clear the delay line and restart from unity gain. Called at the start of
+*  a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_agc_reset(void)
+{
+    memset(agc_delay, 0, sizeof(agc_delay));
+    agc_delay_index = 0u;
+
+    for (uint32_t i = 0u; i < AUDIO_AGC_WINDOW; i++)
+    {
+        agc_box[i] = AUDIO_AGC_Q15_ONE;
+    }
+    agc_box_index = 0u;
+    agc_box_sum = AUDIO_AGC_Q15_ONE * AUDIO_AGC_WINDOW;
+
+    agc_min_head = 0u;
+    agc_min_tail = 0u;
+    agc_frame = 0u;
+
+    agc_gain = 1.0f;
+    agc_limiter_gain = 1.0f;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_agc_set_params
+******************************************************************************
+* Summary:
+*  Change the AGC parameters. They take effect at the next block. Called in
+*  ISR context from the control request handler.
+*
+* Parameters:
+*  params: New parameters
+*
+* Return:
+*  bool: false if a parameter is out of range
+*
+*****************************************************************************/
+bool audio_agc_set_params(const audio_agc_params_t *params)
+{
+    if ((params->enable > 1u) ||
+        (params->target_dbfs < AUDIO_AGC_TARGET_DBFS_MIN) || (params->target_dbfs > AUDIO_AGC_TARGET_DBFS_MAX) ||
+        (params->max_gain_db > AUDIO_AGC_MAX_GAIN_DB_MAX) ||
+        (params->limit_dbfs < AUDIO_AGC_LIMIT_DBFS_MIN) || (params->limit_dbfs > AUDIO_AGC_LIMIT_DBFS_MAX) ||
+        (params->attack_ms < AUDIO_AGC_ATTACK_MS_MIN) || (params->attack_ms > AUDIO_AGC_ATTACK_MS_MAX) ||
+        (params->release_ms < AUDIO_AGC_RELEASE_MS_MIN) || (params->release_ms > AUDIO_AGC_RELEASE_MS_MAX))
+    {
+        return false;
+    }
+
+    agc_pending_params = *params;
+    agc_params_pending = true;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_agc_get_params
+******************************************************************************
+* Summary:
+*  Return the AGC parameters, including a change not applied yet.
+*
+* Parameters:
+*  params: Destination of the parameters
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_agc_get_params(audio_agc_params_t *params)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *params = agc_params_pending ? agc_pending_params : agc_params;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_agc_is_enabled
+******************************************************************************
+* Summary:
+*  Check if the AGC runs on the next block.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+bool audio_agc_is_enabled(void)
+{
+    if (agc_params_pending)
+    {
+        uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+        agc_params = agc_pending_params;
+        agc_params_pending = false;
+
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+        audio_agc_apply_params();
+    }
+
+    return (0u != agc_params.enable);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_agc_process
+******************************************************************************
+* Summary:
+*  Bring the block towards the target level and limit its peaks. The AGC
+*  gain follows the block RMS level with the attack and release time
+*  constants. The limiter looks AUDIO_AGC_LOOKAHEAD_FRAMES ahead so that
+*  its gain has ramped down by the time a peak leaves the delay line: the
+*  output is delayed by AUDIO_AGC_LATENCY_SAMPLES.
+*
+* Parameters:
+*  samples: Interleaved block, processed in place
+*  num_frames: Number of frames in the block
+*  num_channels: Number of channels, 1 or 2
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_agc_process(int16_t *samples, uint32_t num_frames, uint32_t num_channels)
+{
+    float sum_squares = 0.0f;
+    float gain_start = agc_gain;
+    float gain_step;
+    float limiter_target;
+
+    if (0u == num_frames)
+    {
+        return;
+    }
+
+    /* AGC gain from the RMS level of the block */
+    for (uint32_t i = 0u; i < (num_frames * num_channels); i++)
+    {
+        float x = (float) samples[i];
+        sum_squares += x * x;
+    }
+
+    float rms = sqrtf(sum_squares / (float) (num_frames * num_channels));
+
+    if (rms > agc_gate_rms)
+    {
+        float desired = agc_target_rms / rms;
+        float time_ms = (desired < agc_gain) ? (float) agc_params.attack_ms : (float) agc_params.release_ms;
+        float coef = expf(-(1000.0f * (float) num_frames) / (time_ms * (float) AUDIO_IN_SAMPLE_FREQ));
+
+        if (desired > agc_max_gain)
+        {
+            desired = agc_max_gain;
+        }
+
+        agc_gain = desired + ((agc_gain - desired) * coef);
+    }
+
+    /* Ramp the gain over the block to avoid steps */
+    gain_step = (agc_gain - gain_start) / (float) num_frames;
+
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        int16_t *frame = &samples[n * num_channels];
+        float *delayed = agc_delay[agc_delay_index];
+        float gain = gain_start + (gain_step * (float) (n + 1u));
+        float gained[AUDIO_AGC_MAX_CHANNELS];
+        float peak = 0.0f;
+        uint32_t required = AUDIO_AGC_Q15_ONE;
+        uint32_t slot;
+
+        for (uint32_t ch = 0u; ch < num_channels; ch++)
+        {
+            float mag;
+
+            gained[ch] = (float) frame[ch] * gain;
+            mag = fabsf(gained[ch]);
+            if (mag > peak)
+            {
+                peak = mag;
+            }
+        }
+
+        /* Gain the new frame needs to stay below the ceiling */
+        if (peak > agc_limit)
+        {
+            required = (uint32_t) ((agc_limit / peak) * (float) AUDIO_AGC_Q15_ONE);
+        }
+
+        /* Sliding minimum of the required gains over the window */
+        while ((agc_min_tail != agc_min_head) &&
+               (agc_min_gain[(agc_min_tail - 1u) & AUDIO_AGC_MIN_QUEUE_MASK] >= required))
+        {
+            agc_min_tail--;
+        }
+        slot = agc_min_tail & AUDIO_AGC_MIN_QUEUE_MASK;
+        agc_min_gain[slot] = required;
+        agc_min_frame[slot] = agc_frame;
+        agc_min_tail++;
+
+        while ((agc_frame - agc_min_frame[agc_min_head & AUDIO_AGC_MIN_QUEUE_MASK]) >= AUDIO_AGC_WINDOW)
+        {
+            agc_min_head++;
+        }
+
+        /* Moving average of the minimum over the window: reaches the gain
+         * a peak needs by the time it leaves the delay line, and ramps back
+         * up after it */
+        agc_box_sum -= agc_box[agc_box_index];
+        agc_box[agc_box_index] = agc_min_gain[agc_min_head & AUDIO_AGC_MIN_QUEUE_MASK];
+        agc_box_sum += agc_box[agc_box_index];
+        agc_box_index = (agc_box_index + 1u < AUDIO_AGC_WINDOW) ? (agc_box_index + 1u) : 0u;
+
+        limiter_target = (float) agc_box_sum / (float) (AUDIO_AGC_Q15_ONE * AUDIO_AGC_WINDOW);
+        if (limiter_target < agc_limiter_gain)
+        {
+            agc_limiter_gain = limiter_target;
+        }
+        else
+        {
+            agc_limiter_gain = limiter_target + ((agc_limiter_gain - limiter_target) * agc_limiter_release);
+        }
+
+        /* The oldest frame leaves the delay line, the new one takes its place */
+        for (uint32_t ch = 0u; ch < num_channels; ch++)
+        {
+            frame[ch] = (int16_t) lrintf(delayed[ch] * agc_limiter_gain);
+            delayed[ch] = gained[ch];
+        }
+
+        agc_frame++;
+        agc_delay_index = (agc_delay_index + 1u < AUDIO_AGC_LOOKAHEAD_FRAMES) ? (agc_delay_index + 1u) : 0u;
+    }
+}
+AUDIO_HOT_FUNC_END
+
+/* [] END OF FILE */
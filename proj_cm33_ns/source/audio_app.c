@@ -41,6 +41,22 @@
 #include "audio_app.h"
 #include "audio_in.h"
 #include "audio.h"
+#include "audio_bench.h"
+#include "audio_boot.h"
+#include "audio_capture.h"
+#include "audio_clock_trim.h"
+#include "audio_factory.h"
+#include "audio_ctrl.h"
+#include "audio_load.h"
+#include "audio_offload.h"
+#include "audio_perf.h"
+#include "audio_pool.h"
+#include "audio_profile.h"
+#include "audio_recorder.h"
+#include "audio_timestamp.h"
+#include "audio_trace.h"
+#include "audio_vad.h"
+#include "audio_watchdog.h"
 #include "emusbdev_audio_config.h"
 #include "retarget_io_init.h"
 #include "rtos.h"
@@ -49,9 +65,6 @@
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-/* Polling interval for the endpoint in units of 125us (8*125 = 1ms) */
-#define EP_IN_INTERVAL               (8u)
-
 #define TASK_DELAY_MS                (50u)
 #define ONE_BYTE                     (1u)
 #define THREE_BYTES                  (3u)
@@ -87,10 +100,20 @@ TaskHandle_t rtos_audio_in_task;
 /*******************************************************************************
 * Static data
 *******************************************************************************/
-static USBD_AUDIO_HANDLE handle;
-static USBD_AUDIO_INIT_DATA init_data;
-static USBD_AUDIO_IF_CONF* microphone_config = (USBD_AUDIO_IF_CONF *) &audio_interfaces[0];
-static uint8_t current_mic_format_index;
+/* Audio class instances of the capture interfaces, see AUDIO_IN_NUM_STREAMS */
+static USBD_AUDIO_HANDLE handles[AUDIO_IN_NUM_STREAMS];
+static USBD_AUDIO_INIT_DATA init_data[AUDIO_IN_NUM_STREAMS];
+static const USBD_AUDIO_IF_CONF* microphone_configs[AUDIO_IN_NUM_STREAMS] =
+{
+    &audio_interfaces[0],
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    &raw_audio_interfaces[0],
+#endif
+};
+static uint8_t current_mic_format_index[AUDIO_IN_NUM_STREAMS];
+
+/* Hook on the USB device state, used to time the enumeration */
+static USB_HOOK usb_state_hook;
 
 
 /*******************************************************************************
@@ -99,10 +122,12 @@ static uint8_t current_mic_format_index;
 * Summary:
 *  Callback called in ISR context.
 *  Receives audio class control commands and sends appropriate responses
-*  where necessary.
+*  where necessary. Serves the audio class instance of every capture
+*  interface.
 *
 * Parameters:
-*  pUserContext: User context which is passed to the callback.
+*  pUserContext: User context which is passed to the callback: the
+*                AUDIO_IN_STREAM_* capture interface.
 *  Event: Audio event ID.
 *  Unit: ID of the feature unit. In case of USB_AUDIO_PLAYBACK_*
 *        and USB_AUDIO_RECORD_*: 0.
@@ -134,8 +159,9 @@ static int audio_control_callback(void *pUserContext,
                                   U8   AltSetting)
 {
     int retVal;
+    uint32_t stream = (uint32_t) (uintptr_t) pUserContext;
+    const USBD_AUDIO_IF_CONF *microphone_config = microphone_configs[stream];
 
-    CY_UNUSED_PARAMETER(pUserContext);
     CY_UNUSED_PARAMETER(InterfaceNo);
 
     retVal = 0;
@@ -143,11 +169,25 @@ static int audio_control_callback(void *pUserContext,
     {
         case USB_AUDIO_RECORD_START:
             /* Host enabled reception */
-            audio_in_enable();
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+            if (AUDIO_IN_STREAM_RAW == stream)
+            {
+                audio_in_raw_enable();
+                break;
+            }
+#endif
+            audio_in_enable(AltSetting);
             break;
 
         case USB_AUDIO_RECORD_STOP:
             /* Host disabled reception. Some hosts do not always send this! */
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+            if (AUDIO_IN_STREAM_RAW == stream)
+            {
+                audio_in_raw_disable();
+                break;
+            }
+#endif
             audio_in_disable();
             break;
 
@@ -163,6 +203,13 @@ static int audio_control_callback(void *pUserContext,
                     {
                         if (Unit == microphone_config->pUnits->FeatureUnitID) 
                         {
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+                            if (AUDIO_IN_STREAM_RAW == stream)
+                            {
+                                raw_mic_mute = *pBuffer;
+                                break;
+                            }
+#endif
                             mic_mute = *pBuffer;
                         }
                     }
@@ -176,9 +223,9 @@ static int audio_control_callback(void *pUserContext,
                     {
                         if (Unit == microphone_config->pUnits->FeatureUnitID)
                         {
-                            if ((AltSetting) && (AltSetting < microphone_config->NumFormats))
+                            if ((AltSetting) && (AltSetting <= microphone_config->NumFormats))
                             {
-                                current_mic_format_index = AltSetting-1;
+                                current_mic_format_index[stream] = AltSetting-1;
                             }
                         }
                     }
@@ -186,6 +233,11 @@ static int audio_control_callback(void *pUserContext,
 
                 default:
                     retVal = DEFAULT_RET_VAL;
+                    /* The vendor specific controls belong to the microphone interface */
+                    if ((AUDIO_IN_STREAM_MIC == stream) && (Unit == microphone_config->pUnits->FeatureUnitID))
+                    {
+                        retVal = audio_ctrl_set_cur(ControlSelector, pBuffer, NumBytes);
+                    }
                     break;
             }
             break;
@@ -205,15 +257,19 @@ static int audio_control_callback(void *pUserContext,
                 case USB_AUDIO_SAMPLING_FREQ_CONTROL:
                     if (Unit == microphone_config->pUnits->FeatureUnitID)
                     {
-                        pBuffer[0] = microphone_config->paFormats[current_mic_format_index].SamFreq & BYTE_MASK;
-                        pBuffer[1] = (microphone_config->paFormats[current_mic_format_index].SamFreq >> 8) & BYTE_MASK;
-                        pBuffer[2] = (microphone_config->paFormats[current_mic_format_index].SamFreq >> 16) & BYTE_MASK;
+                        pBuffer[0] = microphone_config->paFormats[current_mic_format_index[stream]].SamFreq & BYTE_MASK;
+                        pBuffer[1] = (microphone_config->paFormats[current_mic_format_index[stream]].SamFreq >> 8) & BYTE_MASK;
+                        pBuffer[2] = (microphone_config->paFormats[current_mic_format_index[stream]].SamFreq >> 16) & BYTE_MASK;
                     }
                     break;
 
                 default:
-                    pBuffer[0] = RESET_VAL;
-                    pBuffer[1] = RESET_VAL;
+                    if ((AUDIO_IN_STREAM_MIC != stream) || (Unit != microphone_config->pUnits->FeatureUnitID) ||
+                        (AUDIO_CTRL_HANDLED != audio_ctrl_get_cur(ControlSelector, pBuffer, NumBytes)))
+                    {
+                        pBuffer[0] = RESET_VAL;
+                        pBuffer[1] = RESET_VAL;
+                    }
                     break;
             }           
             break;
@@ -280,48 +336,129 @@ static int audio_control_callback(void *pUserContext,
 * Function Name: add_audio
 ********************************************************************************
 * Summary:
-*  Add a USB Audio interface to the USB stack.
+*  Add a USB Audio interface to the USB stack. Each capture interface is a
+*  separate audio class instance with its own Audio IN endpoint.
 *
 * Parameters:
-*  None
+*  stream: AUDIO_IN_STREAM_* capture interface
 *
 * Return:
 *  USBD_AUDIO_HANDLE
 *
 *******************************************************************************/
-static USBD_AUDIO_HANDLE add_audio(void)
+static USBD_AUDIO_HANDLE add_audio(uint32_t stream)
 {
     USB_ADD_EP_INFO       ep_in;
     USBD_AUDIO_HANDLE     handle;
+    USBD_AUDIO_INIT_DATA  *init = &init_data[stream];
 
     memset(&ep_in, RESET_VAL, sizeof(ep_in));
-    memset(&init_data, RESET_VAL, sizeof(init_data));
+    memset(init, RESET_VAL, sizeof(*init));
 
     ep_in.MaxPacketSize               = MAX_AUDIO_IN_PACKET_SIZE_BYTES;       /* Max packet size for IN endpoint (in bytes) */
-    ep_in.Interval                    = EP_IN_INTERVAL;                       /* Interval of 1 ms (8 * 125us) */
+    ep_in.Interval                    = AUDIO_IN_EP_INTERVAL;                 /* Interval in units of 125us (8 = 1 ms) */
     ep_in.Flags                       = USB_ADD_EP_FLAG_USE_ISO_SYNC_TYPES;   /* Optional parameters */
     ep_in.InDir                       = USB_DIR_IN;                           /* IN direction (Device to Host) */
     ep_in.TransferType                = USB_TRANSFER_TYPE_ISO;                /* Endpoint type - Isochronous. */
     ep_in.ISO_Type                    = USB_ISO_SYNC_TYPE_ASYNCHRONOUS;       /* Async for isochronous endpoints */
 
-    init_data.EPIn                   = USBD_AddEPEx(&ep_in, NULL, 0);
-    init_data.EPOut                  = RESET_VAL;
-    init_data.OutPacketSize          = RESET_VAL;
-    init_data.pfOnOut                = NULL;
-    init_data.pfOnIn                 = audio_in_endpoint_callback;
-    init_data.pfOnControl            = audio_control_callback;
-    init_data.pControlUserContext    = NULL;
-    init_data.NumInterfaces          = SEGGER_COUNTOF(audio_interfaces);
-    init_data.paInterfaces           = audio_interfaces;
-    init_data.pOutUserContext        = NULL;
-    init_data.pInUserContext         = NULL;
+    init->EPIn                       = USBD_AddEPEx(&ep_in, NULL, 0);
+    init->EPOut                      = RESET_VAL;
+    init->OutPacketSize              = RESET_VAL;
+    init->pfOnOut                    = NULL;
+    init->pfOnIn                     = audio_in_endpoint_callback;
+    init->pfOnControl                = audio_control_callback;
+    init->pControlUserContext        = (void *) (uintptr_t) stream;
+    init->NumInterfaces              = SEGGER_COUNTOF(audio_interfaces);
+    init->paInterfaces               = audio_interfaces;
+    init->pOutUserContext            = NULL;
+    init->pInUserContext             = (void *) (uintptr_t) stream;
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    if (AUDIO_IN_STREAM_RAW == stream)
+    {
+        init->pfOnIn                 = audio_in_raw_endpoint_callback;
+        init->NumInterfaces          = SEGGER_COUNTOF(raw_audio_interfaces);
+        init->paInterfaces           = raw_audio_interfaces;
+    }
+#endif
 
-    handle = USBD_AUDIO_Add(&init_data);
+    handle = USBD_AUDIO_Add(init);
 
     return handle;
 }
 
 
+/*******************************************************************************
+* Function Name: audio_app_set_timeouts
+********************************************************************************
+* Summary:
+*  Set the write timeout of the Audio IN endpoints from the latency profile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_app_set_timeouts(void)
+{
+    for (uint32_t stream = 0u; stream < AUDIO_IN_NUM_STREAMS; stream++)
+    {
+        USBD_AUDIO_Set_Timeouts(handles[stream], 0, audio_profile_get()->write_timeout_ms);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: audio_app_stop_play
+********************************************************************************
+* Summary:
+*  Stop providing audio data to the host on every capture interface.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_app_stop_play(void)
+{
+    for (uint32_t stream = 0u; stream < AUDIO_IN_NUM_STREAMS; stream++)
+    {
+        USBD_AUDIO_Stop_Play(handles[stream]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: audio_app_usb_state_changed
+********************************************************************************
+* Summary:
+*  Called by the USB stack when the state of the device changes. Records the
+*  first time the device is configured by the host.
+*
+* Parameters:
+*  pContext: Unused
+*  NewState: New USB_STAT_* state bits
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_app_usb_state_changed(void *pContext, U8 NewState)
+{
+    CY_UNUSED_PARAMETER(pContext);
+
+    if (0u != (NewState & USB_STAT_CONFIGURED))
+    {
+        audio_boot_mark(AUDIO_BOOT_ENUMERATED);
+    }
+}
+
+
 /*******************************************************************************
 * Function Name: app_clock_init
 ********************************************************************************
@@ -398,6 +535,119 @@ void app_clock_init(void)
 }
 
 
+#if (AUDIO_PERF_ENABLE)
+/*******************************************************************************
+* Function Name: audio_app_report_stats
+********************************************************************************
+* Summary:
+*  Print the latency and glitch counters of the Audio IN path for the
+*  selected latency profile, then clear them for the next report interval.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_app_report_stats(void)
+{
+    audio_in_stats_t stats;
+    audio_vad_status_t vad_status;
+    audio_in_levels_t levels;
+    audio_pool_stats_t pool_stats;
+    audio_load_stats_t load;
+    audio_timestamp_status_t timestamp;
+    uint32_t avg_latency_us;
+    uint32_t max_latency_us;
+
+    audio_load_get_stats(&load);
+    printf("APP_LOG: CPU load: CM33 %u.%02u %% (peak %u.%02u %%), CM55 %u.%02u %% (peak %u.%02u %%)\r\n",
+           load.cm33_load / 100u, load.cm33_load % 100u, load.cm33_peak / 100u, load.cm33_peak % 100u,
+           load.cm55_load / 100u, load.cm55_load % 100u, load.cm55_peak / 100u, load.cm55_peak % 100u);
+
+    audio_in_get_stats(&stats);
+    audio_in_reset_stats();
+
+    if (0u == stats.packets)
+    {
+        return;
+    }
+
+    /* Audio held in the capture queue plus the packet in flight */
+    avg_latency_us = (uint32_t) (((uint64_t) stats.queue_frames_sum * 1000000u) /
+                                 ((uint64_t) stats.packets * AUDIO_IN_SAMPLE_FREQ)) +
+                     (1000u / AUDIO_IN_PACKETS_PER_MS);
+    max_latency_us = (uint32_t) (((uint64_t) stats.queue_frames_max * 1000000u) / AUDIO_IN_SAMPLE_FREQ) +
+                     (1000u / AUDIO_IN_PACKETS_PER_MS);
+
+    printf("APP_LOG: Audio IN (%s): latency avg %lu us, max %lu us, "
+           "underruns %lu, overruns %lu, FIFO overflows %lu\r\n",
+           audio_profile_get()->name, (unsigned long) avg_latency_us, (unsigned long) max_latency_us,
+           (unsigned long) stats.underruns, (unsigned long) stats.overruns,
+           (unsigned long) stats.fifo_overflows);
+
+    /* Isochronous bandwidth used by the alternate setting of the session */
+    printf("APP_LOG: Audio IN alt setting %u: %lu bytes/s on the bus\r\n",
+           audio_in_get_alt_setting(),
+           (unsigned long) (((uint64_t) stats.bytes * 1000u) / AUDIO_PERF_REPORT_INTERVAL_MS));
+
+    if (audio_offload_is_active())
+    {
+        audio_ipc_status_t cm55_status;
+        audio_offload_stats_t offload_stats;
+
+        audio_offload_get_status(&cm55_status, &offload_stats);
+
+        printf("APP_LOG: CM55: avg %lu cycles, max %lu cycles per block, latency %lu samples, "
+               "dropped %lu, late %lu\r\n",
+               (unsigned long) cm55_status.avg_cycles, (unsigned long) cm55_status.max_cycles,
+               (unsigned long) cm55_status.latency_samples, (unsigned long) offload_stats.dropped,
+               (unsigned long) offload_stats.late);
+    }
+
+    if (0u != (audio_offload_get_stages() & AUDIO_IPC_STAGE_SPECTRUM))
+    {
+        audio_ipc_status_t cm55_status;
+        audio_offload_stats_t offload_stats;
+
+        audio_offload_get_status(&cm55_status, &offload_stats);
+
+        printf("APP_LOG: Spectrum analyzer: dropped %lu blocks\r\n",
+               (unsigned long) offload_stats.analyzer_dropped);
+    }
+
+    audio_vad_get_status(&vad_status);
+    audio_vad_clear_status();
+
+    if (0u != vad_status.frames)
+    {
+        printf("APP_LOG: VAD: speech %lu %% of the time, %lu onsets\r\n",
+               (unsigned long) ((vad_status.speech_frames * 100u) / vad_status.frames),
+               (unsigned long) vad_status.onsets);
+    }
+
+    audio_timestamp_get_status(&timestamp);
+
+    printf("APP_LOG: Timestamps: device clock %ld ppb from USB, jitter rms %lu ns, max %lu ns\r\n",
+           (long) timestamp.rate_ppb, (unsigned long) timestamp.jitter_rms_ns,
+           (unsigned long) timestamp.jitter_max_ns);
+
+    audio_in_get_levels(&levels);
+
+    printf("APP_LOG: Levels: L peak %u rms %u clips %lu, R peak %u rms %u clips %lu\r\n",
+           levels.channel[0].peak, levels.channel[0].rms, (unsigned long) levels.channel[0].clips,
+           levels.channel[1].peak, levels.channel[1].rms, (unsigned long) levels.channel[1].clips);
+
+    audio_pool_get_stats(&pool_stats);
+
+    printf("APP_LOG: Packet pool: %lu/%u in use, high-water %lu, allocation failures %lu\r\n",
+           (unsigned long) pool_stats.in_use, AUDIO_POOL_NUM_PACKETS,
+           (unsigned long) pool_stats.high_water, (unsigned long) pool_stats.alloc_failures);
+}
+#endif
+
+
 /*******************************************************************************
 * Function Name: audio_app_init
 ********************************************************************************
@@ -445,29 +695,85 @@ void audio_app_init(void)
 void audio_app_task(void *arg)
 {
     uint8_t usb_status = USB_SUSPENDED;
+    audio_profile_id_t current_profile;
+#if (AUDIO_PERF_ENABLE)
+    uint32_t perf_report_ticks = 0u;
+#endif
 
     CY_UNUSED_PARAMETER(arg);
 
+    audio_boot_mark(AUDIO_BOOT_SCHEDULER);
+
     /* Initializes the USB stack */
     USBD_Init();
 
+#if !(AUDIO_BOOT_FAST)
     /* Setup the clock tree for required audio sampling rate */
     app_clock_init();
-    
+    audio_boot_mark(AUDIO_BOOT_CLOCK_LOCKED);
+#endif
+
     /* Endpoint Initialization for Audio class */
-    handle = add_audio();
+    for (uint32_t stream = 0u; stream < AUDIO_IN_NUM_STREAMS; stream++)
+    {
+        handles[stream] = add_audio(stream);
+    }
 
     /* Set device info used in enumeration */
     USBD_SetDeviceInfo(&usb_deviceInfo);
 
     /* Set write timeout for IN endpoint */
-    USBD_AUDIO_Set_Timeouts(handle, 0, WRITE_TIMEOUT_MS);
+    current_profile = audio_profile_get_id();
+    audio_app_set_timeouts();
+
+    /* Time the enumeration */
+    USBD_RegisterSCHook(&usb_state_hook, audio_app_usb_state_changed, NULL);
+
+#if (AUDIO_BOOT_FAST)
+    /* Let the host enumerate the device while the DPLL locks and the capture
+     * path initializes */
+    USBD_Start();
+    audio_boot_mark(AUDIO_BOOT_USB_START);
+
+    /* Setup the clock tree for required audio sampling rate */
+    app_clock_init();
+    audio_boot_mark(AUDIO_BOOT_CLOCK_LOCKED);
+#endif
 
     /* Init the audio IN application */
     audio_in_init();
+    audio_boot_mark(AUDIO_BOOT_AUDIO_INIT);
+
+#if (AUDIO_CLOCK_TRIM_ENABLE)
+    /* Trim the DPLL from its nominal setting */
+    audio_clock_trim_init();
+#endif
+
+#if (AUDIO_RECORDER_ENABLE)
+    /* Continue the log of the offline recordings */
+    audio_recorder_init();
+#endif
+
+    /* Start measuring the load of both cores */
+    audio_load_init();
+
+#if (AUDIO_BENCH_ENABLE)
+    /* Time the capture path kernels ahead of the first session */
+    audio_bench_run();
+#endif
+
+#if (AUDIO_PERF_ENABLE)
+    /* Clear the counters used to profile the audio path */
+    audio_perf_init();
+#endif
 
+#if !(AUDIO_BOOT_FAST)
     /* Start the USB stack */
     USBD_Start();
+    audio_boot_mark(AUDIO_BOOT_USB_START);
+#endif
+
+    audio_watchdog_start();
 
     for (;;)
     {
@@ -475,10 +781,15 @@ void audio_app_task(void *arg)
         if(USB_STAT_CONFIGURED != (USBD_GetState() & (USB_STAT_CONFIGURED | USB_STAT_SUSPENDED)))
         {
             /* Stop providing audio data to the host */
-            USBD_AUDIO_Stop_Play(handle);
+            audio_app_stop_play();
 
             printf("APP_LOG: USB Audio Device Disconnected\r\n");
 
+#if (AUDIO_RECORDER_ENABLE)
+            /* Record to the storage device until a host connects */
+            audio_recorder_arm();
+#endif
+
             /* Wait for USB device configuration */
             while (USB_STAT_CONFIGURED != (USBD_GetState() & (USB_STAT_CONFIGURED | USB_STAT_SUSPENDED)))
             {
@@ -486,10 +797,18 @@ void audio_app_task(void *arg)
                 usb_status = USB_SUSPENDED;
 
                 /* Stop providing audio data to the host */
-                USBD_AUDIO_Stop_Play(handle);
+                audio_app_stop_play();
 
                 USB_OS_Delay(USB_DELAY_MS);
             }
+
+#if (AUDIO_RECORDER_ENABLE)
+            /* Hand the microphones back to the host */
+            audio_recorder_stop();
+#endif
+
+            /* The stream restarts from here */
+            audio_watchdog_start();
         }
 
         if(USB_SUSPENDED == usb_status)
@@ -497,11 +816,73 @@ void audio_app_task(void *arg)
             usb_status = USB_CONNECTED;
 
             /* Start providing audio data to the host */
-            USBD_AUDIO_Start_Play(handle, NULL);
+            for (uint32_t stream = 0u; stream < AUDIO_IN_NUM_STREAMS; stream++)
+            {
+                USBD_AUDIO_Start_Play(handles[stream], NULL);
+            }
 
             printf("APP_LOG: USB Audio Device Connected\r\n");
         }
 
+        /* Apply a latency profile selected by the host */
+        if (current_profile != audio_profile_get_id())
+        {
+            current_profile = audio_profile_get_id();
+            audio_app_set_timeouts();
+
+            printf("APP_LOG: Latency profile: %s\r\n", audio_profile_get()->name);
+        }
+
+        audio_load_update();
+
+        /* Recover from a stall of the capture path */
+        if (audio_watchdog_poll())
+        {
+            /* Restart providing audio data to the host */
+            audio_app_stop_play();
+            usb_status = USB_SUSPENDED;
+        }
+
+#if (AUDIO_CLOCK_TRIM_ENABLE)
+        /* Keep the PDM clock on the USB clock */
+        audio_clock_trim_poll();
+#endif
+
+        /* Print the boot report once the first packet is out */
+        audio_boot_poll();
+
+#if (AUDIO_PERF_ENABLE)
+        perf_report_ticks += TASK_DELAY_MS;
+        if (perf_report_ticks >= AUDIO_PERF_REPORT_INTERVAL_MS)
+        {
+            perf_report_ticks = 0u;
+            audio_perf_report("Audio IN callback", &audio_perf_callback,
+                              1000u * AUDIO_IN_PACKETS_PER_MS);
+            audio_perf_report("Beamformer", &audio_perf_beamformer,
+                              1000u * AUDIO_IN_PACKETS_PER_MS);
+            audio_perf_report("AGC", &audio_perf_agc,
+                              1000u * AUDIO_IN_PACKETS_PER_MS);
+            audio_perf_report("VAD", &audio_perf_vad,
+                              1000u * AUDIO_IN_PACKETS_PER_MS);
+            audio_app_report_stats();
+        }
+#endif
+
+#if (AUDIO_TRACE_ENABLE)
+        /* Print a trace dump requested by the host */
+        audio_trace_poll();
+#endif
+
+#if (AUDIO_CAPTURE_ENABLE)
+        /* Run a replay or a dump of the PDM-PCM recording */
+        audio_capture_poll();
+#endif
+
+#if (AUDIO_FACTORY_ENABLE)
+        /* Run a factory self-test requested by the host */
+        audio_factory_poll();
+#endif
+
         vTaskDelay(pdMS_TO_TICKS(TASK_DELAY_MS));
     }
 }
@@ -0,0 +1,275 @@
+/*****************************************************************************
+* File Name        : audio_beamformer.c
+*
+* Description      : This file contains the delay-and-sum beamformer that combines
+*                    the two PDM microphones into a steered mono channel.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_beamformer.h"
+#include "audio.h"
+#include "audio_hot.h"
+#include "cy_utils.h"
+#include <math.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Delay of the fractional delay filters for a zero fraction */
+#define AUDIO_BF_FILTER_DELAY        (((AUDIO_BF_NUM_TAPS) / 2u) - 1u)
+
+/* Samples of each channel kept from the previous block */
+#define AUDIO_BF_HISTORY             ((AUDIO_BF_NUM_TAPS) + (AUDIO_BF_MAX_DELAY_SAMPLES))
+
+/* Largest block handled in one call */
+#define AUDIO_BF_MAX_FRAMES          (AUDIO_IN_MAX_FRAMES_PER_PACKET)
+
+#define AUDIO_BF_PI                  (3.14159265358979f)
+#define AUDIO_BF_Q15_ONE             (32767.0f)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Windowed-sinc fractional delay filters in Q15, one per fraction step */
+static int16_t frac_delay_taps[AUDIO_BF_FRAC_STEPS][AUDIO_BF_NUM_TAPS];
+
+/* Per channel delay lines: history followed by the current block */
+static int16_t delay_line[NUM_CHANNELS][(AUDIO_BF_HISTORY) + (AUDIO_BF_MAX_FRAMES)];
+
+/* Steering delay in 1/256 of a sample. Positive when the sound reaches the
+ * left microphone first. */
+static volatile int16_t steering_delay;
+
+
+/*****************************************************************************
+* Function Name: audio_beamformer_init
+******************************************************************************
+* Summary:
+*  Compute the fractional delay filters and clear the delay lines.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_beamformer_init(void)
+{
+    for (uint32_t step = 0u; step < AUDIO_BF_FRAC_STEPS; step++)
+    {
+        float frac = (float) step / (float) AUDIO_BF_FRAC_STEPS;
+        float taps[AUDIO_BF_NUM_TAPS];
+        float sum = 0.0f;
+
+        for (uint32_t k = 0u; k < AUDIO_BF_NUM_TAPS; k++)
+        {
+            float t = (float) k - (float) AUDIO_BF_FILTER_DELAY - frac;
+            float sinc = (0.0f == t) ? 1.0f : (sinf(AUDIO_BF_PI * t) / (AUDIO_BF_PI * t));
+
+            /* Hamming window centered on the fractional delay */
+            float window = 0.54f + (0.46f * cosf((AUDIO_BF_PI * t) / ((float) AUDIO_BF_NUM_TAPS / 2.0f)));
+
+            taps[k] = sinc * window;
+            sum += taps[k];
+        }
+
+        /* Normalize to unity gain at DC */
+        for (uint32_t k = 0u; k < AUDIO_BF_NUM_TAPS; k++)
+        {
+            frac_delay_taps[step][k] = (int16_t) lrintf((taps[k] / sum) * AUDIO_BF_Q15_ONE);
+        }
+    }
+
+    audio_beamformer_reset();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_beamformer_reset
+******************************************************************************
+* Summary:
+*  Clear the delay lines. Called at the start of a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_beamformer_reset(void)
+{
+    memset(delay_line, 0, sizeof(delay_line));
+}
+
+
+/*****************************************************************************
+* Function Name: audio_beamformer_set_steering
+******************************************************************************
+* Summary:
+*  Set the arrival time difference between the microphones to steer to.
+*  Takes effect at the next block.
+*
+* Parameters:
+*  delay: Delay in 1/256 of a sample, positive when the sound reaches the
+*         left microphone first. Clipped to +/- AUDIO_BF_DELAY_MAX.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_beamformer_set_steering(int16_t delay)
+{
+    if (delay > (int16_t) AUDIO_BF_DELAY_MAX)
+    {
+        delay = (int16_t) AUDIO_BF_DELAY_MAX;
+    }
+    else if (delay < -(int16_t) AUDIO_BF_DELAY_MAX)
+    {
+        delay = -(int16_t) AUDIO_BF_DELAY_MAX;
+    }
+
+    steering_delay = delay;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_beamformer_get_steering
+******************************************************************************
+* Summary:
+*  Return the steering delay.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int16_t: Delay in 1/256 of a sample
+*
+*****************************************************************************/
+int16_t audio_beamformer_get_steering(void)
+{
+    return steering_delay;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_beamformer_process
+******************************************************************************
+* Summary:
+*  Delay the microphone the sound reaches first so that both line up, then
+*  average them. The result is written in place as mono samples.
+*
+* Parameters:
+*  samples: Interleaved stereo block on input, mono block on output
+*  num_frames: Number of frames in the block, at most
+*              AUDIO_IN_MAX_FRAMES_PER_PACKET
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_beamformer_process(int16_t *samples, uint32_t num_frames)
+{
+    int32_t delay = steering_delay;
+    uint32_t delay_abs = (uint32_t) ((delay < 0) ? -delay : delay);
+    uint32_t int_delay = delay_abs >> AUDIO_BF_DELAY_Q;
+    uint32_t frac = (((delay_abs & ((1u << AUDIO_BF_DELAY_Q) - 1u)) * AUDIO_BF_FRAC_STEPS) +
+                     (1u << (AUDIO_BF_DELAY_Q - 1u))) >> AUDIO_BF_DELAY_Q;
+    uint32_t early = (delay < 0) ? 1u : 0u;
+    const int16_t *taps;
+    const int16_t *x_early;
+    const int16_t *x_late;
+
+    CY_ASSERT(num_frames <= AUDIO_BF_MAX_FRAMES);
+
+    if (AUDIO_BF_FRAC_STEPS == frac)
+    {
+        int_delay++;
+        frac = 0u;
+    }
+    taps = frac_delay_taps[frac];
+
+    /* Append the block to the delay lines */
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        delay_line[0][AUDIO_BF_HISTORY + n] = samples[(2u * n)];
+        delay_line[1][AUDIO_BF_HISTORY + n] = samples[(2u * n) + 1u];
+    }
+
+    x_early = &delay_line[early][AUDIO_BF_HISTORY - int_delay];
+    x_late  = &delay_line[1u - early][AUDIO_BF_HISTORY - AUDIO_BF_FILTER_DELAY];
+
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        /* Fractional delay filter on the early channel, Q15 accumulator */
+        int32_t acc = 0;
+
+        for (uint32_t k = 0u; k < AUDIO_BF_NUM_TAPS; k++)
+        {
+            acc += (int32_t) taps[k] * x_early[(int32_t) n - (int32_t) k];
+        }
+
+        /* The late channel only needs the filter group delay */
+        acc += ((int32_t) x_late[n]) << 15;
+
+        /* Average of the two channels with rounding */
+        acc = (acc + (1 << 15)) >> 16;
+
+        if (acc > INT16_MAX)
+        {
+            acc = INT16_MAX;
+        }
+        else if (acc < INT16_MIN)
+        {
+            acc = INT16_MIN;
+        }
+
+        samples[n] = (int16_t) acc;
+    }
+
+    /* Keep the tail of the block as history for the next one */
+    for (uint32_t ch = 0u; ch < NUM_CHANNELS; ch++)
+    {
+        memmove(&delay_line[ch][0], &delay_line[ch][num_frames], AUDIO_BF_HISTORY * sizeof(int16_t));
+    }
+}
+AUDIO_HOT_FUNC_END
+
+/* [] END OF FILE */
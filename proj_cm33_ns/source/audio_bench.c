@@ -0,0 +1,417 @@
+/*****************************************************************************
+* File Name        : audio_bench.c
+*
+* Description      : This file contains the microbenchmarks of the capture path kernels.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_bench.h"
+
+#if (AUDIO_BENCH_ENABLE)
+
+#include "audio.h"
+#include "audio_agc.h"
+#include "audio_beamformer.h"
+#include "audio_fifo.h"
+#include "audio_matrix.h"
+#include "audio_vad.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Largest packet, at the highest sampling rate */
+#define AUDIO_BENCH_MAX_FRAMES              (((AUDIO_SAMPLING_RATE_48KHZ) / (1000u * (AUDIO_IN_PACKETS_PER_MS))) + 1u)
+
+/* Capture queue stand-in, the packets are read across its end */
+#define AUDIO_BENCH_RING_FRAMES             (4u * (AUDIO_BENCH_MAX_FRAMES))
+
+#define AUDIO_BENCH_NUM_CHANNELS            (2u)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+typedef void (*audio_bench_kernel_t)(uint32_t num_frames, uint32_t num_channels);
+
+typedef struct
+{
+    const char *name;
+    audio_bench_kernel_t kernel;
+    uint32_t min_channels;
+    uint32_t max_channels;
+} audio_bench_entry_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static int16_t bench_source[(AUDIO_BENCH_MAX_FRAMES) * (AUDIO_BENCH_NUM_CHANNELS)];
+static int16_t bench_packet[(AUDIO_BENCH_MAX_FRAMES) * (AUDIO_BENCH_NUM_CHANNELS)];
+static uint16_t bench_ring[(AUDIO_BENCH_RING_FRAMES) * (AUDIO_BENCH_NUM_CHANNELS)];
+
+static const uint32_t bench_rates[] =
+{
+    AUDIO_SAMPLING_RATE_16KHZ,
+    AUDIO_SAMPLING_RATE_22KHZ,
+    AUDIO_SAMPLING_RATE_32KHZ,
+    AUDIO_SAMPLING_RATE_44KHZ,
+    AUDIO_SAMPLING_RATE_48KHZ
+};
+
+
+/*****************************************************************************
+* Function Name: audio_bench_drain
+******************************************************************************
+* Summary:
+*  FIFO drain and interleave as in the PDM-PCM interrupt: the block reads of
+*  audio_fifo_read(), then one pass storing the frames interleaved into the
+*  capture queue with its wrap check. The FIFO status registers stand in for
+*  the FIFO data registers, as popping an inactive FIFO is not allowed.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_drain(uint32_t num_frames, uint32_t num_channels)
+{
+    int16_t block[AUDIO_BENCH_NUM_CHANNELS][AUDIO_BENCH_MAX_FRAMES];
+    uint32_t index = (AUDIO_BENCH_RING_FRAMES) - (num_frames / 2u);
+
+    audio_fifo_read(&PDM_PCM_CH_RX_FIFO_STATUS(CYBSP_PDM_HW, LEFT_CH_INDEX),
+                    &PDM_PCM_CH_RX_FIFO_STATUS(CYBSP_PDM_HW, RIGHT_CH_INDEX),
+                    block[0], block[1], num_frames);
+
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        for (uint32_t ch = 0u; ch < num_channels; ch++)
+        {
+            bench_ring[(index * num_channels) + ch] = (uint16_t) block[ch][i];
+        }
+
+        if (++index == (AUDIO_BENCH_RING_FRAMES))
+        {
+            index = 0u;
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_drain_word
+******************************************************************************
+* Summary:
+*  FIFO drain as it was before the block reads, kept as the reference: one
+*  PDL call per sample, stored interleaved into the capture queue with the
+*  wrap check. The FIFO level stands in for the FIFO data.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_drain_word(uint32_t num_frames, uint32_t num_channels)
+{
+    uint32_t index = (AUDIO_BENCH_RING_FRAMES) - (num_frames / 2u);
+
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        for (uint32_t ch = 0u; ch < num_channels; ch++)
+        {
+            uint32_t word = Cy_PDM_PCM_Channel_GetNumInFifo(CYBSP_PDM_HW,
+                                                            (0u == ch) ? LEFT_CH_INDEX : RIGHT_CH_INDEX);
+            bench_ring[(index * num_channels) + ch] = (uint16_t) word;
+        }
+
+        if (++index == (AUDIO_BENCH_RING_FRAMES))
+        {
+            index = 0u;
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_pack
+******************************************************************************
+* Summary:
+*  Packing: copy of the interleaved frames from the capture queue into the
+*  packet, across the end of the queue as in audio_in_queue_read().
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_pack(uint32_t num_frames, uint32_t num_channels)
+{
+    uint32_t index = (AUDIO_BENCH_RING_FRAMES) - (num_frames / 2u);
+    uint32_t first = (AUDIO_BENCH_RING_FRAMES) - index;
+    uint32_t frame_size = num_channels * sizeof(int16_t);
+
+    memcpy(bench_packet, &bench_ring[index * num_channels], first * frame_size);
+    memcpy(&bench_packet[first * num_channels], bench_ring, (num_frames - first) * frame_size);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_pack_mono
+******************************************************************************
+* Summary:
+*  Mono packing: the mono channel of the mono alternate setting built from
+*  the stereo frames of the capture queue, as in audio_in_queue_read_mono(),
+*  with the matrix of the build.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame of the capture queue
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_pack_mono(uint32_t num_frames, uint32_t num_channels)
+{
+    const int16_t *ring = (const int16_t *) bench_ring;
+    uint32_t index = (AUDIO_BENCH_RING_FRAMES) - (num_frames / 2u);
+    uint32_t first = (AUDIO_BENCH_RING_FRAMES) - index;
+
+    audio_matrix_downmix(bench_packet, &ring[index * num_channels], &ring[(index * num_channels) + 1u],
+                         num_channels, first);
+    audio_matrix_downmix(&bench_packet[first], &ring[0], &ring[1], num_channels, num_frames - first);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_mute
+******************************************************************************
+* Summary:
+*  Muting: clear of the packet, as done while the VAD gates the stages.
+*  A host mute costs nothing as it selects the silent packet instead.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_mute(uint32_t num_frames, uint32_t num_channels)
+{
+    memset(bench_packet, 0, num_frames * num_channels * sizeof(int16_t));
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_gain
+******************************************************************************
+* Summary:
+*  Gain: AGC and lookahead limiter, in blocks of at most one packet of the
+*  configured sampling rate.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_gain(uint32_t num_frames, uint32_t num_channels)
+{
+    for (uint32_t i = 0u; i < num_frames; i += AUDIO_IN_MAX_FRAMES_PER_PACKET)
+    {
+        uint32_t frames = num_frames - i;
+
+        frames = (frames > AUDIO_IN_MAX_FRAMES_PER_PACKET) ? AUDIO_IN_MAX_FRAMES_PER_PACKET : frames;
+        audio_agc_process(&bench_packet[i * num_channels], frames, num_channels);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_beamform
+******************************************************************************
+* Summary:
+*  Beamformer: stereo to steered mono.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_beamform(uint32_t num_frames, uint32_t num_channels)
+{
+    CY_UNUSED_PARAMETER(num_channels);
+
+    for (uint32_t i = 0u; i < num_frames; i += AUDIO_IN_MAX_FRAMES_PER_PACKET)
+    {
+        uint32_t frames = num_frames - i;
+
+        frames = (frames > AUDIO_IN_MAX_FRAMES_PER_PACKET) ? AUDIO_IN_MAX_FRAMES_PER_PACKET : frames;
+        audio_beamformer_process(&bench_packet[i * AUDIO_BENCH_NUM_CHANNELS], frames);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_bench_vad
+******************************************************************************
+* Summary:
+*  Voice activity detection on the stereo frames.
+*
+* Parameters:
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_bench_vad(uint32_t num_frames, uint32_t num_channels)
+{
+    CY_UNUSED_PARAMETER(num_channels);
+
+    audio_vad_process(bench_packet, num_frames, num_channels);
+}
+
+
+static const audio_bench_entry_t bench_kernels[] =
+{
+    { "drain",     audio_bench_drain,       1u, 2u },
+    { "drainword", audio_bench_drain_word,  1u, 2u },
+    { "pack",      audio_bench_pack,        1u, 2u },
+    { "packmono",  audio_bench_pack_mono,   2u, 2u },
+    { "mute",      audio_bench_mute,        1u, 2u },
+    { "gain",      audio_bench_gain,        1u, 2u },
+    { "beamform",  audio_bench_beamform,    2u, 2u },
+    { "vad",       audio_bench_vad,         2u, 2u },
+};
+
+
+/*****************************************************************************
+* Function Name: audio_bench_run
+******************************************************************************
+* Summary:
+*  Run every kernel on one packet of every sampling rate and channel count,
+*  and print a CSV line per case with the fastest of AUDIO_BENCH_RUNS runs.
+*  tools/bench_history.py keeps the results of successive builds and
+*  compares them. Called before the USB stack starts; the stages are reset
+*  at the start of every session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_bench_run(void)
+{
+    uint32_t seed = 1u;
+
+    /* Noise at about -20 dBFS */
+    for (uint32_t i = 0u; i < ((AUDIO_BENCH_MAX_FRAMES) * (AUDIO_BENCH_NUM_CHANNELS)); i++)
+    {
+        seed = (seed * 1664525u) + 1013904223u;
+        bench_source[i] = (int16_t) ((int32_t) (seed >> 16) - 32768) / 10;
+    }
+
+    printf("APP_BENCH: kernel,rate_hz,channels,frames,cycles,ns_per_packet,ksamples_per_s\r\n");
+
+    for (uint32_t k = 0u; k < (sizeof(bench_kernels) / sizeof(bench_kernels[0])); k++)
+    {
+        const audio_bench_entry_t *entry = &bench_kernels[k];
+
+        for (uint32_t r = 0u; r < (sizeof(bench_rates) / sizeof(bench_rates[0])); r++)
+        {
+            uint32_t num_frames = bench_rates[r] / (1000u * AUDIO_IN_PACKETS_PER_MS);
+
+            for (uint32_t ch = entry->min_channels; ch <= entry->max_channels; ch++)
+            {
+                uint32_t best = UINT32_MAX;
+                uint32_t ns;
+                uint32_t ksamples;
+
+                for (uint32_t run = 0u; run < AUDIO_BENCH_RUNS; run++)
+                {
+                    uint32_t start;
+                    uint32_t cycles;
+
+                    memcpy(bench_packet, bench_source, sizeof(bench_packet));
+
+                    start = DWT->CYCCNT;
+                    entry->kernel(num_frames, ch);
+                    cycles = DWT->CYCCNT - start;
+
+                    best = (cycles < best) ? cycles : best;
+                }
+
+                ns = (uint32_t) (((uint64_t) best * 1000000000u) / SystemCoreClock);
+                ksamples = (0u != ns) ? (uint32_t) (((uint64_t) num_frames * ch * 1000000u) / ns) : 0u;
+
+                printf("APP_BENCH: %s,%lu,%lu,%lu,%lu,%lu,%lu\r\n", entry->name,
+                       (unsigned long) bench_rates[r], (unsigned long) ch, (unsigned long) num_frames,
+                       (unsigned long) best, (unsigned long) ns, (unsigned long) ksamples);
+            }
+        }
+    }
+
+    /* Leave no trace of the benchmark in the stages */
+    audio_agc_reset();
+    audio_beamformer_reset();
+    audio_vad_reset();
+}
+
+#endif /* AUDIO_BENCH_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,269 @@
+/*****************************************************************************
+* File Name        : audio_boot.c
+*
+* Description      : This file contains the boot profiler. It records when the
+*                    device first reaches each stage of the boot, from the secure
+*                    main() to the first packet of samples sent to the host.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_boot.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include "rtos.h"
+#include <stdbool.h>
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static const char *const boot_stage_names[AUDIO_BOOT_NUM_STAGES] =
+{
+    "NS main",
+    "BSP init",
+    "CM55 start",
+    "Scheduler",
+    "Clock locked",
+    "Audio init",
+    "USB start",
+    "Enumerated",
+    "Stream start",
+    "First packet",
+};
+
+/* Time of each stage, valid once its bit is set in boot_reached */
+static uint32_t boot_stage_us[AUDIO_BOOT_NUM_STAGES];
+static volatile uint32_t boot_reached;
+
+/* RTOS tick count when the scheduler stage was reached */
+static TickType_t boot_scheduler_ticks;
+
+/* Cycle counter extended to 64 bits */
+static uint32_t boot_cycles_high;
+static uint32_t boot_cycles_last;
+
+static bool boot_reported;
+
+
+/*****************************************************************************
+* Function Name: audio_boot_cycles
+******************************************************************************
+* Summary:
+*  Read the cycle counter extended to 64 bits. It must be read at least once
+*  per wrap of the counter. Called in a critical section.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint64_t: Cycles since the secure main()
+*
+*****************************************************************************/
+static uint64_t audio_boot_cycles(void)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if (now < boot_cycles_last)
+    {
+        boot_cycles_high++;
+    }
+    boot_cycles_last = now;
+
+    return (((uint64_t) boot_cycles_high) << 32) | now;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_boot_init
+******************************************************************************
+* Summary:
+*  Mark the entry of the non-secure main(). The secure application starts
+*  the cycle counter at its own main(), so the time spent in the secure boot
+*  is included. The counter is started here when it did not. It is the only
+*  place the non-secure application starts it: the trace, the load, the
+*  performance counters and the benchmarks all read it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_boot_init(void)
+{
+    if (0u == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0u;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    audio_boot_mark(AUDIO_BOOT_NS_MAIN);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_boot_mark
+******************************************************************************
+* Summary:
+*  Record the time of a boot stage. Only the first time a stage is reached
+*  counts. Can be called from an interrupt.
+*
+* Parameters:
+*  stage: Stage reached
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_boot_mark(audio_boot_stage_t stage)
+{
+    uint32_t bit = 1UL << (uint32_t) stage;
+    uint32_t interrupt_state;
+    uint32_t time_us;
+    uint32_t tick_us;
+
+    if (0u != (boot_reached & bit))
+    {
+        return;
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (0u == (boot_reached & bit))
+    {
+        time_us = (uint32_t) (audio_boot_cycles() / (SystemCoreClock / 1000000UL));
+
+        if (AUDIO_BOOT_SCHEDULER == stage)
+        {
+            boot_scheduler_ticks = xTaskGetTickCountFromISR();
+        }
+        else if (0u != (boot_reached & (1UL << (uint32_t) AUDIO_BOOT_SCHEDULER)))
+        {
+            /* The cycle counter stops in deep sleep, the RTOS tick does not */
+            tick_us = boot_stage_us[AUDIO_BOOT_SCHEDULER] +
+                      ((uint32_t) (xTaskGetTickCountFromISR() - boot_scheduler_ticks) * portTICK_PERIOD_MS * 1000UL);
+            if (tick_us > time_us)
+            {
+                time_us = tick_us;
+            }
+        }
+        else
+        {
+            /* Before the scheduler, the cycle counter is the only clock */
+        }
+
+        boot_stage_us[stage] = time_us;
+        boot_reached |= bit;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_boot_poll
+******************************************************************************
+* Summary:
+*  Keep track of the wraps of the cycle counter, and print the boot report
+*  once the first packet has been sent. Called periodically by the Audio App
+*  Task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_boot_poll(void)
+{
+    uint32_t interrupt_state;
+    uint32_t time_us;
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    (void) audio_boot_cycles();
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    if (boot_reported || (0u == (boot_reached & (1UL << (uint32_t) AUDIO_BOOT_FIRST_PACKET))))
+    {
+        return;
+    }
+    boot_reported = true;
+
+    printf("APP_LOG: Boot stages%s:\r\n", (AUDIO_BOOT_FAST) ? " (fast boot)" : "");
+    for (uint32_t stage = 0u; stage < (uint32_t) AUDIO_BOOT_NUM_STAGES; stage++)
+    {
+        if (0u != (boot_reached & (1UL << stage)))
+        {
+            time_us = boot_stage_us[stage];
+            printf("APP_LOG:   %-12s %6lu.%03lu ms\r\n", boot_stage_names[stage],
+                   (unsigned long) (time_us / 1000u), (unsigned long) (time_us % 1000u));
+        }
+        else
+        {
+            printf("APP_LOG:   %-12s %10s\r\n", boot_stage_names[stage], "-");
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_boot_get_status
+******************************************************************************
+* Summary:
+*  Get the time of each boot stage.
+*
+* Parameters:
+*  status: Destination of the times. A stage not reached yet reads as
+*          AUDIO_BOOT_NOT_REACHED.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_boot_get_status(audio_boot_status_t *status)
+{
+    uint32_t reached = boot_reached;
+
+    for (uint32_t stage = 0u; stage < (uint32_t) AUDIO_BOOT_NUM_STAGES; stage++)
+    {
+        status->stage_us[stage] = (0u != (reached & (1UL << stage))) ?
+                                  boot_stage_us[stage] : AUDIO_BOOT_NOT_REACHED;
+    }
+}
+
+/* [] END OF FILE */
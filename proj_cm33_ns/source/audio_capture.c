@@ -0,0 +1,754 @@
+/*****************************************************************************
+* File Name        : audio_capture.c
+*
+* Description      : This file contains the record/replay harness of the words read from
+*                    the PDM-PCM FIFOs. A recorded session is replayed through the capture
+*                    path faster than real time and its packets compared bit-exactly with
+*                    the ones sent while recording.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_capture.h"
+
+#if (AUDIO_CAPTURE_ENABLE)
+
+#include "audio_in.h"
+#include "audio.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define AUDIO_CAPTURE_EVENT_WORDS           (2u)
+#define AUDIO_CAPTURE_TYPE_POS              (24u)
+#define AUDIO_CAPTURE_COUNT_MASK            (0x00FFFFFFUL)
+
+/* Words of the largest packet recorded by an output event */
+#define AUDIO_CAPTURE_OUTPUT_WORDS          (((MAX_AUDIO_IN_PACKET_SIZE_BYTES) + 3u) / 4u)
+
+/* Words printed per line of a dump */
+#define AUDIO_CAPTURE_DUMP_LINE_WORDS       (8u)
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Recording: a header followed by the events. Also the target of a
+ * debugger restore of a dumped recording. */
+uint32_t audio_capture_buffer[AUDIO_CAPTURE_NUM_WORDS];
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static volatile audio_capture_state_t capture_state = AUDIO_CAPTURE_IDLE;
+
+/* Next word written, and the FIFO words still expected for the current
+ * event */
+static uint32_t capture_pos;
+static uint32_t capture_words_left;
+static uint32_t capture_start_cycles;
+
+/* Words kept free for the output event of a recorded request */
+static uint32_t capture_output_words;
+
+/* Next word read by the replay and the frames of the current FIFO event */
+static uint32_t replay_pos;
+static uint32_t replay_fifo_frames;
+
+/* Commands executed by audio_capture_poll() */
+static volatile bool capture_replay_pending;
+static volatile bool capture_dump_pending;
+
+/* Result of the last replay */
+static audio_capture_status_t capture_result;
+
+/* CRC-32 (IEEE 802.3) of each nibble */
+static const uint32_t capture_crc_table[16] =
+{
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+
+/*****************************************************************************
+* Function Name: audio_capture_header
+******************************************************************************
+* Summary:
+*  Return the header of the recording.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  audio_capture_header_t *: Header at the start of the buffer
+*
+*****************************************************************************/
+static audio_capture_header_t *audio_capture_header(void)
+{
+    return (audio_capture_header_t *) audio_capture_buffer;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_finish
+******************************************************************************
+* Summary:
+*  Complete the recording, when the buffer is full or the session ends.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_capture_finish(void)
+{
+    audio_capture_header_t *header = audio_capture_header();
+
+    capture_state = AUDIO_CAPTURE_IDLE;
+    capture_words_left = 0u;
+
+    header->num_words = capture_pos;
+    header->duration_cycles = DWT->CYCCNT - capture_start_cycles;
+    header->magic = AUDIO_CAPTURE_MAGIC;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_crc32
+******************************************************************************
+* Summary:
+*  Update a CRC-32 with a block of bytes.
+*
+* Parameters:
+*  crc: CRC of the previous blocks, 0 for the first one
+*  data: Block
+*  size: Size of the block, in bytes
+*
+* Return:
+*  uint32_t: Updated CRC
+*
+*****************************************************************************/
+uint32_t audio_capture_crc32(uint32_t crc, const uint8_t *data, uint32_t size)
+{
+    crc = ~crc;
+
+    for (uint32_t i = 0u; i < size; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ capture_crc_table[crc & 0x0Fu];
+        crc = (crc >> 4) ^ capture_crc_table[crc & 0x0Fu];
+    }
+
+    return ~crc;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_session_start
+******************************************************************************
+* Summary:
+*  Start recording if armed. Called by audio_in_endpoint_callback() at the
+*  start of a session, with the PDM-PCM interrupt disabled and the capture
+*  queue empty.
+*
+* Parameters:
+*  alt_setting: Alternate setting of the session
+*  queue_target: Capture queue target level latched for the session
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_session_start(uint32_t alt_setting, uint32_t queue_target)
+{
+    audio_capture_header_t *header = audio_capture_header();
+
+    if (AUDIO_CAPTURE_ARMED != capture_state)
+    {
+        return;
+    }
+
+    memset(header, 0, sizeof(*header));
+    header->alt_setting = alt_setting;
+    header->queue_target = queue_target;
+
+    capture_pos = AUDIO_CAPTURE_HEADER_WORDS;
+    capture_words_left = 0u;
+    capture_output_words = 0u;
+    capture_start_cycles = DWT->CYCCNT;
+    capture_state = AUDIO_CAPTURE_RECORDING;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_session_end
+******************************************************************************
+* Summary:
+*  Complete a recording in progress at the end of a session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_session_end(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (AUDIO_CAPTURE_RECORDING == capture_state)
+    {
+        audio_capture_finish();
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_record_fifo
+******************************************************************************
+* Summary:
+*  Record the start of a FIFO drain. Called by the PDM-PCM interrupt before
+*  it reads the FIFOs, each word read is then passed to
+*  audio_capture_record_word().
+*
+* Parameters:
+*  num_frames: Frames about to be read from the FIFOs
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_record_fifo(uint32_t num_frames)
+{
+    uint32_t num_words = AUDIO_CAPTURE_EVENT_WORDS + (2u * num_frames);
+
+    capture_words_left = 0u;
+
+    if (AUDIO_CAPTURE_RECORDING != capture_state)
+    {
+        return;
+    }
+
+    if ((capture_pos + num_words + capture_output_words) > AUDIO_CAPTURE_NUM_WORDS)
+    {
+        audio_capture_finish();
+        return;
+    }
+
+    audio_capture_buffer[capture_pos++] = (AUDIO_CAPTURE_EVENT_FIFO << AUDIO_CAPTURE_TYPE_POS) | num_frames;
+    audio_capture_buffer[capture_pos++] = DWT->CYCCNT;
+    capture_words_left = 2u * num_frames;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_record_word
+******************************************************************************
+* Summary:
+*  Record a word read from a PDM-PCM FIFO.
+*
+* Parameters:
+*  word: Word returned by Cy_PDM_PCM_Channel_ReadFifo()
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_record_word(uint32_t word)
+{
+    if (0u != capture_words_left)
+    {
+        capture_words_left--;
+        audio_capture_buffer[capture_pos++] = word;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_record_packet
+******************************************************************************
+* Summary:
+*  Record a request of the Audio IN endpoint, and keep room for the packet
+*  sent for it. Must be called in a critical section together with the read
+*  of the capture queue level, so that the replay sees the same level.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the request is recorded, its packet must then be passed
+*        to audio_capture_record_output()
+*
+*****************************************************************************/
+bool audio_capture_record_packet(void)
+{
+    if (AUDIO_CAPTURE_RECORDING != capture_state)
+    {
+        return false;
+    }
+
+    if ((capture_pos + (2u * AUDIO_CAPTURE_EVENT_WORDS) + AUDIO_CAPTURE_OUTPUT_WORDS) > AUDIO_CAPTURE_NUM_WORDS)
+    {
+        audio_capture_finish();
+        return false;
+    }
+
+    audio_capture_buffer[capture_pos++] = AUDIO_CAPTURE_EVENT_PACKET << AUDIO_CAPTURE_TYPE_POS;
+    audio_capture_buffer[capture_pos++] = DWT->CYCCNT;
+    capture_output_words = AUDIO_CAPTURE_EVENT_WORDS + AUDIO_CAPTURE_OUTPUT_WORDS;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_record_output
+******************************************************************************
+* Summary:
+*  Record a packet sent while recording, in an output event after its
+*  request, and add it to the reference CRC. Also done when the recording
+*  completed after the request was recorded, as the replay produces that
+*  packet too: the room for the event was kept by
+*  audio_capture_record_packet().
+*
+* Parameters:
+*  packet: Packet handed to the Audio IN endpoint
+*  size: Size of the packet, in bytes
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_record_output(const uint8_t *packet, uint32_t size)
+{
+    audio_capture_header_t *header = audio_capture_header();
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if ((0u != capture_output_words) && (size <= MAX_AUDIO_IN_PACKET_SIZE_BYTES))
+    {
+        audio_capture_buffer[capture_pos++] = (AUDIO_CAPTURE_EVENT_OUTPUT << AUDIO_CAPTURE_TYPE_POS) | size;
+        audio_capture_buffer[capture_pos++] = DWT->CYCCNT;
+        if (0u != size)
+        {
+            /* Clear the padding of the last word */
+            audio_capture_buffer[capture_pos + ((size - 1u) / 4u)] = 0u;
+            memcpy(&audio_capture_buffer[capture_pos], packet, size);
+        }
+        capture_pos += (size + 3u) / 4u;
+        capture_output_words = 0u;
+
+        if (AUDIO_CAPTURE_RECORDING != capture_state)
+        {
+            header->num_words = capture_pos;
+        }
+    }
+
+    header->crc = audio_capture_crc32(header->crc, packet, size);
+    header->packets++;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_is_replaying
+******************************************************************************
+* Summary:
+*  Check whether the PDM-PCM interrupt must read the recording instead of
+*  the FIFOs.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true during a replay
+*
+*****************************************************************************/
+bool audio_capture_is_replaying(void)
+{
+    return (AUDIO_CAPTURE_REPLAYING == capture_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_replay_begin
+******************************************************************************
+* Summary:
+*  Check the recording and start reading it from the first event.
+*
+* Parameters:
+*  alt_setting: Set to the alternate setting of the recorded session
+*  queue_target: Set to the capture queue target level of the recorded
+*                session
+*
+* Return:
+*  bool: true if a complete recording is available
+*
+*****************************************************************************/
+bool audio_capture_replay_begin(uint32_t *alt_setting, uint32_t *queue_target)
+{
+    const audio_capture_header_t *header = audio_capture_header();
+
+    if ((AUDIO_CAPTURE_IDLE != capture_state) || (AUDIO_CAPTURE_MAGIC != header->magic) ||
+        (header->num_words > AUDIO_CAPTURE_NUM_WORDS) || (header->num_words < AUDIO_CAPTURE_HEADER_WORDS))
+    {
+        return false;
+    }
+
+    *alt_setting = header->alt_setting;
+    *queue_target = header->queue_target;
+    replay_pos = AUDIO_CAPTURE_HEADER_WORDS;
+    replay_fifo_frames = 0u;
+    capture_state = AUDIO_CAPTURE_REPLAYING;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_replay_next
+******************************************************************************
+* Summary:
+*  Read the next event of the recording. For a FIFO event, the frames are
+*  then read by the PDM-PCM interrupt handler. The output events only serve
+*  as the reference and are skipped.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: AUDIO_CAPTURE_EVENT_*, 0 at the end of the recording
+*
+*****************************************************************************/
+uint32_t audio_capture_replay_next(void)
+{
+    const audio_capture_header_t *header = audio_capture_header();
+    uint32_t type;
+    uint32_t count;
+
+    do
+    {
+        if ((replay_pos + AUDIO_CAPTURE_EVENT_WORDS) > header->num_words)
+        {
+            return 0u;
+        }
+
+        type = audio_capture_buffer[replay_pos] >> AUDIO_CAPTURE_TYPE_POS;
+        count = audio_capture_buffer[replay_pos] & AUDIO_CAPTURE_COUNT_MASK;
+        replay_pos += AUDIO_CAPTURE_EVENT_WORDS;
+
+        if (AUDIO_CAPTURE_EVENT_OUTPUT == type)
+        {
+            replay_pos += (count + 3u) / 4u;
+        }
+    } while (AUDIO_CAPTURE_EVENT_OUTPUT == type);
+
+    if (AUDIO_CAPTURE_EVENT_FIFO == type)
+    {
+        if ((replay_pos + (2u * count)) > header->num_words)
+        {
+            return 0u;
+        }
+        replay_fifo_frames = count;
+    }
+    else if (AUDIO_CAPTURE_EVENT_PACKET != type)
+    {
+        return 0u;
+    }
+
+    return type;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_replay_fifo
+******************************************************************************
+* Summary:
+*  Return the frames of the current FIFO event. Called by the PDM-PCM
+*  interrupt handler in place of reading the FIFO levels.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Frames to read with audio_capture_replay_word()
+*
+*****************************************************************************/
+uint32_t audio_capture_replay_fifo(void)
+{
+    uint32_t num_frames = replay_fifo_frames;
+
+    replay_fifo_frames = 0u;
+
+    return num_frames;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_replay_word
+******************************************************************************
+* Summary:
+*  Return the next recorded FIFO word, in place of
+*  Cy_PDM_PCM_Channel_ReadFifo().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Recorded word
+*
+*****************************************************************************/
+uint32_t audio_capture_replay_word(void)
+{
+    return audio_capture_buffer[replay_pos++];
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_replay_end
+******************************************************************************
+* Summary:
+*  Store the result of a replay and compare it with the recording.
+*
+* Parameters:
+*  packets: Packets produced by the replay
+*  crc: CRC-32 of the packets
+*  cycles: Duration of the replay
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_replay_end(uint32_t packets, uint32_t crc, uint32_t cycles)
+{
+    const audio_capture_header_t *header = audio_capture_header();
+
+    capture_result.num_words = header->num_words;
+    capture_result.packets = packets;
+    capture_result.crc = crc;
+    capture_result.replay_cycles = cycles;
+    capture_result.match = ((packets == header->packets) && (crc == header->crc)) ? 1u : 0u;
+
+    capture_state = AUDIO_CAPTURE_IDLE;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_command
+******************************************************************************
+* Summary:
+*  Execute a command of the AUDIO_CTRL_CAPTURE control. The replay and the
+*  dump are deferred to audio_capture_poll().
+*
+* Parameters:
+*  command: AUDIO_CAPTURE_CMD_*
+*
+* Return:
+*  bool: true if the command is valid
+*
+*****************************************************************************/
+bool audio_capture_command(uint8_t command)
+{
+    bool valid = true;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    switch (command)
+    {
+        case AUDIO_CAPTURE_CMD_STOP:
+            if (AUDIO_CAPTURE_RECORDING == capture_state)
+            {
+                audio_capture_finish();
+            }
+            else if (AUDIO_CAPTURE_ARMED == capture_state)
+            {
+                capture_state = AUDIO_CAPTURE_IDLE;
+            }
+            else
+            {
+                /* Nothing to stop */
+            }
+            break;
+
+        case AUDIO_CAPTURE_CMD_RECORD:
+            valid = (AUDIO_CAPTURE_IDLE == capture_state);
+            if (valid)
+            {
+                capture_state = AUDIO_CAPTURE_ARMED;
+            }
+            break;
+
+        case AUDIO_CAPTURE_CMD_REPLAY:
+            capture_replay_pending = true;
+            break;
+
+        case AUDIO_CAPTURE_CMD_DUMP:
+            capture_dump_pending = true;
+            break;
+
+        default:
+            valid = false;
+            break;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return valid;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_get_status
+******************************************************************************
+* Summary:
+*  Return the state of the harness and the result of the last replay.
+*
+* Parameters:
+*  status: Filled with the current status
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_get_status(audio_capture_status_t *status)
+{
+    *status = capture_result;
+    status->state = (uint8_t) capture_state;
+    status->num_words = (AUDIO_CAPTURE_RECORDING == capture_state) ? capture_pos :
+                        audio_capture_header()->num_words;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_dump
+******************************************************************************
+* Summary:
+*  Print the recording on the debug UART. tools/capture_dump.py turns the
+*  log into a binary file that can be restored into audio_capture_buffer
+*  with the debugger and replayed by another build.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_capture_dump(void)
+{
+    const audio_capture_header_t *header = audio_capture_header();
+
+    if ((AUDIO_CAPTURE_MAGIC != header->magic) || (header->num_words > AUDIO_CAPTURE_NUM_WORDS))
+    {
+        printf("APP_LOG: Capture: no recording to dump\r\n");
+        return;
+    }
+
+    printf("APP_CAPTURE: BEGIN %lu\r\n", (unsigned long) header->num_words);
+
+    for (uint32_t i = 0u; i < header->num_words; i += AUDIO_CAPTURE_DUMP_LINE_WORDS)
+    {
+        printf("APP_CAPTURE:");
+        for (uint32_t j = i; (j < header->num_words) && (j < (i + AUDIO_CAPTURE_DUMP_LINE_WORDS)); j++)
+        {
+            printf(" %08lx", (unsigned long) audio_capture_buffer[j]);
+        }
+        printf("\r\n");
+    }
+
+    printf("APP_CAPTURE: END\r\n");
+}
+
+
+/*****************************************************************************
+* Function Name: audio_capture_poll
+******************************************************************************
+* Summary:
+*  Run a pending replay or dump. Called by the Audio App Task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_capture_poll(void)
+{
+    if (capture_replay_pending)
+    {
+        capture_replay_pending = false;
+
+        if (audio_in_replay())
+        {
+            const audio_capture_header_t *header = audio_capture_header();
+
+            /* Speed relative to real time, in units of 0.01 */
+            uint32_t speed = (0u != capture_result.replay_cycles) ?
+                             (uint32_t) (((uint64_t) header->duration_cycles * 100u) / capture_result.replay_cycles) : 0u;
+
+            printf("APP_LOG: Replay: %lu packets, CRC32 0x%08lx, recorded %lu packets, CRC32 0x%08lx: %s, "
+                   "%lu.%02lu x real time\r\n",
+                   (unsigned long) capture_result.packets, (unsigned long) capture_result.crc,
+                   (unsigned long) header->packets, (unsigned long) header->crc,
+                   capture_result.match ? "match" : "MISMATCH",
+                   (unsigned long) (speed / 100u), (unsigned long) (speed % 100u));
+        }
+        else
+        {
+            printf("APP_LOG: Replay: no recording, or the device is streaming\r\n");
+        }
+    }
+
+    if (capture_dump_pending)
+    {
+        capture_dump_pending = false;
+        audio_capture_dump();
+    }
+}
+
+#endif /* AUDIO_CAPTURE_ENABLE */
+
+/* [] END OF FILE */
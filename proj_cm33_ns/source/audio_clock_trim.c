@@ -0,0 +1,395 @@
+/*****************************************************************************
+* File Name        : audio_clock_trim.c
+*
+* Description      : This file implements the loop that locks the PDM clock to the
+*                    USB clock. The PDM clock is measured against the device clock
+*                    at the capture interrupt, the device clock against the USB
+*                    clock by the timestamp estimator, and the fractional feedback
+*                    divider of the audio DPLL is trimmed to cancel the sum.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_clock_trim.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "audio_timestamp.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include "rtos.h"
+#include <math.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Audio DPLL set up by app_clock_init(), and its register instance */
+#define CLOCK_TRIM_DPLL_PATH                (SRSS_DPLL_LP_1_PATH_NUM)
+#define CLOCK_TRIM_DPLL_INSTANCE            ((SRSS_DPLL_LP_1_PATH_NUM) - (SRSS_DPLL_LP_0_PATH_NUM))
+
+/* One unit of the feedback divider, in steps of its fractional part */
+#define CLOCK_TRIM_FRAC_ONE                 ((int64_t) (CLK_DPLL_LP_CONFIG2_FRAC_DIV_Msk >> CLK_DPLL_LP_CONFIG2_FRAC_DIV_Pos) + 1)
+
+#define CLOCK_TRIM_PPB_PER_PPM              (1000)
+
+/* USB time per second, in the units of audio_timestamp_usb_time() */
+#define CLOCK_TRIM_USB_PER_S                ((int64_t) 8000 << (AUDIO_TIMESTAMP_USB_FRAC_BITS))
+
+/* A measurement further off than this spans a gap of the capture, such as
+ * a re-arm by the pipeline watchdog, and is dropped */
+#define CLOCK_TRIM_MAX_ERROR_PPB            (2 * (AUDIO_CLOCK_TRIM_MAX_PPM) * CLOCK_TRIM_PPB_PER_PPM)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static audio_clock_trim_status_t trim_status;
+
+/* Nominal feedback divider of the DPLL, in steps of its fractional part */
+static int64_t trim_nominal;
+
+/* Start of the measurement in progress */
+static bool trim_measuring;
+static uint32_t trim_position;
+static uint32_t trim_cycles;
+static uint32_t trim_usb_time;
+static uint32_t trim_start_ms;
+
+/* Start of the recording session, and the last measurements of the
+ * session, of which the lock takes the mean */
+static bool trim_streaming;
+static uint32_t trim_session_ms;
+static int32_t trim_errors[AUDIO_CLOCK_TRIM_LOCK_COUNT];
+static uint32_t trim_error_count;
+static uint32_t trim_error_index;
+
+
+/*****************************************************************************
+* Function Name: audio_clock_trim_now_ms
+******************************************************************************
+* Summary:
+*  Current time of the RTOS tick.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Time in ms
+*
+*****************************************************************************/
+static uint32_t audio_clock_trim_now_ms(void)
+{
+    return (uint32_t) xTaskGetTickCount() * portTICK_PERIOD_MS;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_clock_trim_apply
+******************************************************************************
+* Summary:
+*  Set the fractional part of the DPLL feedback divider for a trim of its
+*  output frequency. The DPLL stays locked and slews to the new frequency.
+*  The integer part is left as configured, which bounds the trim when the
+*  nominal fraction is close to a whole divider.
+*
+* Parameters:
+*  trim_ppb: Trim requested, in ppb of the nominal frequency
+*  limited: Set if the integer part bounded the trim
+*
+* Return:
+*  int32_t: Trim applied, in ppb
+*
+*****************************************************************************/
+static int32_t audio_clock_trim_apply(int32_t trim_ppb, bool *limited)
+{
+    int64_t low = (trim_nominal / CLOCK_TRIM_FRAC_ONE) * CLOCK_TRIM_FRAC_ONE;
+    int64_t high = low + CLOCK_TRIM_FRAC_ONE - 1;
+    int64_t target = trim_nominal + ((trim_nominal * trim_ppb) / 1000000000);
+
+    *limited = (target < low) || (target > high);
+    if (target < low)
+    {
+        target = low;
+    }
+    else if (target > high)
+    {
+        target = high;
+    }
+
+    CY_REG32_CLR_SET(SRSS_CLK_DPLL_LP_CONFIG2(CLOCK_TRIM_DPLL_INSTANCE),
+                     CLK_DPLL_LP_CONFIG2_FRAC_DIV, (uint32_t) (target - low));
+
+    return (int32_t) (((target - trim_nominal) * 1000000000) / trim_nominal);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_clock_trim_init
+******************************************************************************
+* Summary:
+*  Read the nominal setting of the DPLL. Called once the clock tree is set
+*  up. The trim needs the DPLL in fractional mode.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_clock_trim_init(void)
+{
+    cy_stc_dpll_lp_config_t lp_config = {0};
+    cy_stc_pll_manual_config_t manual_config = { .lpPllCfg = &lp_config };
+
+    if ((CY_SYSCLK_SUCCESS == Cy_SysClk_DpllLpGetConfiguration(CLOCK_TRIM_DPLL_PATH, &manual_config)) &&
+        (lp_config.fracEn))
+    {
+        trim_nominal = ((int64_t) lp_config.feedbackDiv * CLOCK_TRIM_FRAC_ONE) + (int64_t) lp_config.fracDiv;
+        trim_status.available = 1u;
+    }
+    else
+    {
+        printf("APP_LOG: Clock trim: DPLL not in fractional mode, PDM clock not trimmed\r\n");
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_clock_trim_poll
+******************************************************************************
+* Summary:
+*  Measure the PDM clock against the USB clock over
+*  AUDIO_CLOCK_TRIM_INTERVAL_MS while the host records, and trim the DPLL
+*  to cancel the error. The trim is kept between sessions, the crystal
+*  offset it cancels being the same. Called periodically by the Audio App
+*  Task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_clock_trim_poll(void)
+{
+    audio_in_progress_t progress;
+    audio_timestamp_status_t timestamp;
+    uint32_t now = audio_clock_trim_now_ms();
+    uint32_t position;
+    uint32_t cycles;
+    uint32_t usb_time;
+    uint32_t delta_frames;
+    uint32_t delta_cycles;
+    uint32_t delta_usb;
+    int64_t excess;
+    int32_t error_ppb;
+    int32_t trim_ppb;
+    int32_t step_ppb;
+    int32_t mean_ppb;
+    bool limited;
+
+    if (0u == trim_status.available)
+    {
+        return;
+    }
+
+    audio_in_get_progress(&progress);
+    if (progress.streaming != trim_streaming)
+    {
+        trim_streaming = progress.streaming;
+        trim_session_ms = now;
+        trim_status.lock_ms = 0u;
+        trim_status.locked = 0u;
+        trim_error_count = 0u;
+    }
+
+    /* The estimator restarts with each session */
+    audio_timestamp_get_status(&timestamp);
+    if ((!progress.streaming) || (timestamp.packets < AUDIO_CLOCK_TRIM_SETTLE_PACKETS))
+    {
+        trim_measuring = false;
+        return;
+    }
+
+    audio_timestamp_get_anchor(&position, &cycles);
+    usb_time = audio_timestamp_usb_time(cycles);
+    if (!trim_measuring)
+    {
+        trim_measuring = true;
+        trim_position = position;
+        trim_cycles = cycles;
+        trim_usb_time = usb_time;
+        trim_start_ms = now;
+        return;
+    }
+
+    if ((now - trim_start_ms) < AUDIO_CLOCK_TRIM_INTERVAL_MS)
+    {
+        return;
+    }
+
+    /* Frames captured against the frames expected from the device clock,
+     * and against those expected from the USB time of the estimator. The
+     * rate of the estimator is not used: it follows the jitter of the last
+     * few hundred packets and is off by a few ppm, while the USB time that
+     * it gives over the whole interval is accurate to about a ppm. */
+    delta_frames = position - trim_position;
+    delta_cycles = cycles - trim_cycles;
+    delta_usb = usb_time - trim_usb_time;
+
+    trim_position = position;
+    trim_cycles = cycles;
+    trim_usb_time = usb_time;
+    trim_start_ms = now;
+
+    if ((0u == delta_cycles) || (0u == delta_usb))
+    {
+        return;
+    }
+
+    excess = ((int64_t) delta_frames * (int64_t) SystemCoreClock) -
+             ((int64_t) delta_cycles * (int64_t) AUDIO_IN_SAMPLE_FREQ);
+    trim_status.pdm_ppb = (int32_t) lrintf(((float) excess * 1e9f) /
+                                           ((float) delta_cycles * (float) AUDIO_IN_SAMPLE_FREQ));
+
+    excess = ((int64_t) delta_frames * CLOCK_TRIM_USB_PER_S) - ((int64_t) delta_usb * (int64_t) AUDIO_IN_SAMPLE_FREQ);
+    error_ppb = (int32_t) lrintf(((float) excess * 1e9f) / ((float) delta_usb * (float) AUDIO_IN_SAMPLE_FREQ));
+
+    if (abs(error_ppb) > CLOCK_TRIM_MAX_ERROR_PPB)
+    {
+        return;
+    }
+    trim_status.error_ppb = error_ppb;
+
+    /* Remove part of the error, within the range of the trim */
+    trim_ppb = trim_status.trim_ppb - (int32_t) lrintf(AUDIO_CLOCK_TRIM_GAIN * (float) error_ppb);
+    if (trim_ppb > (AUDIO_CLOCK_TRIM_MAX_PPM * CLOCK_TRIM_PPB_PER_PPM))
+    {
+        trim_ppb = AUDIO_CLOCK_TRIM_MAX_PPM * CLOCK_TRIM_PPB_PER_PPM;
+        trim_status.saturations++;
+    }
+    else if (trim_ppb < -(AUDIO_CLOCK_TRIM_MAX_PPM * CLOCK_TRIM_PPB_PER_PPM))
+    {
+        trim_ppb = -(AUDIO_CLOCK_TRIM_MAX_PPM * CLOCK_TRIM_PPB_PER_PPM);
+        trim_status.saturations++;
+    }
+    else
+    {
+        /* Within range */
+    }
+
+    step_ppb = audio_clock_trim_apply(trim_ppb, &limited);
+    if (limited)
+    {
+        trim_status.saturations++;
+    }
+    trim_ppb = step_ppb;
+
+    step_ppb = abs(trim_ppb - trim_status.trim_ppb);
+    if ((uint32_t) step_ppb > trim_status.max_step_ppb)
+    {
+        trim_status.max_step_ppb = (uint32_t) step_ppb;
+    }
+    trim_status.trim_ppb = trim_ppb;
+    trim_status.updates++;
+
+    /* Consecutive measurements share the error of the USB time at their
+     * common end, so their mean is the error over their whole time, which
+     * is measured more accurately than each one */
+    trim_errors[trim_error_index] = error_ppb;
+    trim_error_index = (trim_error_index + 1u) % AUDIO_CLOCK_TRIM_LOCK_COUNT;
+    if (trim_error_count < AUDIO_CLOCK_TRIM_LOCK_COUNT)
+    {
+        trim_error_count++;
+        if (trim_error_count < AUDIO_CLOCK_TRIM_LOCK_COUNT)
+        {
+            return;
+        }
+    }
+
+    mean_ppb = 0;
+    for (uint32_t i = 0u; i < AUDIO_CLOCK_TRIM_LOCK_COUNT; i++)
+    {
+        mean_ppb += trim_errors[i];
+    }
+    mean_ppb /= (int32_t) AUDIO_CLOCK_TRIM_LOCK_COUNT;
+
+    if (abs(mean_ppb) < AUDIO_CLOCK_TRIM_LOCK_PPB)
+    {
+        if (0u == trim_status.locked)
+        {
+            trim_status.locked = 1u;
+            if (0u == trim_status.lock_ms)
+            {
+                trim_status.lock_ms = now - trim_session_ms;
+            }
+
+            printf("APP_LOG: Clock trim locked in %lu ms: trim %ld ppb, residual %ld ppb\r\n",
+                   (unsigned long) trim_status.lock_ms, (long) trim_status.trim_ppb, (long) mean_ppb);
+        }
+    }
+    else if (0u != trim_status.locked)
+    {
+        trim_status.locked = 0u;
+        printf("APP_LOG: Clock trim unlocked: error %ld ppb\r\n", (long) mean_ppb);
+    }
+    else
+    {
+        /* Not locked yet */
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_clock_trim_get_status
+******************************************************************************
+* Summary:
+*  Get the state of the loop.
+*
+* Parameters:
+*  status: Destination of the state
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_clock_trim_get_status(audio_clock_trim_status_t *status)
+{
+    *status = trim_status;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,487 @@
+/*****************************************************************************
+* File Name        : audio_ctrl.c
+*
+* Description      : This file contains the vendor specific audio controls used to
+*                    configure and monitor the device at runtime.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_ctrl.h"
+#include "audio_agc.h"
+#include "audio_beamformer.h"
+#include "audio_boot.h"
+#include "audio_capture.h"
+#include "audio_clock_trim.h"
+#include "audio_factory.h"
+#include "audio_in.h"
+#include "audio_load.h"
+#include "audio_matrix.h"
+#include "audio_offload.h"
+#include "audio_pool.h"
+#include "audio_profile.h"
+#include "audio_recorder.h"
+#include "audio_timestamp.h"
+#include "audio_trace.h"
+#include "audio_vad.h"
+#include "audio_watchdog.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Function Name: audio_ctrl_copy_reply
+******************************************************************************
+* Summary:
+*  Copy a reply to the control request buffer, truncated to the length
+*  requested by the host.
+*
+* Parameters:
+*  pBuffer: Reply buffer of the control request
+*  NumBytes: Requested reply size
+*  data: Reply data
+*  size: Size of the reply data
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_ctrl_copy_reply(U8 *pBuffer, U32 NumBytes, const void *data, U32 size)
+{
+    memset(pBuffer, 0, NumBytes);
+    memcpy(pBuffer, data, (NumBytes < size) ? NumBytes : size);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ctrl_set_cur
+******************************************************************************
+* Summary:
+*  Handle a SET_CUR request for a vendor specific control. Called in ISR
+*  context from audio_control_callback().
+*
+* Parameters:
+*  ControlSelector: ID of the control
+*  pBuffer: Control value sent by the host
+*  NumBytes: Number of bytes in pBuffer
+*
+* Return:
+*  int: AUDIO_CTRL_HANDLED or AUDIO_CTRL_NOT_HANDLED (the request is stalled)
+*
+*****************************************************************************/
+int audio_ctrl_set_cur(U8 ControlSelector, const U8 *pBuffer, U32 NumBytes)
+{
+    int retVal = AUDIO_CTRL_NOT_HANDLED;
+
+    switch (ControlSelector)
+    {
+        case AUDIO_CTRL_LATENCY_PROFILE:
+            if ((1u == NumBytes) && audio_profile_set((audio_profile_id_t) pBuffer[0]))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+
+        case AUDIO_CTRL_STREAM_STATS:
+            audio_in_reset_stats();
+            retVal = AUDIO_CTRL_HANDLED;
+            break;
+
+        case AUDIO_CTRL_BEAM_STEERING:
+            if (2u == NumBytes)
+            {
+                audio_beamformer_set_steering((int16_t) (pBuffer[0] | (pBuffer[1] << 8)));
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+
+        case AUDIO_CTRL_CM55_STAGES:
+            if (1u == NumBytes)
+            {
+                audio_offload_set_stages(pBuffer[0]);
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+
+        case AUDIO_CTRL_SPECTRUM_CONFIG:
+            if (sizeof(audio_offload_spectrum_config_t) == NumBytes)
+            {
+                audio_offload_spectrum_config_t config;
+
+                memcpy(&config, pBuffer, sizeof(config));
+                if (audio_offload_set_spectrum_config(&config))
+                {
+                    retVal = AUDIO_CTRL_HANDLED;
+                }
+            }
+            break;
+
+        case AUDIO_CTRL_SPECTRUM:
+            if ((4u == NumBytes) &&
+                audio_offload_select_spectrum_page(pBuffer[0], (uint32_t) (pBuffer[2] | (pBuffer[3] << 8))))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+
+        case AUDIO_CTRL_AGC:
+            if (sizeof(audio_agc_params_t) == NumBytes)
+            {
+                audio_agc_params_t params;
+
+                memcpy(&params, pBuffer, sizeof(params));
+                if (audio_agc_set_params(&params))
+                {
+                    retVal = AUDIO_CTRL_HANDLED;
+                }
+            }
+            break;
+
+        case AUDIO_CTRL_VAD_MODE:
+            if ((1u == NumBytes) && audio_vad_set_mode((audio_vad_mode_t) pBuffer[0]))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+
+        case AUDIO_CTRL_VAD_STATUS:
+            audio_vad_clear_status();
+            retVal = AUDIO_CTRL_HANDLED;
+            break;
+
+        case AUDIO_CTRL_LEVELS:
+            audio_in_reset_levels();
+            retVal = AUDIO_CTRL_HANDLED;
+            break;
+
+        case AUDIO_CTRL_POOL_STATS:
+            audio_pool_reset_stats();
+            retVal = AUDIO_CTRL_HANDLED;
+            break;
+
+        case AUDIO_CTRL_PREROLL:
+            if ((2u == NumBytes) && audio_in_set_preroll((uint32_t) (pBuffer[0] | (pBuffer[1] << 8))))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+
+        case AUDIO_CTRL_TIMESTAMP:
+            audio_timestamp_reset_stats();
+            retVal = AUDIO_CTRL_HANDLED;
+            break;
+
+        case AUDIO_CTRL_WATCHDOG:
+            audio_watchdog_reset_status();
+            retVal = AUDIO_CTRL_HANDLED;
+            break;
+
+        case AUDIO_CTRL_CHANNEL_MATRIX:
+            if ((1u == NumBytes) && audio_matrix_set_layout((audio_matrix_layout_t) pBuffer[0]))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            else if (sizeof(audio_matrix_params_t) == NumBytes)
+            {
+                audio_matrix_params_t params;
+
+                memcpy(&params, pBuffer, sizeof(params));
+                if (audio_matrix_set(&params))
+                {
+                    retVal = AUDIO_CTRL_HANDLED;
+                }
+            }
+            break;
+
+#if (AUDIO_TRACE_ENABLE)
+        case AUDIO_CTRL_TRACE:
+            if ((1u == NumBytes) && audio_trace_command(pBuffer[0]))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+#endif
+
+#if (AUDIO_CAPTURE_ENABLE)
+        case AUDIO_CTRL_CAPTURE:
+            if ((1u == NumBytes) && audio_capture_command(pBuffer[0]))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+#endif
+
+#if (AUDIO_FACTORY_ENABLE)
+        case AUDIO_CTRL_FACTORY_TEST:
+            if ((2u == NumBytes) && audio_factory_request((uint32_t) (pBuffer[0] | (pBuffer[1] << 8))))
+            {
+                retVal = AUDIO_CTRL_HANDLED;
+            }
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    return retVal;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ctrl_get_cur
+******************************************************************************
+* Summary:
+*  Handle a GET_CUR request for a vendor specific control. Called in ISR
+*  context from audio_control_callback().
+*
+* Parameters:
+*  ControlSelector: ID of the control
+*  pBuffer: Buffer into which the reply is written
+*  NumBytes: Requested size of the reply
+*
+* Return:
+*  int: AUDIO_CTRL_HANDLED or AUDIO_CTRL_NOT_HANDLED
+*
+*****************************************************************************/
+int audio_ctrl_get_cur(U8 ControlSelector, U8 *pBuffer, U32 NumBytes)
+{
+    int retVal = AUDIO_CTRL_HANDLED;
+
+    switch (ControlSelector)
+    {
+        case AUDIO_CTRL_LATENCY_PROFILE:
+        {
+            U8 profile = (U8) audio_profile_get_id();
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &profile, sizeof(profile));
+            break;
+        }
+
+        case AUDIO_CTRL_STREAM_STATS:
+        {
+            audio_in_stats_t stats;
+            audio_in_get_stats(&stats);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &stats, sizeof(stats));
+            break;
+        }
+
+        case AUDIO_CTRL_BEAM_STEERING:
+        {
+            int16_t delay = audio_beamformer_get_steering();
+            U8 reply[2] = { (U8) delay, (U8) ((uint16_t) delay >> 8) };
+            audio_ctrl_copy_reply(pBuffer, NumBytes, reply, sizeof(reply));
+            break;
+        }
+
+        case AUDIO_CTRL_CM55_STAGES:
+        {
+            U8 stages = (U8) audio_offload_get_stages();
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &stages, sizeof(stages));
+            break;
+        }
+
+        case AUDIO_CTRL_CM55_STATUS:
+        {
+            audio_ipc_status_t status;
+            audio_offload_stats_t stats;
+            audio_offload_get_status(&status, &stats);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+
+        case AUDIO_CTRL_SPECTRUM_CONFIG:
+        {
+            audio_offload_spectrum_config_t config;
+            audio_offload_get_spectrum_config(&config);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &config, sizeof(config));
+            break;
+        }
+
+        case AUDIO_CTRL_SPECTRUM:
+        {
+            audio_offload_spectrum_page_t page;
+            if (audio_offload_get_spectrum_page(&page))
+            {
+                audio_ctrl_copy_reply(pBuffer, NumBytes, &page, sizeof(page));
+            }
+            else
+            {
+                retVal = AUDIO_CTRL_NOT_HANDLED;
+            }
+            break;
+        }
+
+        case AUDIO_CTRL_AGC:
+        {
+            audio_agc_params_t params;
+            audio_agc_get_params(&params);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &params, sizeof(params));
+            break;
+        }
+
+        case AUDIO_CTRL_VAD_MODE:
+        {
+            U8 mode = (U8) audio_vad_get_mode();
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &mode, sizeof(mode));
+            break;
+        }
+
+        case AUDIO_CTRL_VAD_STATUS:
+        {
+            audio_vad_status_t status;
+            audio_vad_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+
+        case AUDIO_CTRL_LEVELS:
+        {
+            audio_in_levels_t levels;
+            audio_in_get_levels(&levels);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &levels, sizeof(levels));
+            break;
+        }
+
+        case AUDIO_CTRL_PREROLL:
+        {
+            uint32_t preroll_ms = audio_in_get_preroll();
+            U8 reply[2] = { (U8) preroll_ms, (U8) (preroll_ms >> 8) };
+            audio_ctrl_copy_reply(pBuffer, NumBytes, reply, sizeof(reply));
+            break;
+        }
+
+        case AUDIO_CTRL_POOL_STATS:
+        {
+            audio_pool_stats_t stats;
+            audio_pool_get_stats(&stats);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &stats, sizeof(stats));
+            break;
+        }
+
+        case AUDIO_CTRL_CPU_LOAD:
+        {
+            audio_load_stats_t stats;
+            audio_load_get_stats(&stats);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &stats, sizeof(stats));
+            break;
+        }
+
+        case AUDIO_CTRL_TIMESTAMP:
+        {
+            audio_timestamp_status_t status;
+            audio_timestamp_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+
+        case AUDIO_CTRL_WATCHDOG:
+        {
+            audio_watchdog_status_t status;
+            audio_watchdog_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+
+        case AUDIO_CTRL_CLOCK_TRIM:
+        {
+            audio_clock_trim_status_t status;
+            audio_clock_trim_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+
+        case AUDIO_CTRL_BOOT:
+        {
+            audio_boot_status_t status;
+            audio_boot_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+
+        case AUDIO_CTRL_CHANNEL_MATRIX:
+        {
+            audio_matrix_params_t params;
+            audio_matrix_get(&params);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &params, sizeof(params));
+            break;
+        }
+
+#if (AUDIO_RECORDER_ENABLE)
+        case AUDIO_CTRL_RECORDER:
+        {
+            audio_recorder_status_t status;
+            audio_recorder_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+#endif
+
+#if (AUDIO_TRACE_ENABLE)
+        case AUDIO_CTRL_TRACE:
+        {
+            audio_trace_status_t status;
+            audio_trace_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+#endif
+
+#if (AUDIO_CAPTURE_ENABLE)
+        case AUDIO_CTRL_CAPTURE:
+        {
+            audio_capture_status_t status;
+            audio_capture_get_status(&status);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &status, sizeof(status));
+            break;
+        }
+#endif
+
+#if (AUDIO_FACTORY_ENABLE)
+        case AUDIO_CTRL_FACTORY_TEST:
+        {
+            audio_factory_result_t result;
+            audio_factory_get_result(&result);
+            audio_ctrl_copy_reply(pBuffer, NumBytes, &result, sizeof(result));
+            break;
+        }
+#endif
+
+        default:
+            retVal = AUDIO_CTRL_NOT_HANDLED;
+            break;
+    }
+
+    return retVal;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,687 @@
+/*****************************************************************************
+* File Name        : audio_factory.c
+*
+* Description      : This file contains the factory self-test. On command, it captures
+*                    the microphones while a reference tone plays and measures the tone
+*                    level, SNR, THD, THD+N and noise floor of each microphone, and the
+*                    level and phase mismatch between them.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_factory.h"
+
+#if (AUDIO_FACTORY_ENABLE)
+
+#include "audio.h"
+#include "audio_in.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include "rtos.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define FACTORY_SETTLE_FRAMES               (((AUDIO_IN_SAMPLE_FREQ) / 1000u) * (AUDIO_FACTORY_SETTLE_MS))
+#define FACTORY_MEASURE_FRAMES              (((AUDIO_IN_SAMPLE_FREQ) / 1000u) * (AUDIO_FACTORY_MEASURE_MS))
+
+/* Samples summed in single precision before they are added to the double
+ * precision totals. The sine and cosine are computed exactly at the start
+ * of each block and rotated within it. */
+#define FACTORY_BLOCK_FRAMES                (32u)
+
+/* Power of a full scale sine */
+#define FACTORY_FULL_SCALE_POWER            (0.5f * 32768.0f * 32768.0f)
+
+/* Range of the reported levels and ratios, in 1/100 dB */
+#define FACTORY_DB_LIMIT                    (15000)
+
+#define FACTORY_PI                          (3.14159265358979f)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Sine and cosine of a harmonic of the tone, sample by sample */
+typedef struct
+{
+    uint32_t step;                  /* Phase increment, in 1/sample_rate of a cycle */
+    float    step_c;                /* Cosine and sine of the increment */
+    float    step_s;
+    float    c;                     /* Cosine and sine at the current sample */
+    float    s;
+} factory_oscillator_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static audio_factory_result_t factory_result;
+
+/* Captured frames, interleaved left and right */
+static uint16_t factory_samples[(FACTORY_MEASURE_FRAMES) * (AUDIO_IN_NUM_CHANNELS)];
+
+
+/*****************************************************************************
+* Function Name: audio_factory_oscillator_init
+******************************************************************************
+* Summary:
+*  Set up the oscillator of a frequency.
+*
+* Parameters:
+*  osc: Oscillator
+*  frequency: Frequency, in Hz, below sample_rate
+*  sample_rate: Sampling rate, in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_factory_oscillator_init(factory_oscillator_t *osc, uint32_t frequency, uint32_t sample_rate)
+{
+    float angle = (2.0f * FACTORY_PI * (float) frequency) / (float) sample_rate;
+
+    osc->step = frequency;
+    osc->step_c = cosf(angle);
+    osc->step_s = sinf(angle);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_oscillator_seek
+******************************************************************************
+* Summary:
+*  Move the oscillator to a sample. The phase is computed in integer
+*  arithmetic, so it does not drift over the capture.
+*
+* Parameters:
+*  osc: Oscillator
+*  n: Sample
+*  sample_rate: Sampling rate, in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_factory_oscillator_seek(factory_oscillator_t *osc, uint32_t n, uint32_t sample_rate)
+{
+    uint32_t phase = (uint32_t) (((uint64_t) n * osc->step) % sample_rate);
+    float angle = (2.0f * FACTORY_PI * (float) phase) / (float) sample_rate;
+
+    osc->c = cosf(angle);
+    osc->s = sinf(angle);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_oscillator_next
+******************************************************************************
+* Summary:
+*  Advance the oscillator by one sample.
+*
+* Parameters:
+*  osc: Oscillator
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static inline void audio_factory_oscillator_next(factory_oscillator_t *osc)
+{
+    float c = (osc->c * osc->step_c) - (osc->s * osc->step_s);
+
+    osc->s = (osc->s * osc->step_c) + (osc->c * osc->step_s);
+    osc->c = c;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_db
+******************************************************************************
+* Summary:
+*  Convert a power ratio to 1/100 dB.
+*
+* Parameters:
+*  ratio: Power ratio
+*
+* Return:
+*  int16_t: Ratio in 1/100 dB, limited to +/-150 dB
+*
+*****************************************************************************/
+static int16_t audio_factory_db(double ratio)
+{
+    double db = (ratio > 0.0) ? (1000.0 * log10(ratio)) : (double) -FACTORY_DB_LIMIT;
+
+    if (db < (double) -FACTORY_DB_LIMIT)
+    {
+        db = (double) -FACTORY_DB_LIMIT;
+    }
+    else if (db > (double) FACTORY_DB_LIMIT)
+    {
+        db = (double) FACTORY_DB_LIMIT;
+    }
+
+    return (int16_t) lrint(db);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_analyze
+******************************************************************************
+* Summary:
+*  Measure two channels against a tone of known frequency. The tone is
+*  found by a least squares fit of a sine, a cosine and a constant at its
+*  frequency (the IEEE 1057 three parameter fit). The harmonics are fitted
+*  the same way on what the tone leaves. What the tone leaves is the
+*  THD+N, and what the harmonics leave is the noise. The fit does not need
+*  a whole number of cycles, nor a window. Only uses the samples, so it
+*  also runs on the host on synthetic signals.
+*
+* Parameters:
+*  samples: Interleaved left and right frames
+*  num_frames: Number of frames
+*  tone_hz: Frequency of the tone, below sample_rate / 2
+*  sample_rate: Sampling rate, in Hz
+*  result: Destination of the measurements. Only the measurements and the
+*          errors found in the samples are written.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_factory_analyze(const int16_t *samples, uint32_t num_frames, uint32_t tone_hz,
+                           uint32_t sample_rate, audio_factory_result_t *result)
+{
+    factory_oscillator_t osc[AUDIO_FACTORY_NUM_HARMONICS];
+    uint32_t num_harmonics = 0u;
+    double fit[AUDIO_FACTORY_NUM_HARMONICS][AUDIO_IN_NUM_CHANNELS][2];
+    double dc[AUDIO_IN_NUM_CHANNELS];
+    double residual[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+    double noise[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+    float phase[AUDIO_IN_NUM_CHANNELS];
+    bool clipped = false;
+
+    /* Harmonics below the Nyquist frequency, the tone first */
+    while ((num_harmonics < AUDIO_FACTORY_NUM_HARMONICS) &&
+           ((2u * (num_harmonics + 1u) * tone_hz) < sample_rate))
+    {
+        audio_factory_oscillator_init(&osc[num_harmonics], (num_harmonics + 1u) * tone_hz, sample_rate);
+        num_harmonics++;
+    }
+
+    result->frames = num_frames;
+    if ((0u == num_harmonics) || (num_frames < FACTORY_BLOCK_FRAMES))
+    {
+        result->errors |= AUDIO_FACTORY_ERROR_NO_TONE;
+        return;
+    }
+
+    /* Tone: solve the normal equations of d + a cos + b sin */
+    {
+        double sc = 0.0, ss = 0.0, scc = 0.0, sss = 0.0, scs = 0.0;
+        double sx[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+        double sxc[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+        double sxs[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+        double n = (double) num_frames;
+        double det;
+
+        for (uint32_t start = 0u; start < num_frames; start += FACTORY_BLOCK_FRAMES)
+        {
+            uint32_t end = ((start + FACTORY_BLOCK_FRAMES) < num_frames) ? (start + FACTORY_BLOCK_FRAMES) : num_frames;
+            float bc = 0.0f, bs = 0.0f, bcc = 0.0f, bss = 0.0f, bcs = 0.0f;
+            float bx[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+            float bxc[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+            float bxs[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+
+            audio_factory_oscillator_seek(&osc[0], start, sample_rate);
+            for (uint32_t i = start; i < end; i++)
+            {
+                float c = osc[0].c;
+                float s = osc[0].s;
+
+                bc += c;
+                bs += s;
+                bcc += c * c;
+                bss += s * s;
+                bcs += c * s;
+
+                for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+                {
+                    int16_t sample = samples[(i * AUDIO_IN_NUM_CHANNELS) + ch];
+                    float x = (float) sample;
+
+                    clipped |= ((INT16_MAX == sample) || (INT16_MIN == sample));
+                    bx[ch] += x;
+                    bxc[ch] += x * c;
+                    bxs[ch] += x * s;
+                }
+
+                audio_factory_oscillator_next(&osc[0]);
+            }
+
+            sc += bc;
+            ss += bs;
+            scc += bcc;
+            sss += bss;
+            scs += bcs;
+            for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+            {
+                sx[ch] += bx[ch];
+                sxc[ch] += bxc[ch];
+                sxs[ch] += bxs[ch];
+            }
+        }
+
+        /* Cramer's rule on the symmetric 3x3 system */
+        det = (n * ((scc * sss) - (scs * scs))) - (sc * ((sc * sss) - (scs * ss))) + (ss * ((sc * scs) - (scc * ss)));
+
+        for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+        {
+            double x = sx[ch];
+            double xc = sxc[ch];
+            double xs = sxs[ch];
+
+            dc[ch] = ((x * ((scc * sss) - (scs * scs))) - (sc * ((xc * sss) - (scs * xs))) +
+                      (ss * ((xc * scs) - (scc * xs)))) / det;
+            fit[0][ch][0] = ((n * ((xc * sss) - (scs * xs))) - (x * ((sc * sss) - (scs * ss))) +
+                             (ss * ((sc * xs) - (xc * ss)))) / det;
+            fit[0][ch][1] = ((n * ((scc * xs) - (xc * scs))) - (sc * ((sc * xs) - (xc * ss))) +
+                             (x * ((sc * scs) - (scc * ss)))) / det;
+        }
+    }
+
+    /* Harmonics: fit a cos + b sin on what the tone leaves */
+    for (uint32_t h = 1u; h < num_harmonics; h++)
+    {
+        double scc = 0.0, sss = 0.0, scs = 0.0;
+        double src[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+        double srs[AUDIO_IN_NUM_CHANNELS] = { 0.0 };
+        double det;
+
+        for (uint32_t start = 0u; start < num_frames; start += FACTORY_BLOCK_FRAMES)
+        {
+            uint32_t end = ((start + FACTORY_BLOCK_FRAMES) < num_frames) ? (start + FACTORY_BLOCK_FRAMES) : num_frames;
+            float bcc = 0.0f, bss = 0.0f, bcs = 0.0f;
+            float brc[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+            float brs[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+
+            audio_factory_oscillator_seek(&osc[0], start, sample_rate);
+            audio_factory_oscillator_seek(&osc[h], start, sample_rate);
+            for (uint32_t i = start; i < end; i++)
+            {
+                float c = osc[h].c;
+                float s = osc[h].s;
+
+                bcc += c * c;
+                bss += s * s;
+                bcs += c * s;
+
+                for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+                {
+                    float r = (float) samples[(i * AUDIO_IN_NUM_CHANNELS) + ch] - (float) dc[ch] -
+                              ((float) fit[0][ch][0] * osc[0].c) - ((float) fit[0][ch][1] * osc[0].s);
+
+                    brc[ch] += r * c;
+                    brs[ch] += r * s;
+                }
+
+                audio_factory_oscillator_next(&osc[0]);
+                audio_factory_oscillator_next(&osc[h]);
+            }
+
+            scc += bcc;
+            sss += bss;
+            scs += bcs;
+            for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+            {
+                src[ch] += brc[ch];
+                srs[ch] += brs[ch];
+            }
+        }
+
+        det = (scc * sss) - (scs * scs);
+        for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+        {
+            fit[h][ch][0] = ((src[ch] * sss) - (srs[ch] * scs)) / det;
+            fit[h][ch][1] = ((srs[ch] * scc) - (src[ch] * scs)) / det;
+        }
+    }
+
+    /* Power left by the tone, and by the tone and its harmonics */
+    for (uint32_t start = 0u; start < num_frames; start += FACTORY_BLOCK_FRAMES)
+    {
+        uint32_t end = ((start + FACTORY_BLOCK_FRAMES) < num_frames) ? (start + FACTORY_BLOCK_FRAMES) : num_frames;
+        float br[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+        float bn[AUDIO_IN_NUM_CHANNELS] = { 0.0f };
+
+        for (uint32_t h = 0u; h < num_harmonics; h++)
+        {
+            audio_factory_oscillator_seek(&osc[h], start, sample_rate);
+        }
+
+        for (uint32_t i = start; i < end; i++)
+        {
+            for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+            {
+                float r = (float) samples[(i * AUDIO_IN_NUM_CHANNELS) + ch] - (float) dc[ch] -
+                          ((float) fit[0][ch][0] * osc[0].c) - ((float) fit[0][ch][1] * osc[0].s);
+                float e = r;
+
+                for (uint32_t h = 1u; h < num_harmonics; h++)
+                {
+                    e -= ((float) fit[h][ch][0] * osc[h].c) + ((float) fit[h][ch][1] * osc[h].s);
+                }
+
+                br[ch] += r * r;
+                bn[ch] += e * e;
+            }
+
+            for (uint32_t h = 0u; h < num_harmonics; h++)
+            {
+                audio_factory_oscillator_next(&osc[h]);
+            }
+        }
+
+        for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+        {
+            residual[ch] += br[ch];
+            noise[ch] += bn[ch];
+        }
+    }
+
+    for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+    {
+        audio_factory_channel_t *channel = &result->channel[ch];
+        double tone = 0.5 * ((fit[0][ch][0] * fit[0][ch][0]) + (fit[0][ch][1] * fit[0][ch][1]));
+        double harmonics = 0.0;
+        double noise_power = noise[ch] / (double) num_frames;
+
+        for (uint32_t h = 1u; h < num_harmonics; h++)
+        {
+            harmonics += 0.5 * ((fit[h][ch][0] * fit[h][ch][0]) + (fit[h][ch][1] * fit[h][ch][1]));
+        }
+
+        channel->level = audio_factory_db(tone / (double) FACTORY_FULL_SCALE_POWER);
+        channel->noise_floor = audio_factory_db(noise_power / (double) FACTORY_FULL_SCALE_POWER);
+        channel->snr = audio_factory_db(tone / noise_power);
+        channel->thd = audio_factory_db(harmonics / tone);
+        channel->thd_n = audio_factory_db((residual[ch] / (double) num_frames) / tone);
+        channel->dc_offset = (int16_t) lrint(dc[ch]);
+
+        /* a cos + b sin is a cosine advanced by atan2(-b, a) */
+        phase[ch] = atan2f(-(float) fit[0][ch][1], (float) fit[0][ch][0]);
+
+        if (channel->level < (AUDIO_FACTORY_MIN_LEVEL_DBFS * 100))
+        {
+            result->errors |= AUDIO_FACTORY_ERROR_NO_TONE;
+        }
+    }
+
+    {
+        float mismatch = phase[0] - phase[1];
+
+        if (mismatch > FACTORY_PI)
+        {
+            mismatch -= 2.0f * FACTORY_PI;
+        }
+        else if (mismatch < -FACTORY_PI)
+        {
+            mismatch += 2.0f * FACTORY_PI;
+        }
+
+        result->phase_mismatch = (int16_t) lrintf((mismatch * 18000.0f) / FACTORY_PI);
+        result->level_mismatch = (int16_t) (result->channel[0].level - result->channel[1].level);
+    }
+
+    if (clipped)
+    {
+        result->errors |= AUDIO_FACTORY_ERROR_CLIPPED;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_capture
+******************************************************************************
+* Summary:
+*  Read frames from the capture queue as they arrive.
+*
+* Parameters:
+*  buffer: Destination of the interleaved frames, or NULL to drop them
+*  num_frames: Number of frames
+*
+* Return:
+*  bool: false if a host stream started in the meantime
+*
+*****************************************************************************/
+static bool audio_factory_capture(uint16_t *buffer, uint32_t num_frames)
+{
+    uint32_t count = 0u;
+    audio_in_progress_t progress;
+
+    for (;;)
+    {
+        count += audio_in_offline_read((NULL != buffer) ? &buffer[count * AUDIO_IN_NUM_CHANNELS] : NULL,
+                                       num_frames - count);
+        if (count == num_frames)
+        {
+            return true;
+        }
+
+        audio_in_get_progress(&progress);
+        if (progress.streaming)
+        {
+            return false;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(AUDIO_FACTORY_DRAIN_MS));
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_print_db
+******************************************************************************
+* Summary:
+*  Print a value in 1/100 dB on the debug UART.
+*
+* Parameters:
+*  label: Name of the value
+*  value: Value, in 1/100 dB
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_factory_print_db(const char *label, int16_t value)
+{
+    int32_t magnitude = abs((int32_t) value);
+
+    printf(" %s %s%ld.%02ld", label, (value < 0) ? "-" : "",
+           (long) (magnitude / 100), (long) (magnitude % 100));
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_request
+******************************************************************************
+* Summary:
+*  Request a test. The Audio App Task runs it at its next poll.
+*
+* Parameters:
+*  tone_hz: Frequency of the reference tone, 0 for AUDIO_FACTORY_TONE_HZ
+*
+* Return:
+*  bool: false if a test is already requested or running, or the tone is
+*        above the Nyquist frequency
+*
+*****************************************************************************/
+bool audio_factory_request(uint32_t tone_hz)
+{
+    bool valid;
+    uint32_t interrupt_state;
+
+    if (0u == tone_hz)
+    {
+        tone_hz = AUDIO_FACTORY_TONE_HZ;
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    valid = ((2u * tone_hz) < AUDIO_IN_SAMPLE_FREQ) &&
+            (AUDIO_FACTORY_PENDING != factory_result.state) && (AUDIO_FACTORY_RUNNING != factory_result.state);
+    if (valid)
+    {
+        memset(&factory_result, 0, sizeof(factory_result));
+        factory_result.tone_hz = (uint16_t) tone_hz;
+        factory_result.state = AUDIO_FACTORY_PENDING;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return valid;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_poll
+******************************************************************************
+* Summary:
+*  Run a requested test: let the microphones settle, capture them, and
+*  analyze the capture. Blocks the caller for the length of the test. The
+*  test needs the microphones to itself and fails if a host stream is
+*  recording or starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_factory_poll(void)
+{
+    audio_factory_result_t result;
+    audio_in_progress_t progress;
+    uint32_t start_ms;
+
+    if (AUDIO_FACTORY_PENDING != factory_result.state)
+    {
+        return;
+    }
+
+    start_ms = (uint32_t) xTaskGetTickCount() * portTICK_PERIOD_MS;
+    factory_result.state = AUDIO_FACTORY_RUNNING;
+    result = factory_result;
+
+    audio_in_get_progress(&progress);
+    if (progress.streaming)
+    {
+        result.errors |= AUDIO_FACTORY_ERROR_BUSY;
+    }
+    else
+    {
+        bool complete;
+
+        audio_in_offline_enable();
+        complete = audio_factory_capture(NULL, FACTORY_SETTLE_FRAMES) &&
+                   audio_factory_capture(factory_samples, FACTORY_MEASURE_FRAMES);
+        audio_in_offline_disable();
+
+        if (complete)
+        {
+            audio_factory_analyze((const int16_t *) factory_samples, FACTORY_MEASURE_FRAMES, result.tone_hz,
+                                  AUDIO_IN_SAMPLE_FREQ, &result);
+        }
+        else
+        {
+            result.errors |= AUDIO_FACTORY_ERROR_BUSY;
+        }
+    }
+
+    result.duration_ms = ((uint32_t) xTaskGetTickCount() * portTICK_PERIOD_MS) - start_ms;
+    result.state = AUDIO_FACTORY_DONE;
+    factory_result = result;
+
+    printf("APP_LOG: Factory test: %u Hz, %lu ms, errors 0x%02x\r\n",
+           (unsigned int) result.tone_hz, (unsigned long) result.duration_ms, (unsigned int) result.errors);
+    if (0u == (result.errors & AUDIO_FACTORY_ERROR_BUSY))
+    {
+        for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+        {
+            printf("APP_LOG: Factory test: %s:", (0u == ch) ? "left" : "right");
+            audio_factory_print_db("level", result.channel[ch].level);
+            audio_factory_print_db("dBFS, SNR", result.channel[ch].snr);
+            audio_factory_print_db("dB, THD", result.channel[ch].thd);
+            audio_factory_print_db("dB, THD+N", result.channel[ch].thd_n);
+            audio_factory_print_db("dB, noise", result.channel[ch].noise_floor);
+            printf(" dBFS\r\n");
+        }
+        printf("APP_LOG: Factory test: mismatch:");
+        audio_factory_print_db("level", result.level_mismatch);
+        audio_factory_print_db("dB, phase", result.phase_mismatch);
+        printf(" degrees\r\n");
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_factory_get_result
+******************************************************************************
+* Summary:
+*  Return the result of the last test.
+*
+* Parameters:
+*  result: Destination of the result
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_factory_get_result(audio_factory_result_t *result)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *result = factory_result;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+#endif /* AUDIO_FACTORY_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*****************************************************************************
+* File Name        : audio_fifo.c
+*
+* Description      : This file contains the block reads of the PDM-PCM FIFOs
+*                    shared by the PDM-PCM interrupt and the benchmarks.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_fifo.h"
+#include "audio_hot.h"
+#include "cybsp.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Read of a FIFO register. The host tests replace it to pop their model of
+ * the FIFO data register. */
+#ifndef AUDIO_FIFO_READ
+#define AUDIO_FIFO_READ(reg)         (*(reg))
+#endif
+
+
+/*****************************************************************************
+* Function Name: audio_fifo_read
+******************************************************************************
+* Summary:
+*  Read a block of frames from the FIFOs of the left and right channels:
+*  all the words of the left FIFO register, then all those of the right
+*  one. The PDM-PCM interrupt passes the FIFO data registers. A replay and
+*  the benchmarks pass the FIFO status registers instead, as reading an
+*  inactive FIFO is not allowed.
+*
+* Parameters:
+*  left_fifo: FIFO register of the left channel
+*  right_fifo: FIFO register of the right channel
+*  left: Destination of the left samples
+*  right: Destination of the right samples
+*  num_frames: Number of frames to read, at most the level of both FIFOs
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_fifo_read(const volatile uint32_t *left_fifo, const volatile uint32_t *right_fifo,
+                     int16_t *left, int16_t *right, uint32_t num_frames)
+{
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        left[i] = (int16_t) AUDIO_FIFO_READ(left_fifo);
+    }
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        right[i] = (int16_t) AUDIO_FIFO_READ(right_fifo);
+    }
+}
+AUDIO_HOT_FUNC_END
+
+/* [] END OF FILE */
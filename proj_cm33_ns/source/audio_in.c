@@ -40,19 +40,57 @@
 *****************************************************************************/
 #include "audio_in.h"
 #include "audio.h"
+#include "audio_agc.h"
+#include "audio_beamformer.h"
+#include "audio_boot.h"
+#include "audio_capture.h"
+#include "audio_fifo.h"
+#include "audio_hot.h"
+#include "audio_matrix.h"
+#include "audio_offload.h"
+#include "audio_perf.h"
+#include "audio_pool.h"
+#include "audio_profile.h"
+#include "audio_timestamp.h"
+#include "audio_trace.h"
+#include "audio_vad.h"
+#include "audio_watchdog.h"
 #include "emusbdev_audio_config.h"
 #include "retarget_io_init.h"
 #include "rtos.h"
+#include <math.h>
+#include <stdlib.h>
 
 
 /*****************************************************************************
 * Macros
 *****************************************************************************/
-/*Macro to select STEREO or MONO mode */
+/* Layout of the capture queue: 1 interleaves the channels of each frame,
+ * 0 keeps one plane per channel. The packets are interleaved either way. */
+#ifndef AUDIO_DATA_INTERLEAVING
 #define AUDIO_DATA_INTERLEAVING      (1u)
+#endif
 
 #define LSB_MASK                     (0x0000FFFF)
 
+/* Capture queue size in frames. Leaves room for the deepest profile plus
+ * one FIFO trigger worth of frames on top of its target level, and for the
+ * pre-roll history.
+ */
+#define AUDIO_IN_PREROLL_FRAMES_MAX  (((AUDIO_IN_SAMPLE_FREQ) / 1000u) * (AUDIO_IN_PREROLL_MAX_MS))
+#define AUDIO_IN_QUEUE_FRAMES        ((((2u * (AUDIO_PROFILE_MAX_QUEUE_DEPTH)) + 2u) * \
+                                       ((AUDIO_IN_FRAMES_PER_PACKET) + 1u)) + (AUDIO_IN_PREROLL_FRAMES_MAX))
+
+/* Highest usable PDM-PCM FIFO trigger level */
+#define PDM_FIFO_TRIGGER_LEVEL_MAX   (((PDM_FIFO_DEPTH) / 2u) - 1u)
+
+/* Frames read from the PDM-PCM FIFOs in one block: a full FIFO */
+#define AUDIO_IN_DRAIN_BLOCK_FRAMES  (PDM_FIFO_DEPTH)
+
+/* Level metering window, and magnitude counted as a clipped sample */
+#define AUDIO_IN_METER_WINDOW_FRAMES (((AUDIO_IN_SAMPLE_FREQ) * (AUDIO_IN_METER_WINDOW_MS)) / 1000u)
+#define AUDIO_IN_METER_CLIP_LEVEL    (32767u)
+
 /*****************************************************************************
 * Global Variables
 *****************************************************************************/
@@ -124,10 +162,6 @@ const cy_stc_pdm_pcm_channel_config_t pdm_pcm_channel_3_config =
     .dc_block_code = CY_PDM_PCM_CHAN_DCBLOCK_CODE_16,
 };
 
-/* PCM buffer data (16-bits) */
-uint16_t audio_in_pcm_buffer_ping[(MAX_AUDIO_IN_PACKET_SIZE_WORDS)];
-uint16_t audio_in_pcm_buffer_pong[(MAX_AUDIO_IN_PACKET_SIZE_WORDS)];
-
 /* Audio IN flags */
 volatile bool audio_in_start_recording = false;
 volatile bool audio_in_is_recording    = false;
@@ -135,213 +169,1993 @@ volatile bool audio_in_is_recording    = false;
 /* Mic mute status */
 U8 mic_mute;
 
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+/* Mute status of the raw microphone interface */
+U8 raw_mic_mute;
+#endif
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Capture queue filled by the PDM-PCM interrupt and drained by the Audio IN
+ * endpoint callback. The head and tail are free-running frame counters.
+ * Without AUDIO_DATA_INTERLEAVING, the left plane is followed by the right
+ * one.
+ */
+static uint16_t audio_in_queue[(AUDIO_IN_QUEUE_FRAMES) * (AUDIO_IN_NUM_CHANNELS)];
+static volatile uint32_t audio_in_queue_head;
+static volatile uint32_t audio_in_queue_tail;
+
+/* Queue level to maintain, in frames, set by the latency profile */
+static uint32_t audio_in_queue_target = AUDIO_IN_FRAMES_PER_PACKET;
+
+/* Audio IN streaming statistics */
+static audio_in_stats_t audio_in_stats;
+
+/* Alternate setting of the running recording session */
+static volatile U8 audio_in_alt_setting = AUDIO_IN_ALT_STEREO;
+
+/* Set while the VAD gates the processing stages */
+static bool audio_in_gated;
+
+/* Packets handed to the Audio IN endpoint: the one in transfer and the
+ * one queued after it */
+static audio_packet_t *audio_in_usb_packets[2];
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+/* Raw stream of the second capture interface. It reads the capture queue
+ * through its own tail, after the frames read by the PDM-PCM interrupt for
+ * both streams, and skips the processing stages. */
+static volatile bool audio_in_raw_start_recording;
+static volatile bool audio_in_raw_is_recording;
+static volatile uint32_t audio_in_raw_queue_tail;
+static audio_packet_t *audio_in_raw_usb_packets[2];
+static volatile bool audio_in_raw_flush_pending;
+#endif
+
+/* Packet requests of the Audio IN endpoints while recording, watched by the
+ * pipeline watchdog */
+static volatile uint32_t audio_in_requests;
+
+/* Set while the offline recorder reads the capture queue in place of the
+ * microphone interface, when no host is connected */
+static volatile bool audio_in_offline_is_recording;
+
+/* Capture tap: the PDM-PCM interrupt copies every captured frame to pool
+ * packets, independently of the recording streams, and queues them for
+ * the Audio Tap Task, which publishes them to the pool consumers. The
+ * queue head is moved by the interrupt and the tail by the task. */
+static volatile bool audio_in_tap_is_enabled;
+static audio_packet_t *audio_in_tap_packet;
+static audio_packet_t *audio_in_tap_queue[AUDIO_IN_TAP_QUEUE_PACKETS];
+static volatile uint32_t audio_in_tap_head;
+static volatile uint32_t audio_in_tap_tail;
+
+/* Set by the watchdog: the next request restarts the stream from live audio */
+static volatile bool audio_in_flush_pending;
+
+#if (AUDIO_BOOT_FAST)
+/* The host can start a session while audio_in_init() is still running. The
+ * session is held here and started at the end of the init. */
+static volatile bool audio_in_ready;
+static volatile bool audio_in_enable_pending;
+static volatile U8 audio_in_pending_alt_setting;
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+static volatile bool audio_in_raw_enable_pending;
+#endif
+static volatile bool audio_in_tap_enable_pending;
+#endif
+
+/* Audio captured before the start of a session delivered to the host */
+static volatile uint32_t audio_in_preroll_ms = AUDIO_IN_PREROLL_MAX_MS;
+
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+/* Set while the PDM-PCM interrupt has to restart the channels for a new
+ * session, once it has moved the frames in the FIFOs to the history */
+static volatile bool audio_in_restart_pending;
+#endif
+
+/* Level meter accumulators of the current window, per channel, updated by
+ * the PDM-PCM interrupt */
+static uint32_t meter_peak[AUDIO_IN_NUM_CHANNELS];
+static uint64_t meter_sum_squares[AUDIO_IN_NUM_CHANNELS];
+static uint32_t meter_frames;
+
+/* Last completed metering window and clip counters */
+static uint32_t meter_window_peak[AUDIO_IN_NUM_CHANNELS];
+static uint64_t meter_window_sum_squares[AUDIO_IN_NUM_CHANNELS];
+static uint32_t meter_window_frames;
+static uint32_t meter_clips[AUDIO_IN_NUM_CHANNELS];
+
 /*****************************************************************************
 * Static const data
 *****************************************************************************/
-const unsigned char silent_frame[MAX_AUDIO_IN_PACKET_SIZE_BYTES] = {0};
+AUDIO_HOT_CONST unsigned char silent_frame[MAX_AUDIO_IN_PACKET_SIZE_BYTES] = {0};
 
+
+#if (AUDIO_CAPTURE_ENABLE)
 /*****************************************************************************
-* Function Name: audio_in_init
+* Function Name: audio_in_capture_block
 ******************************************************************************
 * Summary:
-*  Initialize the PDM/PCM block and create the "Audio In Task" which will
-*  process the Audio IN endpoint transactions.
+*  Record the frames read from the PDM-PCM FIFOs, left word then right word
+*  of every frame, or replace them with the recorded ones during a replay.
 *
 * Parameters:
-*  None
+*  left: Left samples
+*  right: Right samples
+*  num_frames: Number of frames
 *
 * Return:
 *  None
 *
 *****************************************************************************/
-void audio_in_init(void)
+static inline void audio_in_capture_block(int16_t *left, int16_t *right, uint32_t num_frames)
 {
-    BaseType_t rtos_task_status;
-
-    /* Initialize PDM/PCM block */
-    cy_en_pdm_pcm_status_t status = Cy_PDM_PCM_Init(CYBSP_PDM_HW, &CYBSP_PDM_config);
-    
-    if(CY_PDM_PCM_SUCCESS != status)
+    if (audio_capture_is_replaying())
     {
-        handle_app_error();
+        for (uint32_t i = 0u; i < num_frames; i++)
+        {
+            left[i] = (int16_t) audio_capture_replay_word();
+            right[i] = (int16_t) audio_capture_replay_word();
+        }
     }
-
-    /* Initialize PDM/PCM channel 0 -Left, 1 -Right */
-    /* Enable PDM channel, we will activate channel for record later */
-    Cy_PDM_PCM_Channel_Enable(CYBSP_PDM_HW, LEFT_CH_INDEX);
-    Cy_PDM_PCM_Channel_Enable(CYBSP_PDM_HW, RIGHT_CH_INDEX);
-
-    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &pdm_pcm_channel_2_config, (uint8_t) LEFT_CH_INDEX);
-    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &pdm_pcm_channel_3_config, (uint8_t) RIGHT_CH_INDEX);
-
-    /* Create the AUDIO Write RTOS task */
-    rtos_task_status = xTaskCreate(audio_in_process, "Audio In Task", AUDIO_TASK_STACK_DEPTH, NULL,
-            AUDIO_WRITE_TASK_PRIORITY, &rtos_audio_in_task);
-    if (pdPASS != rtos_task_status)
+    else
     {
-        handle_app_error();
+        for (uint32_t i = 0u; i < num_frames; i++)
+        {
+            audio_capture_record_word((uint32_t) (int32_t) left[i]);
+            audio_capture_record_word((uint32_t) (int32_t) right[i]);
+        }
     }
 }
+#endif
 
 
 /*****************************************************************************
-* Function Name: audio_in_enable
+* Function Name: audio_in_meter
 ******************************************************************************
 * Summary:
-*  Start a recording session.
+*  Account one frame to the level meters.
 *
 * Parameters:
-*  None
+*  left: Left sample
+*  right: Right sample
 *
 * Return:
 *  None
 *
 *****************************************************************************/
-void audio_in_enable(void)
+static inline void audio_in_meter(int16_t left, int16_t right)
 {
-    audio_in_start_recording = true;
-
-    /* Activate recording from channel after init Activate Channel */
-    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
-    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    uint32_t mag_left  = (uint32_t) abs(left);
+    uint32_t mag_right = (uint32_t) abs(right);
 
-    /* Turn ON the kit LED to indicate start of a recording session */
-    Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_ON);
+    meter_peak[0] = (mag_left > meter_peak[0]) ? mag_left : meter_peak[0];
+    meter_peak[1] = (mag_right > meter_peak[1]) ? mag_right : meter_peak[1];
+    meter_sum_squares[0] += mag_left * mag_left;
+    meter_sum_squares[1] += mag_right * mag_right;
+    meter_clips[0] += (mag_left >= AUDIO_IN_METER_CLIP_LEVEL) ? 1u : 0u;
+    meter_clips[1] += (mag_right >= AUDIO_IN_METER_CLIP_LEVEL) ? 1u : 0u;
 }
 
 
 /*****************************************************************************
-* Function Name: audio_in_disable
+* Function Name: audio_in_tap_capture
 ******************************************************************************
 * Summary:
-*  Stop a recording session.
+*  Copy a block of captured frames to the packets of the capture tap, and
+*  queue every complete packet for the Audio Tap Task. The frames that find
+*  no packet or no room in the queue are dropped.
 *
 * Parameters:
-*  None
+*  left: Left samples
+*  right: Right samples
+*  num_frames: Number of frames
+*  position: Capture position of the first frame
 *
 * Return:
 *  None
 *
 *****************************************************************************/
-void audio_in_disable(void)
+static inline void audio_in_tap_capture(const int16_t *left, const int16_t *right, uint32_t num_frames,
+                                        uint32_t position)
 {
-    audio_in_is_recording = false;
+    audio_packet_t *packet = audio_in_tap_packet;
+    uint32_t fill;
 
-    Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
-    Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        if (NULL == packet)
+        {
+            packet = audio_pool_alloc();
+            if (NULL == packet)
+            {
+                break;
+            }
 
-    /* Turn OFF the kit LED to indicate the end of the recording session */
-    Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_OFF);
+            packet->position = position + i;
+            packet->num_frames = 0u;
+            packet->num_channels = AUDIO_IN_NUM_CHANNELS;
+            packet->source = AUDIO_POOL_SOURCE_TAP;
+        }
+
+        fill = packet->num_frames;
+        packet->samples[(fill * AUDIO_IN_NUM_CHANNELS)]      = left[i];
+        packet->samples[(fill * AUDIO_IN_NUM_CHANNELS) + 1u] = right[i];
+        packet->num_frames = (uint16_t) (fill + 1u);
+
+        if ((fill + 1u) == AUDIO_IN_FRAMES_PER_PACKET)
+        {
+            if ((audio_in_tap_head - audio_in_tap_tail) < AUDIO_IN_TAP_QUEUE_PACKETS)
+            {
+                audio_in_tap_queue[audio_in_tap_head % AUDIO_IN_TAP_QUEUE_PACKETS] = packet;
+                __DMB();
+                audio_in_tap_head++;
+            }
+            else
+            {
+                audio_pool_release(packet);
+            }
+            packet = NULL;
+        }
+    }
+
+    audio_in_tap_packet = packet;
 }
 
 
 /*****************************************************************************
-* Function Name: audio_in_process
+* Function Name: audio_in_apply_profile
 ******************************************************************************
 * Summary:
-*  Wrapper task for USBD_AUDIO_Write_Task (audio in endpoint).
+*  Apply the capture parameters of the selected latency profile. Must be
+*  called with the PDM-PCM channels deactivated.
 *
 * Parameters:
-*  arg
+*  None
 *
 * Return:
 *  None
 *
 *****************************************************************************/
-void audio_in_process(void *arg)
+static void audio_in_apply_profile(void)
 {
-    CY_UNUSED_PARAMETER(arg);
+    const audio_profile_t *profile = audio_profile_get();
+    cy_stc_pdm_pcm_channel_config_t channel_config;
+    uint32_t trigger_level = profile->fifo_trigger_level;
 
-    USBD_AUDIO_Write_Task();
+    audio_in_queue_target = profile->queue_depth * AUDIO_IN_FRAMES_PER_PACKET;
 
-    for (;;)
+    /* The interrupt must fire before the queue target is consumed */
+    if (trigger_level >= audio_in_queue_target)
+    {
+        trigger_level = audio_in_queue_target - 1u;
+    }
+    if (trigger_level > PDM_FIFO_TRIGGER_LEVEL_MAX)
     {
+        trigger_level = PDM_FIFO_TRIGGER_LEVEL_MAX;
     }
+
+    channel_config = pdm_pcm_channel_2_config;
+    channel_config.rxFifoTriggerLevel = trigger_level;
+    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &channel_config, (uint8_t) LEFT_CH_INDEX);
+
+    channel_config = pdm_pcm_channel_3_config;
+    channel_config.rxFifoTriggerLevel = trigger_level;
+    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &channel_config, (uint8_t) RIGHT_CH_INDEX);
+
+    Cy_PDM_PCM_Channel_ClearInterrupt(CYBSP_PDM_HW, RIGHT_CH_INDEX,
+                                      CY_PDM_PCM_INTR_RX_TRIGGER | CY_PDM_PCM_INTR_RX_OVERFLOW);
+    Cy_PDM_PCM_Channel_SetInterruptMask(CYBSP_PDM_HW, RIGHT_CH_INDEX,
+                                        CY_PDM_PCM_INTR_RX_TRIGGER | CY_PDM_PCM_INTR_RX_OVERFLOW);
 }
 
 
 /*****************************************************************************
-* Function Name: audio_in_endpoint_callback
+* Function Name: audio_in_pdm_interrupt_handler
 ******************************************************************************
 * Summary:
-*  Callback called in the context of USBD_AUDIO_Write_Task.
-*  Handles data sent to the host (IN direction).
+*  PDM-PCM FIFO trigger interrupt. Moves the captured frames of both
+*  channels from the hardware FIFOs into the capture queue.
 *
 * Parameters:
-*  pUserContext: User context which is passed to the callback.
-*  ppNextBuffer: Buffer containing audio samples which should match the
-*                configuration from microphone USBD_AUDIO_IF_CONF.
-*  pNextPacketSize: Size of the next buffer.
+*  None
 *
 * Return:
 *  None
 *
 *****************************************************************************/
-void audio_in_endpoint_callback(void *pUserContext,
-                                const U8 **ppNextBuffer,
-                                U32 *pNextPacketSize)
+AUDIO_HOT_FUNC_BEGIN
+static void audio_in_pdm_interrupt_handler(void)
 {
-    static uint16_t *audio_in_pcm_buffer = NULL;
+    uint32_t intr_status = Cy_PDM_PCM_Channel_GetInterruptStatusMasked(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    uint32_t num_frames  = Cy_PDM_PCM_Channel_GetNumInFifo(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    uint32_t left_frames = Cy_PDM_PCM_Channel_GetNumInFifo(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    uint32_t head        = audio_in_queue_head;
+    uint32_t free_frames;
+    uint32_t index       = head % (AUDIO_IN_QUEUE_FRAMES);
+    uint32_t cycles      = DWT->CYCCNT;
+    const volatile uint32_t *left_fifo  = &PDM_PCM_CH_RX_FIFO_RD(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    const volatile uint32_t *right_fifo = &PDM_PCM_CH_RX_FIFO_RD(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    uint32_t block_frames;
+    uint32_t store_frames;
+    int16_t left[AUDIO_IN_DRAIN_BLOCK_FRAMES];
+    int16_t right[AUDIO_IN_DRAIN_BLOCK_FRAMES];
 
-    CY_UNUSED_PARAMETER(pUserContext);
+    AUDIO_TRACE_ISR_ENTER(AUDIO_TRACE_ISR_PDM);
 
-    if (audio_in_start_recording)
+    if (left_frames < num_frames)
     {
-        audio_in_start_recording = false;
-        audio_in_is_recording = true;
+        num_frames = left_frames;
+    }
+
+#if (AUDIO_CAPTURE_ENABLE)
+    if (audio_capture_is_replaying())
+    {
+        /* Drain the recorded FIFO event instead of the FIFOs. The block
+         * reads still run, on the status registers. */
+        intr_status = 0u;
+        num_frames = audio_capture_replay_fifo();
+        left_fifo = &PDM_PCM_CH_RX_FIFO_STATUS(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        right_fifo = &PDM_PCM_CH_RX_FIFO_STATUS(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+    else
+    {
+        audio_capture_record_fifo(num_frames);
+    }
+#endif
 
-        /* Clear Audio In buffer */
-        memset(audio_in_pcm_buffer_ping, 0, (MAX_AUDIO_IN_PACKET_SIZE_BYTES));
-        memset(audio_in_pcm_buffer_pong, 0, (MAX_AUDIO_IN_PACKET_SIZE_BYTES));
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+    /* Between sessions the queue holds the pre-roll history: the newest
+     * frames replace the oldest ones */
+    if ((!audio_in_is_recording) && (!audio_in_offline_is_recording) &&
+        (((head - audio_in_queue_tail) + num_frames) > (AUDIO_IN_QUEUE_FRAMES)))
+    {
+        audio_in_queue_tail = (head + num_frames) - (AUDIO_IN_QUEUE_FRAMES);
+    }
+#else
+    /* The microphones may run for the raw stream or the capture tap only:
+     * the microphone interface does not hold on to any frame between
+     * sessions */
+    if ((!audio_in_is_recording) && (!audio_in_offline_is_recording))
+    {
+        audio_in_queue_tail = head;
+    }
+#endif
 
-        audio_in_pcm_buffer = audio_in_pcm_buffer_ping;
+    free_frames = (AUDIO_IN_QUEUE_FRAMES) - (head - audio_in_queue_tail);
 
-        /* Start a transfer to the Audio IN endpoint */
-        *ppNextBuffer = (uint8_t *) audio_in_pcm_buffer;
-        *pNextPacketSize = MAX_AUDIO_IN_PACKET_SIZE_BYTES;
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    /* Keep the frames until both streams have read them */
+    if (audio_in_raw_is_recording &&
+        (((AUDIO_IN_QUEUE_FRAMES) - (head - audio_in_raw_queue_tail)) < free_frames))
+    {
+        free_frames = (AUDIO_IN_QUEUE_FRAMES) - (head - audio_in_raw_queue_tail);
     }
-    else if (audio_in_is_recording) /* Check if should keep recording */
+#endif
+
+    if (0u != (intr_status & CY_PDM_PCM_INTR_RX_OVERFLOW))
     {
-        if (audio_in_pcm_buffer == audio_in_pcm_buffer_ping)
+        audio_in_stats.fifo_overflows++;
+    }
+
+    /* Read audio data from PDM-PCM FIFO, one block at a time */
+    for (uint32_t done = 0u; done < num_frames; done += block_frames)
+    {
+        block_frames = num_frames - done;
+        if (block_frames > (AUDIO_IN_DRAIN_BLOCK_FRAMES))
         {
-            audio_in_pcm_buffer = audio_in_pcm_buffer_pong;
+            block_frames = AUDIO_IN_DRAIN_BLOCK_FRAMES;
         }
-        else
+
+        audio_fifo_read(left_fifo, right_fifo, left, right, block_frames);
+#if (AUDIO_CAPTURE_ENABLE)
+        audio_in_capture_block(left, right, block_frames);
+#endif
+
+#if (AUDIO_CAPTURE_ENABLE)
+        /* A replay only runs the recorded streams */
+        if (audio_in_tap_is_enabled && (!audio_capture_is_replaying()))
+#else
+        if (audio_in_tap_is_enabled)
+#endif
         {
-            audio_in_pcm_buffer = audio_in_pcm_buffer_ping;
+            audio_in_tap_capture(left, right, block_frames, head + done);
         }
-        
-        /* Read audio data from PDM-PCM FIFO */
-        for(uint8_t i=0; i < MAX_AUDIO_IN_PACKET_SIZE_WORDS; i++)
+
+        /* Drop the frames beyond the free space if the consumer fell behind */
+        store_frames = (free_frames > done) ? (free_frames - done) : 0u;
+        if (store_frames > block_frames)
+        {
+            store_frames = block_frames;
+        }
+
+        for (uint32_t i = 0u; i < store_frames; i++)
         {
-            int32_t data = (int32_t) Cy_PDM_PCM_Channel_ReadFifo(CYBSP_PDM_HW, LEFT_CH_INDEX);
+            /* Level metering of the microphones */
+            audio_in_meter(left[i], right[i]);
 
             #if AUDIO_DATA_INTERLEAVING
-            *(audio_in_pcm_buffer + i++) = (uint16_t) (data);
+            audio_in_queue[(index * AUDIO_IN_NUM_CHANNELS)]      = (uint16_t) left[i];
+            audio_in_queue[(index * AUDIO_IN_NUM_CHANNELS) + 1u] = (uint16_t) right[i];
             #else
-                audio_data_left[l] = (int16_t) (data);
+            audio_in_queue[index]                            = (uint16_t) left[i];
+            audio_in_queue[(AUDIO_IN_QUEUE_FRAMES) + index]  = (uint16_t) right[i];
             #endif
 
-            data = (int32_t) Cy_PDM_PCM_Channel_ReadFifo(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+            if (++index == (AUDIO_IN_QUEUE_FRAMES))
+            {
+                index = 0u;
+            }
+        }
 
-            #if AUDIO_DATA_INTERLEAVING
-            *(audio_in_pcm_buffer + i) = (uint16_t) (data);
-            #else
-                audio_data_right[l] = (int16_t) (data);
-            #endif
+        /* The dropped frames are metered too */
+        for (uint32_t i = store_frames; i < block_frames; i++)
+        {
+            audio_in_meter(left[i], right[i]);
         }
-        if (mic_mute)
+    }
+
+    /* Latch the metering window once complete */
+    meter_frames += num_frames;
+    if (meter_frames >= AUDIO_IN_METER_WINDOW_FRAMES)
+    {
+        for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
         {
-            /* Send silent frames in case of mute */
-            *ppNextBuffer = silent_frame;
+            meter_window_peak[ch] = meter_peak[ch];
+            meter_window_sum_squares[ch] = meter_sum_squares[ch];
+            meter_peak[ch] = 0u;
+            meter_sum_squares[ch] = 0u;
         }
-        else
+        meter_window_frames = meter_frames;
+        meter_frames = 0u;
+    }
+
+    if (num_frames > free_frames)
+    {
+        audio_in_stats.overruns += (num_frames - free_frames);
+        num_frames = free_frames;
+    }
+
+    /* Publish the frames only once they are in the queue */
+    __DMB();
+    audio_in_queue_head = head + num_frames;
+
+    /* The newest frame has just been read from the FIFO */
+    if (0u != num_frames)
+    {
+        audio_timestamp_capture(head + num_frames - 1u, cycles);
+    }
+
+    Cy_PDM_PCM_Channel_ClearInterrupt(CYBSP_PDM_HW, RIGHT_CH_INDEX, intr_status);
+
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+    if (audio_in_restart_pending)
+    {
+        /* The FIFOs are in the history: restart the channels with the
+         * settings of the profile */
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+        audio_in_apply_profile();
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+        audio_in_restart_pending = false;
+    }
+#endif
+
+    AUDIO_TRACE_ISR_EXIT(AUDIO_TRACE_ISR_PDM);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_in_queue_read
+******************************************************************************
+* Summary:
+*  Copy frames out of the capture queue and release them to the PDM-PCM
+*  interrupt.
+*
+* Parameters:
+*  buffer: Destination of the interleaved frames
+*  tail: Capture queue tail read by the caller
+*  num_frames: Number of frames to copy, at most the queue level
+*  queue_tail: Capture queue tail of the stream, advanced past the frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static void audio_in_queue_read(uint16_t *buffer, uint32_t tail, uint32_t num_frames,
+                                volatile uint32_t *queue_tail)
+{
+    uint32_t index = tail % (AUDIO_IN_QUEUE_FRAMES);
+#if AUDIO_DATA_INTERLEAVING
+    uint32_t first = (AUDIO_IN_QUEUE_FRAMES) - index;
+
+    /* The frames may wrap around the end of the queue */
+    if (first > num_frames)
+    {
+        first = num_frames;
+    }
+
+    memcpy(buffer, &audio_in_queue[index * AUDIO_IN_NUM_CHANNELS],
+           first * AUDIO_IN_FRAME_SIZE_BYTES);
+    memcpy(buffer + (first * AUDIO_IN_NUM_CHANNELS), audio_in_queue,
+           (num_frames - first) * AUDIO_IN_FRAME_SIZE_BYTES);
+#else
+    const uint16_t *left = audio_in_queue;
+    const uint16_t *right = &audio_in_queue[AUDIO_IN_QUEUE_FRAMES];
+
+    /* Interleave the planes into the packet */
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        buffer[(i * AUDIO_IN_NUM_CHANNELS)]      = left[index];
+        buffer[(i * AUDIO_IN_NUM_CHANNELS) + 1u] = right[index];
+
+        if (++index == (AUDIO_IN_QUEUE_FRAMES))
+        {
+            index = 0u;
+        }
+    }
+#endif
+
+    __DMB();
+    *queue_tail = tail + num_frames;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_in_queue_read_mono
+******************************************************************************
+* Summary:
+*  Copy the mono channel of the mono alternate setting out of the capture
+*  queue, built from the microphones by the channel matrix, and release the
+*  frames to the PDM-PCM interrupt. Only the mono samples are written.
+*
+* Parameters:
+*  buffer: Destination of the mono samples
+*  tail: Capture queue tail read by the caller
+*  num_frames: Number of frames to copy, at most the queue level
+*  queue_tail: Capture queue tail of the stream, advanced past the frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static void audio_in_queue_read_mono(int16_t *buffer, uint32_t tail, uint32_t num_frames,
+                                     volatile uint32_t *queue_tail)
+{
+    const int16_t *queue = (const int16_t *) audio_in_queue;
+    uint32_t index = tail % (AUDIO_IN_QUEUE_FRAMES);
+    uint32_t first = (AUDIO_IN_QUEUE_FRAMES) - index;
+
+    /* The frames may wrap around the end of the queue */
+    if (first > num_frames)
+    {
+        first = num_frames;
+    }
+
+#if AUDIO_DATA_INTERLEAVING
+    audio_matrix_downmix(buffer, &queue[index * AUDIO_IN_NUM_CHANNELS],
+                         &queue[(index * AUDIO_IN_NUM_CHANNELS) + 1u], AUDIO_IN_NUM_CHANNELS, first);
+    audio_matrix_downmix(buffer + first, &queue[0], &queue[1], AUDIO_IN_NUM_CHANNELS, num_frames - first);
+#else
+    audio_matrix_downmix(buffer, &queue[index], &queue[(AUDIO_IN_QUEUE_FRAMES) + index], 1u, first);
+    audio_matrix_downmix(buffer + first, &queue[0], &queue[AUDIO_IN_QUEUE_FRAMES], 1u, num_frames - first);
+#endif
+
+    __DMB();
+    *queue_tail = tail + num_frames;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_in_packet_frames
+******************************************************************************
+* Summary:
+*  Number of frames to send in the next packet. The endpoints are
+*  asynchronous: they follow the PDM rate by sending one frame more or less
+*  when the queue runs ahead of or behind its target level. A backlog, such
+*  as the pre-roll, is sent with up to AUDIO_IN_CATCHUP_FRAMES more frames
+*  per packet.
+*
+* Parameters:
+*  queue_level: Frames in the capture queue for the stream
+*
+* Return:
+*  uint32_t: Number of frames, possibly more than the queue level
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static uint32_t audio_in_packet_frames(uint32_t queue_level)
+{
+    uint32_t num_frames = AUDIO_IN_FRAMES_PER_PACKET;
+
+    if (queue_level > (audio_in_queue_target + AUDIO_IN_FRAMES_PER_PACKET))
+    {
+        uint32_t backlog = queue_level - (audio_in_queue_target + AUDIO_IN_FRAMES_PER_PACKET);
+
+        if (backlog > AUDIO_IN_CATCHUP_FRAMES)
         {
-        /* Send captured audio samples to the Audio IN endpoint */
-            *ppNextBuffer = (uint8_t *) audio_in_pcm_buffer;
+            backlog = AUDIO_IN_CATCHUP_FRAMES;
         }
-        *pNextPacketSize = MAX_AUDIO_IN_PACKET_SIZE_BYTES;
+        num_frames += 1u + backlog;
+    }
+    else if ((queue_level < audio_in_queue_target) && (num_frames > 1u))
+    {
+        num_frames--;
+    }
+
+    return num_frames;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_in_release_usb_packet
+******************************************************************************
+* Summary:
+*  Release the oldest packet handed to an Audio IN endpoint, which has
+*  been sent, and make room for the next one.
+*
+* Parameters:
+*  usb_packets: Packets held by the endpoint
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static void audio_in_release_usb_packet(audio_packet_t *usb_packets[2])
+{
+    if (NULL != usb_packets[0])
+    {
+        audio_pool_release(usb_packets[0]);
     }
+
+    usb_packets[0] = usb_packets[1];
+    usb_packets[1] = NULL;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_in_tap_task
+******************************************************************************
+* Summary:
+*  Audio Tap Task: every AUDIO_IN_TAP_PERIOD_MS, stamp the packets queued
+*  by the capture tap with the timing of their first frame, publish them to
+*  the pool consumers, and release them.
+*
+* Parameters:
+*  arg: Unused
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_tap_task(void *arg)
+{
+    audio_packet_t *packet;
+    uint32_t tail;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(AUDIO_IN_TAP_PERIOD_MS));
+
+        for (tail = audio_in_tap_tail; tail != audio_in_tap_head; tail++)
+        {
+            packet = audio_in_tap_queue[tail % AUDIO_IN_TAP_QUEUE_PACKETS];
+            __DMB();
+            audio_in_tap_tail = tail + 1u;
+
+            audio_timestamp_stamp(packet->position, &packet->capture_cycles, &packet->usb_time);
+            audio_pool_publish(packet);
+            audio_pool_release(packet);
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_init
+******************************************************************************
+* Summary:
+*  Initialize the PDM/PCM block and create the "Audio In Task" which will
+*  process the Audio IN endpoint transactions.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_init(void)
+{
+    BaseType_t rtos_task_status;
+#if (AUDIO_BOOT_FAST)
+    uint32_t interrupt_state;
+#endif
+
+    /* Interrupt configuration structure for the PDM-PCM FIFO trigger */
+    cy_stc_sysint_t pdm_intr_cfg =
+    {
+        .intrSrc = PDM_IRQ,
+        .intrPriority = PDM_IRQ_PRIORITY
+    };
+
+    /* Initialize PDM/PCM block */
+    cy_en_pdm_pcm_status_t status = Cy_PDM_PCM_Init(CYBSP_PDM_HW, &CYBSP_PDM_config);
+    
+    if(CY_PDM_PCM_SUCCESS != status)
+    {
+        handle_app_error();
+    }
+
+    /* Initialize PDM/PCM channel 0 -Left, 1 -Right */
+    /* Enable PDM channel, we will activate channel for record later */
+    Cy_PDM_PCM_Channel_Enable(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    Cy_PDM_PCM_Channel_Enable(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+
+    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &pdm_pcm_channel_2_config, (uint8_t) LEFT_CH_INDEX);
+    Cy_PDM_PCM_Channel_Init(CYBSP_PDM_HW, &pdm_pcm_channel_3_config, (uint8_t) RIGHT_CH_INDEX);
+
+    /* Compute the beamformer filters ahead of the first session */
+    audio_beamformer_init();
+    audio_agc_init();
+    audio_vad_init();
+    audio_matrix_init();
+    audio_timestamp_init();
+
+    /* Open the mailbox to the processing stages running on the CM55 */
+    audio_offload_init();
+
+    /* Packets shared by the USB endpoint and the other consumers */
+    audio_pool_init();
+
+    /* Both channels run in lockstep: the right channel trigger drains both */
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&pdm_intr_cfg, audio_in_pdm_interrupt_handler))
+    {
+        handle_app_error();
+    }
+    NVIC_EnableIRQ(pdm_intr_cfg.intrSrc);
+
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+    /* Capture all the time to keep the pre-roll history filled */
+    audio_in_apply_profile();
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+#endif
+
+    /* Create the AUDIO Write RTOS task */
+    rtos_task_status = xTaskCreate(audio_in_process, "Audio In Task", AUDIO_TASK_STACK_DEPTH, NULL,
+            AUDIO_WRITE_TASK_PRIORITY, &rtos_audio_in_task);
+    if (pdPASS != rtos_task_status)
+    {
+        handle_app_error();
+    }
+
+    rtos_task_status = xTaskCreate(audio_in_tap_task, "Audio Tap Task", AUDIO_TASK_STACK_DEPTH, NULL,
+                                   AUDIO_TAP_TASK_PRIORITY, NULL);
+    if (pdPASS != rtos_task_status)
+    {
+        handle_app_error();
+    }
+
+    /* Start the spectrum analyzer if it is enabled at startup */
+    audio_offload_apply_stages();
+
+#if (AUDIO_BOOT_FAST)
+    /* Start the sessions the host opened during the init */
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    audio_in_ready = true;
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    if (audio_in_raw_enable_pending)
+    {
+        audio_in_raw_enable_pending = false;
+        audio_in_raw_enable();
+    }
+#endif
+    if (audio_in_enable_pending)
+    {
+        audio_in_enable_pending = false;
+        audio_in_enable(audio_in_pending_alt_setting);
+    }
+    if (audio_in_tap_enable_pending)
+    {
+        audio_in_tap_enable_pending = false;
+        audio_in_tap_enable();
+    }
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_enable
+******************************************************************************
+* Summary:
+*  Start a recording session.
+*
+* Parameters:
+*  alt_setting: Alternate setting of the microphone interface selected by
+*               the host
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_enable(U8 alt_setting)
+{
+    bool restart = true;
+
+    audio_boot_mark(AUDIO_BOOT_STREAM_START);
+
+#if (AUDIO_BOOT_FAST)
+    if (!audio_in_ready)
+    {
+        audio_in_pending_alt_setting = alt_setting;
+        audio_in_enable_pending = true;
+        return;
+    }
+#endif
+
+    audio_in_alt_setting = alt_setting;
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    /* Keep the microphones running under the raw stream. The latency
+     * profile then applies from their next restart. */
+    restart = !audio_in_raw_is_recording;
+#endif
+
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+    if (restart)
+    {
+        /* The frames in the FIFOs go to the pre-roll history before the
+         * channels restart. This runs in the USB interrupt, which may
+         * have preempted the PDM-PCM interrupt: let the PDM-PCM interrupt
+         * do both. The session starts once it has. */
+        audio_in_restart_pending = true;
+        NVIC_SetPendingIRQ(PDM_IRQ);
+    }
+
+    audio_in_start_recording = true;
+#else
+    if (restart)
+    {
+        /* Some hosts restart a session without stopping it first */
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+
+        /* Latch the latency profile for this session */
+        audio_in_apply_profile();
+    }
+
+    audio_in_start_recording = true;
+
+    if (restart)
+    {
+        /* Activate recording from channel after init Activate Channel */
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+
+    /* Turn ON the kit LED to indicate start of a recording session */
+    Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_ON);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_disable
+******************************************************************************
+* Summary:
+*  Stop a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_disable(void)
+{
+#if (AUDIO_BOOT_FAST)
+    if (!audio_in_ready)
+    {
+        audio_in_enable_pending = false;
+        return;
+    }
+#endif
+
+    audio_in_is_recording = false;
+    audio_offload_stop();
+
+#if (AUDIO_CAPTURE_ENABLE)
+    audio_capture_session_end();
+#endif
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    if ((!audio_in_raw_is_recording) && (!audio_in_offline_is_recording) && (!audio_in_tap_is_enabled))
+#else
+    if ((!audio_in_offline_is_recording) && (!audio_in_tap_is_enabled))
+#endif
+    {
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+
+    /* Turn OFF the kit LED to indicate the end of the recording session */
+    Cy_GPIO_Write(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN, CYBSP_LED_STATE_OFF);
+}
+
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+/*****************************************************************************
+* Function Name: audio_in_raw_enable
+******************************************************************************
+* Summary:
+*  Start a recording session on the raw microphone interface.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_raw_enable(void)
+{
+    audio_boot_mark(AUDIO_BOOT_STREAM_START);
+
+#if (AUDIO_BOOT_FAST)
+    if (!audio_in_ready)
+    {
+        audio_in_raw_enable_pending = true;
+        return;
+    }
+#endif
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_raw_is_recording ||
+          audio_in_offline_is_recording || audio_in_tap_is_enabled))
+    {
+        /* The microphones only run while a stream is recording */
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+        audio_in_apply_profile();
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+
+    audio_in_raw_start_recording = true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_raw_disable
+******************************************************************************
+* Summary:
+*  Stop a recording session on the raw microphone interface.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_raw_disable(void)
+{
+#if (AUDIO_BOOT_FAST)
+    if (!audio_in_ready)
+    {
+        audio_in_raw_enable_pending = false;
+        return;
+    }
+#endif
+
+    audio_in_raw_is_recording = false;
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_offline_is_recording ||
+          audio_in_tap_is_enabled))
+    {
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+}
+#endif
+
+
+/*****************************************************************************
+* Function Name: audio_in_offline_enable
+******************************************************************************
+* Summary:
+*  Start a recording session of the offline recorder, which reads the
+*  capture queue in place of the microphone interface. Also used by the
+*  factory self-test. Only called while no host stream is recording.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_offline_enable(void)
+{
+    uint32_t interrupt_state;
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+    /* The microphones only run while a stream is recording */
+    Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    audio_in_apply_profile();
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+#endif
+
+    /* Start from live audio */
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    audio_in_queue_tail = audio_in_queue_head;
+    audio_in_offline_is_recording = true;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_offline_disable
+******************************************************************************
+* Summary:
+*  Stop the recording session of the offline recorder.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_offline_disable(void)
+{
+    audio_in_offline_is_recording = false;
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_raw_is_recording ||
+          audio_in_tap_is_enabled))
+#else
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_tap_is_enabled))
+#endif
+    {
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_offline_read
+******************************************************************************
+* Summary:
+*  Copy the captured frames out of the capture queue for the offline
+*  recorder, and release them to the PDM-PCM interrupt. Never waits.
+*
+* Parameters:
+*  buffer: Destination of the interleaved frames, or NULL to drop them
+*  max_frames: Most frames to copy
+*
+* Return:
+*  uint32_t: Number of frames copied or dropped
+*
+*****************************************************************************/
+uint32_t audio_in_offline_read(uint16_t *buffer, uint32_t max_frames)
+{
+    uint32_t tail = audio_in_queue_tail;
+    uint32_t num_frames = audio_in_queue_head - tail;
+
+    if (num_frames > max_frames)
+    {
+        num_frames = max_frames;
+    }
+
+    if (NULL != buffer)
+    {
+        audio_in_queue_read(buffer, tail, num_frames, &audio_in_queue_tail);
+    }
+    else
+    {
+        audio_in_queue_tail = tail + num_frames;
+    }
+
+    return num_frames;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_tap_enable
+******************************************************************************
+* Summary:
+*  Start the capture tap: every captured frame of both microphones is
+*  published to the pool consumers as AUDIO_POOL_SOURCE_TAP packets, before
+*  the processing stages and whether a host records or not. The microphones
+*  keep running while the tap is enabled.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_tap_enable(void)
+{
+#if (AUDIO_BOOT_FAST)
+    if (!audio_in_ready)
+    {
+        audio_in_tap_enable_pending = true;
+        return;
+    }
+#endif
+
+    if (audio_in_tap_is_enabled)
+    {
+        return;
+    }
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_raw_is_recording ||
+          audio_in_offline_is_recording))
+#else
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_offline_is_recording))
+#endif
+    {
+        /* The microphones only run while the capture is in use */
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+        audio_in_apply_profile();
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+
+    audio_in_tap_is_enabled = true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_tap_disable
+******************************************************************************
+* Summary:
+*  Stop the capture tap. The packets already queued are still published.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_tap_disable(void)
+{
+    audio_packet_t *packet;
+    uint32_t interrupt_state;
+
+#if (AUDIO_BOOT_FAST)
+    if (!audio_in_ready)
+    {
+        audio_in_tap_enable_pending = false;
+        return;
+    }
+#endif
+
+    /* Return the packet being filled to the pool */
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    audio_in_tap_is_enabled = false;
+    packet = audio_in_tap_packet;
+    audio_in_tap_packet = NULL;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    if (NULL != packet)
+    {
+        audio_pool_release(packet);
+    }
+
+#if (AUDIO_IN_PREROLL_MAX_MS == 0u)
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_raw_is_recording ||
+          audio_in_offline_is_recording))
+#else
+    if (!(audio_in_is_recording || audio_in_start_recording || audio_in_offline_is_recording))
+#endif
+    {
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+        Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    }
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_process
+******************************************************************************
+* Summary:
+*  Wrapper task for USBD_AUDIO_Write_Task (audio in endpoints). The write
+*  task serves the Audio IN endpoints of every capture interface. It only
+*  returns on a failure: the task then reports it to the pipeline watchdog
+*  and blocks until the watchdog restarts the stream.
+*
+* Parameters:
+*  arg
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_process(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        USBD_AUDIO_Write_Task();
+
+        audio_watchdog_write_task_returned();
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_endpoint_callback
+******************************************************************************
+* Summary:
+*  Callback called in the context of USBD_AUDIO_Write_Task.
+*  Handles data sent to the host (IN direction).
+*
+* Parameters:
+*  pUserContext: User context which is passed to the callback.
+*  ppNextBuffer: Buffer containing audio samples which should match the
+*                configuration from microphone USBD_AUDIO_IF_CONF.
+*  pNextPacketSize: Size of the next buffer.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_in_endpoint_callback(void *pUserContext,
+                                const U8 **ppNextBuffer,
+                                U32 *pNextPacketSize)
+{
+    static bool audio_in_queue_primed = false;
+    uint32_t frame_size = (AUDIO_IN_ALT_STEREO == audio_in_alt_setting) ?
+                          AUDIO_IN_FRAME_SIZE_BYTES : AUDIO_IN_SUB_FRAME_SIZE;
+
+    CY_UNUSED_PARAMETER(pUserContext);
+
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+    if (audio_in_start_recording && audio_in_restart_pending)
+    {
+        /* The PDM-PCM interrupt has not restarted the channels yet */
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = AUDIO_IN_FRAMES_PER_PACKET * frame_size;
+    }
+    else
+#endif
+    if (audio_in_start_recording)
+    {
+        audio_in_start_recording = false;
+
+        NVIC_DisableIRQ(PDM_IRQ);
+#if (AUDIO_IN_PREROLL_MAX_MS > 0u)
+        {
+            /* Start the session with the pre-roll history. The queue then
+             * holds more than its target level and the packets catch up
+             * to live audio. */
+            uint32_t preroll_frames = ((AUDIO_IN_SAMPLE_FREQ) / 1000u) * audio_in_preroll_ms;
+            uint32_t history_frames = audio_in_queue_head - audio_in_queue_tail;
+
+            if (history_frames > preroll_frames)
+            {
+                audio_in_queue_tail = audio_in_queue_head - preroll_frames;
+            }
+        }
+#else
+        /* Restart the capture queue from empty. The head keeps running for
+         * the raw stream. */
+        audio_in_queue_tail = audio_in_queue_head;
+#endif
+        audio_in_queue_primed = false;
+        audio_in_is_recording = true;
+#if (AUDIO_CAPTURE_ENABLE)
+        audio_capture_session_start(audio_in_alt_setting, audio_in_queue_target);
+#endif
+        NVIC_EnableIRQ(PDM_IRQ);
+
+        audio_beamformer_reset();
+        audio_agc_reset();
+        audio_vad_reset();
+        audio_offload_start();
+        audio_in_gated = false;
+
+        /* The USB time of the session starts at its first request */
+        audio_timestamp_start(DWT->CYCCNT);
+
+        /* Return the packets of the previous session to the pool */
+        audio_in_release_usb_packet(audio_in_usb_packets);
+        audio_in_release_usb_packet(audio_in_usb_packets);
+
+        /* Start a transfer to the Audio IN endpoint */
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = AUDIO_IN_FRAMES_PER_PACKET * frame_size;
+    }
+    else if (audio_in_is_recording) /* Check if should keep recording */
+    {
+        uint32_t num_frames;
+        uint32_t tail = audio_in_queue_tail;
+        uint32_t queue_level = audio_in_queue_head - tail;
+        audio_packet_t *packet = NULL;
+        uint16_t *audio_in_pcm_buffer;
+        uint32_t num_channels = AUDIO_IN_NUM_CHANNELS;
+#if (AUDIO_CAPTURE_ENABLE)
+        bool capture_packet;
+        uint32_t interrupt_state;
+
+        /* Record the request together with the queue level it sees */
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        capture_packet = audio_capture_record_packet();
+        queue_level = audio_in_queue_head - tail;
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+#endif
+
+        AUDIO_PERF_BEGIN(perf_start);
+        AUDIO_TRACE_BEGIN(AUDIO_TRACE_ID_CALLBACK, queue_level);
+
+        /* The oldest packet handed to the endpoint has been sent */
+        audio_in_release_usb_packet(audio_in_usb_packets);
+
+        audio_in_requests++;
+        if (audio_in_flush_pending)
+        {
+            /* Drop the backlog left by a stall, and prime again */
+            audio_in_flush_pending = false;
+            audio_in_queue_tail = audio_in_queue_head;
+            audio_in_queue_primed = false;
+            tail = audio_in_queue_tail;
+            queue_level = 0u;
+        }
+
+        /* One more service interval of the endpoint */
+        audio_timestamp_usb_packet(DWT->CYCCNT);
+
+        /* Send silence until the queue has filled up to its target level */
+        if ((!audio_in_queue_primed) && (queue_level >= audio_in_queue_target))
+        {
+            audio_in_queue_primed = true;
+        }
+
+        if (audio_in_queue_primed)
+        {
+            packet = audio_pool_alloc();
+        }
+
+        if (NULL == packet)
+        {
+            /* Not primed yet, or every packet is held by a consumer */
+            *ppNextBuffer = silent_frame;
+            *pNextPacketSize = AUDIO_IN_FRAMES_PER_PACKET * frame_size;
+        }
+        else
+        {
+            audio_boot_mark(AUDIO_BOOT_FIRST_PACKET);
+
+            num_frames = audio_in_packet_frames(queue_level);
+
+            if (queue_level < num_frames)
+            {
+                audio_in_stats.underruns++;
+                AUDIO_TRACE_MARK(AUDIO_TRACE_ID_UNDERRUN, queue_level);
+                num_frames = queue_level;
+            }
+
+            audio_in_pcm_buffer = (uint16_t *) packet->samples;
+
+            /* Stamp the packet with the timing of its first frame */
+            packet->position = tail;
+            audio_timestamp_stamp(tail, &packet->capture_cycles, &packet->usb_time);
+            if (AUDIO_IN_ALT_MONO == audio_in_alt_setting)
+            {
+                /* Only pack the mono channel */
+                audio_in_queue_read_mono((int16_t *) audio_in_pcm_buffer, tail, num_frames, &audio_in_queue_tail);
+                num_channels = 1u;
+            }
+            else
+            {
+                audio_in_queue_read(audio_in_pcm_buffer, tail, num_frames, &audio_in_queue_tail);
+
+                /* Map the microphones to the channels of the packet. The
+                 * beamformer needs the microphones as captured. */
+                if (AUDIO_IN_ALT_STEREO == audio_in_alt_setting)
+                {
+                    audio_matrix_process((int16_t *) audio_in_pcm_buffer, num_frames);
+                }
+            }
+
+            AUDIO_PERF_BEGIN(vad_start);
+            audio_vad_process((const int16_t *) audio_in_pcm_buffer, num_frames, num_channels);
+            AUDIO_PERF_END(audio_perf_vad, vad_start);
+
+            if (audio_vad_is_gated())
+            {
+                /* No speech: skip the processing stages and leave the CM55
+                 * asleep. The AGC still runs and holds its gain on silence. */
+                memset(audio_in_pcm_buffer, 0, num_frames * frame_size);
+                audio_in_gated = true;
+            }
+            else
+            {
+                if (audio_in_gated)
+                {
+                    /* Speech resumes: restart the stages from a clean state */
+                    audio_in_gated = false;
+                    audio_beamformer_reset();
+                    audio_offload_restart();
+                }
+
+                if (AUDIO_IN_ALT_BEAM_MONO == audio_in_alt_setting)
+                {
+                    AUDIO_PERF_BEGIN(beamformer_start);
+
+                    /* Combine both microphones into the steered mono channel */
+                    audio_beamformer_process((int16_t *) audio_in_pcm_buffer, num_frames);
+
+                    AUDIO_PERF_END(audio_perf_beamformer, beamformer_start);
+                }
+
+                if (audio_offload_is_active())
+                {
+                    /* Swap the block for the one processed by the CM55 */
+                    AUDIO_TRACE_BEGIN(AUDIO_TRACE_ID_OFFLOAD, num_frames);
+                    num_frames = audio_offload_process((int16_t *) audio_in_pcm_buffer, num_frames,
+                                                       frame_size / AUDIO_IN_SUB_FRAME_SIZE);
+                    AUDIO_TRACE_END(AUDIO_TRACE_ID_OFFLOAD, num_frames);
+                }
+            }
+
+            if ((0u != num_frames) && audio_agc_is_enabled())
+            {
+                AUDIO_PERF_BEGIN(agc_start);
+
+                /* Level the block and limit its peaks */
+                audio_agc_process((int16_t *) audio_in_pcm_buffer, num_frames,
+                                  frame_size / AUDIO_IN_SUB_FRAME_SIZE);
+
+                AUDIO_PERF_END(audio_perf_agc, agc_start);
+            }
+
+            audio_in_stats.packets++;
+            audio_in_stats.queue_frames_sum += queue_level;
+            if (queue_level > audio_in_stats.queue_frames_max)
+            {
+                audio_in_stats.queue_frames_max = queue_level;
+            }
+
+            /* The endpoint holds on to the packet until it has been sent */
+            audio_in_usb_packets[1] = packet;
+
+            if (0u == num_frames)
+            {
+                /* The CM55 has no processed block ready yet */
+                *ppNextBuffer = silent_frame;
+                *pNextPacketSize = AUDIO_IN_FRAMES_PER_PACKET * frame_size;
+            }
+            else
+            {
+                /* Share the packet with the other consumers */
+                packet->num_frames = (uint16_t) num_frames;
+                packet->num_channels = (uint16_t) (frame_size / AUDIO_IN_SUB_FRAME_SIZE);
+                packet->source = AUDIO_POOL_SOURCE_MIC;
+                audio_pool_publish(packet);
+
+                if (mic_mute)
+                {
+                    /* Send silent frames in case of mute */
+                    *ppNextBuffer = silent_frame;
+                }
+                else
+                {
+                    /* Send captured audio samples to the Audio IN endpoint */
+                    *ppNextBuffer = (uint8_t *) audio_in_pcm_buffer;
+                }
+                *pNextPacketSize = num_frames * frame_size;
+            }
+        }
+
+        audio_in_stats.bytes += *pNextPacketSize;
+
+#if (AUDIO_CAPTURE_ENABLE)
+        if (capture_packet)
+        {
+            audio_capture_record_output(*ppNextBuffer, *pNextPacketSize);
+        }
+#endif
+
+        AUDIO_TRACE_END(AUDIO_TRACE_ID_CALLBACK, *pNextPacketSize / frame_size);
+        AUDIO_PERF_END(audio_perf_callback, perf_start);
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+/*****************************************************************************
+* Function Name: audio_in_raw_endpoint_callback
+******************************************************************************
+* Summary:
+*  Callback called in the context of USBD_AUDIO_Write_Task for the Audio IN
+*  endpoint of the raw microphone interface. Sends the frames of both
+*  microphones as captured, read from the capture queue shared with the
+*  microphone interface.
+*
+* Parameters:
+*  pUserContext: User context which is passed to the callback.
+*  ppNextBuffer: Buffer containing audio samples which should match the
+*                configuration from raw microphone USBD_AUDIO_IF_CONF.
+*  pNextPacketSize: Size of the next buffer.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_in_raw_endpoint_callback(void *pUserContext,
+                                    const U8 **ppNextBuffer,
+                                    U32 *pNextPacketSize)
+{
+    static bool audio_in_raw_queue_primed = false;
+
+    CY_UNUSED_PARAMETER(pUserContext);
+
+    if (audio_in_raw_start_recording)
+    {
+        audio_in_raw_start_recording = false;
+
+        /* Join the capture queue at live audio */
+        NVIC_DisableIRQ(PDM_IRQ);
+        audio_in_raw_queue_tail = audio_in_queue_head;
+        audio_in_raw_queue_primed = false;
+        audio_in_raw_is_recording = true;
+        NVIC_EnableIRQ(PDM_IRQ);
+
+        /* Return the packets of the previous session to the pool */
+        audio_in_release_usb_packet(audio_in_raw_usb_packets);
+        audio_in_release_usb_packet(audio_in_raw_usb_packets);
+
+        /* Start a transfer to the Audio IN endpoint */
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = AUDIO_IN_PACKET_SIZE_BYTES;
+    }
+    else if (audio_in_raw_is_recording)
+    {
+        uint32_t tail = audio_in_raw_queue_tail;
+        uint32_t queue_level = audio_in_queue_head - tail;
+        uint32_t num_frames;
+        audio_packet_t *packet = NULL;
+
+        /* The oldest packet handed to the endpoint has been sent */
+        audio_in_release_usb_packet(audio_in_raw_usb_packets);
+
+        audio_in_requests++;
+        if (audio_in_raw_flush_pending)
+        {
+            audio_in_raw_flush_pending = false;
+            audio_in_raw_queue_tail = audio_in_queue_head;
+            audio_in_raw_queue_primed = false;
+            tail = audio_in_raw_queue_tail;
+            queue_level = 0u;
+        }
+
+        /* Send silence until the queue has filled up to its target level */
+        if ((!audio_in_raw_queue_primed) && (queue_level >= audio_in_queue_target))
+        {
+            audio_in_raw_queue_primed = true;
+        }
+
+        if (audio_in_raw_queue_primed)
+        {
+            packet = audio_pool_alloc();
+        }
+
+        if (NULL == packet)
+        {
+            *ppNextBuffer = silent_frame;
+            *pNextPacketSize = AUDIO_IN_PACKET_SIZE_BYTES;
+        }
+        else
+        {
+            audio_boot_mark(AUDIO_BOOT_FIRST_PACKET);
+
+            num_frames = audio_in_packet_frames(queue_level);
+            if (queue_level < num_frames)
+            {
+                num_frames = queue_level;
+            }
+
+            audio_in_queue_read((uint16_t *) packet->samples, tail, num_frames, &audio_in_raw_queue_tail);
+
+            /* The endpoint holds on to the packet until it has been sent */
+            audio_in_raw_usb_packets[1] = packet;
+
+            *ppNextBuffer = raw_mic_mute ? silent_frame : (const U8 *) packet->samples;
+            *pNextPacketSize = num_frames * AUDIO_IN_FRAME_SIZE_BYTES;
+        }
+    }
+}
+AUDIO_HOT_FUNC_END
+#endif
+
+
+#if (AUDIO_CAPTURE_ENABLE)
+/*****************************************************************************
+* Function Name: audio_in_replay
+******************************************************************************
+* Summary:
+*  Replay the recorded session through the capture path: the recorded FIFO
+*  drains run the PDM-PCM interrupt handler and the recorded requests run
+*  audio_in_endpoint_callback(), in their recorded order, back to back.
+*  The packets are accumulated into a CRC-32 compared with the one of the
+*  recording. Only runs while the host is not streaming.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the recording was replayed
+*
+*****************************************************************************/
+bool audio_in_replay(void)
+{
+    uint32_t alt_setting;
+    uint32_t queue_target;
+    U8 saved_alt_setting = audio_in_alt_setting;
+    uint32_t saved_queue_target = audio_in_queue_target;
+    const U8 *packet;
+    U32 packet_size;
+    uint32_t packets = 0u;
+    uint32_t crc = 0u;
+    uint32_t event;
+    uint32_t start;
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    /* The replay owns the capture queue */
+    if (audio_in_raw_is_recording || audio_in_raw_start_recording)
+    {
+        return false;
+    }
+#endif
+
+    if (audio_in_is_recording || audio_in_start_recording || (!audio_capture_replay_begin(&alt_setting, &queue_target)))
+    {
+        return false;
+    }
+
+    NVIC_DisableIRQ(PDM_IRQ);
+    audio_in_alt_setting = (U8) alt_setting;
+
+    /* The packet sizes follow the queue level the recorded session aimed
+     * at, whatever the profile latched since */
+    audio_in_queue_target = queue_target;
+
+    start = DWT->CYCCNT;
+
+    /* Start a session the same way as the recorded one */
+    audio_in_start_recording = true;
+    audio_in_endpoint_callback(NULL, &packet, &packet_size);
+
+    for (event = audio_capture_replay_next(); 0u != event; event = audio_capture_replay_next())
+    {
+        if (AUDIO_CAPTURE_EVENT_FIFO == event)
+        {
+            audio_in_pdm_interrupt_handler();
+        }
+        else
+        {
+            audio_in_endpoint_callback(NULL, &packet, &packet_size);
+            crc = audio_capture_crc32(crc, packet, packet_size);
+            packets++;
+        }
+    }
+
+    audio_capture_replay_end(packets, crc, DWT->CYCCNT - start);
+
+    /* Leave the capture path idle, as after the end of a session */
+    audio_in_is_recording = false;
+    audio_offload_stop();
+    audio_in_release_usb_packet(audio_in_usb_packets);
+    audio_in_release_usb_packet(audio_in_usb_packets);
+    audio_in_alt_setting = saved_alt_setting;
+    audio_in_queue_target = saved_queue_target;
+
+    /* The replay runs faster than real time: restart the USB time estimate */
+    audio_timestamp_init();
+    NVIC_EnableIRQ(PDM_IRQ);
+
+    return true;
+}
+#endif
+
+
+/*****************************************************************************
+* Function Name: audio_in_get_alt_setting
+******************************************************************************
+* Summary:
+*  Return the alternate setting of the last recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  U8: AUDIO_IN_ALT_* alternate setting
+*
+*****************************************************************************/
+U8 audio_in_get_alt_setting(void)
+{
+    return audio_in_alt_setting;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_get_progress
+******************************************************************************
+* Summary:
+*  Get the progress counters of the capture path, for the pipeline watchdog.
+*
+* Parameters:
+*  progress: Destination of the counters
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_progress(audio_in_progress_t *progress)
+{
+    bool streaming = audio_in_is_recording;
+
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    streaming = streaming || audio_in_raw_is_recording;
+#endif
+
+    progress->frames = audio_in_queue_head;
+    progress->requests = audio_in_requests;
+    progress->streaming = streaming;
+    progress->capturing = streaming || audio_in_offline_is_recording || audio_in_tap_is_enabled ||
+                          (AUDIO_IN_PREROLL_MAX_MS > 0u);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_flush
+******************************************************************************
+* Summary:
+*  Drop the frames queued for the recording streams. Each stream primes
+*  again from live audio at its next packet request.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_flush(void)
+{
+    audio_in_flush_pending = true;
+#if (AUDIO_IN_NUM_STREAMS > 1u)
+    audio_in_raw_flush_pending = true;
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_rearm
+******************************************************************************
+* Summary:
+*  Restart the PDM-PCM channels from their configuration, which also
+*  empties their FIFOs, and flush the capture queue.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_rearm(void)
+{
+    NVIC_DisableIRQ(PDM_IRQ);
+
+    Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    Cy_PDM_PCM_DeActivate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+    audio_in_apply_profile();
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, LEFT_CH_INDEX);
+    Cy_PDM_PCM_Activate_Channel(CYBSP_PDM_HW, RIGHT_CH_INDEX);
+
+    NVIC_ClearPendingIRQ(PDM_IRQ);
+    NVIC_EnableIRQ(PDM_IRQ);
+
+    audio_in_flush();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_get_stats
+******************************************************************************
+* Summary:
+*  Return a snapshot of the Audio IN streaming statistics.
+*
+* Parameters:
+*  stats: Destination of the snapshot
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_stats(audio_in_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = audio_in_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_reset_stats
+******************************************************************************
+* Summary:
+*  Clear the Audio IN streaming statistics.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_reset_stats(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    memset(&audio_in_stats, 0, sizeof(audio_in_stats));
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+
+/*****************************************************************************
+* Function Name: audio_in_get_levels
+******************************************************************************
+* Summary:
+*  Return the microphone levels of the last completed metering window and
+*  the clip counters.
+*
+* Parameters:
+*  levels: Destination of the levels
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_levels(audio_in_levels_t *levels)
+{
+    uint64_t sum_squares[AUDIO_IN_NUM_CHANNELS];
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    levels->frames = meter_window_frames;
+    for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+    {
+        levels->channel[ch].peak = (uint16_t) meter_window_peak[ch];
+        levels->channel[ch].clips = meter_clips[ch];
+        sum_squares[ch] = meter_window_sum_squares[ch];
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    for (uint32_t ch = 0u; ch < AUDIO_IN_NUM_CHANNELS; ch++)
+    {
+        float mean_square = (0u != levels->frames) ? ((float) sum_squares[ch] / (float) levels->frames) : 0.0f;
+
+        levels->channel[ch].rms = (uint16_t) sqrtf(mean_square);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_reset_levels
+******************************************************************************
+* Summary:
+*  Clear the clip counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_reset_levels(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    memset(meter_clips, 0, sizeof(meter_clips));
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+
+/*****************************************************************************
+* Function Name: audio_in_set_preroll
+******************************************************************************
+* Summary:
+*  Set the length of audio captured before the start of a session that is
+*  delivered to the host. Takes effect at the next recording start.
+*
+* Parameters:
+*  preroll_ms: Pre-roll in ms, at most AUDIO_IN_PREROLL_MAX_MS
+*
+* Return:
+*  bool: false if the pre-roll is too long
+*
+*****************************************************************************/
+bool audio_in_set_preroll(uint32_t preroll_ms)
+{
+    if (preroll_ms > AUDIO_IN_PREROLL_MAX_MS)
+    {
+        return false;
+    }
+
+    audio_in_preroll_ms = preroll_ms;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_in_get_preroll
+******************************************************************************
+* Summary:
+*  Return the length of the pre-roll.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Pre-roll in ms
+*
+*****************************************************************************/
+uint32_t audio_in_get_preroll(void)
+{
+    return audio_in_preroll_ms;
 }
 
-/* [] END OF FILE */
\ No newline at end of file
+/* [] END OF FILE */
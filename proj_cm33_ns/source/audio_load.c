@@ -0,0 +1,350 @@
+/*****************************************************************************
+* File Name        : audio_load.c
+*
+* Description      : This file contains the CPU load meter of the CM33 and the CM55.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_load.h"
+#include "audio_offload.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include "rtos.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Full load, in units of 0.01 % */
+#define AUDIO_LOAD_FULL                     (10000u)
+
+/* Runs the sleep callbacks after all the others, and first on wake-up */
+#define AUDIO_LOAD_SYSPM_ORDER              (255u)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Idle time of the CM33, in cycles: the idle loop and the time asleep */
+static volatile uint32_t load_idle_cycles;
+static uint32_t load_idle_last;
+static uint32_t load_sleep_start;
+
+/* Start of the current window */
+static TickType_t load_window_tick;
+static uint32_t load_window_cycles;
+static uint32_t load_window_idle;
+static uint32_t load_window_cm55_busy;
+
+/* Current period */
+static uint32_t load_period_ms;
+static uint64_t load_period_cm33_busy;
+static uint64_t load_period_cm55_busy;
+static uint16_t load_period_cm33_peak;
+static uint16_t load_period_cm55_peak;
+
+/* Result of the last period */
+static audio_load_stats_t load_stats;
+
+static cy_en_syspm_status_t audio_load_syspm_callback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                      cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_params_t load_syspm_params =
+{
+    .context            = NULL,
+    .base               = NULL
+};
+
+static cy_stc_syspm_callback_t load_syspm_sleep_cb =
+{
+    .callback           = &audio_load_syspm_callback,
+    .skipMode           = 0u,
+    .type               = CY_SYSPM_SLEEP,
+    .callbackParams     = &load_syspm_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = AUDIO_LOAD_SYSPM_ORDER
+};
+
+static cy_stc_syspm_callback_t load_syspm_deepsleep_cb =
+{
+    .callback           = &audio_load_syspm_callback,
+    .skipMode           = 0u,
+    .type               = CY_SYSPM_DEEPSLEEP,
+    .callbackParams     = &load_syspm_params,
+    .prevItm            = NULL,
+    .nextItm            = NULL,
+    .order              = AUDIO_LOAD_SYSPM_ORDER
+};
+
+
+/*****************************************************************************
+* Function Name: audio_load_syspm_callback
+******************************************************************************
+* Summary:
+*  Account the time the CM33 spends in Sleep or Deep Sleep as idle time.
+*  Whether or not the cycle counter runs while asleep, the busy time
+*  derived from it stays correct: a stopped counter makes both the elapsed
+*  cycles and the sleep time exclude the time asleep.
+*
+* Parameters:
+*  callbackParams: Unused
+*  mode: Phase of the transition
+*
+* Return:
+*  cy_en_syspm_status_t: Always CY_SYSPM_SUCCESS
+*
+*****************************************************************************/
+static cy_en_syspm_status_t audio_load_syspm_callback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                      cy_en_syspm_callback_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(callbackParams);
+
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        load_sleep_start = DWT->CYCCNT;
+    }
+    else if (CY_SYSPM_AFTER_TRANSITION == mode)
+    {
+        uint32_t now = DWT->CYCCNT;
+
+        load_idle_cycles += now - load_sleep_start;
+
+        /* The next call of the idle hook measures from the wake-up */
+        load_idle_last = now;
+    }
+    else
+    {
+        /* Nothing to check */
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/*****************************************************************************
+* Function Name: vApplicationIdleHook
+******************************************************************************
+* Summary:
+*  FreeRTOS idle hook. Counts the time between two consecutive calls as idle
+*  time, unless a task or an interrupt ran in between.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void vApplicationIdleHook(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint32_t delta = now - load_idle_last;
+
+    if (delta < AUDIO_LOAD_IDLE_LOOP_MAX_CYCLES)
+    {
+        load_idle_cycles += delta;
+    }
+    load_idle_last = now;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_load_percent
+******************************************************************************
+* Summary:
+*  Convert a busy time into a load.
+*
+* Parameters:
+*  busy_cycles: Cycles spent busy
+*  elapsed_ms: Length of the interval
+*  clock_hz: Clock of the core
+*
+* Return:
+*  uint16_t: Load in units of 0.01 %
+*
+*****************************************************************************/
+static uint16_t audio_load_percent(uint64_t busy_cycles, uint32_t elapsed_ms, uint32_t clock_hz)
+{
+    uint64_t elapsed_cycles = ((uint64_t) elapsed_ms * clock_hz) / 1000u;
+    uint64_t load;
+
+    if (0u == elapsed_cycles)
+    {
+        return 0u;
+    }
+
+    load = (busy_cycles * AUDIO_LOAD_FULL) / elapsed_cycles;
+
+    return (uint16_t) ((load > AUDIO_LOAD_FULL) ? AUDIO_LOAD_FULL : load);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_load_init
+******************************************************************************
+* Summary:
+*  Register the sleep callbacks and start the first window. The cycle
+*  counter runs from audio_boot_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_load_init(void)
+{
+    audio_ipc_status_t status;
+    audio_offload_stats_t stats;
+
+    if ((!Cy_SysPm_RegisterCallback(&load_syspm_sleep_cb)) ||
+        (!Cy_SysPm_RegisterCallback(&load_syspm_deepsleep_cb)))
+    {
+        handle_app_error();
+    }
+
+    audio_offload_get_status(&status, &stats);
+
+    load_window_tick = xTaskGetTickCount();
+    load_window_cycles = DWT->CYCCNT;
+    load_idle_last = load_window_cycles;
+    load_window_idle = load_idle_cycles;
+    load_window_cm55_busy = status.busy_cycles;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_load_update
+******************************************************************************
+* Summary:
+*  Close the current window once AUDIO_LOAD_WINDOW_MS have elapsed, and the
+*  period once AUDIO_LOAD_PERIOD_MS have elapsed. Called periodically by
+*  the Audio App Task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_load_update(void)
+{
+    TickType_t tick = xTaskGetTickCount();
+    uint32_t elapsed_ms = (uint32_t) ((tick - load_window_tick) * portTICK_PERIOD_MS);
+    audio_ipc_status_t status;
+    audio_offload_stats_t stats;
+    uint32_t cycles;
+    uint32_t idle_cycles;
+    uint32_t idle;
+    uint32_t cm33_busy;
+    uint32_t cm55_busy;
+    uint16_t cm33_load;
+    uint16_t cm55_load;
+
+    if (elapsed_ms < AUDIO_LOAD_WINDOW_MS)
+    {
+        return;
+    }
+
+    audio_offload_get_status(&status, &stats);
+    cycles = DWT->CYCCNT;
+    idle_cycles = load_idle_cycles;
+
+    cm33_busy = cycles - load_window_cycles;
+    idle = idle_cycles - load_window_idle;
+    cm33_busy = (cm33_busy > idle) ? (cm33_busy - idle) : 0u;
+    cm55_busy = status.busy_cycles - load_window_cm55_busy;
+
+    load_window_tick = tick;
+    load_window_cycles = cycles;
+    load_window_idle = idle_cycles;
+    load_window_cm55_busy = status.busy_cycles;
+
+    cm33_load = audio_load_percent(cm33_busy, elapsed_ms, SystemCoreClock);
+    cm55_load = audio_load_percent(cm55_busy, elapsed_ms, status.core_clock_hz);
+
+    load_period_ms += elapsed_ms;
+    load_period_cm33_busy += cm33_busy;
+    load_period_cm55_busy += cm55_busy;
+    load_period_cm33_peak = (cm33_load > load_period_cm33_peak) ? cm33_load : load_period_cm33_peak;
+    load_period_cm55_peak = (cm55_load > load_period_cm55_peak) ? cm55_load : load_period_cm55_peak;
+
+    if (load_period_ms >= AUDIO_LOAD_PERIOD_MS)
+    {
+        audio_load_stats_t result;
+        uint32_t interrupt_state;
+
+        result.cm33_load = audio_load_percent(load_period_cm33_busy, load_period_ms, SystemCoreClock);
+        result.cm33_peak = load_period_cm33_peak;
+        result.cm55_load = audio_load_percent(load_period_cm55_busy, load_period_ms, status.core_clock_hz);
+        result.cm55_peak = load_period_cm55_peak;
+
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        load_stats = result;
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+        load_period_ms = 0u;
+        load_period_cm33_busy = 0u;
+        load_period_cm55_busy = 0u;
+        load_period_cm33_peak = 0u;
+        load_period_cm55_peak = 0u;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_load_get_stats
+******************************************************************************
+* Summary:
+*  Return the load of both cores over the last period.
+*
+* Parameters:
+*  stats: Filled with the load of the last period
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_load_get_stats(audio_load_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    *stats = load_stats;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/* [] END OF FILE */
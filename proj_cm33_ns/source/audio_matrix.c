@@ -0,0 +1,445 @@
+/*****************************************************************************
+* File Name        : audio_matrix.c
+*
+* Description      : This file contains the channel matrix stage that maps the
+*                    microphones to the channels of the Audio IN packets.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_matrix.h"
+#include "audio_hot.h"
+#include "cybsp.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define AUDIO_MATRIX_HALF            ((AUDIO_MATRIX_UNITY) / 2)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Matrices of the 1-byte presets */
+static const audio_matrix_params_t matrix_presets[] =
+{
+    { { { AUDIO_MATRIX_UNITY, 0 }, { 0, AUDIO_MATRIX_UNITY } } },                  /* AUDIO_MATRIX_LAYOUT_IDENTITY */
+    { { { 0, AUDIO_MATRIX_UNITY }, { AUDIO_MATRIX_UNITY, 0 } } },                  /* AUDIO_MATRIX_LAYOUT_SWAP */
+    { { { AUDIO_MATRIX_UNITY, 0 }, { AUDIO_MATRIX_UNITY, 0 } } },                  /* AUDIO_MATRIX_LAYOUT_LEFT */
+    { { { 0, AUDIO_MATRIX_UNITY }, { 0, AUDIO_MATRIX_UNITY } } },                  /* AUDIO_MATRIX_LAYOUT_RIGHT */
+    { { { AUDIO_MATRIX_HALF, AUDIO_MATRIX_HALF }, { AUDIO_MATRIX_HALF, AUDIO_MATRIX_HALF } } }, /* AUDIO_MATRIX_LAYOUT_MONO_SUM */
+};
+
+static audio_matrix_params_t matrix_params;
+static audio_matrix_layout_t matrix_layout = AUDIO_MATRIX_LAYOUT_IDENTITY;
+
+/* Matrix set by the host, picked up at the next block */
+static audio_matrix_params_t matrix_pending_params;
+static volatile bool matrix_params_pending;
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_classify
+******************************************************************************
+* Summary:
+*  Find the specialized loop that applies a matrix.
+*
+* Parameters:
+*  params: Matrix
+*
+* Return:
+*  audio_matrix_layout_t: Layout of the matrix
+*
+*****************************************************************************/
+static audio_matrix_layout_t audio_matrix_classify(const audio_matrix_params_t *params)
+{
+    const int16_t (*c)[AUDIO_MATRIX_NUM_CHANNELS] = params->coeffs;
+
+    for (uint32_t layout = 0u; layout < (sizeof(matrix_presets) / sizeof(matrix_presets[0])); layout++)
+    {
+        const int16_t (*p)[AUDIO_MATRIX_NUM_CHANNELS] = matrix_presets[layout].coeffs;
+
+        if ((c[0][0] == p[0][0]) && (c[0][1] == p[0][1]) && (c[1][0] == p[1][0]) && (c[1][1] == p[1][1]))
+        {
+            return (audio_matrix_layout_t) layout;
+        }
+    }
+
+    if ((0 == c[0][1]) && (0 == c[1][0]))
+    {
+        return AUDIO_MATRIX_LAYOUT_GAIN;
+    }
+
+    return AUDIO_MATRIX_LAYOUT_GENERAL;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_saturate
+******************************************************************************
+* Summary:
+*  Scale a Q14 product back to a sample, rounded and saturated.
+*
+* Parameters:
+*  acc: Sum of the products
+*
+* Return:
+*  int16_t: Sample
+*
+*****************************************************************************/
+static inline int16_t audio_matrix_saturate(int32_t acc)
+{
+    acc = (acc + (AUDIO_MATRIX_UNITY / 2)) >> 14;
+
+    if (acc > INT16_MAX)
+    {
+        acc = INT16_MAX;
+    }
+    else if (acc < INT16_MIN)
+    {
+        acc = INT16_MIN;
+    }
+
+    return (int16_t) acc;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_init
+******************************************************************************
+* Summary:
+*  Start with the channels as captured.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_matrix_init(void)
+{
+    matrix_params = matrix_presets[AUDIO_MATRIX_LAYOUT_IDENTITY];
+    matrix_layout = AUDIO_MATRIX_LAYOUT_IDENTITY;
+    matrix_params_pending = false;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_set
+******************************************************************************
+* Summary:
+*  Change the channel matrix. It takes effect at the next block. Called in
+*  ISR context from the control request handler.
+*
+* Parameters:
+*  params: New matrix
+*
+* Return:
+*  bool: false if a coefficient is -2, which could overflow the sum
+*
+*****************************************************************************/
+bool audio_matrix_set(const audio_matrix_params_t *params)
+{
+    for (uint32_t row = 0u; row < AUDIO_MATRIX_NUM_CHANNELS; row++)
+    {
+        for (uint32_t col = 0u; col < AUDIO_MATRIX_NUM_CHANNELS; col++)
+        {
+            if (INT16_MIN == params->coeffs[row][col])
+            {
+                return false;
+            }
+        }
+    }
+
+    matrix_pending_params = *params;
+    matrix_params_pending = true;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_set_layout
+******************************************************************************
+* Summary:
+*  Change the channel matrix to one of the presets.
+*
+* Parameters:
+*  layout: AUDIO_MATRIX_LAYOUT_IDENTITY to AUDIO_MATRIX_LAYOUT_MONO_SUM
+*
+* Return:
+*  bool: false if the layout has no preset
+*
+*****************************************************************************/
+bool audio_matrix_set_layout(audio_matrix_layout_t layout)
+{
+    if ((uint32_t) layout >= (sizeof(matrix_presets) / sizeof(matrix_presets[0])))
+    {
+        return false;
+    }
+
+    return audio_matrix_set(&matrix_presets[layout]);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_get
+******************************************************************************
+* Summary:
+*  Return the channel matrix, including a change not applied yet.
+*
+* Parameters:
+*  params: Destination of the matrix
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_matrix_get(audio_matrix_params_t *params)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *params = matrix_params_pending ? matrix_pending_params : matrix_params;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_update
+******************************************************************************
+* Summary:
+*  Pick up a matrix set by the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static void audio_matrix_update(void)
+{
+    if (matrix_params_pending)
+    {
+        uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+        matrix_params = matrix_pending_params;
+        matrix_params_pending = false;
+
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+        matrix_layout = audio_matrix_classify(&matrix_params);
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_process
+******************************************************************************
+* Summary:
+*  Map the microphones to the channels of the block. Each layout has its
+*  own loop, and the identity matrix returns without touching the block.
+*
+* Parameters:
+*  samples: Interleaved stereo block, processed in place
+*  num_frames: Number of frames in the block
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_matrix_process(int16_t *samples, uint32_t num_frames)
+{
+    int16_t *frame = samples;
+    int16_t *end = &samples[num_frames * AUDIO_MATRIX_NUM_CHANNELS];
+
+    audio_matrix_update();
+
+    switch (matrix_layout)
+    {
+        case AUDIO_MATRIX_LAYOUT_IDENTITY:
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_SWAP:
+            for (; frame < end; frame += AUDIO_MATRIX_NUM_CHANNELS)
+            {
+                int16_t left = frame[0];
+
+                frame[0] = frame[1];
+                frame[1] = left;
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_LEFT:
+            for (; frame < end; frame += AUDIO_MATRIX_NUM_CHANNELS)
+            {
+                frame[1] = frame[0];
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_RIGHT:
+            for (; frame < end; frame += AUDIO_MATRIX_NUM_CHANNELS)
+            {
+                frame[0] = frame[1];
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_MONO_SUM:
+            for (; frame < end; frame += AUDIO_MATRIX_NUM_CHANNELS)
+            {
+                /* The average of two samples cannot overflow */
+                int16_t mono = (int16_t) (((int32_t) frame[0] + frame[1]) >> 1);
+
+                frame[0] = mono;
+                frame[1] = mono;
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_GAIN:
+        {
+            int32_t gain_left = matrix_params.coeffs[0][0];
+            int32_t gain_right = matrix_params.coeffs[1][1];
+
+            for (; frame < end; frame += AUDIO_MATRIX_NUM_CHANNELS)
+            {
+                frame[0] = audio_matrix_saturate(gain_left * frame[0]);
+                frame[1] = audio_matrix_saturate(gain_right * frame[1]);
+            }
+            break;
+        }
+
+        default:
+        {
+            const int16_t (*c)[AUDIO_MATRIX_NUM_CHANNELS] = matrix_params.coeffs;
+
+            for (; frame < end; frame += AUDIO_MATRIX_NUM_CHANNELS)
+            {
+                int32_t left = frame[0];
+                int32_t right = frame[1];
+
+                frame[0] = audio_matrix_saturate((c[0][0] * left) + (c[0][1] * right));
+                frame[1] = audio_matrix_saturate((c[1][0] * left) + (c[1][1] * right));
+            }
+            break;
+        }
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_matrix_downmix
+******************************************************************************
+* Summary:
+*  Produce the mono channel of the mono alternate setting: the left output
+*  of the matrix, computed from the microphones without a stereo copy. The
+*  identity matrix keeps the left microphone, the mono sum preset averages
+*  both.
+*
+* Parameters:
+*  mono: Destination of the mono samples
+*  left: First left sample
+*  right: First right sample
+*  stride: Distance between two samples of a channel: 2 for interleaved
+*          frames, 1 for planes
+*  num_frames: Number of frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_matrix_downmix(int16_t *mono, const int16_t *left, const int16_t *right,
+                          uint32_t stride, uint32_t num_frames)
+{
+    audio_matrix_update();
+
+    switch (matrix_layout)
+    {
+        case AUDIO_MATRIX_LAYOUT_IDENTITY:
+        case AUDIO_MATRIX_LAYOUT_LEFT:
+            for (uint32_t n = 0u; n < num_frames; n++)
+            {
+                mono[n] = left[n * stride];
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_SWAP:
+        case AUDIO_MATRIX_LAYOUT_RIGHT:
+            for (uint32_t n = 0u; n < num_frames; n++)
+            {
+                mono[n] = right[n * stride];
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_MONO_SUM:
+            for (uint32_t n = 0u; n < num_frames; n++)
+            {
+                mono[n] = (int16_t) (((int32_t) left[n * stride] + right[n * stride]) >> 1);
+            }
+            break;
+
+        case AUDIO_MATRIX_LAYOUT_GAIN:
+        {
+            int32_t gain_left = matrix_params.coeffs[0][0];
+
+            for (uint32_t n = 0u; n < num_frames; n++)
+            {
+                mono[n] = audio_matrix_saturate(gain_left * left[n * stride]);
+            }
+            break;
+        }
+
+        default:
+        {
+            int32_t from_left = matrix_params.coeffs[0][0];
+            int32_t from_right = matrix_params.coeffs[0][1];
+
+            for (uint32_t n = 0u; n < num_frames; n++)
+            {
+                mono[n] = audio_matrix_saturate((from_left * left[n * stride]) + (from_right * right[n * stride]));
+            }
+            break;
+        }
+    }
+}
+AUDIO_HOT_FUNC_END
+
+/* [] END OF FILE */
@@ -0,0 +1,798 @@
+/*****************************************************************************
+* File Name        : audio_offload.c
+*
+* Description      : This file contains the CM33 side of the audio processing
+*                    offload to the CM55.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_offload.h"
+#include "audio.h"
+#include "audio_hot.h"
+#include "audio_in.h"
+#include "audio_pool.h"
+#include "retarget_io_init.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Copies of the spectrum tried before giving up on a consistent one */
+#define AUDIO_OFFLOAD_SPECTRUM_READ_ATTEMPTS    (8u)
+
+/* Stages run on the blocks of a recording session, latched at its start.
+ * The spectrum analyzer runs on the capture tap instead, outside of the
+ * recording sessions. */
+#define AUDIO_OFFLOAD_SESSION_STAGES            (AUDIO_IPC_STAGE_NOISE_SUPPRESSION)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Stages requested by the host. The session stages are latched at the
+ * start of a recording session, the analyzer follows at once. */
+static volatile uint32_t requested_stages = AUDIO_OFFLOAD_DEFAULT_STAGES;
+
+/* Stages and session of the running recording session */
+static uint32_t active_stages;
+static uint32_t active_session;
+
+/* Set once the CM55 returned the first block of the session */
+static bool offload_primed;
+
+static audio_offload_stats_t offload_stats;
+
+/* Spectrum analyzer: running, session of its blocks, and blocks dropped
+ * since its start */
+static volatile bool analyzer_active;
+static uint32_t analyzer_session;
+static uint32_t analyzer_dropped;
+
+/* Tap packet held by the analyzer while its ring is full, sent first when
+ * the next packet is published */
+static audio_packet_t *analyzer_pending;
+
+/* Spectrum analyzer settings requested by the host, applied at once */
+static audio_offload_spectrum_config_t spectrum_config =
+{
+    .fft_size = AUDIO_OFFLOAD_SPECTRUM_FFT_SIZE,
+    .hop_size = AUDIO_OFFLOAD_SPECTRUM_HOP_SIZE,
+    .num_average = AUDIO_OFFLOAD_SPECTRUM_NUM_AVERAGE,
+};
+
+/* Page of the spectrum returned to the host */
+static uint32_t spectrum_channel;
+static uint32_t spectrum_first_bin;
+
+
+/*****************************************************************************
+* Function Name: audio_offload_write_stages
+******************************************************************************
+* Summary:
+*  Publish the stages that run on the CM55: the stages of the recording
+*  session and the spectrum analyzer. Called in a critical section.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_offload_write_stages(void)
+{
+    AUDIO_IPC_SHARED->stages = active_stages | (analyzer_active ? AUDIO_IPC_STAGE_SPECTRUM : 0u);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_start_analyzer
+******************************************************************************
+* Summary:
+*  Start the spectrum analyzer with the requested settings, or restart it
+*  if it runs. The blocks of the new analyzer session restart the analysis
+*  on the CM55 with the settings written here.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_offload_start_analyzer(void)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+    uint32_t interrupt_state;
+
+    shared->spectrum_fft_size = spectrum_config.fft_size;
+    shared->spectrum_hop_size = spectrum_config.hop_size;
+    shared->spectrum_num_average = spectrum_config.num_average;
+    __DMB();
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    analyzer_session++;
+    analyzer_dropped = 0u;
+    analyzer_active = true;
+    audio_offload_write_stages();
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    audio_in_tap_enable();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_stop_analyzer
+******************************************************************************
+* Summary:
+*  Stop the spectrum analyzer. The last spectrum stays readable.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_offload_stop_analyzer(void)
+{
+    audio_packet_t *packet;
+    uint32_t interrupt_state;
+
+    audio_in_tap_disable();
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    analyzer_active = false;
+    audio_offload_write_stages();
+    packet = analyzer_pending;
+    analyzer_pending = NULL;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    if (NULL != packet)
+    {
+        audio_pool_release(packet);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_post_analyzer
+******************************************************************************
+* Summary:
+*  Copy a tap packet to the ring of the spectrum analyzer and wake up the
+*  CM55.
+*
+* Parameters:
+*  packet: Tap packet
+*
+* Return:
+*  bool: false if the ring is full
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static bool audio_offload_post_analyzer(const audio_packet_t *packet)
+{
+    audio_ipc_ring_t *ring = &AUDIO_IPC_SHARED->to_analyzer;
+    audio_ipc_block_t *block;
+    uint32_t index = ring->head;
+
+    if ((index - ring->tail) >= AUDIO_IPC_NUM_SLOTS)
+    {
+        return false;
+    }
+
+    block = &ring->slots[index % AUDIO_IPC_NUM_SLOTS];
+    block->session = analyzer_session;
+    block->num_frames = packet->num_frames;
+    block->num_channels = packet->num_channels;
+    memcpy(block->samples, packet->samples, (uint32_t) packet->num_frames * packet->num_channels * sizeof(int16_t));
+
+    __DMB();
+    ring->head = index + 1u;
+
+    /* Wake up the CM55 */
+    __DSB();
+    __SEV();
+
+    return true;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_offload_hold_packet
+******************************************************************************
+* Summary:
+*  Keep a tap packet the caller holds a reference to until the analyzer
+*  ring has room. The packet is released instead if the analyzer stopped.
+*
+* Parameters:
+*  packet: Tap packet
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_offload_hold_packet(audio_packet_t *packet)
+{
+    bool held;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    held = analyzer_active;
+    if (held)
+    {
+        analyzer_pending = packet;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    if (!held)
+    {
+        audio_pool_release(packet);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_analyze_packet
+******************************************************************************
+* Summary:
+*  Pool consumer of the spectrum analyzer: pass the packets of the capture
+*  tap to the CM55. The tap runs before the processing stages and the VAD
+*  gate, and whether the host records or not. A packet that finds the ring
+*  full is held with a reference and sent first at the next packet, which
+*  rides out an FFT that takes longer than one packet. The packets that
+*  find the ring still full are dropped.
+*
+* Parameters:
+*  packet: Published packet
+*  context: Unused
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_offload_analyze_packet(audio_packet_t *packet, void *context)
+{
+    audio_packet_t *pending;
+    uint32_t interrupt_state;
+
+    CY_UNUSED_PARAMETER(context);
+
+    if (AUDIO_POOL_SOURCE_TAP != packet->source)
+    {
+        return;
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    pending = analyzer_pending;
+    analyzer_pending = NULL;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    if (NULL != pending)
+    {
+        if (analyzer_active && (!audio_offload_post_analyzer(pending)))
+        {
+            /* Still full: keep the held packet and drop this one */
+            analyzer_dropped++;
+            audio_offload_hold_packet(pending);
+            return;
+        }
+
+        audio_pool_release(pending);
+    }
+
+    if (analyzer_active && (!audio_offload_post_analyzer(packet)))
+    {
+        audio_pool_retain(packet);
+        audio_offload_hold_packet(packet);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_init
+******************************************************************************
+* Summary:
+*  Initialize the shared memory mailbox. The CM55 ignores the mailbox until
+*  it is initialized.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_init(void)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+
+    memset(shared, 0, sizeof(*shared));
+
+    /* An analyzer requested during the startup is started again by
+     * audio_offload_apply_stages() */
+    analyzer_active = false;
+
+    __DMB();
+    shared->magic = AUDIO_IPC_MAGIC;
+
+    /* The spectrum analyzer takes its blocks from the capture tap */
+    if (!audio_pool_add_consumer(audio_offload_analyze_packet, NULL))
+    {
+        handle_app_error();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_start
+******************************************************************************
+* Summary:
+*  Start a new session: latch the requested session stages and tag the
+*  following blocks so that the CM55 resets its processing state. Called at
+*  the start of a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_start(void)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+    uint32_t interrupt_state;
+
+    active_session = shared->session + 1u;
+    offload_primed = false;
+    memset(&offload_stats, 0, sizeof(offload_stats));
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    active_stages = requested_stages & AUDIO_OFFLOAD_SESSION_STAGES;
+    audio_offload_write_stages();
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    __DMB();
+    shared->session = active_session;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_stop
+******************************************************************************
+* Summary:
+*  End the session: clear the session stages in the mailbox so that the
+*  CM55 goes back to Deep Sleep once it has processed the blocks left in
+*  the ring, unless the spectrum analyzer runs. Called at the end of a
+*  recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_stop(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    active_stages = 0u;
+    audio_offload_write_stages();
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_restart
+******************************************************************************
+* Summary:
+*  Tag the following blocks with a new session so that the CM55 restarts
+*  its processing state, keeping the stages and the counters. Called when
+*  streaming resumes after the stages were skipped.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_restart(void)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+
+    active_session = shared->session + 1u;
+    offload_primed = false;
+
+    __DMB();
+    shared->session = active_session;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_is_active
+******************************************************************************
+* Summary:
+*  Check if any stage runs on the blocks of the current recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+bool audio_offload_is_active(void)
+{
+    return (0u != active_stages);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_offload_set_stages
+******************************************************************************
+* Summary:
+*  Select the stages run by the CM55. The spectrum analyzer starts or stops
+*  at once, the other stages apply from the next recording session.
+*
+* Parameters:
+*  stages: AUDIO_IPC_STAGE_* bits
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_set_stages(uint32_t stages)
+{
+    requested_stages = stages;
+    audio_offload_apply_stages();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_apply_stages
+******************************************************************************
+* Summary:
+*  Start or stop the spectrum analyzer to match the requested stages.
+*  Called at startup once the capture path is ready, then on every change.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_apply_stages(void)
+{
+    bool analyze = (0u != (requested_stages & AUDIO_IPC_STAGE_SPECTRUM));
+
+    if (analyze && (!analyzer_active))
+    {
+        audio_offload_start_analyzer();
+    }
+    else if ((!analyze) && analyzer_active)
+    {
+        audio_offload_stop_analyzer();
+    }
+    else
+    {
+        /* No change */
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_get_stages
+******************************************************************************
+* Summary:
+*  Return the stages requested for the next recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: AUDIO_IPC_STAGE_* bits
+*
+*****************************************************************************/
+uint32_t audio_offload_get_stages(void)
+{
+    return requested_stages;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_process
+******************************************************************************
+* Summary:
+*  Pass a captured block to the CM55 and replace it with the oldest block
+*  the CM55 has processed. This adds one packet of latency on top of the
+*  algorithmic latency of the stages.
+*
+* Parameters:
+*  samples: Interleaved block, replaced by the processed block
+*  num_frames: Number of frames in the block
+*  num_channels: Number of channels in the block
+*
+* Return:
+*  uint32_t: Number of frames of the processed block written to samples,
+*            0 if none is ready
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+uint32_t audio_offload_process(int16_t *samples, uint32_t num_frames, uint32_t num_channels)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+    audio_ipc_ring_t *ring = &shared->to_cm55;
+    audio_ipc_block_t *block;
+    uint32_t index;
+
+    /* Queue the captured block */
+    index = ring->head;
+    if ((index - ring->tail) < AUDIO_IPC_NUM_SLOTS)
+    {
+        block = &ring->slots[index % AUDIO_IPC_NUM_SLOTS];
+        block->session = active_session;
+        block->num_frames = (uint16_t) num_frames;
+        block->num_channels = (uint16_t) num_channels;
+        memcpy(block->samples, samples, num_frames * num_channels * sizeof(int16_t));
+
+        __DMB();
+        ring->head = index + 1u;
+
+        /* Wake up the CM55 */
+        __DSB();
+        __SEV();
+    }
+    else
+    {
+        offload_stats.dropped++;
+    }
+
+    /* Return the oldest processed block of this session */
+    ring = &shared->from_cm55;
+    for (index = ring->tail; index != ring->head; index++)
+    {
+        block = &ring->slots[index % AUDIO_IPC_NUM_SLOTS];
+
+        if (active_session == block->session)
+        {
+            uint32_t processed_frames = block->num_frames;
+
+            memcpy(samples, block->samples, processed_frames * block->num_channels * sizeof(int16_t));
+
+            __DMB();
+            ring->tail = index + 1u;
+            offload_primed = true;
+
+            return processed_frames;
+        }
+    }
+
+    /* Discard blocks left over from an earlier session */
+    ring->tail = index;
+
+    if (offload_primed)
+    {
+        offload_stats.late++;
+    }
+
+    return 0u;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_offload_get_status
+******************************************************************************
+* Summary:
+*  Return the processing status published by the CM55, the offload
+*  counters of the current recording session, and the blocks dropped by
+*  the spectrum analyzer since its start.
+*
+* Parameters:
+*  status: Destination of the CM55 status
+*  stats: Destination of the offload counters
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_get_status(audio_ipc_status_t *status, audio_offload_stats_t *stats)
+{
+    memcpy(status, (const void *) &AUDIO_IPC_SHARED->status, sizeof(*status));
+    *stats = offload_stats;
+    stats->analyzer_dropped = analyzer_dropped;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_set_spectrum_config
+******************************************************************************
+* Summary:
+*  Change the spectrum analyzer settings. A running analyzer restarts with
+*  the new settings.
+*
+* Parameters:
+*  config: New settings
+*
+* Return:
+*  bool: false if the settings are out of range
+*
+*****************************************************************************/
+bool audio_offload_set_spectrum_config(const audio_offload_spectrum_config_t *config)
+{
+    uint32_t fft_size = config->fft_size;
+
+    if ((fft_size < AUDIO_IPC_SPECTRUM_MIN_FFT_SIZE) || (fft_size > AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE) ||
+        (0u != (fft_size & (fft_size - 1u))) || (config->hop_size < AUDIO_IPC_SPECTRUM_MIN_HOP_SIZE(fft_size)) ||
+        (config->hop_size > fft_size) || (0u == config->num_average))
+    {
+        return false;
+    }
+
+    spectrum_config = *config;
+    spectrum_config.reserved = 0u;
+
+    if (analyzer_active)
+    {
+        audio_offload_start_analyzer();
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_get_spectrum_config
+******************************************************************************
+* Summary:
+*  Return the spectrum analyzer settings.
+*
+* Parameters:
+*  config: Destination of the settings
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_offload_get_spectrum_config(audio_offload_spectrum_config_t *config)
+{
+    *config = spectrum_config;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_select_spectrum_page
+******************************************************************************
+* Summary:
+*  Select the channel and the first bin of the page returned by
+*  audio_offload_get_spectrum_page().
+*
+* Parameters:
+*  channel: Channel, 0 or 1
+*  first_bin: First bin of the page
+*
+* Return:
+*  bool: false if the page is out of range
+*
+*****************************************************************************/
+bool audio_offload_select_spectrum_page(uint32_t channel, uint32_t first_bin)
+{
+    if ((channel >= AUDIO_IPC_MAX_CHANNELS) || (first_bin >= AUDIO_IPC_SPECTRUM_MAX_BINS))
+    {
+        return false;
+    }
+
+    spectrum_channel = channel;
+    spectrum_first_bin = first_bin;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_offload_get_spectrum_page
+******************************************************************************
+* Summary:
+*  Copy the selected page of the last spectrum published by the CM55. The
+*  CM55 makes the sequence odd while it writes a result, the copy is
+*  retried if it overlaps an update.
+*
+* Parameters:
+*  page: Destination of the page
+*
+* Return:
+*  bool: false if no consistent copy could be made
+*
+*****************************************************************************/
+bool audio_offload_get_spectrum_page(audio_offload_spectrum_page_t *page)
+{
+    const audio_ipc_spectrum_t *spectrum = &AUDIO_IPC_SHARED->spectrum;
+
+    for (uint32_t attempt = 0u; attempt < AUDIO_OFFLOAD_SPECTRUM_READ_ATTEMPTS; attempt++)
+    {
+        uint32_t sequence = spectrum->sequence;
+        uint32_t num_bins;
+
+        if (0u != (sequence & 1u))
+        {
+            continue;
+        }
+        __DMB();
+
+        page->results = spectrum->results;
+        page->fft_size = (uint16_t) spectrum->fft_size;
+        page->hop_size = (uint16_t) spectrum->hop_size;
+        page->num_average = (uint16_t) spectrum->num_average;
+        page->avg_cycles = spectrum->avg_cycles;
+        page->max_cycles = spectrum->max_cycles;
+        page->channel = (uint8_t) spectrum_channel;
+        page->num_channels = (uint8_t) spectrum->num_channels;
+        page->first_bin = (uint16_t) spectrum_first_bin;
+
+        num_bins = (0u != page->results) ? ((spectrum->fft_size / 2u) + 1u) : 0u;
+        if ((num_bins > AUDIO_IPC_SPECTRUM_MAX_BINS) || (spectrum_channel >= page->num_channels))
+        {
+            num_bins = 0u;
+        }
+        page->num_bins = (uint16_t) num_bins;
+
+        for (uint32_t i = 0u; i < AUDIO_OFFLOAD_SPECTRUM_PAGE_BINS; i++)
+        {
+            uint32_t bin = spectrum_first_bin + i;
+
+            page->level[i] = (bin < num_bins) ? spectrum->level[spectrum_channel][bin] :
+                                                (int16_t) AUDIO_IPC_SPECTRUM_FLOOR;
+        }
+
+        __DMB();
+        if (sequence == spectrum->sequence)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* [] END OF FILE */
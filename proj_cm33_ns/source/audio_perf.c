@@ -0,0 +1,179 @@
+/*****************************************************************************
+* File Name        : audio_perf.c
+*
+* Description      : This file contains the cycle counter based profiling helpers
+*                    used to measure the CPU cost of the audio path.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_perf.h"
+#include "audio_hot.h"
+#include "retarget_io_init.h"
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+audio_perf_counter_t audio_perf_callback;
+audio_perf_counter_t audio_perf_beamformer;
+audio_perf_counter_t audio_perf_agc;
+audio_perf_counter_t audio_perf_vad;
+
+
+/*****************************************************************************
+* Function Name: audio_perf_init
+******************************************************************************
+* Summary:
+*  Clear all the counters. The DWT cycle counter runs from
+*  audio_boot_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_perf_init(void)
+{
+    audio_perf_reset(&audio_perf_callback);
+    audio_perf_reset(&audio_perf_beamformer);
+    audio_perf_reset(&audio_perf_agc);
+    audio_perf_reset(&audio_perf_vad);
+
+    printf("APP_LOG: Audio hot path runs from %s\r\n", AUDIO_HOT_PATH_LOCATION);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_perf_update
+******************************************************************************
+* Summary:
+*  Account a single measurement to a counter.
+*
+* Parameters:
+*  counter: Counter to update
+*  cycles: Number of CPU cycles of the measurement
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_perf_update(audio_perf_counter_t *counter, uint32_t cycles)
+{
+    counter->count++;
+    counter->total_cycles += cycles;
+
+    if (cycles < counter->min_cycles)
+    {
+        counter->min_cycles = cycles;
+    }
+    if (cycles > counter->max_cycles)
+    {
+        counter->max_cycles = cycles;
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_perf_reset
+******************************************************************************
+* Summary:
+*  Clear a counter.
+*
+* Parameters:
+*  counter: Counter to clear
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_perf_reset(audio_perf_counter_t *counter)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    counter->count = 0u;
+    counter->min_cycles = UINT32_MAX;
+    counter->max_cycles = 0u;
+    counter->total_cycles = 0u;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_perf_report
+******************************************************************************
+* Summary:
+*  Print the average, best and worst case cost of a counter and the resulting
+*  CPU load, then clear the counter for the next report interval. The spread
+*  between the best and the worst case includes the stalls on misses of the
+*  XIP cache, unless the hot path runs from SRAM (see AUDIO_HOT_PATH_IN_RAM).
+*
+* Parameters:
+*  name: Label printed in front of the report
+*  counter: Counter to report
+*  calls_per_sec: Nominal number of measurements per second, used to
+*                 compute the CPU load
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_perf_report(const char *name, audio_perf_counter_t *counter, uint32_t calls_per_sec)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    audio_perf_counter_t snapshot = *counter;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    audio_perf_reset(counter);
+
+    if (0u != snapshot.count)
+    {
+        uint32_t avg_cycles = (uint32_t) (snapshot.total_cycles / snapshot.count);
+
+        /* Load in units of 0.01 % of the CPU */
+        uint32_t load = (uint32_t) (((uint64_t) avg_cycles * calls_per_sec * 10000u) / SystemCoreClock);
+
+        printf("APP_LOG: %s: avg %lu cycles, min %lu cycles, max %lu cycles, load %lu.%02lu %%\r\n",
+               name, (unsigned long) avg_cycles, (unsigned long) snapshot.min_cycles,
+               (unsigned long) snapshot.max_cycles,
+               (unsigned long) (load / 100u), (unsigned long) (load % 100u));
+    }
+}
+
+/* [] END OF FILE */
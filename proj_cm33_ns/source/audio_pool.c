@@ -0,0 +1,310 @@
+/*****************************************************************************
+* File Name        : audio_pool.c
+*
+* Description      : This file contains the reference counted pool of Audio IN packets.
+*                    A captured packet is shared by all its consumers without copies and
+*                    returns to the pool when the last of them releases it.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_pool.h"
+#include "audio_hot.h"
+#include "cybsp.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static audio_packet_t pool_packets[AUDIO_POOL_NUM_PACKETS];
+
+/* Stack of the free packets */
+static audio_packet_t *pool_free[AUDIO_POOL_NUM_PACKETS];
+static uint32_t pool_num_free;
+
+static uint32_t pool_sequence;
+
+static audio_pool_consumer_t pool_consumers[AUDIO_POOL_MAX_CONSUMERS];
+static void *pool_consumer_contexts[AUDIO_POOL_MAX_CONSUMERS];
+static uint32_t pool_num_consumers;
+
+static audio_pool_stats_t pool_stats;
+
+
+/*****************************************************************************
+* Function Name: audio_pool_init
+******************************************************************************
+* Summary:
+*  Return all the packets to the pool.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_pool_init(void)
+{
+    for (uint32_t i = 0u; i < AUDIO_POOL_NUM_PACKETS; i++)
+    {
+        pool_packets[i].refcount = 0u;
+        pool_free[i] = &pool_packets[i];
+    }
+    pool_num_free = AUDIO_POOL_NUM_PACKETS;
+
+    memset(&pool_stats, 0, sizeof(pool_stats));
+}
+
+
+/*****************************************************************************
+* Function Name: audio_pool_alloc
+******************************************************************************
+* Summary:
+*  Take a packet from the pool. The caller holds the only reference.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  audio_packet_t *: Packet, NULL if the pool is empty
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+audio_packet_t *audio_pool_alloc(void)
+{
+    audio_packet_t *packet = NULL;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (0u != pool_num_free)
+    {
+        packet = pool_free[--pool_num_free];
+        packet->refcount = 1u;
+        packet->sequence = pool_sequence++;
+
+        pool_stats.in_use++;
+        if (pool_stats.in_use > pool_stats.high_water)
+        {
+            pool_stats.high_water = pool_stats.in_use;
+        }
+    }
+    else
+    {
+        pool_stats.alloc_failures++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return packet;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_pool_retain
+******************************************************************************
+* Summary:
+*  Take an additional reference to a packet.
+*
+* Parameters:
+*  packet: Packet the caller already holds a reference to
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_pool_retain(audio_packet_t *packet)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    CY_ASSERT(0u != packet->refcount);
+    packet->refcount++;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_pool_release
+******************************************************************************
+* Summary:
+*  Drop a reference to a packet. The packet returns to the pool with the
+*  last reference. Can be called from any task or interrupt.
+*
+* Parameters:
+*  packet: Packet to release
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_pool_release(audio_packet_t *packet)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    CY_ASSERT(0u != packet->refcount);
+
+    if (0u == --packet->refcount)
+    {
+        CY_ASSERT(pool_num_free < AUDIO_POOL_NUM_PACKETS);
+        pool_free[pool_num_free++] = packet;
+        pool_stats.in_use--;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_pool_add_consumer
+******************************************************************************
+* Summary:
+*  Register a consumer of the published packets. Consumers are called in
+*  the context of the Audio In Task for the packets of the microphone
+*  interface, and of the Audio Tap Task for the packets of the capture tap,
+*  in the order they were added. They must not block.
+*
+* Parameters:
+*  consumer: Function called with every published packet
+*  context: Passed to the consumer
+*
+* Return:
+*  bool: false if AUDIO_POOL_MAX_CONSUMERS are already registered
+*
+*****************************************************************************/
+bool audio_pool_add_consumer(audio_pool_consumer_t consumer, void *context)
+{
+    bool result = false;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (pool_num_consumers < AUDIO_POOL_MAX_CONSUMERS)
+    {
+        pool_consumers[pool_num_consumers] = consumer;
+        pool_consumer_contexts[pool_num_consumers] = context;
+        pool_num_consumers++;
+        result = true;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return result;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_pool_publish
+******************************************************************************
+* Summary:
+*  Pass a filled packet to every consumer. The caller keeps its reference.
+*  Can be called from several tasks.
+*
+* Parameters:
+*  packet: Packet to publish
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_pool_publish(audio_packet_t *packet)
+{
+    uint32_t num_consumers = pool_num_consumers;
+    uint32_t interrupt_state;
+
+    for (uint32_t i = 0u; i < num_consumers; i++)
+    {
+        pool_consumers[i](packet, pool_consumer_contexts[i]);
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    pool_stats.published++;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_pool_get_stats
+******************************************************************************
+* Summary:
+*  Return a snapshot of the pool occupancy.
+*
+* Parameters:
+*  stats: Destination of the snapshot
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_pool_get_stats(audio_pool_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = pool_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_pool_reset_stats
+******************************************************************************
+* Summary:
+*  Restart the high-water mark from the current occupancy and clear the
+*  counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_pool_reset_stats(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    pool_stats.high_water = pool_stats.in_use;
+    pool_stats.alloc_failures = 0u;
+    pool_stats.published = 0u;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/* [] END OF FILE */
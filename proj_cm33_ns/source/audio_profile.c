@@ -0,0 +1,147 @@
+/*****************************************************************************
+* File Name        : audio_profile.c
+*
+* Description      : This file contains the latency profiles of the Audio IN path.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_profile.h"
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+/* The endpoint service interval is part of the configuration descriptor and
+ * cannot change after enumeration. It is selected at build time with
+ * AUDIO_IN_EP_INTERVAL. All the other buffering parameters are set here.
+ */
+static const audio_profile_t audio_profiles[AUDIO_PROFILE_COUNT] =
+{
+    [AUDIO_PROFILE_LOW_LATENCY] =
+    {
+        .name               = "low-latency",
+        .queue_depth        = 1u,
+        .fifo_trigger_level = 3u,
+        .write_timeout_ms   = 5u,
+    },
+    [AUDIO_PROFILE_BALANCED] =
+    {
+        .name               = "balanced",
+        .queue_depth        = 2u,
+        .fifo_trigger_level = 15u,
+        .write_timeout_ms   = 10u,
+    },
+    [AUDIO_PROFILE_ROBUST] =
+    {
+        .name               = "robust",
+        .queue_depth        = AUDIO_PROFILE_MAX_QUEUE_DEPTH,
+        .fifo_trigger_level = 31u,
+        .write_timeout_ms   = 20u,
+    },
+};
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static volatile audio_profile_id_t current_profile = AUDIO_PROFILE_DEFAULT;
+
+
+/*****************************************************************************
+* Function Name: audio_profile_set
+******************************************************************************
+* Summary:
+*  Select the latency profile. The capture parameters take effect at the
+*  start of the next recording session, the write timeout is applied by the
+*  Audio App Task.
+*
+* Parameters:
+*  id: Profile to select
+*
+* Return:
+*  bool: true if the profile exists, false otherwise
+*
+*****************************************************************************/
+bool audio_profile_set(audio_profile_id_t id)
+{
+    if (id >= AUDIO_PROFILE_COUNT)
+    {
+        return false;
+    }
+
+    current_profile = id;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_profile_get_id
+******************************************************************************
+* Summary:
+*  Return the ID of the selected latency profile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  audio_profile_id_t
+*
+*****************************************************************************/
+audio_profile_id_t audio_profile_get_id(void)
+{
+    return current_profile;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_profile_get
+******************************************************************************
+* Summary:
+*  Return the parameters of the selected latency profile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  const audio_profile_t *
+*
+*****************************************************************************/
+const audio_profile_t *audio_profile_get(void)
+{
+    return &audio_profiles[current_profile];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,990 @@
+/*****************************************************************************
+* File Name        : audio_recorder.c
+*
+* Description      : This file implements the offline recorder. While no USB host
+*                    is connected, the Audio Rec Task moves the captured frames to
+*                    a buffer, and the Audio Store Task writes the buffer to a log
+*                    of WAV segments on the storage device. The capture never waits
+*                    for the device.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_recorder.h"
+
+#if (AUDIO_RECORDER_ENABLE)
+
+#include "audio.h"
+#include "audio_in.h"
+#include "audio_store.h"
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include "rtos.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define RECORDER_BUFFER_FRAMES              (((AUDIO_IN_SAMPLE_FREQ) / 1000u) * (AUDIO_RECORDER_BUFFER_MS))
+#define RECORDER_WRITE_FRAMES               ((AUDIO_RECORDER_WRITE_BYTES) / (AUDIO_IN_FRAME_SIZE_BYTES))
+
+/* WAV header up to the segment record, and the chunk headers after it */
+#define RECORDER_WAV_PREFIX_BYTES           (44u)
+#define RECORDER_WAV_CHUNK_BYTES            (8u)
+#define RECORDER_WAV_FMT_BYTES              (16u)
+#define RECORDER_WAV_FORMAT_PCM             (1u)
+#define RECORDER_WAV_PAD_BYTES              ((AUDIO_RECORDER_HEADER_BYTES) - (RECORDER_WAV_PREFIX_BYTES) - \
+                                             sizeof(audio_recorder_segment_t) - (RECORDER_WAV_CHUNK_BYTES))
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* WAV header of a segment: RIFF, fmt, the "aseg" chunk with the segment
+ * record, padded so that the data chunk ends the header */
+typedef struct
+{
+    char     riff_id[4];
+    uint32_t riff_size;
+    char     wave_id[4];
+    char     fmt_id[4];
+    uint32_t fmt_size;
+    uint16_t format;
+    uint16_t channels;
+    uint32_t sample_rate;
+    uint32_t byte_rate;
+    uint16_t block_align;
+    uint16_t bits_per_sample;
+    char     aseg_id[4];
+    uint32_t aseg_size;
+    audio_recorder_segment_t segment;
+    uint8_t  pad[RECORDER_WAV_PAD_BYTES];
+    char     data_id[4];
+    uint32_t data_size;
+} recorder_wav_header_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static const audio_store_backend_t *const recorder_store = &(AUDIO_RECORDER_BACKEND);
+
+/* Frames between the capture and the storage device. The head is moved by
+ * the Audio Rec Task and the tail by the Audio Store Task. Free running. */
+static uint16_t recorder_buffer[(RECORDER_BUFFER_FRAMES) * (AUDIO_IN_NUM_CHANNELS)];
+static volatile uint32_t recorder_buffer_head;
+static volatile uint32_t recorder_buffer_tail;
+
+/* The state is moved by the Audio Rec Task, except from flushing to idle,
+ * which the Audio Store Task does */
+static volatile audio_recorder_state_t recorder_state;
+static volatile bool recorder_arm_request;
+static volatile bool recorder_stop_request;
+static volatile bool recorder_failed;
+static uint32_t recorder_armed_ms;
+
+/* Segments of the storage device: erase count, and position in the log,
+ * 0 if the segment holds no complete record */
+static uint32_t recorder_num_segments;
+static uint32_t recorder_erase_counts[AUDIO_RECORDER_MAX_SEGMENTS];
+static uint32_t recorder_sequences[AUDIO_RECORDER_MAX_SEGMENTS];
+static uint32_t recorder_next_sequence;
+static uint32_t recorder_next_session;
+
+/* Segment erased ahead of the one being written, so that the log moves on
+ * to it without waiting for an erase */
+static bool recorder_spare_pending;
+static bool recorder_spare_ready;
+static uint32_t recorder_spare;
+
+/* Segment being written */
+static bool recorder_segment_open;
+static uint32_t recorder_segment;
+static uint32_t recorder_segment_offset;
+static recorder_wav_header_t recorder_header;
+
+/* Frames dropped in the current session */
+static uint32_t recorder_session_dropped;
+
+/* Device time spent in writes, and bytes written */
+static uint64_t recorder_busy_us;
+static uint64_t recorder_bytes;
+
+static audio_recorder_status_t recorder_status;
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_now_ms
+******************************************************************************
+* Summary:
+*  Current time of the RTOS tick.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Time in ms
+*
+*****************************************************************************/
+static uint32_t audio_recorder_now_ms(void)
+{
+    return (uint32_t) xTaskGetTickCount() * portTICK_PERIOD_MS;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_elapsed_us
+******************************************************************************
+* Summary:
+*  Time elapsed since a cycle count.
+*
+* Parameters:
+*  start: Cycle count at the start
+*
+* Return:
+*  uint32_t: Elapsed time in us
+*
+*****************************************************************************/
+static uint32_t audio_recorder_elapsed_us(uint32_t start)
+{
+    return (DWT->CYCCNT - start) / (SystemCoreClock / 1000000UL);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_drain
+******************************************************************************
+* Summary:
+*  Move the captured frames to the buffer. The frames that do not fit are
+*  dropped, so that the capture queue never fills.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_recorder_drain(void)
+{
+    uint32_t head = recorder_buffer_head;
+    uint32_t free_frames = (RECORDER_BUFFER_FRAMES) - (head - recorder_buffer_tail);
+    uint32_t index = head % (RECORDER_BUFFER_FRAMES);
+    uint32_t first = (RECORDER_BUFFER_FRAMES) - index;
+    uint32_t num_frames;
+    uint32_t dropped;
+
+    /* Up to the end of the buffer, then from its start */
+    if (first > free_frames)
+    {
+        first = free_frames;
+    }
+    num_frames = audio_in_offline_read(&recorder_buffer[index * AUDIO_IN_NUM_CHANNELS], first);
+    if (num_frames == first)
+    {
+        num_frames += audio_in_offline_read(recorder_buffer, free_frames - first);
+    }
+
+    __DMB();
+    recorder_buffer_head = head + num_frames;
+
+    if (((head + num_frames - recorder_buffer_tail) * AUDIO_IN_FRAME_SIZE_BYTES) > recorder_status.buffer_max_bytes)
+    {
+        recorder_status.buffer_max_bytes = (head + num_frames - recorder_buffer_tail) * AUDIO_IN_FRAME_SIZE_BYTES;
+    }
+
+    dropped = audio_in_offline_read(NULL, UINT32_MAX);
+    recorder_session_dropped += dropped;
+    recorder_status.dropped_frames += dropped;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_pick_segment
+******************************************************************************
+* Summary:
+*  Choose the next segment of the log, other than the open one. Segments
+*  without a complete record come first, the least erased one first, then
+*  the oldest segment of the log. The log then wraps over the device, which
+*  spreads the erases evenly.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Segment to write, UINT32_MAX if there is none
+*
+*****************************************************************************/
+static uint32_t audio_recorder_pick_segment(void)
+{
+    uint32_t best = UINT32_MAX;
+    bool best_empty = false;
+    bool empty;
+    bool better;
+
+    for (uint32_t segment = 0u; segment < recorder_num_segments; segment++)
+    {
+        if (recorder_segment_open && (segment == recorder_segment))
+        {
+            continue;
+        }
+
+        empty = (0u == recorder_sequences[segment]);
+        if (UINT32_MAX == best)
+        {
+            better = true;
+        }
+        else if (empty != best_empty)
+        {
+            better = empty;
+        }
+        else if (empty)
+        {
+            better = (recorder_erase_counts[segment] < recorder_erase_counts[best]);
+        }
+        else
+        {
+            better = (recorder_sequences[segment] < recorder_sequences[best]);
+        }
+
+        if (better)
+        {
+            best = segment;
+            best_empty = empty;
+        }
+    }
+
+    return best;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_write
+******************************************************************************
+* Summary:
+*  Write to the open segment, and time the write.
+*
+* Parameters:
+*  offset: Offset in the segment
+*  data: Bytes to write
+*  size: Number of bytes
+*
+* Return:
+*  bool: true if the device wrote the bytes
+*
+*****************************************************************************/
+static bool audio_recorder_write(uint32_t offset, const void *data, uint32_t size)
+{
+    uint32_t start = DWT->CYCCNT;
+    bool written = recorder_store->write(recorder_segment, offset, data, size);
+    uint32_t time_us = audio_recorder_elapsed_us(start);
+
+    if (time_us > recorder_status.write_max_us)
+    {
+        recorder_status.write_max_us = time_us;
+    }
+    recorder_busy_us += time_us;
+
+    if (written)
+    {
+        recorder_bytes += size;
+    }
+    else
+    {
+        recorder_status.errors++;
+    }
+
+    return written;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_start_spare
+******************************************************************************
+* Summary:
+*  Choose the segment that follows the open one in the log, and start its
+*  erase.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_recorder_start_spare(void)
+{
+    uint32_t segment = audio_recorder_pick_segment();
+
+    if (UINT32_MAX == segment)
+    {
+        return;
+    }
+
+    /* The record of the segment is gone from here on */
+    recorder_sequences[segment] = 0u;
+    recorder_erase_counts[segment]++;
+
+    recorder_spare = segment;
+    recorder_spare_pending = true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_erase_spare
+******************************************************************************
+* Summary:
+*  Erase the spare segment, a step at a time on a device with erase_step,
+*  and time the erase.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the device took the erase
+*
+*****************************************************************************/
+static bool audio_recorder_erase_spare(void)
+{
+    uint32_t start = DWT->CYCCNT;
+    bool done = false;
+    bool erased;
+    uint32_t time_us;
+
+    if (NULL != recorder_store->erase_step)
+    {
+        erased = recorder_store->erase_step(recorder_spare, &done);
+    }
+    else
+    {
+        erased = recorder_store->erase(recorder_spare);
+        done = erased;
+    }
+
+    time_us = audio_recorder_elapsed_us(start);
+    if (time_us > recorder_status.erase_max_us)
+    {
+        recorder_status.erase_max_us = time_us;
+    }
+
+    if (!erased)
+    {
+        recorder_status.errors++;
+        return false;
+    }
+
+    if (done)
+    {
+        recorder_spare_pending = false;
+        recorder_spare_ready = true;
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_open_segment
+******************************************************************************
+* Summary:
+*  Move on to the spare segment, once erased, and start writing its audio
+*  after the header space. The erase of the next spare then starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the device erased the segment
+*
+*****************************************************************************/
+static bool audio_recorder_open_segment(void)
+{
+    if ((!recorder_spare_pending) && (!recorder_spare_ready))
+    {
+        audio_recorder_start_spare();
+    }
+
+    /* The log caught up with the erase */
+    while (recorder_spare_pending)
+    {
+        if (!audio_recorder_erase_spare())
+        {
+            return false;
+        }
+    }
+
+    if (!recorder_spare_ready)
+    {
+        return false;
+    }
+
+    recorder_spare_ready = false;
+    recorder_segment = recorder_spare;
+    recorder_segment_offset = AUDIO_RECORDER_HEADER_BYTES;
+    recorder_segment_open = true;
+
+    audio_recorder_start_spare();
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_close_segment
+******************************************************************************
+* Summary:
+*  Write the WAV header of the open segment, now that its length is known.
+*  On a NOR flash, the header space is still erased and takes the write.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the device wrote the header
+*
+*****************************************************************************/
+static bool audio_recorder_close_segment(void)
+{
+    uint32_t data_bytes = recorder_segment_offset - (AUDIO_RECORDER_HEADER_BYTES);
+    recorder_wav_header_t *header = &recorder_header;
+
+    recorder_segment_open = false;
+
+    memset(header, 0, sizeof(*header));
+    memcpy(header->riff_id, "RIFF", 4u);
+    header->riff_size = ((AUDIO_RECORDER_HEADER_BYTES) - (RECORDER_WAV_CHUNK_BYTES)) + data_bytes;
+    memcpy(header->wave_id, "WAVE", 4u);
+    memcpy(header->fmt_id, "fmt ", 4u);
+    header->fmt_size = RECORDER_WAV_FMT_BYTES;
+    header->format = RECORDER_WAV_FORMAT_PCM;
+    header->channels = AUDIO_IN_NUM_CHANNELS;
+    header->sample_rate = AUDIO_IN_SAMPLE_FREQ;
+    header->byte_rate = (AUDIO_IN_SAMPLE_FREQ) * (AUDIO_IN_FRAME_SIZE_BYTES);
+    header->block_align = AUDIO_IN_FRAME_SIZE_BYTES;
+    header->bits_per_sample = 16u;
+    memcpy(header->aseg_id, "aseg", 4u);
+    header->aseg_size = sizeof(header->segment) + sizeof(header->pad);
+    header->segment.magic = AUDIO_RECORDER_MAGIC;
+    header->segment.sequence = recorder_next_sequence;
+    header->segment.session = recorder_next_session - 1u;
+    header->segment.erase_count = recorder_erase_counts[recorder_segment];
+    header->segment.frames = data_bytes / (AUDIO_IN_FRAME_SIZE_BYTES);
+    header->segment.dropped_frames = recorder_session_dropped;
+    memcpy(header->data_id, "data", 4u);
+    header->data_size = data_bytes;
+
+    if (!audio_recorder_write(0u, header, sizeof(*header)))
+    {
+        return false;
+    }
+
+    recorder_sequences[recorder_segment] = recorder_next_sequence++;
+    recorder_status.segments++;
+    recorder_status.frames += header->segment.frames;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_store_step
+******************************************************************************
+* Summary:
+*  Write the next block of the buffer to the log, at most
+*  AUDIO_RECORDER_WRITE_BYTES. While recording, only full blocks are
+*  written. Opens and closes the segments on the way.
+*
+* Parameters:
+*  flushing: true once the capture has stopped
+*
+* Return:
+*  bool: true if there was a block to write
+*
+*****************************************************************************/
+static bool audio_recorder_store_step(bool flushing)
+{
+    uint32_t tail = recorder_buffer_tail;
+    uint32_t index = tail % (RECORDER_BUFFER_FRAMES);
+    uint32_t num_frames = recorder_buffer_head - tail;
+    uint32_t room_frames;
+
+    if ((num_frames < (RECORDER_WRITE_FRAMES)) && ((!flushing) || (0u == num_frames)))
+    {
+        return false;
+    }
+
+    if ((!recorder_segment_open) && (!audio_recorder_open_segment()))
+    {
+        recorder_failed = true;
+        return false;
+    }
+
+    /* Within a block, the end of the buffer and the end of the segment */
+    room_frames = (recorder_store->segment_bytes - recorder_segment_offset) / (AUDIO_IN_FRAME_SIZE_BYTES);
+    if (num_frames > (RECORDER_WRITE_FRAMES))
+    {
+        num_frames = RECORDER_WRITE_FRAMES;
+    }
+    if (num_frames > ((RECORDER_BUFFER_FRAMES) - index))
+    {
+        num_frames = (RECORDER_BUFFER_FRAMES) - index;
+    }
+    if (num_frames > room_frames)
+    {
+        num_frames = room_frames;
+    }
+
+    if (!audio_recorder_write(recorder_segment_offset, &recorder_buffer[index * AUDIO_IN_NUM_CHANNELS],
+                              num_frames * AUDIO_IN_FRAME_SIZE_BYTES))
+    {
+        recorder_failed = true;
+        return false;
+    }
+
+    recorder_segment_offset += num_frames * AUDIO_IN_FRAME_SIZE_BYTES;
+    recorder_buffer_tail = tail + num_frames;
+
+    if ((num_frames == room_frames) && (!audio_recorder_close_segment()))
+    {
+        recorder_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_store_poll
+******************************************************************************
+* Summary:
+*  Write the next block of the buffer to the log, and take the next step of
+*  the erase of the spare segment. Complete the log once the capture has
+*  stopped.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if there is more to do at once
+*
+*****************************************************************************/
+static bool audio_recorder_store_poll(void)
+{
+    bool flushing = (AUDIO_RECORDER_FLUSHING == recorder_state);
+    bool written;
+
+    if (recorder_failed)
+    {
+        /* Drop the audio until the next session */
+        recorder_segment_open = false;
+        recorder_buffer_tail = recorder_buffer_head;
+        return false;
+    }
+
+    if ((AUDIO_RECORDER_ARMED == recorder_state) && (!recorder_segment_open) && (!recorder_spare_pending) &&
+        (!recorder_spare_ready))
+    {
+        /* Erase the first segment during the start delay */
+        audio_recorder_start_spare();
+    }
+
+    written = audio_recorder_store_step(flushing);
+    if (recorder_failed)
+    {
+        return false;
+    }
+
+    if (recorder_spare_pending)
+    {
+        /* Between the blocks */
+        if (!audio_recorder_erase_spare())
+        {
+            recorder_failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    if (written)
+    {
+        return true;
+    }
+
+    if (flushing)
+    {
+        if ((!recorder_segment_open) || audio_recorder_close_segment())
+        {
+            printf("APP_LOG: Recorder: %lu frames in %lu segments, %lu dropped, "
+                   "write max %lu us, erase max %lu us\r\n",
+                   (unsigned long) recorder_status.frames, (unsigned long) recorder_status.segments,
+                   (unsigned long) recorder_status.dropped_frames,
+                   (unsigned long) recorder_status.write_max_us,
+                   (unsigned long) recorder_status.erase_max_us);
+            recorder_state = AUDIO_RECORDER_IDLE;
+        }
+        else
+        {
+            recorder_failed = true;
+        }
+    }
+
+    return false;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_store_task
+******************************************************************************
+* Summary:
+*  Audio Store Task: write the buffer to the storage device, and complete
+*  the log once the capture has stopped. Runs below the other audio tasks:
+*  the device may block it for the length of an erase, or of an erase step
+*  on a device with erase_step.
+*
+* Parameters:
+*  arg: Unused
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_recorder_store_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        if (!audio_recorder_store_poll())
+        {
+            vTaskDelay(pdMS_TO_TICKS(AUDIO_RECORDER_DRAIN_MS));
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_capture_poll
+******************************************************************************
+* Summary:
+*  Start and stop the capture, and move the captured frames to the buffer.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_recorder_capture_poll(void)
+{
+    switch (recorder_state)
+    {
+        case AUDIO_RECORDER_IDLE:
+        case AUDIO_RECORDER_FAILED:
+            recorder_stop_request = false;
+            if (recorder_arm_request)
+            {
+                recorder_arm_request = false;
+                recorder_failed = false;
+                recorder_armed_ms = audio_recorder_now_ms();
+                recorder_state = AUDIO_RECORDER_ARMED;
+            }
+            break;
+
+        case AUDIO_RECORDER_ARMED:
+            if (recorder_stop_request)
+            {
+                recorder_stop_request = false;
+                recorder_state = AUDIO_RECORDER_IDLE;
+            }
+            else if ((audio_recorder_now_ms() - recorder_armed_ms) >= AUDIO_RECORDER_START_DELAY_MS)
+            {
+                recorder_status.sessions++;
+                recorder_next_session++;
+                recorder_session_dropped = 0u;
+                audio_in_offline_enable();
+                recorder_state = AUDIO_RECORDER_RECORDING;
+
+                printf("APP_LOG: Recorder: recording to %s\r\n", recorder_store->name);
+            }
+            else
+            {
+                /* Waiting for the start delay */
+            }
+            break;
+
+        case AUDIO_RECORDER_RECORDING:
+            audio_recorder_drain();
+            if (recorder_failed)
+            {
+                audio_in_offline_disable();
+                recorder_state = AUDIO_RECORDER_FAILED;
+
+                printf("APP_LOG: Recorder: %s failed, recording stopped\r\n", recorder_store->name);
+            }
+            else if (recorder_stop_request)
+            {
+                recorder_stop_request = false;
+                audio_in_offline_disable();
+                audio_recorder_drain();
+                recorder_state = AUDIO_RECORDER_FLUSHING;
+            }
+            else
+            {
+                /* Keep recording */
+            }
+            break;
+
+        case AUDIO_RECORDER_FLUSHING:
+        default:
+            recorder_stop_request = false;
+            if (recorder_failed)
+            {
+                recorder_state = AUDIO_RECORDER_FAILED;
+            }
+            break;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_capture_task
+******************************************************************************
+* Summary:
+*  Audio Rec Task: start and stop the capture, and move the captured frames
+*  to the buffer every AUDIO_RECORDER_DRAIN_MS.
+*
+* Parameters:
+*  arg: Unused
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_recorder_capture_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(AUDIO_RECORDER_DRAIN_MS));
+        audio_recorder_capture_poll();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_init
+******************************************************************************
+* Summary:
+*  Open the storage device, find the log left by the previous sessions and
+*  start the recorder tasks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_recorder_init(void)
+{
+    BaseType_t rtos_task_status;
+    uint32_t erase_count_max = 0u;
+
+    recorder_num_segments = recorder_store->num_segments;
+    if (recorder_num_segments > AUDIO_RECORDER_MAX_SEGMENTS)
+    {
+        recorder_num_segments = AUDIO_RECORDER_MAX_SEGMENTS;
+    }
+
+    if (!recorder_store->init())
+    {
+        recorder_state = AUDIO_RECORDER_FAILED;
+        printf("APP_LOG: Recorder: %s not available\r\n", recorder_store->name);
+        return;
+    }
+
+    /* Continue the log */
+    for (uint32_t segment = 0u; segment < recorder_num_segments; segment++)
+    {
+        if ((recorder_store->read(segment, 0u, &recorder_header, sizeof(recorder_header))) &&
+            (AUDIO_RECORDER_MAGIC == recorder_header.segment.magic))
+        {
+            recorder_sequences[segment] = recorder_header.segment.sequence;
+            recorder_erase_counts[segment] = recorder_header.segment.erase_count;
+
+            if (recorder_header.segment.erase_count > erase_count_max)
+            {
+                erase_count_max = recorder_header.segment.erase_count;
+            }
+            if (recorder_header.segment.sequence >= recorder_next_sequence)
+            {
+                recorder_next_sequence = recorder_header.segment.sequence + 1u;
+            }
+            if (recorder_header.segment.session >= recorder_next_session)
+            {
+                recorder_next_session = recorder_header.segment.session + 1u;
+            }
+        }
+    }
+    if (0u == recorder_next_sequence)
+    {
+        recorder_next_sequence = 1u;
+    }
+
+    /* The erase count of a segment without a record is lost, such as the
+     * spare erased ahead of the log: count it as the most erased one */
+    for (uint32_t segment = 0u; segment < recorder_num_segments; segment++)
+    {
+        if (0u == recorder_sequences[segment])
+        {
+            recorder_erase_counts[segment] = erase_count_max;
+        }
+    }
+
+    rtos_task_status = xTaskCreate(audio_recorder_capture_task, "Audio Rec Task", AUDIO_TASK_STACK_DEPTH, NULL,
+                                   AUDIO_REC_TASK_PRIORITY, NULL);
+    if (pdPASS != rtos_task_status)
+    {
+        handle_app_error();
+    }
+
+    rtos_task_status = xTaskCreate(audio_recorder_store_task, "Audio Store Task", AUDIO_TASK_STACK_DEPTH, NULL,
+                                   AUDIO_STORE_TASK_PRIORITY, NULL);
+    if (pdPASS != rtos_task_status)
+    {
+        handle_app_error();
+    }
+
+    printf("APP_LOG: Recorder: %lu segments of %lu bytes on %s\r\n",
+           (unsigned long) recorder_num_segments, (unsigned long) recorder_store->segment_bytes,
+           recorder_store->name);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_arm
+******************************************************************************
+* Summary:
+*  Start recording after AUDIO_RECORDER_START_DELAY_MS. Called when no host
+*  is connected.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_recorder_arm(void)
+{
+    recorder_stop_request = false;
+    recorder_arm_request = true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_stop
+******************************************************************************
+* Summary:
+*  Stop recording, and wait until the recorder has released the capture
+*  queue. The buffered audio is written in the background. Called when a
+*  host is connected, before the stream starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_recorder_stop(void)
+{
+    recorder_arm_request = false;
+    recorder_stop_request = true;
+
+    while ((AUDIO_RECORDER_ARMED == recorder_state) || (AUDIO_RECORDER_RECORDING == recorder_state))
+    {
+        vTaskDelay(pdMS_TO_TICKS(AUDIO_RECORDER_DRAIN_MS));
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_recorder_get_status
+******************************************************************************
+* Summary:
+*  Get the status of the recorder, with the wear of the storage device and
+*  its measured write throughput.
+*
+* Parameters:
+*  status: Destination of the status
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_recorder_get_status(audio_recorder_status_t *status)
+{
+    *status = recorder_status;
+    status->state = (uint8_t) recorder_state;
+
+    status->erase_count_min = UINT32_MAX;
+    status->erase_count_max = 0u;
+    for (uint32_t segment = 0u; segment < recorder_num_segments; segment++)
+    {
+        if (recorder_erase_counts[segment] < status->erase_count_min)
+        {
+            status->erase_count_min = recorder_erase_counts[segment];
+        }
+        if (recorder_erase_counts[segment] > status->erase_count_max)
+        {
+            status->erase_count_max = recorder_erase_counts[segment];
+        }
+    }
+    if (0u == recorder_num_segments)
+    {
+        status->erase_count_min = 0u;
+    }
+
+    status->throughput_kib_s = (0u != recorder_busy_us) ?
+                               (uint32_t) ((recorder_bytes * 1000000u) / (recorder_busy_us * 1024u)) : 0u;
+}
+
+#endif /* AUDIO_RECORDER_ENABLE */
+
+/* [] END OF FILE */
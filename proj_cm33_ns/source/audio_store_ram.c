@@ -0,0 +1,157 @@
+/*****************************************************************************
+* File Name        : audio_store_ram.c
+*
+* Description      : This file implements the RAM storage backend of the offline
+*                    recorder.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_recorder.h"
+
+#if (AUDIO_RECORDER_ENABLE)
+
+#include "audio_store.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static uint8_t store_ram[AUDIO_STORE_RAM_SEGMENTS][AUDIO_STORE_RAM_SEGMENT_BYTES];
+
+
+/*****************************************************************************
+* Function Name: audio_store_ram_init
+******************************************************************************
+* Summary:
+*  Erase the whole store. RAM keeps nothing over a reset.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true
+*
+*****************************************************************************/
+static bool audio_store_ram_init(void)
+{
+    memset(store_ram, 0xFF, sizeof(store_ram));
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_store_ram_read
+******************************************************************************
+* Summary:
+*  Read bytes of a segment.
+*
+* Parameters:
+*  segment: Segment to read
+*  offset: Offset in the segment
+*  data: Destination of the bytes
+*  size: Number of bytes
+*
+* Return:
+*  bool: true
+*
+*****************************************************************************/
+static bool audio_store_ram_read(uint32_t segment, uint32_t offset, void *data, uint32_t size)
+{
+    memcpy(data, &store_ram[segment][offset], size);
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_store_ram_erase
+******************************************************************************
+* Summary:
+*  Erase a segment.
+*
+* Parameters:
+*  segment: Segment to erase
+*
+* Return:
+*  bool: true
+*
+*****************************************************************************/
+static bool audio_store_ram_erase(uint32_t segment)
+{
+    memset(store_ram[segment], 0xFF, AUDIO_STORE_RAM_SEGMENT_BYTES);
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_store_ram_write
+******************************************************************************
+* Summary:
+*  Write bytes of a segment.
+*
+* Parameters:
+*  segment: Segment to write
+*  offset: Offset in the segment
+*  data: Bytes to write
+*  size: Number of bytes
+*
+* Return:
+*  bool: true
+*
+*****************************************************************************/
+static bool audio_store_ram_write(uint32_t segment, uint32_t offset, const void *data, uint32_t size)
+{
+    memcpy(&store_ram[segment][offset], data, size);
+    return true;
+}
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+const audio_store_backend_t audio_store_ram =
+{
+    .name = "RAM",
+    .num_segments = AUDIO_STORE_RAM_SEGMENTS,
+    .segment_bytes = AUDIO_STORE_RAM_SEGMENT_BYTES,
+    .init = audio_store_ram_init,
+    .read = audio_store_ram_read,
+    .erase = audio_store_ram_erase,
+    .write = audio_store_ram_write,
+};
+
+#endif /* AUDIO_RECORDER_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,387 @@
+/*****************************************************************************
+* File Name        : audio_timestamp.c
+*
+* Description      : This file contains the timestamps of the captured audio and
+*                    their mapping to the USB time of the host.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_timestamp.h"
+#include "audio.h"
+#include "audio_hot.h"
+#include "cybsp.h"
+#include <math.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define AUDIO_TIMESTAMP_MICROFRAMES_PER_S   (8000.0f)
+#define AUDIO_TIMESTAMP_NS_PER_MICROFRAME   (125000.0f)
+#define AUDIO_TIMESTAMP_USB_ONE             ((float) (1u << (AUDIO_TIMESTAMP_USB_FRAC_BITS)))
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Newest captured frame and the cycle count it was read at, set by the
+ * PDM-PCM interrupt */
+static volatile uint32_t ts_anchor_position;
+static volatile uint32_t ts_anchor_cycles;
+
+/* Nominal clocks: device cycles per audio frame, and USB microframes per
+ * device cycle */
+static float ts_cycles_per_frame;
+static float ts_nominal_rate;
+
+/* Nominal packets per device cycle */
+static float ts_packet_rate;
+
+/* USB time counted from the Audio IN endpoint, in microframes, and the
+ * cycle count of the last packet */
+static uint32_t ts_usb_count;
+static uint32_t ts_last_cycles;
+
+/* Alpha-beta filter: estimated USB time minus ts_usb_count at the last
+ * packet, and estimated USB microframes per device cycle */
+static float ts_phase;
+static float ts_rate;
+
+/* Residual of the estimator, in microframes */
+static float ts_residual_sum_squares;
+static float ts_residual_max;
+static uint32_t ts_residual_count;
+
+/* Last stamped packet */
+static audio_timestamp_status_t ts_status;
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_elapsed
+******************************************************************************
+* Summary:
+*  Convert a difference of cycle counts to the device time seen by the
+*  estimator, with the test offset applied.
+*
+* Parameters:
+*  delta: Difference of two cycle counts
+*
+* Return:
+*  float: Elapsed device cycles
+*
+*****************************************************************************/
+static inline float audio_timestamp_elapsed(int32_t delta)
+{
+#if (AUDIO_TIMESTAMP_TEST_OFFSET_PPM != 0)
+    return (float) delta * (1.0f + ((float) (AUDIO_TIMESTAMP_TEST_OFFSET_PPM) * 1e-6f));
+#else
+    return (float) delta;
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_init
+******************************************************************************
+* Summary:
+*  Compute the nominal clock ratios.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_timestamp_init(void)
+{
+    ts_cycles_per_frame = (float) SystemCoreClock / (float) AUDIO_IN_SAMPLE_FREQ;
+    ts_nominal_rate = AUDIO_TIMESTAMP_MICROFRAMES_PER_S / (float) SystemCoreClock;
+    ts_packet_rate = ts_nominal_rate / (float) AUDIO_IN_EP_INTERVAL;
+    ts_rate = ts_nominal_rate;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_capture
+******************************************************************************
+* Summary:
+*  Record the capture time of the newest frame. Called by the PDM-PCM
+*  interrupt after it has moved the frames to the capture queue.
+*
+* Parameters:
+*  position: Capture position of the newest frame
+*  cycles: Cycle count when the frame was read from the FIFO
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_timestamp_capture(uint32_t position, uint32_t cycles)
+{
+    ts_anchor_position = position;
+    ts_anchor_cycles = cycles;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_start
+******************************************************************************
+* Summary:
+*  Restart the USB time at the first packet of a recording session. The
+*  rate estimate is kept from the previous session.
+*
+* Parameters:
+*  cycles: Cycle count of the first packet request
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_timestamp_start(uint32_t cycles)
+{
+    ts_usb_count = 0u;
+    ts_last_cycles = cycles;
+    ts_phase = 0.0f;
+    ts_status.packets = 0u;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_usb_packet
+******************************************************************************
+* Summary:
+*  Advance the USB time by one service interval of the Audio IN endpoint
+*  and correct the estimate. The endpoint asks for a packet once per
+*  interval of the host, so the requests follow the USB clock with the
+*  jitter of the task scheduling, which the filter removes.
+*
+* Parameters:
+*  cycles: Cycle count of the packet request
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_timestamp_usb_packet(uint32_t cycles)
+{
+    float dt = audio_timestamp_elapsed((int32_t) (cycles - ts_last_cycles));
+    float residual;
+
+    /* Prediction relative to the new USB count, and its error */
+    ts_phase += (ts_rate * dt) - (float) AUDIO_IN_EP_INTERVAL;
+    residual = -ts_phase;
+
+    /* The rate correction uses the nominal interval: the measured one is
+     * correlated with the residual and would bias the rate */
+    ts_phase += AUDIO_TIMESTAMP_ALPHA * residual;
+    ts_rate += AUDIO_TIMESTAMP_BETA * residual * ts_packet_rate;
+
+    ts_usb_count += AUDIO_IN_EP_INTERVAL;
+    ts_last_cycles = cycles;
+    ts_status.packets++;
+
+    /* The first packets only settle the filter */
+    if (ts_status.packets > (uint32_t) (2.0f / AUDIO_TIMESTAMP_ALPHA))
+    {
+        ts_residual_sum_squares += residual * residual;
+        ts_residual_count++;
+        if (fabsf(residual) > ts_residual_max)
+        {
+            ts_residual_max = fabsf(residual);
+        }
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_stamp
+******************************************************************************
+* Summary:
+*  Return the capture time and the USB time of a frame of the capture
+*  queue. The capture time is extrapolated from the newest captured frame
+*  at the nominal sampling rate, and mapped to the USB time with the
+*  estimate of the last packet.
+*
+* Parameters:
+*  position: Capture position of the frame
+*  capture_cycles: Destination of the cycle count of its capture
+*  usb_time: Destination of its USB time, in 1/256 microframe
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_timestamp_stamp(uint32_t position, uint32_t *capture_cycles, uint32_t *usb_time)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t anchor_position = ts_anchor_position;
+    uint32_t anchor_cycles = ts_anchor_cycles;
+    float usb;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    *capture_cycles = anchor_cycles - (uint32_t) ((float) (int32_t) (anchor_position - position) * ts_cycles_per_frame);
+
+    usb = ts_phase + (ts_rate * audio_timestamp_elapsed((int32_t) (*capture_cycles - ts_last_cycles)));
+    *usb_time = (ts_usb_count << AUDIO_TIMESTAMP_USB_FRAC_BITS) + (uint32_t) (int32_t) lrintf(usb * AUDIO_TIMESTAMP_USB_ONE);
+
+    ts_status.position = position;
+    ts_status.usb_time = *usb_time;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_get_anchor
+******************************************************************************
+* Summary:
+*  Return the newest captured frame and the cycle count it was read at.
+*
+* Parameters:
+*  position: Destination of the capture position of the frame
+*  cycles: Destination of its cycle count
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_timestamp_get_anchor(uint32_t *position, uint32_t *cycles)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *position = ts_anchor_position;
+    *cycles = ts_anchor_cycles;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_usb_time
+******************************************************************************
+* Summary:
+*  Map a cycle count near the last packet to the USB time, with the
+*  estimate of the last packet. The phase of the estimate averages the
+*  jitter over many more packets than its rate, so the USB time elapsed
+*  between two calls a second apart is accurate to about a ppm.
+*
+* Parameters:
+*  cycles: Cycle count
+*
+* Return:
+*  uint32_t: USB time since the session start, in 1/256 microframe
+*
+*****************************************************************************/
+uint32_t audio_timestamp_usb_time(uint32_t cycles)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t usb_count = ts_usb_count;
+    uint32_t last_cycles = ts_last_cycles;
+    float phase = ts_phase;
+    float rate = ts_rate;
+    float usb;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    usb = phase + (rate * audio_timestamp_elapsed((int32_t) (cycles - last_cycles)));
+
+    return (usb_count << AUDIO_TIMESTAMP_USB_FRAC_BITS) + (uint32_t) (int32_t) lrintf(usb * AUDIO_TIMESTAMP_USB_ONE);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_get_status
+******************************************************************************
+* Summary:
+*  Return the timing of the last stamped packet and the state of the
+*  estimator.
+*
+* Parameters:
+*  status: Destination of the status
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_timestamp_get_status(audio_timestamp_status_t *status)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    float rate = ts_rate;
+    float sum_squares = ts_residual_sum_squares;
+    float max = ts_residual_max;
+    uint32_t count = ts_residual_count;
+
+    *status = ts_status;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    status->rate_ppb = (int32_t) lrintf(((ts_nominal_rate / rate) - 1.0f) * 1e9f);
+    status->jitter_rms_ns = (0u != count) ?
+                            (uint32_t) (sqrtf(sum_squares / (float) count) * AUDIO_TIMESTAMP_NS_PER_MICROFRAME) : 0u;
+    status->jitter_max_ns = (uint32_t) (max * AUDIO_TIMESTAMP_NS_PER_MICROFRAME);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_timestamp_reset_stats
+******************************************************************************
+* Summary:
+*  Clear the residual statistics of the estimator.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_timestamp_reset_stats(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    ts_residual_sum_squares = 0.0f;
+    ts_residual_max = 0.0f;
+    ts_residual_count = 0u;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,311 @@
+/*****************************************************************************
+* File Name        : audio_trace.c
+*
+* Description      : This file contains the trace recorder that logs task switches,
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_trace.h"
+#include "audio_hot.h"
+
+#if (AUDIO_TRACE_ENABLE)
+
+#include "cybsp.h"
+#include "retarget_io_init.h"
+#include <stdbool.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define AUDIO_TRACE_MASK                    ((AUDIO_TRACE_NUM_EVENTS) - 1u)
+#define AUDIO_TRACE_NAME_LEN                (16u)
+
+/* Events recorded at init to measure the cost of one event */
+#define AUDIO_TRACE_CALIBRATION_EVENTS      (64u)
+
+#if (0u != ((AUDIO_TRACE_NUM_EVENTS) & (AUDIO_TRACE_MASK)))
+#error "AUDIO_TRACE_NUM_EVENTS must be a power of 2."
+#endif
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Event ring, also readable from the debugger */
+audio_trace_event_t audio_trace_events[AUDIO_TRACE_NUM_EVENTS];
+
+/* Number of events recorded, the next one goes to head & AUDIO_TRACE_MASK */
+static volatile uint32_t trace_head;
+static volatile bool trace_running;
+static volatile bool trace_dump_pending;
+static uint32_t trace_cycles_per_event;
+
+/* Task names indexed by the FreeRTOS task number */
+static char trace_task_names[AUDIO_TRACE_MAX_TASKS][AUDIO_TRACE_NAME_LEN];
+
+
+/*****************************************************************************
+* Function Name: audio_trace_init
+******************************************************************************
+* Summary:
+*  Measure the cost of recording one event and start recording. Called
+*  before the tasks are created so that their names are captured. The DWT
+*  cycle counter used for the timestamps runs from audio_boot_init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_trace_init(void)
+{
+    uint32_t start;
+    uint32_t i;
+
+    trace_head = 0u;
+    trace_running = true;
+
+    start = DWT->CYCCNT;
+    for (i = 0u; i < AUDIO_TRACE_CALIBRATION_EVENTS; i++)
+    {
+        audio_trace_record(AUDIO_TRACE_TYPE_MARK, 0u, (uint16_t) i);
+    }
+    trace_cycles_per_event = (DWT->CYCCNT - start) / AUDIO_TRACE_CALIBRATION_EVENTS;
+
+    trace_head = 0u;
+
+    printf("APP_LOG: Trace: %lu events, %lu cycles per event\r\n",
+           (unsigned long) AUDIO_TRACE_NUM_EVENTS, (unsigned long) trace_cycles_per_event);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_trace_record
+******************************************************************************
+* Summary:
+*  Record one event. The slot and the timestamp are taken with the interrupts
+*  masked so that events of nested interrupts stay in time order. Safe to
+*  call from tasks, interrupts and the FreeRTOS trace hooks.
+*
+* Parameters:
+*  type: AUDIO_TRACE_TYPE_*
+*  id: Task number, interrupt or audio event
+*  arg: Event data
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_trace_record(uint8_t type, uint8_t id, uint16_t arg)
+{
+    audio_trace_event_t *event;
+    uint32_t primask;
+    uint32_t timestamp;
+
+    if (!trace_running)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    timestamp = DWT->CYCCNT;
+    event = &audio_trace_events[trace_head & AUDIO_TRACE_MASK];
+    trace_head++;
+    __set_PRIMASK(primask);
+
+    event->timestamp = timestamp;
+    event->type = type;
+    event->id = id;
+    event->arg = arg;
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_trace_task_create
+******************************************************************************
+* Summary:
+*  Save the name of a new task. Called from the traceTASK_CREATE() hook.
+*
+* Parameters:
+*  task_number: FreeRTOS task number, as recorded in the task switch events
+*  name: Task name
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_trace_task_create(uint32_t task_number, const char *name)
+{
+    if (task_number < AUDIO_TRACE_MAX_TASKS)
+    {
+        strncpy(trace_task_names[task_number], name, AUDIO_TRACE_NAME_LEN - 1u);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_trace_command
+******************************************************************************
+* Summary:
+*  Execute a command of the AUDIO_CTRL_TRACE control. Start clears the ring.
+*  The dump is deferred to audio_trace_poll() as printing is too slow for
+*  the USB interrupt.
+*
+* Parameters:
+*  command: AUDIO_TRACE_CMD_*
+*
+* Return:
+*  int: 1 if the command is valid, 0 otherwise
+*
+*****************************************************************************/
+int audio_trace_command(uint8_t command)
+{
+    int valid = 1;
+
+    switch (command)
+    {
+        case AUDIO_TRACE_CMD_STOP:
+            trace_running = false;
+            break;
+
+        case AUDIO_TRACE_CMD_START:
+            trace_running = false;
+            trace_head = 0u;
+            trace_running = true;
+            break;
+
+        case AUDIO_TRACE_CMD_DUMP:
+            trace_dump_pending = true;
+            break;
+
+        default:
+            valid = 0;
+            break;
+    }
+
+    return valid;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_trace_get_status
+******************************************************************************
+* Summary:
+*  Return the state of the recorder.
+*
+* Parameters:
+*  status: Filled with the current status
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_trace_get_status(audio_trace_status_t *status)
+{
+    memset(status, 0, sizeof(*status));
+
+    status->running = trace_running ? 1u : 0u;
+    status->events = trace_head;
+    status->capacity = AUDIO_TRACE_NUM_EVENTS;
+    status->cycles_per_event = trace_cycles_per_event;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_trace_poll
+******************************************************************************
+* Summary:
+*  Print a pending dump on the debug UART, oldest event first. Recording is
+*  paused while printing. tools/trace_to_perfetto.py converts the captured
+*  log into a trace viewable in Perfetto or chrome://tracing.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_trace_poll(void)
+{
+    bool was_running;
+    uint32_t first;
+    uint32_t i;
+
+    if (!trace_dump_pending)
+    {
+        return;
+    }
+    trace_dump_pending = false;
+
+    was_running = trace_running;
+    trace_running = false;
+
+    first = (trace_head > AUDIO_TRACE_NUM_EVENTS) ? (trace_head - AUDIO_TRACE_NUM_EVENTS) : 0u;
+
+    printf("APP_TRACE: BEGIN %lu %lu %lu\r\n", (unsigned long) SystemCoreClock,
+           (unsigned long) (trace_head - first), (unsigned long) trace_cycles_per_event);
+
+    for (i = 0u; i < AUDIO_TRACE_MAX_TASKS; i++)
+    {
+        if ('\0' != trace_task_names[i][0])
+        {
+            printf("APP_TRACE: TASK %lu %s\r\n", (unsigned long) i, trace_task_names[i]);
+        }
+    }
+
+    for (i = first; i != trace_head; i++)
+    {
+        const audio_trace_event_t *event = &audio_trace_events[i & AUDIO_TRACE_MASK];
+
+        printf("APP_TRACE: E %08lx %u %u %u\r\n", (unsigned long) event->timestamp,
+               event->type, event->id, event->arg);
+    }
+
+    printf("APP_TRACE: END\r\n");
+
+    trace_running = was_running;
+}
+
+#endif /* AUDIO_TRACE_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,393 @@
+/*****************************************************************************
+* File Name        : audio_vad.c
+*
+* Description      : This file contains the voice activity detector of the Audio IN path.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_vad.h"
+#include "audio.h"
+#include "audio_hot.h"
+#include "cybsp.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Frames in an analysis frame and in the hangover */
+#define AUDIO_VAD_FRAME_SAMPLES      (((AUDIO_IN_SAMPLE_FREQ) * (AUDIO_VAD_FRAME_MS)) / 1000u)
+#define AUDIO_VAD_HANGOVER_FRAMES    ((AUDIO_VAD_HANGOVER_MS) / (AUDIO_VAD_FRAME_MS))
+
+/* Energy above the noise floor needed for speech (4.0 = 6 dB), and above
+ * which the spectral check is skipped (31.6 = 15 dB) */
+#define AUDIO_VAD_SNR_THRESHOLD      (4.0f)
+#define AUDIO_VAD_SNR_STRONG         (31.6f)
+
+/* Range of the normalized first difference energy, 2 * (1 - r1) with r1 the
+ * lag-1 autocorrelation, for speech. Hum and rumble fall below the range,
+ * broadband noise close to 2 falls above it. */
+#define AUDIO_VAD_SPECTRUM_MIN       (0.005f)
+#define AUDIO_VAD_SPECTRUM_MAX       (1.2f)
+
+/* Noise floor tracking: follows the energy down at once, rises by about
+ * 3 dB/s so that a louder background is picked up */
+#define AUDIO_VAD_FLOOR_RISE         (1.007f)
+
+/* Floor of the noise estimate, about -90 dBFS */
+#define AUDIO_VAD_FLOOR_MIN          (1.0f)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static volatile audio_vad_mode_t vad_mode = AUDIO_VAD_DEFAULT_MODE;
+
+/* Accumulators of the current analysis frame */
+static uint64_t vad_energy;
+static uint64_t vad_diff_energy;
+static uint32_t vad_count;
+static int32_t vad_previous;
+
+static float vad_noise_floor;
+static bool vad_floor_valid;
+static uint32_t vad_hangover;
+static volatile bool vad_speech;
+
+static audio_vad_status_t vad_status;
+
+
+/*****************************************************************************
+* Function Name: audio_vad_decide
+******************************************************************************
+* Summary:
+*  Classify a completed analysis frame and update the speech state.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+static void audio_vad_decide(void)
+{
+    float energy = (float) vad_energy / (float) vad_count;
+    float diff_energy = (float) vad_diff_energy / (float) vad_count;
+    bool speech_frame = false;
+
+    if (!vad_floor_valid)
+    {
+        vad_noise_floor = energy;
+        vad_floor_valid = true;
+    }
+
+    if (energy > (vad_noise_floor * AUDIO_VAD_SNR_THRESHOLD))
+    {
+        float spectrum = diff_energy / energy;
+
+        speech_frame = (energy > (vad_noise_floor * AUDIO_VAD_SNR_STRONG)) ||
+                       ((spectrum > AUDIO_VAD_SPECTRUM_MIN) && (spectrum < AUDIO_VAD_SPECTRUM_MAX));
+    }
+
+    /* Track the floor on every frame: the fast fall follows the pauses
+     * within speech, the slow rise cannot follow speech itself */
+    if (energy < vad_noise_floor)
+    {
+        vad_noise_floor = energy;
+    }
+    else
+    {
+        vad_noise_floor *= AUDIO_VAD_FLOOR_RISE;
+    }
+
+    if (vad_noise_floor < AUDIO_VAD_FLOOR_MIN)
+    {
+        vad_noise_floor = AUDIO_VAD_FLOOR_MIN;
+    }
+
+    if (speech_frame)
+    {
+        if (!vad_speech)
+        {
+            vad_status.onsets++;
+        }
+        vad_speech = true;
+        vad_hangover = AUDIO_VAD_HANGOVER_FRAMES;
+    }
+    else if (vad_hangover > 0u)
+    {
+        vad_hangover--;
+    }
+    else
+    {
+        vad_speech = false;
+    }
+
+    vad_status.frames++;
+    if (vad_speech)
+    {
+        vad_status.speech_frames++;
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_vad_init
+******************************************************************************
+* Summary:
+*  Initialize the voice activity detector.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_vad_init(void)
+{
+    memset(&vad_status, 0, sizeof(vad_status));
+
+    audio_vad_reset();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_vad_reset
+******************************************************************************
+* Summary:
+*  Restart the detection from silence with a new noise floor. Called at the
+*  start of a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_vad_reset(void)
+{
+    vad_energy = 0u;
+    vad_diff_energy = 0u;
+    vad_count = 0u;
+    vad_previous = 0;
+
+    vad_floor_valid = false;
+    vad_hangover = 0u;
+    vad_speech = false;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_vad_set_mode
+******************************************************************************
+* Summary:
+*  Select what the speech state is used for. Takes effect at the next
+*  packet.
+*
+* Parameters:
+*  mode: VAD mode
+*
+* Return:
+*  bool: true if the mode exists, false otherwise
+*
+*****************************************************************************/
+bool audio_vad_set_mode(audio_vad_mode_t mode)
+{
+    if (mode >= AUDIO_VAD_MODE_COUNT)
+    {
+        return false;
+    }
+
+    vad_mode = mode;
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_vad_get_mode
+******************************************************************************
+* Summary:
+*  Return the VAD mode.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  audio_vad_mode_t
+*
+*****************************************************************************/
+audio_vad_mode_t audio_vad_get_mode(void)
+{
+    return vad_mode;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_vad_is_speech
+******************************************************************************
+* Summary:
+*  Return the speech state, including the hangover after the last speech
+*  frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while speech is detected
+*
+*****************************************************************************/
+bool audio_vad_is_speech(void)
+{
+    return vad_speech;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_vad_is_gated
+******************************************************************************
+* Summary:
+*  Check if the processing stages should be skipped and silence streamed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true in gate mode without speech
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+bool audio_vad_is_gated(void)
+{
+    return (AUDIO_VAD_MODE_GATE == vad_mode) && (!vad_speech);
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_vad_process
+******************************************************************************
+* Summary:
+*  Accumulate the energy and the first difference energy of the mix of both
+*  microphones, and take a decision at the end of every analysis frame.
+*
+* Parameters:
+*  samples: Interleaved block
+*  num_frames: Number of frames in the block
+*  num_channels: 2 for both microphones, 1 for a block already mixed
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+AUDIO_HOT_FUNC_BEGIN
+void audio_vad_process(const int16_t *samples, uint32_t num_frames, uint32_t num_channels)
+{
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        int32_t x = (1u == num_channels) ? samples[n] :
+                    (((int32_t) samples[(2u * n)] + samples[(2u * n) + 1u]) >> 1);
+        int32_t d = x - vad_previous;
+
+        vad_previous = x;
+        vad_energy += (uint64_t) ((int64_t) x * x);
+        vad_diff_energy += (uint64_t) ((int64_t) d * d);
+
+        if (++vad_count == AUDIO_VAD_FRAME_SAMPLES)
+        {
+            audio_vad_decide();
+
+            vad_energy = 0u;
+            vad_diff_energy = 0u;
+            vad_count = 0u;
+        }
+    }
+}
+AUDIO_HOT_FUNC_END
+
+
+/*****************************************************************************
+* Function Name: audio_vad_get_status
+******************************************************************************
+* Summary:
+*  Return a snapshot of the VAD status.
+*
+* Parameters:
+*  status: Destination of the snapshot
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_vad_get_status(audio_vad_status_t *status)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *status = vad_status;
+    status->speech = vad_speech ? 1u : 0u;
+    status->mode = (uint8_t) vad_mode;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_vad_clear_status
+******************************************************************************
+* Summary:
+*  Clear the VAD counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_vad_clear_status(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    memset(&vad_status, 0, sizeof(vad_status));
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/* [] END OF FILE */
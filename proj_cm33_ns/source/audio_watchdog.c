@@ -0,0 +1,340 @@
+/*****************************************************************************
+* File Name        : audio_watchdog.c
+*
+* Description      : This file contains the watchdog of the audio pipeline. It
+*                    watches the progress of the capture path from the Audio App
+*                    Task, and recovers from a stall in tiers: flush the capture
+*                    queue, restart the PDM-PCM channels, restart the stream.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_watchdog.h"
+#include "audio_in.h"
+#include "retarget_io_init.h"
+#include "rtos.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static const char *const watchdog_fault_names[AUDIO_WATCHDOG_NUM_FAULTS] =
+{
+    "packet",
+    "FIFO",
+    "write task",
+};
+
+static const char *const watchdog_tier_names[AUDIO_WATCHDOG_NUM_TIERS] =
+{
+    "flush",
+    "re-arm",
+    "restart",
+};
+
+static audio_watchdog_status_t watchdog_status;
+
+/* Set by the Audio In Task when the write task returns */
+static volatile bool watchdog_write_task_returned;
+
+/* Last progress seen, and when it was seen */
+static uint32_t watchdog_frames;
+static uint32_t watchdog_frames_ms;
+static uint32_t watchdog_requests;
+static uint32_t watchdog_requests_ms;
+
+/* Stall in progress */
+static bool watchdog_stalled;
+static audio_watchdog_fault_t watchdog_fault;
+static uint32_t watchdog_stall_start_ms;
+static uint32_t watchdog_action_ms;
+static audio_watchdog_tier_t watchdog_next_tier;
+static uint32_t watchdog_restarts;
+static bool watchdog_given_up;
+
+
+/*****************************************************************************
+* Function Name: audio_watchdog_now_ms
+******************************************************************************
+* Summary:
+*  Current time of the RTOS tick.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Time in ms
+*
+*****************************************************************************/
+static uint32_t audio_watchdog_now_ms(void)
+{
+    return (uint32_t) xTaskGetTickCount() * portTICK_PERIOD_MS;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_watchdog_start
+******************************************************************************
+* Summary:
+*  Start watching from the current progress. Called when the device is
+*  configured by the host, the stream having been stopped before.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_watchdog_start(void)
+{
+    audio_in_progress_t progress;
+    uint32_t now = audio_watchdog_now_ms();
+
+    audio_in_get_progress(&progress);
+
+    watchdog_frames = progress.frames;
+    watchdog_frames_ms = now;
+    watchdog_requests = progress.requests;
+    watchdog_requests_ms = now;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_watchdog_poll
+******************************************************************************
+* Summary:
+*  Check the progress of the capture path, and take the next recovery
+*  action of a stall once the previous one had AUDIO_WATCHDOG_TIMEOUT_MS to
+*  work. The restart of the stream on the USB side is left to the caller.
+*  Called periodically by the Audio App Task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the caller must restart the stream
+*
+*****************************************************************************/
+bool audio_watchdog_poll(void)
+{
+    audio_in_progress_t progress;
+    uint32_t now = audio_watchdog_now_ms();
+    bool stalled = true;
+    bool restart = false;
+    audio_watchdog_fault_t fault = AUDIO_WATCHDOG_FAULT_WRITE_TASK;
+    audio_watchdog_tier_t tier;
+
+    audio_in_get_progress(&progress);
+
+    if ((progress.frames != watchdog_frames) || (!progress.capturing))
+    {
+        watchdog_frames = progress.frames;
+        watchdog_frames_ms = now;
+    }
+    if ((progress.requests != watchdog_requests) || (!progress.streaming))
+    {
+        watchdog_requests = progress.requests;
+        watchdog_requests_ms = now;
+    }
+
+    if (watchdog_write_task_returned)
+    {
+        fault = AUDIO_WATCHDOG_FAULT_WRITE_TASK;
+    }
+    else if ((now - watchdog_frames_ms) >= AUDIO_WATCHDOG_TIMEOUT_MS)
+    {
+        fault = AUDIO_WATCHDOG_FAULT_FIFO;
+    }
+    else if ((now - watchdog_requests_ms) >= AUDIO_WATCHDOG_TIMEOUT_MS)
+    {
+        fault = AUDIO_WATCHDOG_FAULT_PACKETS;
+    }
+    else
+    {
+        stalled = false;
+    }
+
+    if (!stalled)
+    {
+        if (watchdog_stalled)
+        {
+            /* The pipeline moves again */
+            watchdog_stalled = false;
+            watchdog_status.recovered++;
+            watchdog_status.last_duration_ms = now - watchdog_stall_start_ms;
+            if (watchdog_status.last_duration_ms > watchdog_status.max_duration_ms)
+            {
+                watchdog_status.max_duration_ms = watchdog_status.last_duration_ms;
+            }
+
+            printf("APP_LOG: Watchdog: %s stall recovered after %lu ms\r\n",
+                   watchdog_fault_names[watchdog_fault], (unsigned long) watchdog_status.last_duration_ms);
+        }
+        return false;
+    }
+
+    if (!watchdog_stalled)
+    {
+        /* New stall: it started with the last progress seen */
+        watchdog_stalled = true;
+        watchdog_fault = fault;
+        watchdog_status.faults[fault]++;
+        watchdog_restarts = 0u;
+        watchdog_given_up = false;
+
+        if (AUDIO_WATCHDOG_FAULT_WRITE_TASK == fault)
+        {
+            /* Nothing short of a restart brings the write task back */
+            watchdog_stall_start_ms = now;
+            watchdog_next_tier = AUDIO_WATCHDOG_TIER_RESTART;
+        }
+        else
+        {
+            watchdog_stall_start_ms = (AUDIO_WATCHDOG_FAULT_FIFO == fault) ?
+                                      watchdog_frames_ms : watchdog_requests_ms;
+            watchdog_next_tier = AUDIO_WATCHDOG_TIER_FLUSH;
+        }
+        watchdog_action_ms = now - AUDIO_WATCHDOG_TIMEOUT_MS;
+
+        printf("APP_LOG: Watchdog: %s stall\r\n", watchdog_fault_names[fault]);
+    }
+
+    if ((now - watchdog_action_ms) < (watchdog_given_up ? AUDIO_WATCHDOG_RETRY_MS : AUDIO_WATCHDOG_TIMEOUT_MS))
+    {
+        /* Give the last action time to work */
+        return false;
+    }
+
+    tier = watchdog_next_tier;
+    watchdog_action_ms = now;
+    watchdog_status.actions[tier]++;
+
+    switch (tier)
+    {
+        case AUDIO_WATCHDOG_TIER_FLUSH:
+            audio_in_flush();
+            watchdog_next_tier = AUDIO_WATCHDOG_TIER_REARM;
+            break;
+
+        case AUDIO_WATCHDOG_TIER_REARM:
+            audio_in_rearm();
+            watchdog_next_tier = AUDIO_WATCHDOG_TIER_RESTART;
+            break;
+
+        case AUDIO_WATCHDOG_TIER_RESTART:
+        default:
+            audio_in_flush();
+            restart = true;
+
+            if (watchdog_write_task_returned)
+            {
+                watchdog_write_task_returned = false;
+                (void) xTaskNotifyGive(rtos_audio_in_task);
+            }
+
+            if ((++watchdog_restarts >= AUDIO_WATCHDOG_MAX_RESTARTS) && (!watchdog_given_up))
+            {
+                watchdog_given_up = true;
+                watchdog_status.given_up++;
+            }
+            break;
+    }
+
+    printf("APP_LOG: Watchdog: %s stall, %s%s\r\n", watchdog_fault_names[watchdog_fault],
+           watchdog_tier_names[tier], watchdog_given_up ? ", retrying slowly" : "");
+
+    return restart;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_watchdog_write_task_returned
+******************************************************************************
+* Summary:
+*  Report that USBD_AUDIO_Write_Task() returned. Called by the Audio In
+*  Task, which then waits for the watchdog to restart the stream.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_watchdog_write_task_returned(void)
+{
+    watchdog_write_task_returned = true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_watchdog_get_status
+******************************************************************************
+* Summary:
+*  Get the recovery record.
+*
+* Parameters:
+*  status: Destination of the record
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_watchdog_get_status(audio_watchdog_status_t *status)
+{
+    *status = watchdog_status;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_watchdog_reset_status
+******************************************************************************
+* Summary:
+*  Clear the recovery record.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_watchdog_reset_status(void)
+{
+    memset(&watchdog_status, 0, sizeof(watchdog_status));
+}
+
+/* [] END OF FILE */
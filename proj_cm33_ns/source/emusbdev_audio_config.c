@@ -65,7 +65,9 @@ const USB_DEVICE_INFO usb_deviceInfo =
 */
 static const USBD_AUDIO_FORMAT microphone_formats[] =
 {
-    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SAMPLE_FREQ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SAMPLE_FREQ}, /* AUDIO_IN_ALT_STEREO */
+    {0, 1,                     AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SAMPLE_FREQ}, /* AUDIO_IN_ALT_BEAM_MONO */
+    {0, 1,                     AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SAMPLE_FREQ}, /* AUDIO_IN_ALT_MONO */
 };
 
 static USBD_AUDIO_UNITS microphone_units;
@@ -85,4 +87,30 @@ const USBD_AUDIO_IF_CONF audio_interfaces[] =
     }
 };
 
+#if (AUDIO_IN_NUM_STREAMS > 1U)
+/* Second capture interface of the composite device, with its own Audio IN
+ * endpoint. See AUDIO_IN_NUM_STREAMS. */
+static const USBD_AUDIO_FORMAT raw_microphone_formats[] =
+{
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SAMPLE_FREQ},
+};
+
+static USBD_AUDIO_UNITS raw_microphone_units;
+
+const USBD_AUDIO_IF_CONF raw_audio_interfaces[] =
+{
+    /* Raw microphone config. */
+    {
+        0,                                  /* Flags */
+        0x03,                               /* Controls */
+        AUDIO_IN_NUM_CHANNELS,              /* TotalNrChannels */
+        SEGGER_COUNTOF(raw_microphone_formats), /* NumFormats */
+        raw_microphone_formats,             /* paFormats */
+        0x0000,                             /* bmChannelConfig (0x3: Left Front, Right Front) */
+        USB_AUDIO_TERMTYPE_INPUT_MICROPHONE,/* TerminalType */
+        &raw_microphone_units               /* pUnits */
+    }
+};
+#endif
+
 /* [] END OF FILE */
@@ -44,6 +44,8 @@
 *******************************************************************************/
 #include "retarget_io_init.h"
 #include "audio_app.h"
+#include "audio_boot.h"
+#include "audio_trace.h"
 #include "rtos.h"
 #include "cy_time.h"
 
@@ -208,6 +210,9 @@ int main(void)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
+    /* Time the boot stages from here on */
+    audio_boot_init();
+
     /* Initialize the device and board peripherals. */
     result = cybsp_init();
 
@@ -216,6 +221,7 @@ int main(void)
     {
         handle_app_error();
     }
+    audio_boot_mark(AUDIO_BOOT_BSP_INIT);
 
     /* Initialize retarget-io to use the debug UART port */
     init_retarget_io();
@@ -232,6 +238,7 @@ int main(void)
     /* Enable CM55. */
     /* CM55_APP_BOOT_ADDR must be updated if CM55 memory layout is changed.*/
     Cy_SysEnableCM55(MXCM55, CM55_APP_BOOT_ADDR, CM55_BOOT_WAIT_TIME_USEC);
+    audio_boot_mark(AUDIO_BOOT_CM55_START);
 
     /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
     printf("\x1b[2J\x1b[;H");
@@ -240,6 +247,11 @@ int main(void)
            " PSOC Edge MCU: Audio recorder using emUSB-device "
            "******************\r\n\n");
 
+#if (AUDIO_TRACE_ENABLE)
+    /* Start the trace recorder ahead of the tasks to capture their names */
+    audio_trace_init();
+#endif
+
     /* Initialize the Audio application */
     audio_app_init();
     
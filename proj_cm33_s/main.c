@@ -69,6 +69,12 @@ int main(void)
     cy_cmse_funcptr NonSecure_ResetHandler;
     cy_rslt_t result;
 
+    /* Start the cycle counter: the boot profiler of the non-secure
+     * application times its stages from here */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     /* Set up internal routing, pins, and clock-to-peripheral connections */
     result = cybsp_init();
 
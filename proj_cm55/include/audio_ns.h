@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name   : audio_ns.h
+*
+* Description : This file contains the STFT based noise suppressor run by the
+*               CM55 on the captured audio.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_NS_H
+#define AUDIO_NS_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Analysis frame size, a power of 2, and hop size (50 % overlap) */
+#define AUDIO_NS_FFT_SIZE                   (256u)
+#define AUDIO_NS_HOP_SIZE                   ((AUDIO_NS_FFT_SIZE) / 2u)
+
+/* Delay between the input and the output of the suppressor, in samples */
+#define AUDIO_NS_LATENCY_SAMPLES            (AUDIO_NS_FFT_SIZE)
+
+/* Number of channels processed together, packed into one complex FFT */
+#define AUDIO_NS_MAX_CHANNELS               (2u)
+
+/* Lowest gain applied to a noise-only bin (0.1 = -20 dB) */
+#define AUDIO_NS_GAIN_FLOOR                 (0.1f)
+
+/* Over-subtraction factor of the noise estimate */
+#define AUDIO_NS_OVER_SUBTRACTION           (2.0f)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_ns_init(void);
+void audio_ns_reset(void);
+void audio_ns_process(const int16_t *in, int16_t *out, uint32_t num_frames, uint32_t num_channels);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_NS_H */
+
+/* [] END OF FILE */
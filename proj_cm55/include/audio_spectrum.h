@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name   : audio_spectrum.h
+*
+* Description : This file contains the spectrum analyzer run by the CM55, which
+*               monitors the spectrum of the captured channels.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_SPECTRUM_H
+#define AUDIO_SPECTRUM_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Settings used when the CM33 asks for invalid ones */
+#define AUDIO_SPECTRUM_DEFAULT_FFT_SIZE     (512u)
+#define AUDIO_SPECTRUM_DEFAULT_HOP_SIZE     ((AUDIO_SPECTRUM_DEFAULT_FFT_SIZE) / 2u)
+#define AUDIO_SPECTRUM_DEFAULT_NUM_AVERAGE  (16u)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void audio_spectrum_init(void);
+void audio_spectrum_start(uint32_t fft_size, uint32_t hop_size, uint32_t num_average);
+bool audio_spectrum_process(const int16_t *in, uint32_t num_frames, uint32_t num_channels);
+void audio_spectrum_get_result(int16_t *level, uint32_t bins_per_channel, uint32_t *num_channels);
+void audio_spectrum_get_settings(uint32_t *fft_size, uint32_t *hop_size, uint32_t *num_average);
+void audio_spectrum_get_cycles(uint32_t *avg_cycles, uint32_t *max_cycles);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_SPECTRUM_H */
+
+/* [] END OF FILE */
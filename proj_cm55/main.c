@@ -43,6 +43,7 @@
 *******************************************************************************/
 
 #include "cybsp.h"
+#include "audio_worker.h"
 
 /*******************************************************************************
 * Function Name: main
@@ -50,8 +51,9 @@
 * Summary:
 * This is the main function for CM55 application. 
 * 
-* CM33 application enables the CM55 CPU and then the CM55 CPU enters 
-* deep sleep.
+* CM33 application enables the CM55 CPU. The CM55 CPU then processes the
+* audio blocks the CM33 offloads to it and sleeps until the CM33 signals
+* the next block.
 * 
 * Parameters:
 *  void
@@ -82,10 +84,16 @@ int main(void)
     /* Enable global interrupts. */
     __enable_irq();
 
-    /* Put the CPU to Deep Sleep. */
+    /* Initialize the audio processing stages */
+    audio_worker_init();
+
+    /* Process the offloaded blocks, then sleep until the CM33 sends an
+     * event: in Sleep while a session runs stages on the CM55, in Deep
+     * Sleep otherwise. */
     for (;;)
     {
-        Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+        audio_worker_poll();
+        audio_worker_sleep();
     }
 }
 
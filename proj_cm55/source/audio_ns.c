@@ -0,0 +1,445 @@
+/*****************************************************************************
+* File Name        : audio_ns.c
+*
+* Description      : This file contains the STFT based noise suppressor run by the
+*                    CM55 on the captured audio.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_ns.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define AUDIO_NS_NUM_BINS            (((AUDIO_NS_FFT_SIZE) / 2u) + 1u)
+
+/* Output ring per channel, a power of 2 larger than the prefill plus one
+ * hop plus the largest block */
+#define AUDIO_NS_OUT_RING_SIZE       (2u * (AUDIO_NS_FFT_SIZE))
+#define AUDIO_NS_OUT_RING_MASK       ((AUDIO_NS_OUT_RING_SIZE) - 1u)
+
+/* Recursive smoothing of the bin power the noise estimate follows */
+#define AUDIO_NS_POWER_SMOOTHING     (0.8f)
+
+/* Noise estimate tracking: follows the smoothed power down at once, rises
+ * slowly (about +4 dB/s at 48 ksps) so that speech does not lift it */
+#define AUDIO_NS_NOISE_RISE          (1.0025f)
+
+/* Ratio between the mean noise power and the tracked minimum of the
+ * smoothed power */
+#define AUDIO_NS_NOISE_BIAS          (1.5f)
+
+/* Temporal smoothing of the gains, reduces musical noise */
+#define AUDIO_NS_GAIN_SMOOTHING      (0.7f)
+
+#define AUDIO_NS_PI                  (3.14159265358979f)
+#define AUDIO_NS_EPSILON             (1.0e-6f)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Square root Hann window, used for analysis and synthesis */
+static float window[AUDIO_NS_FFT_SIZE];
+
+/* FFT twiddle factors and bit reversal permutation */
+static float twiddle_cos[(AUDIO_NS_FFT_SIZE) / 2u];
+static float twiddle_sin[(AUDIO_NS_FFT_SIZE) / 2u];
+static uint16_t bit_reverse[AUDIO_NS_FFT_SIZE];
+
+/* Last frame of input samples and number of new samples in it */
+static float in_frame[AUDIO_NS_MAX_CHANNELS][AUDIO_NS_FFT_SIZE];
+static uint32_t in_count;
+
+/* Overlap-add accumulator */
+static float ola[AUDIO_NS_MAX_CHANNELS][AUDIO_NS_FFT_SIZE];
+
+/* Output ring, free-running read and write counters */
+static float out_ring[AUDIO_NS_MAX_CHANNELS][AUDIO_NS_OUT_RING_SIZE];
+static uint32_t out_read;
+static uint32_t out_write;
+
+/* Per bin smoothed power, noise power estimate and smoothed gain */
+static float smooth_power[AUDIO_NS_MAX_CHANNELS][AUDIO_NS_NUM_BINS];
+static float noise_power[AUDIO_NS_MAX_CHANNELS][AUDIO_NS_NUM_BINS];
+static float gain[AUDIO_NS_MAX_CHANNELS][AUDIO_NS_NUM_BINS];
+static bool noise_valid;
+
+/* FFT work buffer */
+static float fft_re[AUDIO_NS_FFT_SIZE];
+static float fft_im[AUDIO_NS_FFT_SIZE];
+
+
+/*****************************************************************************
+* Function Name: audio_ns_fft
+******************************************************************************
+* Summary:
+*  In place radix-2 complex FFT.
+*
+* Parameters:
+*  re: Real part
+*  im: Imaginary part
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_ns_fft(float *re, float *im)
+{
+    for (uint32_t i = 0u; i < AUDIO_NS_FFT_SIZE; i++)
+    {
+        uint32_t j = bit_reverse[i];
+
+        if (j > i)
+        {
+            float tmp = re[i];
+            re[i] = re[j];
+            re[j] = tmp;
+            tmp = im[i];
+            im[i] = im[j];
+            im[j] = tmp;
+        }
+    }
+
+    for (uint32_t half = 1u; half < AUDIO_NS_FFT_SIZE; half <<= 1)
+    {
+        uint32_t stride = (AUDIO_NS_FFT_SIZE) / (2u * half);
+
+        for (uint32_t start = 0u; start < AUDIO_NS_FFT_SIZE; start += 2u * half)
+        {
+            for (uint32_t k = 0u; k < half; k++)
+            {
+                float wr = twiddle_cos[k * stride];
+                float wi = twiddle_sin[k * stride];
+                uint32_t a = start + k;
+                uint32_t b = a + half;
+                float tr = (re[b] * wr) - (im[b] * wi);
+                float ti = (re[b] * wi) + (im[b] * wr);
+
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ns_bin_gain
+******************************************************************************
+* Summary:
+*  Update the noise estimate of a bin and return its smoothed spectral
+*  subtraction gain.
+*
+* Parameters:
+*  channel: Channel index
+*  bin: Bin index
+*  power: Power of the bin in the current frame
+*
+* Return:
+*  float: Gain to apply to the bin
+*
+*****************************************************************************/
+static float audio_ns_bin_gain(uint32_t channel, uint32_t bin, float power)
+{
+    float smooth = smooth_power[channel][bin];
+    float noise = noise_power[channel][bin];
+    float g;
+
+    if (!noise_valid)
+    {
+        smooth = power;
+        noise = power;
+    }
+    else
+    {
+        smooth = (AUDIO_NS_POWER_SMOOTHING * smooth) + ((1.0f - AUDIO_NS_POWER_SMOOTHING) * power);
+        noise = (smooth < noise) ? smooth : (noise * AUDIO_NS_NOISE_RISE);
+    }
+    smooth_power[channel][bin] = smooth;
+    noise_power[channel][bin] = noise;
+
+    g = 1.0f - ((AUDIO_NS_OVER_SUBTRACTION * AUDIO_NS_NOISE_BIAS * noise) / (power + AUDIO_NS_EPSILON));
+    if (g < AUDIO_NS_GAIN_FLOOR)
+    {
+        g = AUDIO_NS_GAIN_FLOOR;
+    }
+
+    g = (AUDIO_NS_GAIN_SMOOTHING * gain[channel][bin]) + ((1.0f - AUDIO_NS_GAIN_SMOOTHING) * g);
+    gain[channel][bin] = g;
+
+    return g;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ns_process_frame
+******************************************************************************
+* Summary:
+*  Process one analysis frame of up to two channels and append one hop of
+*  output samples to the output ring. Both channels share one complex FFT,
+*  the first channel as the real part and the second one as the imaginary
+*  part, and are separated using the conjugate symmetry of real signals.
+*
+* Parameters:
+*  num_channels: Number of channels in the frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_ns_process_frame(uint32_t num_channels)
+{
+    const float scale = 1.0f / (float) AUDIO_NS_FFT_SIZE;
+
+    for (uint32_t n = 0u; n < AUDIO_NS_FFT_SIZE; n++)
+    {
+        fft_re[n] = in_frame[0][n] * window[n];
+        fft_im[n] = (num_channels > 1u) ? (in_frame[1][n] * window[n]) : 0.0f;
+    }
+
+    audio_ns_fft(fft_re, fft_im);
+
+    for (uint32_t k = 0u; k < AUDIO_NS_NUM_BINS; k++)
+    {
+        uint32_t kr = (AUDIO_NS_FFT_SIZE - k) & (AUDIO_NS_FFT_SIZE - 1u);
+        float zr = fft_re[k];
+        float zi = fft_im[k];
+        float cr = fft_re[kr];
+        float ci = -fft_im[kr];
+
+        /* X = (Z[k] + conj(Z[N-k])) / 2, Y = (Z[k] - conj(Z[N-k])) / 2j */
+        float xr = 0.5f * (zr + cr);
+        float xi = 0.5f * (zi + ci);
+        float yr = 0.5f * (zi - ci);
+        float yi = -0.5f * (zr - cr);
+
+        float gx = audio_ns_bin_gain(0u, k, (xr * xr) + (xi * xi));
+        float gy = (num_channels > 1u) ? audio_ns_bin_gain(1u, k, (yr * yr) + (yi * yi)) : gx;
+
+        /* Z'[k] = gx X + j gy Y = a Z[k] + b conj(Z[N-k]) */
+        float a = 0.5f * (gx + gy);
+        float b = 0.5f * (gx - gy);
+
+        fft_re[k] = (a * zr) + (b * cr);
+        fft_im[k] = (a * zi) + (b * ci);
+
+        if (kr != k)
+        {
+            /* Z'[N-k] = a Z[N-k] + b conj(Z[k]) */
+            fft_re[kr] = (a * cr) + (b * zr);
+            fft_im[kr] = (-a * ci) - (b * zi);
+        }
+    }
+    noise_valid = true;
+
+    /* Inverse FFT through the forward one on the conjugate */
+    for (uint32_t n = 0u; n < AUDIO_NS_FFT_SIZE; n++)
+    {
+        fft_im[n] = -fft_im[n];
+    }
+    audio_ns_fft(fft_re, fft_im);
+
+    for (uint32_t n = 0u; n < AUDIO_NS_FFT_SIZE; n++)
+    {
+        ola[0][n] += fft_re[n] * scale * window[n];
+        ola[1][n] -= fft_im[n] * scale * window[n];
+    }
+
+    /* The first hop of the accumulator is complete */
+    for (uint32_t ch = 0u; ch < AUDIO_NS_MAX_CHANNELS; ch++)
+    {
+        for (uint32_t n = 0u; n < AUDIO_NS_HOP_SIZE; n++)
+        {
+            out_ring[ch][(out_write + n) & AUDIO_NS_OUT_RING_MASK] = ola[ch][n];
+        }
+
+        memmove(&ola[ch][0], &ola[ch][AUDIO_NS_HOP_SIZE],
+                (AUDIO_NS_FFT_SIZE - AUDIO_NS_HOP_SIZE) * sizeof(float));
+        memset(&ola[ch][AUDIO_NS_FFT_SIZE - AUDIO_NS_HOP_SIZE], 0, AUDIO_NS_HOP_SIZE * sizeof(float));
+
+        memmove(&in_frame[ch][0], &in_frame[ch][AUDIO_NS_HOP_SIZE],
+                (AUDIO_NS_FFT_SIZE - AUDIO_NS_HOP_SIZE) * sizeof(float));
+    }
+    out_write += AUDIO_NS_HOP_SIZE;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ns_init
+******************************************************************************
+* Summary:
+*  Compute the window and FFT tables and reset the suppressor.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_ns_init(void)
+{
+    uint32_t bits = 0u;
+
+    while ((1u << bits) < AUDIO_NS_FFT_SIZE)
+    {
+        bits++;
+    }
+
+    for (uint32_t n = 0u; n < AUDIO_NS_FFT_SIZE; n++)
+    {
+        uint32_t reversed = 0u;
+
+        for (uint32_t b = 0u; b < bits; b++)
+        {
+            reversed |= ((n >> b) & 1u) << (bits - 1u - b);
+        }
+        bit_reverse[n] = (uint16_t) reversed;
+
+        /* Periodic Hann, its square root sums to one at 50 % overlap */
+        window[n] = sqrtf(0.5f - (0.5f * cosf((2.0f * AUDIO_NS_PI * (float) n) / (float) AUDIO_NS_FFT_SIZE)));
+    }
+
+    for (uint32_t k = 0u; k < (AUDIO_NS_FFT_SIZE / 2u); k++)
+    {
+        twiddle_cos[k] = cosf((2.0f * AUDIO_NS_PI * (float) k) / (float) AUDIO_NS_FFT_SIZE);
+        twiddle_sin[k] = -sinf((2.0f * AUDIO_NS_PI * (float) k) / (float) AUDIO_NS_FFT_SIZE);
+    }
+
+    audio_ns_reset();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ns_reset
+******************************************************************************
+* Summary:
+*  Clear the state of the suppressor. Called at the start of a recording
+*  session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_ns_reset(void)
+{
+    memset(in_frame, 0, sizeof(in_frame));
+    memset(ola, 0, sizeof(ola));
+    memset(out_ring, 0, sizeof(out_ring));
+
+    for (uint32_t ch = 0u; ch < AUDIO_NS_MAX_CHANNELS; ch++)
+    {
+        for (uint32_t k = 0u; k < AUDIO_NS_NUM_BINS; k++)
+        {
+            gain[ch][k] = 1.0f;
+        }
+    }
+    noise_valid = false;
+
+    /* New samples go after the history of the first frame */
+    in_count = AUDIO_NS_FFT_SIZE - AUDIO_NS_HOP_SIZE;
+
+    /* One hop of silence lets every block leave with as many frames as it
+     * came in with, for a total latency of AUDIO_NS_LATENCY_SAMPLES */
+    out_read = 0u;
+    out_write = AUDIO_NS_HOP_SIZE;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_ns_process
+******************************************************************************
+* Summary:
+*  Run a block of interleaved frames through the noise suppressor. The
+*  output is delayed by AUDIO_NS_LATENCY_SAMPLES.
+*
+* Parameters:
+*  in: Interleaved input frames
+*  out: Interleaved output frames, may not alias in
+*  num_frames: Number of frames in the block
+*  num_channels: Number of channels, 1 or 2
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_ns_process(const int16_t *in, int16_t *out, uint32_t num_frames, uint32_t num_channels)
+{
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        for (uint32_t ch = 0u; ch < num_channels; ch++)
+        {
+            in_frame[ch][in_count] = (float) in[(n * num_channels) + ch];
+        }
+
+        if (++in_count == AUDIO_NS_FFT_SIZE)
+        {
+            audio_ns_process_frame(num_channels);
+            in_count = AUDIO_NS_FFT_SIZE - AUDIO_NS_HOP_SIZE;
+        }
+    }
+
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        for (uint32_t ch = 0u; ch < num_channels; ch++)
+        {
+            float sample = out_ring[ch][out_read & AUDIO_NS_OUT_RING_MASK];
+
+            if (sample > 32767.0f)
+            {
+                sample = 32767.0f;
+            }
+            else if (sample < -32768.0f)
+            {
+                sample = -32768.0f;
+            }
+
+            out[(n * num_channels) + ch] = (int16_t) lrintf(sample);
+        }
+        out_read++;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,497 @@
+/*****************************************************************************
+* File Name        : audio_spectrum.c
+*
+* Description      : This file contains the streaming spectrum analyzer run by the
+*                    CM55. It windows overlapping frames of up to two channels,
+*                    transforms both channels with one complex FFT, and averages the
+*                    power of each bin over a number of frames.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_spectrum.h"
+#include "audio_ipc.h"
+#include "cybsp.h"
+#include <math.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define AUDIO_SPECTRUM_PI                   (3.14159265358979f)
+
+/* Power of a bin without signal, keeps the level above the floor finite */
+#define AUDIO_SPECTRUM_EPSILON              (1.0e-16f)
+
+/* Full scale of a sample */
+#define AUDIO_SPECTRUM_SAMPLE_SCALE         (1.0f / 32768.0f)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Settings of the session */
+static uint32_t spectrum_fft_size;
+static uint32_t spectrum_hop_size;
+static uint32_t spectrum_num_average;
+static uint32_t spectrum_num_bins;
+
+/* Hann window, and power of a full scale sine through it */
+static float window[AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+static float full_scale_power;
+
+/* FFT twiddle factors, contiguous per stage: the stage that combines
+ * blocks of half points uses entries half to 2 * half - 1. The inner loop
+ * of the FFT then reads them at unit stride and vectorizes. */
+static float twiddle_re[AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+static float twiddle_im[AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+static uint16_t bit_reverse[AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+
+/* Size the tables are computed for */
+static uint32_t table_fft_size;
+
+/* Analysis frame being filled, per channel */
+static float in_frame[AUDIO_IPC_MAX_CHANNELS][AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+static uint32_t in_fill;
+static uint32_t in_channels;
+
+/* Power summed over the frames of the average in progress */
+static float power_sum[AUDIO_IPC_MAX_CHANNELS][AUDIO_IPC_SPECTRUM_MAX_BINS];
+static uint32_t power_frames;
+
+/* Last complete average */
+static int16_t result_level[AUDIO_IPC_MAX_CHANNELS][AUDIO_IPC_SPECTRUM_MAX_BINS];
+static uint32_t result_channels;
+
+/* FFT work buffer */
+static float fft_re[AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+static float fft_im[AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE];
+
+/* Cycles per analysis frame in the session */
+static uint32_t frame_count;
+static uint64_t frame_total_cycles;
+static uint32_t frame_max_cycles;
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_tables
+******************************************************************************
+* Summary:
+*  Compute the window, the twiddle factors and the bit reversal permutation
+*  of an FFT size.
+*
+* Parameters:
+*  fft_size: FFT size, a power of 2
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_spectrum_tables(uint32_t fft_size)
+{
+    uint32_t bits = 0u;
+    float window_sum = 0.0f;
+
+    if (fft_size == table_fft_size)
+    {
+        return;
+    }
+
+    while ((1u << bits) < fft_size)
+    {
+        bits++;
+    }
+
+    for (uint32_t n = 0u; n < fft_size; n++)
+    {
+        uint32_t reversed = 0u;
+
+        for (uint32_t b = 0u; b < bits; b++)
+        {
+            reversed |= ((n >> b) & 1u) << (bits - 1u - b);
+        }
+        bit_reverse[n] = (uint16_t) reversed;
+
+        /* Periodic Hann window */
+        window[n] = 0.5f - (0.5f * cosf((2.0f * AUDIO_SPECTRUM_PI * (float) n) / (float) fft_size));
+        window_sum += window[n];
+    }
+
+    for (uint32_t half = 1u; half < fft_size; half <<= 1)
+    {
+        for (uint32_t k = 0u; k < half; k++)
+        {
+            twiddle_re[half + k] = cosf((AUDIO_SPECTRUM_PI * (float) k) / (float) half);
+            twiddle_im[half + k] = -sinf((AUDIO_SPECTRUM_PI * (float) k) / (float) half);
+        }
+    }
+
+    /* A full scale sine puts half of the window sum in its bin */
+    full_scale_power = 0.25f * window_sum * window_sum;
+
+    table_fft_size = fft_size;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_fft
+******************************************************************************
+* Summary:
+*  In place radix-2 complex FFT of the session size.
+*
+* Parameters:
+*  re: Real part
+*  im: Imaginary part
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_spectrum_fft(float *re, float *im)
+{
+    const uint32_t fft_size = spectrum_fft_size;
+
+    for (uint32_t i = 0u; i < fft_size; i++)
+    {
+        uint32_t j = bit_reverse[i];
+
+        if (j > i)
+        {
+            float tmp = re[i];
+            re[i] = re[j];
+            re[j] = tmp;
+            tmp = im[i];
+            im[i] = im[j];
+            im[j] = tmp;
+        }
+    }
+
+    for (uint32_t half = 1u; half < fft_size; half <<= 1)
+    {
+        const float *wr = &twiddle_re[half];
+        const float *wi = &twiddle_im[half];
+
+        for (uint32_t start = 0u; start < fft_size; start += 2u * half)
+        {
+            float *ar = &re[start];
+            float *ai = &im[start];
+            float *br = &re[start + half];
+            float *bi = &im[start + half];
+
+            for (uint32_t k = 0u; k < half; k++)
+            {
+                float tr = (br[k] * wr[k]) - (bi[k] * wi[k]);
+                float ti = (br[k] * wi[k]) + (bi[k] * wr[k]);
+
+                br[k] = ar[k] - tr;
+                bi[k] = ai[k] - ti;
+                ar[k] += tr;
+                ai[k] += ti;
+            }
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_frame
+******************************************************************************
+* Summary:
+*  Analyze one frame and add the power of its bins to the average. Both
+*  channels share one complex FFT, the first channel as the real part and
+*  the second one as the imaginary part, and are separated using the
+*  conjugate symmetry of real signals.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the frame completed an average
+*
+*****************************************************************************/
+static bool audio_spectrum_frame(void)
+{
+    const uint32_t fft_size = spectrum_fft_size;
+    uint32_t start = DWT->CYCCNT;
+    uint32_t cycles;
+    bool complete = false;
+
+    for (uint32_t n = 0u; n < fft_size; n++)
+    {
+        fft_re[n] = in_frame[0][n] * window[n];
+        fft_im[n] = in_frame[1][n] * window[n];
+    }
+
+    audio_spectrum_fft(fft_re, fft_im);
+
+    for (uint32_t k = 0u; k < spectrum_num_bins; k++)
+    {
+        uint32_t kr = (fft_size - k) & (fft_size - 1u);
+        float zr = fft_re[k];
+        float zi = fft_im[k];
+        float cr = fft_re[kr];
+        float ci = -fft_im[kr];
+
+        /* X = (Z[k] + conj(Z[N-k])) / 2, Y = (Z[k] - conj(Z[N-k])) / 2j */
+        float xr = 0.5f * (zr + cr);
+        float xi = 0.5f * (zi + ci);
+        float yr = 0.5f * (zi - ci);
+        float yi = -0.5f * (zr - cr);
+
+        power_sum[0][k] += (xr * xr) + (xi * xi);
+        power_sum[1][k] += (yr * yr) + (yi * yi);
+    }
+
+    if (++power_frames == spectrum_num_average)
+    {
+        /* Average power against a full scale sine, in 1/100 dB */
+        const float scale = 1.0f / ((float) spectrum_num_average * full_scale_power);
+
+        for (uint32_t ch = 0u; ch < in_channels; ch++)
+        {
+            for (uint32_t k = 0u; k < spectrum_num_bins; k++)
+            {
+                float level = 1000.0f * log10f((power_sum[ch][k] * scale) + AUDIO_SPECTRUM_EPSILON);
+
+                result_level[ch][k] = (level > (float) AUDIO_IPC_SPECTRUM_FLOOR) ?
+                                      (int16_t) lrintf(level) : (int16_t) AUDIO_IPC_SPECTRUM_FLOOR;
+            }
+        }
+        result_channels = in_channels;
+
+        memset(power_sum, 0, sizeof(power_sum));
+        power_frames = 0u;
+        complete = true;
+    }
+
+    cycles = DWT->CYCCNT - start;
+    frame_count++;
+    frame_total_cycles += cycles;
+    if (cycles > frame_max_cycles)
+    {
+        frame_max_cycles = cycles;
+    }
+
+    return complete;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_init
+******************************************************************************
+* Summary:
+*  Compute the tables of the default settings.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_spectrum_init(void)
+{
+    audio_spectrum_start(AUDIO_SPECTRUM_DEFAULT_FFT_SIZE, AUDIO_SPECTRUM_DEFAULT_HOP_SIZE,
+                         AUDIO_SPECTRUM_DEFAULT_NUM_AVERAGE);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_start
+******************************************************************************
+* Summary:
+*  Start the analysis of a new session. Invalid settings are replaced by
+*  the defaults. The tables are only computed again when the FFT size
+*  changes.
+*
+* Parameters:
+*  fft_size: FFT size, a power of 2 from AUDIO_IPC_SPECTRUM_MIN_FFT_SIZE
+*            to AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE
+*  hop_size: Frames between the starts of two analysis frames, from
+*            AUDIO_IPC_SPECTRUM_MIN_HOP_SIZE(fft_size) to fft_size
+*  num_average: Analysis frames averaged into one result, at least 1
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_spectrum_start(uint32_t fft_size, uint32_t hop_size, uint32_t num_average)
+{
+    if ((fft_size < AUDIO_IPC_SPECTRUM_MIN_FFT_SIZE) || (fft_size > AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE) ||
+        (0u != (fft_size & (fft_size - 1u))) || (hop_size < AUDIO_IPC_SPECTRUM_MIN_HOP_SIZE(fft_size)) ||
+        (hop_size > fft_size) || (0u == num_average))
+    {
+        fft_size = AUDIO_SPECTRUM_DEFAULT_FFT_SIZE;
+        hop_size = AUDIO_SPECTRUM_DEFAULT_HOP_SIZE;
+        num_average = AUDIO_SPECTRUM_DEFAULT_NUM_AVERAGE;
+    }
+
+    audio_spectrum_tables(fft_size);
+
+    spectrum_fft_size = fft_size;
+    spectrum_hop_size = hop_size;
+    spectrum_num_average = num_average;
+    spectrum_num_bins = (fft_size / 2u) + 1u;
+
+    memset(in_frame, 0, sizeof(in_frame));
+    memset(power_sum, 0, sizeof(power_sum));
+    in_fill = 0u;
+    in_channels = 1u;
+    power_frames = 0u;
+
+    frame_count = 0u;
+    frame_total_cycles = 0u;
+    frame_max_cycles = 0u;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_process
+******************************************************************************
+* Summary:
+*  Add a block to the analysis, and analyze every frame it completes. The
+*  block is left untouched.
+*
+* Parameters:
+*  in: Interleaved block
+*  num_frames: Number of frames in the block
+*  num_channels: Number of channels, the first two are analyzed
+*
+* Return:
+*  bool: true if a new result is available
+*
+*****************************************************************************/
+bool audio_spectrum_process(const int16_t *in, uint32_t num_frames, uint32_t num_channels)
+{
+    bool complete = false;
+
+    in_channels = (num_channels > AUDIO_IPC_MAX_CHANNELS) ? AUDIO_IPC_MAX_CHANNELS : num_channels;
+
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        in_frame[0][in_fill] = (float) in[i * num_channels] * AUDIO_SPECTRUM_SAMPLE_SCALE;
+        in_frame[1][in_fill] = (in_channels > 1u) ?
+                               ((float) in[(i * num_channels) + 1u] * AUDIO_SPECTRUM_SAMPLE_SCALE) : 0.0f;
+
+        if (++in_fill == spectrum_fft_size)
+        {
+            if (audio_spectrum_frame())
+            {
+                complete = true;
+            }
+
+            /* Keep the overlap with the next frame */
+            in_fill = spectrum_fft_size - spectrum_hop_size;
+            for (uint32_t ch = 0u; ch < AUDIO_IPC_MAX_CHANNELS; ch++)
+            {
+                memmove(&in_frame[ch][0], &in_frame[ch][spectrum_hop_size], in_fill * sizeof(float));
+            }
+        }
+    }
+
+    return complete;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_get_result
+******************************************************************************
+* Summary:
+*  Copy the last complete average.
+*
+* Parameters:
+*  level: Destination of the levels in 1/100 dBFS, channel after channel
+*  bins_per_channel: Stride between the channels in level, at least the
+*                    number of bins
+*  num_channels: Destination of the number of channels analyzed
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_spectrum_get_result(int16_t *level, uint32_t bins_per_channel, uint32_t *num_channels)
+{
+    for (uint32_t ch = 0u; ch < result_channels; ch++)
+    {
+        memcpy(&level[ch * bins_per_channel], result_level[ch], spectrum_num_bins * sizeof(int16_t));
+    }
+    *num_channels = result_channels;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_get_settings
+******************************************************************************
+* Summary:
+*  Return the settings of the session.
+*
+* Parameters:
+*  fft_size: Destination of the FFT size
+*  hop_size: Destination of the hop size
+*  num_average: Destination of the frames per average
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_spectrum_get_settings(uint32_t *fft_size, uint32_t *hop_size, uint32_t *num_average)
+{
+    *fft_size = spectrum_fft_size;
+    *hop_size = spectrum_hop_size;
+    *num_average = spectrum_num_average;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_spectrum_get_cycles
+******************************************************************************
+* Summary:
+*  Return the CM55 cycles spent per analysis frame in the session.
+*
+* Parameters:
+*  avg_cycles: Destination of the average
+*  max_cycles: Destination of the worst case
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_spectrum_get_cycles(uint32_t *avg_cycles, uint32_t *max_cycles)
+{
+    *avg_cycles = (0u != frame_count) ? (uint32_t) (frame_total_cycles / frame_count) : 0u;
+    *max_cycles = frame_max_cycles;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,488 @@
+/*****************************************************************************
+* File Name        : audio_worker.c
+*
+* Description      : This file contains the CM55 audio worker. It takes the blocks the
+*                    CM33 places in the shared memory mailbox, runs the enabled stages on them
+*                    and hands them back.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_worker.h"
+#include "audio_ipc.h"
+#include "audio_ns.h"
+#include "audio_spectrum.h"
+#include <string.h>
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Session the processing state belongs to */
+static uint32_t worker_session;
+
+/* Session of the spectrum analyzer, independent of the recording sessions */
+static uint32_t worker_spectrum_session;
+
+/* Cycle counters of the current session */
+static uint32_t worker_blocks;
+static uint64_t worker_total_cycles;
+static uint32_t worker_max_cycles;
+
+/* Cycles spent awake, and the cycle count at the last wake-up */
+static uint32_t worker_busy_cycles;
+static uint32_t worker_wake_cycles;
+
+/* Output of the stages, the input block stays untouched until released */
+static int16_t worker_output[(AUDIO_IPC_MAX_FRAMES) * (AUDIO_IPC_MAX_CHANNELS)];
+
+
+/*****************************************************************************
+* Function Name: audio_worker_invalidate
+******************************************************************************
+* Summary:
+*  Discard the cached copy of a shared memory area written by the CM33.
+*
+* Parameters:
+*  addr: Start of the area
+*  size: Size of the area, in bytes
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_worker_invalidate(volatile void *addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr(addr, (int32_t) size);
+#else
+    (void) addr;
+    (void) size;
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_clean
+******************************************************************************
+* Summary:
+*  Write back a shared memory area read by the CM33.
+*
+* Parameters:
+*  addr: Start of the area
+*  size: Size of the area, in bytes
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_worker_clean(volatile void *addr, uint32_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr(addr, (int32_t) size);
+#else
+    (void) addr;
+    (void) size;
+#endif
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_start_session
+******************************************************************************
+* Summary:
+*  Reset the processing state and the counters for a new session.
+*
+* Parameters:
+*  shared: Mailbox
+*  session: New session
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_worker_start_session(audio_ipc_shared_t *shared, uint32_t session)
+{
+    uint32_t stages = shared->stages;
+
+    worker_session = session;
+    worker_blocks = 0u;
+    worker_total_cycles = 0u;
+    worker_max_cycles = 0u;
+
+    audio_ns_reset();
+
+    shared->status.blocks = 0u;
+    shared->status.avg_cycles = 0u;
+    shared->status.max_cycles = 0u;
+    shared->status.latency_samples =
+        (0u != (stages & AUDIO_IPC_STAGE_NOISE_SUPPRESSION)) ? AUDIO_NS_LATENCY_SAMPLES : 0u;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_start_spectrum
+******************************************************************************
+* Summary:
+*  Restart the spectrum analyzer with the settings in the mailbox for a new
+*  session of the analyzer.
+*
+* Parameters:
+*  shared: Mailbox
+*  session: New session of the analyzer
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_worker_start_spectrum(audio_ipc_shared_t *shared, uint32_t session)
+{
+    worker_spectrum_session = session;
+
+    audio_worker_invalidate(shared, AUDIO_IPC_CACHE_LINE);
+    audio_spectrum_start(shared->spectrum_fft_size, shared->spectrum_hop_size, shared->spectrum_num_average);
+    shared->spectrum.results = 0u;
+    audio_worker_clean(&shared->spectrum, AUDIO_IPC_CACHE_LINE);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_publish_spectrum
+******************************************************************************
+* Summary:
+*  Publish the last result of the spectrum analyzer. The sequence is odd
+*  while the result is written, so the CM33 can detect and retry a read
+*  that overlaps an update.
+*
+* Parameters:
+*  shared: Mailbox
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_worker_publish_spectrum(audio_ipc_shared_t *shared)
+{
+    audio_ipc_spectrum_t *spectrum = &shared->spectrum;
+    uint32_t fft_size;
+    uint32_t hop_size;
+    uint32_t num_average;
+    uint32_t avg_cycles;
+    uint32_t max_cycles;
+    uint32_t num_channels;
+
+    spectrum->sequence++;
+    audio_worker_clean(spectrum, AUDIO_IPC_CACHE_LINE);
+    __DMB();
+
+    audio_spectrum_get_result(&spectrum->level[0][0], AUDIO_IPC_SPECTRUM_MAX_BINS, &num_channels);
+    audio_spectrum_get_settings(&fft_size, &hop_size, &num_average);
+    audio_spectrum_get_cycles(&avg_cycles, &max_cycles);
+
+    spectrum->num_channels = num_channels;
+    spectrum->fft_size = fft_size;
+    spectrum->hop_size = hop_size;
+    spectrum->num_average = num_average;
+    spectrum->avg_cycles = avg_cycles;
+    spectrum->max_cycles = max_cycles;
+    spectrum->results++;
+    audio_worker_clean(spectrum, sizeof(*spectrum));
+    __DMB();
+
+    spectrum->sequence++;
+    audio_worker_clean(spectrum, AUDIO_IPC_CACHE_LINE);
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_init
+******************************************************************************
+* Summary:
+*  Initialize the stages and enable the cycle counter used to measure them.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_worker_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    worker_wake_cycles = DWT->CYCCNT;
+
+    audio_ns_init();
+    audio_spectrum_init();
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_process_blocks
+******************************************************************************
+* Summary:
+*  Run the stages on all the blocks queued by the CM33 for the recording
+*  session, and return the processed blocks.
+*
+* Parameters:
+*  shared: Mailbox
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_worker_process_blocks(audio_ipc_shared_t *shared)
+{
+    audio_ipc_ring_t *in_ring = &shared->to_cm55;
+    audio_ipc_ring_t *out_ring = &shared->from_cm55;
+
+    audio_worker_invalidate(&in_ring->head, AUDIO_IPC_CACHE_LINE);
+    audio_worker_invalidate(&out_ring->tail, AUDIO_IPC_CACHE_LINE);
+
+    while (in_ring->tail != in_ring->head)
+    {
+        uint32_t out_index = out_ring->head;
+        audio_ipc_block_t *in_block;
+        audio_ipc_block_t *out_block;
+        uint32_t num_samples;
+        uint32_t start;
+        uint32_t cycles;
+
+        /* Wait for the CM33 to release a processed block */
+        if ((out_index - out_ring->tail) >= AUDIO_IPC_NUM_SLOTS)
+        {
+            break;
+        }
+
+        in_block = &in_ring->slots[in_ring->tail % AUDIO_IPC_NUM_SLOTS];
+        out_block = &out_ring->slots[out_index % AUDIO_IPC_NUM_SLOTS];
+        audio_worker_invalidate(in_block, sizeof(*in_block));
+
+        if (in_block->session != worker_session)
+        {
+            audio_worker_start_session(shared, in_block->session);
+        }
+
+        num_samples = (uint32_t) in_block->num_frames * in_block->num_channels;
+        if ((in_block->num_frames > AUDIO_IPC_MAX_FRAMES) || (in_block->num_channels > AUDIO_IPC_MAX_CHANNELS))
+        {
+            num_samples = 0u;
+        }
+
+        start = DWT->CYCCNT;
+
+        if ((0u != num_samples) && (0u != (shared->stages & AUDIO_IPC_STAGE_NOISE_SUPPRESSION)))
+        {
+            audio_ns_process(in_block->samples, worker_output, in_block->num_frames, in_block->num_channels);
+        }
+        else
+        {
+            memcpy(worker_output, in_block->samples, num_samples * sizeof(int16_t));
+        }
+
+        cycles = DWT->CYCCNT - start;
+
+        out_block->session = in_block->session;
+        out_block->num_frames = (0u != num_samples) ? in_block->num_frames : 0u;
+        out_block->num_channels = in_block->num_channels;
+        memcpy(out_block->samples, worker_output, num_samples * sizeof(int16_t));
+        audio_worker_clean(out_block, sizeof(*out_block));
+
+        /* Release the input block, then publish the output block */
+        in_ring->tail++;
+        audio_worker_clean(&in_ring->tail, AUDIO_IPC_CACHE_LINE);
+        __DMB();
+        out_ring->head = out_index + 1u;
+        audio_worker_clean(&out_ring->head, AUDIO_IPC_CACHE_LINE);
+
+        worker_blocks++;
+        worker_total_cycles += cycles;
+        if (cycles > worker_max_cycles)
+        {
+            worker_max_cycles = cycles;
+        }
+
+        shared->status.heartbeat++;
+        shared->status.blocks = worker_blocks;
+        shared->status.avg_cycles = (uint32_t) (worker_total_cycles / worker_blocks);
+        shared->status.max_cycles = worker_max_cycles;
+        audio_worker_clean(&shared->status, sizeof(shared->status));
+
+        audio_worker_invalidate(&in_ring->head, AUDIO_IPC_CACHE_LINE);
+        audio_worker_invalidate(&out_ring->tail, AUDIO_IPC_CACHE_LINE);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_analyze_block
+******************************************************************************
+* Summary:
+*  Pass the oldest block queued for the spectrum analyzer to the analyzer,
+*  and release it.
+*
+* Parameters:
+*  shared: Mailbox
+*
+* Return:
+*  bool: false if no block was queued
+*
+*****************************************************************************/
+static bool audio_worker_analyze_block(audio_ipc_shared_t *shared)
+{
+    audio_ipc_ring_t *ring = &shared->to_analyzer;
+    audio_ipc_block_t *block;
+
+    audio_worker_invalidate(&ring->head, AUDIO_IPC_CACHE_LINE);
+    if (ring->tail == ring->head)
+    {
+        return false;
+    }
+
+    block = &ring->slots[ring->tail % AUDIO_IPC_NUM_SLOTS];
+    audio_worker_invalidate(block, sizeof(*block));
+
+    if (block->session != worker_spectrum_session)
+    {
+        audio_worker_start_spectrum(shared, block->session);
+    }
+
+    if ((block->num_frames <= AUDIO_IPC_MAX_FRAMES) && (block->num_channels <= AUDIO_IPC_MAX_CHANNELS) &&
+        (0u != (shared->stages & AUDIO_IPC_STAGE_SPECTRUM)) &&
+        audio_spectrum_process(block->samples, block->num_frames, block->num_channels))
+    {
+        audio_worker_publish_spectrum(shared);
+    }
+
+    __DMB();
+    ring->tail++;
+    audio_worker_clean(&ring->tail, AUDIO_IPC_CACHE_LINE);
+
+    shared->status.heartbeat++;
+    audio_worker_clean(&shared->status, sizeof(shared->status));
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_poll
+******************************************************************************
+* Summary:
+*  Process all the blocks queued by the CM33. Called from the main loop
+*  every time the CM55 wakes up. The blocks of the recording session go
+*  first: the CM33 waits for them. The spectrum analyzer takes one block at
+*  a time in between, so an FFT never holds back a processed block by more
+*  than the analysis of one block.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_worker_poll(void)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+
+    audio_worker_invalidate(shared, AUDIO_IPC_CACHE_LINE);
+    if (AUDIO_IPC_MAGIC != shared->magic)
+    {
+        return;
+    }
+
+    do
+    {
+        audio_worker_process_blocks(shared);
+    }
+    while (audio_worker_analyze_block(shared));
+}
+
+
+/*****************************************************************************
+* Function Name: audio_worker_sleep
+******************************************************************************
+* Summary:
+*  Account the time spent awake since the last wake-up, publish it for the
+*  CPU load meter of the CM33, then sleep until the CM33 sends an event.
+*  The busy time is measured while awake only, so the result does not
+*  depend on the cycle counter running during sleep. The CPU enters Sleep
+*  while a recording session runs stages on the CM55 or the spectrum
+*  analyzer runs, which keeps the wake-up latency well below one USB
+*  packet, and Deep Sleep otherwise.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_worker_sleep(void)
+{
+    audio_ipc_shared_t *shared = AUDIO_IPC_SHARED;
+
+    worker_busy_cycles += DWT->CYCCNT - worker_wake_cycles;
+
+    audio_worker_invalidate(shared, AUDIO_IPC_CACHE_LINE);
+    if (AUDIO_IPC_MAGIC != shared->magic)
+    {
+        /* The CM33 has not initialized the mailbox yet */
+        Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_EVENT);
+    }
+    else
+    {
+        shared->status.busy_cycles = worker_busy_cycles;
+        shared->status.core_clock_hz = SystemCoreClock;
+        audio_worker_clean(&shared->status, sizeof(shared->status));
+
+        if (0u != shared->stages)
+        {
+            Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_EVENT);
+        }
+        else
+        {
+            /* Nothing runs on the CM55: the event that starts the next
+             * session also wakes the CPU from Deep Sleep */
+            Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_EVENT);
+        }
+    }
+
+    worker_wake_cycles = DWT->CYCCNT;
+}
+
+/* [] END OF FILE */
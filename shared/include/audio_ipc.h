@@ -0,0 +1,177 @@
+/******************************************************************************
+* File Name   : audio_ipc.h
+*
+* Description : This file contains the layout of the shared memory mailbox used
+*               to offload audio processing stages from the CM33 to the CM55.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_IPC_H
+#define AUDIO_IPC_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "cybsp.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* The mailbox occupies the end of the m33_m55_shared SOCMEM region so that it
+ * does not collide with variables the linker places at its start. Each core
+ * sees the region through its own address alias.
+ */
+#if defined(COMPONENT_CM55)
+#define AUDIO_IPC_REGION_START              (CYMEM_CM55_0_m33_m55_shared_START)
+#define AUDIO_IPC_REGION_SIZE               (CYMEM_CM55_0_m33_m55_shared_SIZE)
+#else
+#define AUDIO_IPC_REGION_START              (CYMEM_CM33_0_m33_m55_shared_START)
+#define AUDIO_IPC_REGION_SIZE               (CYMEM_CM33_0_m33_m55_shared_SIZE)
+#endif
+
+#define AUDIO_IPC_SHARED                    ((audio_ipc_shared_t *) (AUDIO_IPC_REGION_START + \
+                                             AUDIO_IPC_REGION_SIZE - sizeof(audio_ipc_shared_t)))
+
+/* Written by the CM33 once the mailbox is initialized */
+#define AUDIO_IPC_MAGIC                     (0x41495043UL)
+
+/* Number of blocks in flight in each direction */
+#define AUDIO_IPC_NUM_SLOTS                 (8u)
+
+/* Largest block, in frames of up to two channels */
+#define AUDIO_IPC_MAX_FRAMES                (64u)
+#define AUDIO_IPC_MAX_CHANNELS              (2u)
+
+/* Data cache line size of the CM55 */
+#define AUDIO_IPC_CACHE_LINE                (32u)
+
+/* Processing stages run by the CM55, bits of audio_ipc_shared_t.stages */
+#define AUDIO_IPC_STAGE_NOISE_SUPPRESSION   (1UL << 0)
+#define AUDIO_IPC_STAGE_SPECTRUM            (1UL << 1)
+
+/* Range of the FFT size of the spectrum analyzer, powers of 2 */
+#define AUDIO_IPC_SPECTRUM_MIN_FFT_SIZE     (64u)
+#define AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE     (1024u)
+#define AUDIO_IPC_SPECTRUM_MAX_BINS         (((AUDIO_IPC_SPECTRUM_MAX_FFT_SIZE) / 2u) + 1u)
+
+/* Smallest hop size of the spectrum analyzer. It bounds the FFTs run for
+ * one block, so that the CM55 keeps up with the capture. */
+#define AUDIO_IPC_SPECTRUM_MIN_HOP_SIZE(fft_size)   ((fft_size) / 4u)
+
+/* Level of a bin without power, in 1/100 dBFS */
+#define AUDIO_IPC_SPECTRUM_FLOOR            (-15000)
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* One block of interleaved audio frames */
+typedef struct
+{
+    uint32_t session;                   /* Session the block belongs to */
+    uint16_t num_frames;
+    uint16_t num_channels;
+    int16_t  samples[(AUDIO_IPC_MAX_FRAMES) * (AUDIO_IPC_MAX_CHANNELS)];
+    uint8_t  reserved[24];              /* Pad to a whole number of cache lines */
+} audio_ipc_block_t;
+
+/* Single producer, single consumer ring of blocks. The head and tail are
+ * free-running counters, each written by one core only, and live in their
+ * own cache line.
+ */
+typedef struct
+{
+    volatile uint32_t head;
+    uint8_t  reserved_head[(AUDIO_IPC_CACHE_LINE) - sizeof(uint32_t)];
+    volatile uint32_t tail;
+    uint8_t  reserved_tail[(AUDIO_IPC_CACHE_LINE) - sizeof(uint32_t)];
+    audio_ipc_block_t slots[AUDIO_IPC_NUM_SLOTS];
+} audio_ipc_ring_t;
+
+/* Processing status published by the CM55 */
+typedef struct
+{
+    volatile uint32_t heartbeat;        /* Incremented for every processed block */
+    volatile uint32_t blocks;           /* Blocks processed in the current session */
+    volatile uint32_t avg_cycles;       /* Average CM55 cycles per block */
+    volatile uint32_t max_cycles;       /* Worst case CM55 cycles per block */
+    volatile uint32_t latency_samples;  /* Algorithmic latency of the enabled stages */
+    volatile uint32_t busy_cycles;      /* Free-running count of the cycles spent awake */
+    volatile uint32_t core_clock_hz;    /* Clock of the CM55, to convert busy_cycles to time */
+    uint8_t  reserved[(AUDIO_IPC_CACHE_LINE) - (7u * sizeof(uint32_t))];
+} audio_ipc_status_t;
+
+/* Result of the spectrum analyzer published by the CM55. The sequence is
+ * odd while the CM55 writes the result. */
+typedef struct
+{
+    volatile uint32_t sequence;
+    volatile uint32_t results;          /* Results published in the current session */
+    volatile uint32_t num_channels;     /* Channels analyzed */
+    volatile uint32_t fft_size;         /* Settings of the result */
+    volatile uint32_t hop_size;
+    volatile uint32_t num_average;
+    volatile uint32_t avg_cycles;       /* Average CM55 cycles per analysis frame */
+    volatile uint32_t max_cycles;       /* Worst case CM55 cycles per analysis frame */
+    int16_t  level[AUDIO_IPC_MAX_CHANNELS][AUDIO_IPC_SPECTRUM_MAX_BINS];    /* Average power per bin, in 1/100 dBFS */
+    uint8_t  reserved[(AUDIO_IPC_CACHE_LINE) - (((AUDIO_IPC_MAX_CHANNELS) * (AUDIO_IPC_SPECTRUM_MAX_BINS) *
+                                                 sizeof(int16_t)) % (AUDIO_IPC_CACHE_LINE))];
+} audio_ipc_spectrum_t;
+
+typedef struct
+{
+    volatile uint32_t magic;
+    volatile uint32_t stages;           /* Stages enabled: the recording session stages and the analyzer */
+    volatile uint32_t session;          /* Incremented by the CM33 at every recording start */
+    volatile uint32_t spectrum_fft_size;    /* Settings of the spectrum analyzer for its next session */
+    volatile uint32_t spectrum_hop_size;
+    volatile uint32_t spectrum_num_average;
+    uint8_t  reserved[(AUDIO_IPC_CACHE_LINE) - (6u * sizeof(uint32_t))];
+    audio_ipc_status_t status;
+    audio_ipc_spectrum_t spectrum;
+    audio_ipc_ring_t to_cm55;           /* Captured blocks, CM33 to CM55 */
+    audio_ipc_ring_t from_cm55;         /* Processed blocks, CM55 to CM33 */
+    audio_ipc_ring_t to_analyzer;       /* Captured blocks for the spectrum analyzer, CM33 to CM55 */
+} audio_ipc_shared_t;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_IPC_H */
+
+/* [] END OF FILE */
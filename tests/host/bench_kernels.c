@@ -0,0 +1,283 @@
+/*****************************************************************************
+* File Name        : bench_kernels.c
+*
+* Description      : This file contains the host build of the kernel benchmarks
+*                    (audio_bench.c), and the benchmarks of the CM55 stages.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_bench.h"
+#include "audio.h"
+#include "audio_agc.h"
+#include "audio_beamformer.h"
+#include "audio_matrix.h"
+#include "audio_vad.h"
+#include "audio_ns.h"
+#include "audio_spectrum.h"
+#include "cybsp.h"
+#include <stdio.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Largest packet, at the highest sampling rate, as in audio_bench.c */
+#define BENCH_MAX_FRAMES            (((AUDIO_SAMPLING_RATE_48KHZ) / (1000u * (AUDIO_IN_PACKETS_PER_MS))) + 1u)
+#define BENCH_NUM_CHANNELS          (2u)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Stage of the CM55, processing one packet */
+typedef void (*bench_stage_t)(const int16_t *in, int16_t *out, uint32_t num_frames, uint32_t num_channels);
+
+typedef struct
+{
+    const char *name;
+    bench_stage_t stage;
+    uint32_t fft_size;                  /* Frames analyzed by one FFT of the stage */
+    uint32_t hop_size;                  /* Frames between two FFTs of the stage */
+} bench_entry_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static int16_t bench_source[(BENCH_MAX_FRAMES) * (BENCH_NUM_CHANNELS)];
+static int16_t bench_output[(BENCH_MAX_FRAMES) * (BENCH_NUM_CHANNELS)];
+
+static const uint32_t bench_rates[] =
+{
+    AUDIO_SAMPLING_RATE_16KHZ,
+    AUDIO_SAMPLING_RATE_22KHZ,
+    AUDIO_SAMPLING_RATE_32KHZ,
+    AUDIO_SAMPLING_RATE_44KHZ,
+    AUDIO_SAMPLING_RATE_48KHZ
+};
+
+
+/*****************************************************************************
+* Function Name: bench_ns
+******************************************************************************
+* Summary:
+*  Noise suppressor of the CM55.
+*
+* Parameters:
+*  in: Input frames
+*  out: Output frames
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void bench_ns(const int16_t *in, int16_t *out, uint32_t num_frames, uint32_t num_channels)
+{
+    audio_ns_process(in, out, num_frames, num_channels);
+}
+
+
+/*****************************************************************************
+* Function Name: bench_spectrum
+******************************************************************************
+* Summary:
+*  Spectrum analyzer of the CM55, with its default settings.
+*
+* Parameters:
+*  in: Input frames
+*  out: Unused
+*  num_frames: Frames in the packet
+*  num_channels: Channels per frame
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void bench_spectrum(const int16_t *in, int16_t *out, uint32_t num_frames, uint32_t num_channels)
+{
+    CY_UNUSED_PARAMETER(out);
+
+    (void) audio_spectrum_process(in, num_frames, num_channels);
+}
+
+
+static const bench_entry_t bench_stages[] =
+{
+    { "ns",        bench_ns,        AUDIO_NS_FFT_SIZE,                AUDIO_NS_HOP_SIZE },
+    { "spectrum",  bench_spectrum,  AUDIO_SPECTRUM_DEFAULT_FFT_SIZE,  AUDIO_SPECTRUM_DEFAULT_HOP_SIZE },
+};
+
+
+/*****************************************************************************
+* Function Name: bench_gcd
+******************************************************************************
+* Summary:
+*  Return the greatest common divisor of two numbers.
+*
+* Parameters:
+*  a: First number
+*  b: Second number
+*
+* Return:
+*  uint32_t: Greatest common divisor
+*
+*****************************************************************************/
+static uint32_t bench_gcd(uint32_t a, uint32_t b)
+{
+    while (0u != b)
+    {
+        uint32_t rest = a % b;
+
+        a = b;
+        b = rest;
+    }
+
+    return a;
+}
+
+
+/*****************************************************************************
+* Function Name: bench_run_stages
+******************************************************************************
+* Summary:
+*  Run the stages of the CM55 on the packets of every sampling rate and
+*  channel count, and print their results as audio_bench_run() does. The
+*  stages work in FFT frames: once a first frame is filled, each run
+*  processes the smallest number of packets spanning a whole number of hops,
+*  so that every run computes the same number of FFTs, and the cost is
+*  reported per packet.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void bench_run_stages(void)
+{
+    for (uint32_t k = 0u; k < (sizeof(bench_stages) / sizeof(bench_stages[0])); k++)
+    {
+        const bench_entry_t *entry = &bench_stages[k];
+
+        for (uint32_t r = 0u; r < (sizeof(bench_rates) / sizeof(bench_rates[0])); r++)
+        {
+            uint32_t num_frames = bench_rates[r] / (1000u * AUDIO_IN_PACKETS_PER_MS);
+            uint32_t num_packets = entry->hop_size / bench_gcd(entry->hop_size, num_frames);
+
+            for (uint32_t ch = 1u; ch <= BENCH_NUM_CHANNELS; ch++)
+            {
+                uint32_t best = UINT32_MAX;
+                uint32_t ns;
+                uint32_t ksamples;
+
+                audio_ns_reset();
+                audio_spectrum_start(AUDIO_SPECTRUM_DEFAULT_FFT_SIZE, AUDIO_SPECTRUM_DEFAULT_HOP_SIZE,
+                                     AUDIO_SPECTRUM_DEFAULT_NUM_AVERAGE);
+                for (uint32_t i = 0u; i <= (entry->fft_size / num_frames); i++)
+                {
+                    entry->stage(bench_source, bench_output, num_frames, ch);
+                }
+
+                for (uint32_t run = 0u; run < AUDIO_BENCH_RUNS; run++)
+                {
+                    uint32_t start = DWT->CYCCNT;
+                    uint32_t cycles;
+
+                    for (uint32_t i = 0u; i < num_packets; i++)
+                    {
+                        entry->stage(bench_source, bench_output, num_frames, ch);
+                    }
+                    cycles = (DWT->CYCCNT - start) / num_packets;
+
+                    best = (cycles < best) ? cycles : best;
+                }
+
+                ns = (uint32_t) (((uint64_t) best * 1000000000u) / SystemCoreClock);
+                ksamples = (0u != ns) ? (uint32_t) (((uint64_t) num_frames * ch * 1000000u) / ns) : 0u;
+
+                printf("APP_BENCH: %s,%lu,%lu,%lu,%lu,%lu,%lu\r\n", entry->name,
+                       (unsigned long) bench_rates[r], (unsigned long) ch, (unsigned long) num_frames,
+                       (unsigned long) best, (unsigned long) ns, (unsigned long) ksamples);
+            }
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the kernel benchmarks of the CM33 and the stages of the CM55 on the
+*  host, and print the results in the format of the debug UART log, for
+*  tools/bench_history.py.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t seed = 1u;
+
+    audio_beamformer_init();
+    audio_agc_init();
+    audio_vad_init();
+    audio_matrix_init();
+    audio_ns_init();
+    audio_spectrum_init();
+
+    audio_bench_run();
+
+    /* Noise at about -20 dBFS, as in audio_bench_run() */
+    for (uint32_t i = 0u; i < ((BENCH_MAX_FRAMES) * (BENCH_NUM_CHANNELS)); i++)
+    {
+        seed = (seed * 1664525u) + 1013904223u;
+        bench_source[i] = (int16_t) ((int32_t) (seed >> 16) - 32768) / 10;
+    }
+
+    bench_run_stages();
+
+    return 0;
+}
+
+/* [] END OF FILE */
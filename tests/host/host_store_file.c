@@ -0,0 +1,387 @@
+/*****************************************************************************
+* File Name        : host_store_file.c
+*
+* Description      : This file implements the file storage backend of the offline
+*                    recorder, for the host tests. It keeps the rules of a NOR
+*                    flash, and models the time of its erases and writes.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "host_store_file.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Erase sector of the modelled flash: an erase in steps erases the segment
+ * sector by sector */
+#define HOST_STORE_SECTOR_BYTES     (4096u)
+
+#define HOST_STORE_NO_SEGMENT       (0xFFFFFFFFUL)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static host_store_file_config_t host_store_config;
+static int host_store_fd = -1;
+
+/* Segment being erased in steps, and the time spent on it */
+static uint32_t host_store_erase_segment = HOST_STORE_NO_SEGMENT;
+static uint32_t host_store_erase_us;
+
+static uint8_t host_store_erased[HOST_STORE_SECTOR_BYTES];
+static uint8_t host_store_old[HOST_STORE_SECTOR_BYTES];
+
+
+/*****************************************************************************
+* Function Name: host_store_file_wait
+******************************************************************************
+* Summary:
+*  Pass the modelled time of an operation to the test.
+*
+* Parameters:
+*  us: Time in us
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void host_store_file_wait(uint32_t us)
+{
+    if ((NULL != host_store_config.wait) && (0u != us))
+    {
+        host_store_config.wait(us);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: host_store_file_fill
+******************************************************************************
+* Summary:
+*  Erase a range of the file.
+*
+* Parameters:
+*  position: Offset in the file
+*  size: Number of bytes
+*
+* Return:
+*  bool: true if the file was written
+*
+*****************************************************************************/
+static bool host_store_file_fill(off_t position, uint32_t size)
+{
+    uint32_t chunk;
+
+    while (size > 0u)
+    {
+        chunk = (size < sizeof(host_store_erased)) ? size : (uint32_t) sizeof(host_store_erased);
+        if (pwrite(host_store_fd, host_store_erased, chunk, position) != (ssize_t) chunk)
+        {
+            return false;
+        }
+        position += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: host_store_file_init
+******************************************************************************
+* Summary:
+*  Open the file, and erase what it lacks of the store. A file left by a
+*  previous run keeps its log.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the file is open
+*
+*****************************************************************************/
+static bool host_store_file_init(void)
+{
+    off_t total = (off_t) host_store_config.num_segments * host_store_config.segment_bytes;
+    struct stat file_stat;
+
+    memset(host_store_erased, 0xFF, sizeof(host_store_erased));
+    host_store_erase_segment = HOST_STORE_NO_SEGMENT;
+
+    if (host_store_fd >= 0)
+    {
+        close(host_store_fd);
+    }
+    host_store_fd = open(host_store_config.path, O_RDWR | O_CREAT, 0644);
+    if ((host_store_fd < 0) || (0 != fstat(host_store_fd, &file_stat)))
+    {
+        printf("host_store_file: %s: %s\n", host_store_config.path, strerror(errno));
+        return false;
+    }
+
+    if ((file_stat.st_size < total) &&
+        (!host_store_file_fill(file_stat.st_size, (uint32_t) (total - file_stat.st_size))))
+    {
+        printf("host_store_file: %s: %s\n", host_store_config.path, strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: host_store_file_read
+******************************************************************************
+* Summary:
+*  Read bytes of a segment.
+*
+* Parameters:
+*  segment: Segment to read
+*  offset: Offset in the segment
+*  data: Destination of the bytes
+*  size: Number of bytes
+*
+* Return:
+*  bool: true if the file was read
+*
+*****************************************************************************/
+static bool host_store_file_read(uint32_t segment, uint32_t offset, void *data, uint32_t size)
+{
+    off_t position = ((off_t) segment * host_store_config.segment_bytes) + offset;
+
+    return (pread(host_store_fd, data, size, position) == (ssize_t) size);
+}
+
+
+/*****************************************************************************
+* Function Name: host_store_file_erase_step
+******************************************************************************
+* Summary:
+*  Erase a segment in steps of erase_step_us, sector by sector in
+*  proportion to the time of the erase. Without steps, the segment is
+*  erased in one call.
+*
+* Parameters:
+*  segment: Segment to erase
+*  done: Set to true once the segment is erased
+*
+* Return:
+*  bool: true if the file was written
+*
+*****************************************************************************/
+static bool host_store_file_erase_step(uint32_t segment, bool *done)
+{
+    uint32_t total_us = host_store_config.erase_ms * 1000u;
+    uint32_t step_us = total_us - host_store_erase_us;
+    uint32_t erased;
+    uint32_t target;
+
+    if (segment != host_store_erase_segment)
+    {
+        host_store_erase_segment = segment;
+        host_store_erase_us = 0u;
+        step_us = total_us;
+    }
+
+    if ((0u != host_store_config.erase_step_us) && (step_us > host_store_config.erase_step_us))
+    {
+        step_us = host_store_config.erase_step_us;
+    }
+
+    /* Sectors erased before and after the step */
+    erased = (0u != total_us) ? (uint32_t) (((uint64_t) host_store_config.segment_bytes * host_store_erase_us) /
+                                            total_us) : 0u;
+    erased -= erased % HOST_STORE_SECTOR_BYTES;
+    host_store_erase_us += step_us;
+    target = host_store_config.segment_bytes;
+    if (host_store_erase_us < total_us)
+    {
+        target = (uint32_t) (((uint64_t) target * host_store_erase_us) / total_us);
+        target -= target % HOST_STORE_SECTOR_BYTES;
+    }
+
+    if ((target > erased) &&
+        (!host_store_file_fill(((off_t) segment * host_store_config.segment_bytes) + erased, target - erased)))
+    {
+        host_store_erase_segment = HOST_STORE_NO_SEGMENT;
+        return false;
+    }
+
+    host_store_file_wait(step_us);
+
+    *done = (host_store_erase_us >= total_us);
+    if (*done)
+    {
+        host_store_erase_segment = HOST_STORE_NO_SEGMENT;
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: host_store_file_erase
+******************************************************************************
+* Summary:
+*  Erase a segment.
+*
+* Parameters:
+*  segment: Segment to erase
+*
+* Return:
+*  bool: true if the file was written
+*
+*****************************************************************************/
+static bool host_store_file_erase(uint32_t segment)
+{
+    bool done = false;
+
+    while (!done)
+    {
+        if (!host_store_file_erase_step(segment, &done))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: host_store_file_write
+******************************************************************************
+* Summary:
+*  Write bytes of a segment. As on a NOR flash, a write only clears bits: a
+*  write that would set one fails.
+*
+* Parameters:
+*  segment: Segment to write
+*  offset: Offset in the segment
+*  data: Bytes to write
+*  size: Number of bytes
+*
+* Return:
+*  bool: true if the file was written
+*
+*****************************************************************************/
+static bool host_store_file_write(uint32_t segment, uint32_t offset, const void *data, uint32_t size)
+{
+    off_t position = ((off_t) segment * host_store_config.segment_bytes) + offset;
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint32_t chunk;
+
+    if ((offset + size) > host_store_config.segment_bytes)
+    {
+        printf("host_store_file: write past the end of segment %u\n", (unsigned) segment);
+        return false;
+    }
+
+    for (uint32_t done = 0u; done < size; done += chunk)
+    {
+        chunk = ((size - done) < sizeof(host_store_old)) ? (size - done) : (uint32_t) sizeof(host_store_old);
+        if (pread(host_store_fd, host_store_old, chunk, position + done) != (ssize_t) chunk)
+        {
+            return false;
+        }
+        for (uint32_t index = 0u; index < chunk; index++)
+        {
+            if ((host_store_old[index] & bytes[done + index]) != bytes[done + index])
+            {
+                printf("host_store_file: segment %u offset %u written without an erase\n", (unsigned) segment,
+                       (unsigned) (offset + done + index));
+                return false;
+            }
+        }
+    }
+
+    if ((pwrite(host_store_fd, bytes, size, position) != (ssize_t) size) ||
+        (host_store_config.sync && (0 != fdatasync(host_store_fd))))
+    {
+        return false;
+    }
+
+    host_store_file_wait((uint32_t) (((uint64_t) size * host_store_config.write_us_per_kib) / 1024u));
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+audio_store_backend_t audio_store_file =
+{
+    .name = "file",
+    .init = host_store_file_init,
+    .read = host_store_file_read,
+    .erase = host_store_file_erase,
+    .erase_step = host_store_file_erase_step,
+    .write = host_store_file_write,
+};
+
+
+/*****************************************************************************
+* Function Name: host_store_file_configure
+******************************************************************************
+* Summary:
+*  Set the file, the geometry and the device model of the store, before
+*  audio_recorder_init().
+*
+* Parameters:
+*  config: Configuration
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void host_store_file_configure(const host_store_file_config_t *config)
+{
+    host_store_config = *config;
+    audio_store_file.num_segments = config->num_segments;
+    audio_store_file.segment_bytes = config->segment_bytes;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name   : host_store_file.h
+*
+* Description : This file contains the file storage backend of the offline
+*               recorder, for the host tests.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef HOST_STORE_FILE_H
+#define HOST_STORE_FILE_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "audio_store.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+/* Geometry of the store and model of the device. The file is written at
+ * the speed of the host; the modelled times are passed to wait, which runs
+ * them in simulated time. */
+typedef struct
+{
+    const char *path;               /* File holding the segments */
+    uint32_t num_segments;
+    uint32_t segment_bytes;
+    bool sync;                      /* Flush every write to the disk */
+    uint32_t erase_ms;              /* Time of a segment erase */
+    uint32_t erase_step_us;         /* Time of an erase step, 0 to erase a segment in one step */
+    uint32_t write_us_per_kib;      /* Time of a write */
+    void (*wait)(uint32_t us);      /* Called with the time of each operation, NULL to ignore it */
+} host_store_file_config_t;
+
+
+/******************************************************************************
+* Externs
+******************************************************************************/
+extern audio_store_backend_t audio_store_file;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void host_store_file_configure(const host_store_file_config_t *config);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_STORE_FILE_H */
+
+/* [] END OF FILE */
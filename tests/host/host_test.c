@@ -0,0 +1,328 @@
+/*****************************************************************************
+* File Name        : host_test.c
+*
+* Description      : This file contains the helpers shared by the host tests of the
+*                    audio stages: checks, timing, test signals and WAV files.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "host_test.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define HOST_WAV_FORMAT_PCM         (1u)
+#define HOST_WAV_MAX_CHANNELS       (2u)
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static uint32_t host_checks;
+static uint32_t host_failures;
+
+
+/*****************************************************************************
+* Function Name: host_check
+******************************************************************************
+* Summary:
+*  Print the result of a check and count it.
+*
+* Parameters:
+*  passed: Result of the check
+*  format: printf format of the description, followed by its arguments
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void host_check(bool passed, const char *format, ...)
+{
+    va_list args;
+
+    host_checks++;
+    if (!passed)
+    {
+        host_failures++;
+    }
+
+    printf("%s: ", passed ? "PASS" : "FAIL");
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+}
+
+
+/*****************************************************************************
+* Function Name: host_report
+******************************************************************************
+* Summary:
+*  Print the summary of the checks.
+*
+* Parameters:
+*  name: Name of the test
+*
+* Return:
+*  int: Exit status of the test, 0 if all the checks passed
+*
+*****************************************************************************/
+int host_report(const char *name)
+{
+    printf("%s: %u checks, %u failed\n", name, (unsigned) host_checks, (unsigned) host_failures);
+
+    return (0u == host_failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*****************************************************************************
+* Function Name: host_time_ns
+******************************************************************************
+* Summary:
+*  Return a monotonic time, for the throughput measurements.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint64_t: Time in ns
+*
+*****************************************************************************/
+uint64_t host_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t) now.tv_sec * 1000000000u) + (uint64_t) now.tv_nsec;
+}
+
+
+/*****************************************************************************
+* Function Name: host_random
+******************************************************************************
+* Summary:
+*  Return the next value of a xorshift generator, so that the test signals
+*  are the same on every host.
+*
+* Parameters:
+*  state: State of the generator, not 0
+*
+* Return:
+*  uint32_t: Pseudo-random value
+*
+*****************************************************************************/
+uint32_t host_random(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+
+/*****************************************************************************
+* Function Name: host_random_gauss
+******************************************************************************
+* Summary:
+*  Return an approximately Gaussian value with unit variance, the sum of
+*  four uniform values.
+*
+* Parameters:
+*  state: State of the generator
+*
+* Return:
+*  float: Pseudo-random value
+*
+*****************************************************************************/
+float host_random_gauss(uint32_t *state)
+{
+    float sum = 0.0f;
+
+    for (uint32_t i = 0u; i < 4u; i++)
+    {
+        sum += ((float) host_random(state) / 4294967296.0f) - 0.5f;
+    }
+
+    /* Each uniform value has a variance of 1/12 */
+    return sum * sqrtf(3.0f);
+}
+
+
+/*****************************************************************************
+* Function Name: host_saturate
+******************************************************************************
+* Summary:
+*  Round a sample to 16 bits with saturation.
+*
+* Parameters:
+*  sample: Sample
+*
+* Return:
+*  int16_t: Rounded sample
+*
+*****************************************************************************/
+int16_t host_saturate(float sample)
+{
+    if (sample > 32767.0f)
+    {
+        return 32767;
+    }
+    if (sample < -32768.0f)
+    {
+        return -32768;
+    }
+
+    return (int16_t) lrintf(sample);
+}
+
+
+/*****************************************************************************
+* Function Name: host_wav_read_u32
+******************************************************************************
+* Summary:
+*  Decode a little-endian 32-bit field of a WAV file.
+*
+* Parameters:
+*  bytes: Field
+*
+* Return:
+*  uint32_t: Value
+*
+*****************************************************************************/
+static uint32_t host_wav_read_u32(const uint8_t *bytes)
+{
+    return (uint32_t) bytes[0] | ((uint32_t) bytes[1] << 8) |
+           ((uint32_t) bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+
+/*****************************************************************************
+* Function Name: host_wav_read
+******************************************************************************
+* Summary:
+*  Load a 16-bit PCM WAV file with one or two channels.
+*
+* Parameters:
+*  path: File
+*  num_frames: Set to the number of frames
+*  num_channels: Set to the number of channels
+*  sample_rate: Set to the sampling rate
+*
+* Return:
+*  int16_t *: Interleaved samples to be freed by the caller, NULL if the
+*             file cannot be read or has another format
+*
+*****************************************************************************/
+int16_t *host_wav_read(const char *path, uint32_t *num_frames, uint32_t *num_channels,
+                       uint32_t *sample_rate)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t header[12];
+    uint8_t chunk[8];
+    uint8_t format[16];
+    bool have_format = false;
+    int16_t *samples = NULL;
+
+    if (NULL == file)
+    {
+        return NULL;
+    }
+
+    if ((1u != fread(header, sizeof(header), 1u, file)) ||
+        (0 != memcmp(header, "RIFF", 4u)) || (0 != memcmp(&header[8], "WAVE", 4u)))
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    while (1u == fread(chunk, sizeof(chunk), 1u, file))
+    {
+        uint32_t size = host_wav_read_u32(&chunk[4]);
+
+        if ((0 == memcmp(chunk, "fmt ", 4u)) && (size >= sizeof(format)))
+        {
+            if (1u != fread(format, sizeof(format), 1u, file))
+            {
+                break;
+            }
+            have_format = ((format[0] | (format[1] << 8)) == HOST_WAV_FORMAT_PCM) &&
+                          ((format[14] | (format[15] << 8)) == 16);
+            *num_channels = (uint32_t) (format[2] | (format[3] << 8));
+            *sample_rate = host_wav_read_u32(&format[4]);
+            size -= (uint32_t) sizeof(format);
+        }
+        else if (0 == memcmp(chunk, "data", 4u))
+        {
+            if ((!have_format) || (0u == *num_channels) || (*num_channels > HOST_WAV_MAX_CHANNELS))
+            {
+                break;
+            }
+
+            *num_frames = size / (2u * *num_channels);
+            samples = malloc((size_t) *num_frames * *num_channels * sizeof(int16_t));
+            if ((NULL != samples) &&
+                (*num_frames != fread(samples, 2u * *num_channels, *num_frames, file)))
+            {
+                free(samples);
+                samples = NULL;
+            }
+            break;
+        }
+
+        /* Skip the rest of the chunk, chunks are padded to an even size */
+        if (0 != fseek(file, (long) (size + (size & 1u)), SEEK_CUR))
+        {
+            break;
+        }
+    }
+
+    fclose(file);
+
+    return samples;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name   : host_test.h
+*
+* Description : This file contains the declarations of the helpers shared by the
+*               host tests of the audio stages.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Check a condition, print it with its result and count the failures */
+#define HOST_CHECK(cond, ...)       host_check((cond), __VA_ARGS__)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void host_check(bool passed, const char *format, ...) __attribute__((format(printf, 2, 3)));
+int host_report(const char *name);
+uint64_t host_time_ns(void);
+uint32_t host_random(uint32_t *state);
+float host_random_gauss(uint32_t *state);
+int16_t host_saturate(float sample);
+int16_t *host_wav_read(const char *path, uint32_t *num_frames, uint32_t *num_channels,
+                       uint32_t *sample_rate);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* HOST_TEST_H */
+
+/* [] END OF FILE */
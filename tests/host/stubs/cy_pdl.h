@@ -0,0 +1,283 @@
+/******************************************************************************
+* File Name   : cy_pdl.h
+*
+* Description : This file contains the subset of the PDL used by the audio stages,
+*               for the host build of the tests.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define __STATIC_INLINE                     static inline
+#define CY_UNUSED_PARAMETER(param)          (void) (param)
+#define CY_ASSERT(condition)                assert(condition)
+#define CY_RAMFUNC_BEGIN
+#define CY_RAMFUNC_END
+
+/* Barriers between the tasks and the interrupts */
+#define __DMB()                             __sync_synchronize()
+#define __DSB()                             __sync_synchronize()
+
+/* Cycle counter. On the host, DWT->CYCCNT reads the monotonic clock in
+ * nanoseconds, plus the simulated time of host_dwt_advance(), and
+ * SystemCoreClock is 1 GHz to match. */
+#define DWT                                 (host_dwt())
+#define DWT_CTRL_CYCCNTENA_Msk              (1u)
+#define CoreDebug                           (&host_core_debug)
+#define CoreDebug_DEMCR_TRCENA_Msk          (1u << 24)
+
+/* PDM-PCM registers, plain memory on the host. The FIFOs are modelled:
+ * host_pdm_write_fifo() fills them, and the level is kept in the low byte
+ * of the status register. The reads of audio_fifo_read() go through
+ * host_pdm_read_register(), which pops a FIFO on a read of its data
+ * register. */
+#define PDM_PCM_CH_RX_FIFO_STATUS(base, ch) ((base)->RX_FIFO_STATUS[(ch)])
+#define PDM_PCM_CH_RX_FIFO_RD(base, ch)     ((base)->RX_FIFO_RD[(ch)])
+#define AUDIO_FIFO_READ(reg)                host_pdm_read_register(reg)
+#define HOST_PDM_NUM_CHANNELS               (6u)
+#define HOST_PDM_FIFO_DEPTH                 (64u)
+
+#define CY_PDM_PCM_INTR_RX_TRIGGER          (1UL << 0)
+#define CY_PDM_PCM_INTR_RX_OVERFLOW         (1UL << 2)
+
+/* Audio DPLLs, plain memory on the host. host_dpll_lp holds the
+ * configuration returned by Cy_SysClk_DpllLpGetConfiguration(), and the
+ * fractional part of the feedback divider is read back from CONFIG2. */
+#define SRSS_DPLL_LP_0_PATH_NUM             (1u)
+#define SRSS_DPLL_LP_1_PATH_NUM             (2u)
+#define HOST_DPLL_LP_NUM                    (2u)
+#define SRSS_CLK_DPLL_LP_CONFIG2(instance)  (host_dpll_lp[(instance)].CONFIG2)
+#define CLK_DPLL_LP_CONFIG2_FRAC_DIV_Pos    (0u)
+#define CLK_DPLL_LP_CONFIG2_FRAC_DIV_Msk    (0x00FFFFFFUL)
+
+#define _VAL2FLD(field, value)              ((((uint32_t) (value)) << field ## _Pos) & field ## _Msk)
+#define _FLD2VAL(field, value)              ((((uint32_t) (value)) & field ## _Msk) >> field ## _Pos)
+#define CY_REG32_CLR_SET(reg, field, value) ((reg) = (((reg) & ~(field ## _Msk)) | _VAL2FLD(field, (value))))
+
+
+/******************************************************************************
+* Structures
+******************************************************************************/
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} host_dwt_t;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} host_core_debug_t;
+
+typedef struct
+{
+    volatile uint32_t RX_FIFO_STATUS[HOST_PDM_NUM_CHANNELS];
+    volatile uint32_t RX_FIFO_RD[HOST_PDM_NUM_CHANNELS];
+    volatile uint32_t INTR_MASKED[HOST_PDM_NUM_CHANNELS];
+    uint32_t host_fifo[HOST_PDM_NUM_CHANNELS][HOST_PDM_FIFO_DEPTH];
+    uint32_t host_fifo_read[HOST_PDM_NUM_CHANNELS];
+    uint32_t host_trigger_level[HOST_PDM_NUM_CHANNELS];
+} PDM_Type;
+
+typedef enum
+{
+    CY_PDM_PCM_SUCCESS = 0,
+    CY_PDM_PCM_BAD_PARAM = 1,
+} cy_en_pdm_pcm_status_t;
+
+typedef enum
+{
+    CY_PDM_PCM_WSIZE_16_BIT = 1,
+} cy_en_pdm_pcm_word_size_t;
+
+typedef enum
+{
+    CY_PDM_PCM_CHAN_FIR0_DECIM_1 = 0,
+} cy_en_pdm_pcm_chan_fir0_decimcode_t;
+
+typedef enum
+{
+    CY_PDM_PCM_CHAN_CIC_DECIM_16 = 2,
+    CY_PDM_PCM_CHAN_CIC_DECIM_32 = 3,
+} cy_en_pdm_pcm_chan_cic_decimcode_t;
+
+typedef enum
+{
+    CY_PDM_PCM_CHAN_FIR1_DECIM_2 = 1,
+    CY_PDM_PCM_CHAN_FIR1_DECIM_3 = 2,
+    CY_PDM_PCM_CHAN_FIR1_DECIM_4 = 3,
+} cy_en_pdm_pcm_chan_fir1_decimcode_t;
+
+typedef enum
+{
+    CY_PDM_PCM_CHAN_DCBLOCK_CODE_16 = 3,
+} cy_en_pdm_pcm_chan_dcblock_coef_t;
+
+typedef struct
+{
+    uint8_t sampledelay;
+    cy_en_pdm_pcm_word_size_t wordSize;
+    bool signExtension;
+    uint8_t rxFifoTriggerLevel;
+    bool fir0_enable;
+    cy_en_pdm_pcm_chan_fir0_decimcode_t fir0_decim_code;
+    uint8_t fir0_scale;
+    cy_en_pdm_pcm_chan_cic_decimcode_t cic_decim_code;
+    cy_en_pdm_pcm_chan_fir1_decimcode_t fir1_decim_code;
+    uint8_t fir1_scale;
+    bool dc_block_disable;
+    cy_en_pdm_pcm_chan_dcblock_coef_t dc_block_code;
+} cy_stc_pdm_pcm_channel_config_t;
+
+typedef struct
+{
+    uint8_t clkDiv;
+} cy_stc_pdm_pcm_config_v2_t;
+
+typedef enum
+{
+    pdm_0_CHANNEL_3_IRQ = 0,
+    HOST_IRQ_NUM
+} IRQn_Type;
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS = 0,
+    CY_SYSINT_BAD_PARAM = 1,
+} cy_en_sysint_status_t;
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef void (*cy_israddress)(void);
+
+typedef struct
+{
+    volatile uint32_t OUT;
+} GPIO_PRT_Type;
+
+typedef enum
+{
+    CY_SYSCLK_SUCCESS = 0,
+    CY_SYSCLK_BAD_PARAM = 1,
+} cy_en_sysclk_status_t;
+
+typedef struct
+{
+    uint32_t feedbackDiv;
+    uint32_t referenceDiv;
+    uint32_t outputDiv;
+    uint32_t fracDiv;
+    bool fracEn;
+} cy_stc_dpll_lp_config_t;
+
+typedef struct
+{
+    cy_stc_dpll_lp_config_t *lpPllCfg;
+} cy_stc_pll_manual_config_t;
+
+typedef struct
+{
+    cy_stc_dpll_lp_config_t host_config;
+    volatile uint32_t CONFIG2;
+} host_dpll_lp_t;
+
+
+/******************************************************************************
+* Global variables
+******************************************************************************/
+extern uint32_t SystemCoreClock;
+extern host_core_debug_t host_core_debug;
+extern host_dpll_lp_t host_dpll_lp[HOST_DPLL_LP_NUM];
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+/* Critical sections exclude each other across the threads of a test */
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+
+host_dwt_t *host_dwt(void);
+void host_dwt_advance(uint32_t ns);
+
+cy_en_pdm_pcm_status_t Cy_PDM_PCM_Init(PDM_Type *base, cy_stc_pdm_pcm_config_v2_t const *config);
+cy_en_pdm_pcm_status_t Cy_PDM_PCM_Channel_Init(PDM_Type *base, cy_stc_pdm_pcm_channel_config_t const *channel_config,
+                                               uint8_t channel_num);
+void Cy_PDM_PCM_Channel_Enable(PDM_Type *base, uint8_t channel_num);
+void Cy_PDM_PCM_Activate_Channel(PDM_Type *base, uint8_t channel_num);
+void Cy_PDM_PCM_DeActivate_Channel(PDM_Type *base, uint8_t channel_num);
+uint32_t Cy_PDM_PCM_Channel_GetNumInFifo(PDM_Type const *base, uint8_t channel_num);
+uint32_t Cy_PDM_PCM_Channel_ReadFifo(PDM_Type *base, uint8_t channel_num);
+uint32_t Cy_PDM_PCM_Channel_GetInterruptStatusMasked(PDM_Type const *base, uint8_t channel_num);
+void Cy_PDM_PCM_Channel_ClearInterrupt(PDM_Type *base, uint8_t channel_num, uint32_t mask);
+void Cy_PDM_PCM_Channel_SetInterruptMask(PDM_Type *base, uint8_t channel_num, uint32_t mask);
+void host_pdm_write_fifo(PDM_Type *base, uint8_t channel_num, uint32_t word);
+uint32_t host_pdm_read_register(const volatile uint32_t *reg);
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress isr);
+void NVIC_EnableIRQ(IRQn_Type irqn);
+void NVIC_DisableIRQ(IRQn_Type irqn);
+void NVIC_ClearPendingIRQ(IRQn_Type irqn);
+void NVIC_SetPendingIRQ(IRQn_Type irqn);
+bool host_nvic_take_pending(IRQn_Type irqn);
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pin_num, uint32_t value);
+cy_en_sysclk_status_t Cy_SysClk_DpllLpGetConfiguration(uint32_t pathNum, cy_stc_pll_manual_config_t *config);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_PDL_H */
+
+/* [] END OF FILE */
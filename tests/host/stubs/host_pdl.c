@@ -0,0 +1,649 @@
+/*****************************************************************************
+* File Name        : host_pdl.c
+*
+* Description      : This file contains the stubs of the PDL functions used by the audio
+*                    stages, for the host build of the tests.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include <pthread.h>
+#include <time.h>
+
+
+/*****************************************************************************
+* Global variables
+*****************************************************************************/
+/* Cycles are nanoseconds on the host, see host_dwt() */
+uint32_t SystemCoreClock = 1000000000u;
+
+host_core_debug_t host_core_debug;
+PDM_Type host_pdm;
+const cy_stc_pdm_pcm_config_v2_t CYBSP_PDM_config;
+GPIO_PRT_Type host_gpio;
+host_dpll_lp_t host_dpll_lp[HOST_DPLL_LP_NUM];
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Held for the duration of a critical section, by one thread at a time.
+ * Recursive, as critical sections nest. */
+static pthread_mutex_t host_critical_section;
+static pthread_once_t host_critical_section_once = PTHREAD_ONCE_INIT;
+
+/* Added to the cycle counter, see host_dwt_advance() */
+static uint32_t host_dwt_offset;
+
+/* Interrupts pended by the code under test, see host_nvic_take_pending() */
+static volatile bool host_nvic_pending[HOST_IRQ_NUM];
+
+
+/*****************************************************************************
+* Function Name: host_critical_section_init
+******************************************************************************
+* Summary:
+*  Create the mutex of the critical sections.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void host_critical_section_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&host_critical_section, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_SysLib_EnterCriticalSection
+******************************************************************************
+* Summary:
+*  Enter a critical section. On the device, this masks the interrupts; on
+*  the host, the threads that stand for the interrupts and the tasks are
+*  serialized by a recursive mutex.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: State passed to Cy_SysLib_ExitCriticalSection()
+*
+*****************************************************************************/
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    pthread_once(&host_critical_section_once, host_critical_section_init);
+    pthread_mutex_lock(&host_critical_section);
+
+    return 0u;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_SysLib_ExitCriticalSection
+******************************************************************************
+* Summary:
+*  Leave a critical section.
+*
+* Parameters:
+*  savedIntrStatus: State returned by Cy_SysLib_EnterCriticalSection()
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    (void) savedIntrStatus;
+
+    pthread_mutex_unlock(&host_critical_section);
+}
+
+
+/*****************************************************************************
+* Function Name: host_dwt
+******************************************************************************
+* Summary:
+*  Stand-in of the DWT registers: the cycle counter is updated from the
+*  monotonic clock, in nanoseconds, at every access. Simulated time adds to
+*  it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  host_dwt_t *: Registers
+*
+*****************************************************************************/
+host_dwt_t *host_dwt(void)
+{
+    static host_dwt_t dwt;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    dwt.CYCCNT = (uint32_t) (((uint64_t) now.tv_sec * 1000000000u) + (uint64_t) now.tv_nsec) + host_dwt_offset;
+
+    return &dwt;
+}
+
+
+/*****************************************************************************
+* Function Name: host_dwt_advance
+******************************************************************************
+* Summary:
+*  Move the cycle counter on by a simulated time, such as the time of a
+*  modelled device operation.
+*
+* Parameters:
+*  ns: Time in ns
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void host_dwt_advance(uint32_t ns)
+{
+    host_dwt_offset += ns;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Init
+******************************************************************************
+* Summary:
+*  Initialize the PDM-PCM block: nothing to do on the host.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  config: Configuration
+*
+* Return:
+*  cy_en_pdm_pcm_status_t: CY_PDM_PCM_SUCCESS
+*
+*****************************************************************************/
+cy_en_pdm_pcm_status_t Cy_PDM_PCM_Init(PDM_Type *base, cy_stc_pdm_pcm_config_v2_t const *config)
+{
+    (void) config;
+
+    memset(base, 0, sizeof(*base));
+
+    return CY_PDM_PCM_SUCCESS;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_Init
+******************************************************************************
+* Summary:
+*  Initialize a channel: keep its FIFO trigger level for the tests.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_config: Configuration of the channel
+*  channel_num: Channel
+*
+* Return:
+*  cy_en_pdm_pcm_status_t: CY_PDM_PCM_SUCCESS
+*
+*****************************************************************************/
+cy_en_pdm_pcm_status_t Cy_PDM_PCM_Channel_Init(PDM_Type *base, cy_stc_pdm_pcm_channel_config_t const *channel_config,
+                                               uint8_t channel_num)
+{
+    base->host_trigger_level[channel_num] = channel_config->rxFifoTriggerLevel;
+
+    return CY_PDM_PCM_SUCCESS;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_Enable
+******************************************************************************
+* Summary:
+*  Enable a channel: nothing to do on the host.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_PDM_PCM_Channel_Enable(PDM_Type *base, uint8_t channel_num)
+{
+    (void) base;
+    (void) channel_num;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Activate_Channel
+******************************************************************************
+* Summary:
+*  Start a channel: nothing to do on the host, the tests fill the FIFOs.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_PDM_PCM_Activate_Channel(PDM_Type *base, uint8_t channel_num)
+{
+    (void) base;
+    (void) channel_num;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_DeActivate_Channel
+******************************************************************************
+* Summary:
+*  Stop a channel and empty its FIFO.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_PDM_PCM_DeActivate_Channel(PDM_Type *base, uint8_t channel_num)
+{
+    base->RX_FIFO_STATUS[channel_num] = 0u;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_GetNumInFifo
+******************************************************************************
+* Summary:
+*  Return the FIFO level of a PDM-PCM channel, read from its status register.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*
+* Return:
+*  uint32_t: Samples in the FIFO
+*
+*****************************************************************************/
+uint32_t Cy_PDM_PCM_Channel_GetNumInFifo(PDM_Type const *base, uint8_t channel_num)
+{
+    return base->RX_FIFO_STATUS[channel_num] & 0xFFu;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_ReadFifo
+******************************************************************************
+* Summary:
+*  Pop the oldest word of the FIFO of a channel.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*
+* Return:
+*  uint32_t: Word, 0 if the FIFO is empty
+*
+*****************************************************************************/
+uint32_t Cy_PDM_PCM_Channel_ReadFifo(PDM_Type *base, uint8_t channel_num)
+{
+    uint32_t level = base->RX_FIFO_STATUS[channel_num] & 0xFFu;
+    uint32_t word = 0u;
+
+    if (0u != level)
+    {
+        word = base->host_fifo[channel_num][base->host_fifo_read[channel_num] % HOST_PDM_FIFO_DEPTH];
+        base->host_fifo_read[channel_num]++;
+        base->RX_FIFO_STATUS[channel_num] = level - 1u;
+    }
+
+    return word;
+}
+
+
+/*****************************************************************************
+* Function Name: host_pdm_write_fifo
+******************************************************************************
+* Summary:
+*  Push a word into the FIFO of a channel, as the PDM-PCM converter does.
+*  A full FIFO drops the word and raises the overflow interrupt.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*  word: Sample
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void host_pdm_write_fifo(PDM_Type *base, uint8_t channel_num, uint32_t word)
+{
+    uint32_t level = base->RX_FIFO_STATUS[channel_num] & 0xFFu;
+
+    if (level < HOST_PDM_FIFO_DEPTH)
+    {
+        base->host_fifo[channel_num][(base->host_fifo_read[channel_num] + level) % HOST_PDM_FIFO_DEPTH] = word;
+        base->RX_FIFO_STATUS[channel_num] = level + 1u;
+    }
+    else
+    {
+        base->INTR_MASKED[channel_num] |= CY_PDM_PCM_INTR_RX_OVERFLOW;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: host_pdm_read_register
+******************************************************************************
+* Summary:
+*  Read a register of the PDM-PCM block. A read of the FIFO data register
+*  of a channel pops its FIFO, as on the device.
+*
+* Parameters:
+*  reg: Register
+*
+* Return:
+*  uint32_t: Value of the register, or word popped from the FIFO
+*
+*****************************************************************************/
+uint32_t host_pdm_read_register(const volatile uint32_t *reg)
+{
+    for (uint8_t ch = 0u; ch < HOST_PDM_NUM_CHANNELS; ch++)
+    {
+        if (reg == &host_pdm.RX_FIFO_RD[ch])
+        {
+            return Cy_PDM_PCM_Channel_ReadFifo(&host_pdm, ch);
+        }
+    }
+
+    return *reg;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_GetInterruptStatusMasked
+******************************************************************************
+* Summary:
+*  Return the pending interrupts of a channel.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*
+* Return:
+*  uint32_t: CY_PDM_PCM_INTR_* mask
+*
+*****************************************************************************/
+uint32_t Cy_PDM_PCM_Channel_GetInterruptStatusMasked(PDM_Type const *base, uint8_t channel_num)
+{
+    return base->INTR_MASKED[channel_num];
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_ClearInterrupt
+******************************************************************************
+* Summary:
+*  Clear pending interrupts of a channel.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*  mask: CY_PDM_PCM_INTR_* mask
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_PDM_PCM_Channel_ClearInterrupt(PDM_Type *base, uint8_t channel_num, uint32_t mask)
+{
+    base->INTR_MASKED[channel_num] &= ~mask;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_PDM_PCM_Channel_SetInterruptMask
+******************************************************************************
+* Summary:
+*  Select the interrupts of a channel: nothing to do on the host.
+*
+* Parameters:
+*  base: PDM-PCM registers
+*  channel_num: Channel
+*  mask: CY_PDM_PCM_INTR_* mask
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_PDM_PCM_Channel_SetInterruptMask(PDM_Type *base, uint8_t channel_num, uint32_t mask)
+{
+    (void) base;
+    (void) channel_num;
+    (void) mask;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_SysInt_Init
+******************************************************************************
+* Summary:
+*  Register an interrupt handler: the tests call the handlers themselves.
+*
+* Parameters:
+*  config: Interrupt source and priority
+*  isr: Handler
+*
+* Return:
+*  cy_en_sysint_status_t: CY_SYSINT_SUCCESS
+*
+*****************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress isr)
+{
+    (void) config;
+    (void) isr;
+
+    return CY_SYSINT_SUCCESS;
+}
+
+
+/*****************************************************************************
+* Function Name: NVIC_EnableIRQ
+******************************************************************************
+* Summary:
+*  Enable an interrupt: nothing to do on the host.
+*
+* Parameters:
+*  irqn: Interrupt
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    (void) irqn;
+}
+
+
+/*****************************************************************************
+* Function Name: NVIC_DisableIRQ
+******************************************************************************
+* Summary:
+*  Disable an interrupt: nothing to do on the host.
+*
+* Parameters:
+*  irqn: Interrupt
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    (void) irqn;
+}
+
+
+/*****************************************************************************
+* Function Name: NVIC_ClearPendingIRQ
+******************************************************************************
+* Summary:
+*  Clear a pending interrupt.
+*
+* Parameters:
+*  irqn: Interrupt
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+    host_nvic_pending[irqn] = false;
+}
+
+
+/*****************************************************************************
+* Function Name: NVIC_SetPendingIRQ
+******************************************************************************
+* Summary:
+*  Pend an interrupt. The tests call the handlers, after
+*  host_nvic_take_pending().
+*
+* Parameters:
+*  irqn: Interrupt
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void NVIC_SetPendingIRQ(IRQn_Type irqn)
+{
+    host_nvic_pending[irqn] = true;
+}
+
+
+/*****************************************************************************
+* Function Name: host_nvic_take_pending
+******************************************************************************
+* Summary:
+*  Check for an interrupt pended with NVIC_SetPendingIRQ(), and clear it.
+*
+* Parameters:
+*  irqn: Interrupt
+*
+* Return:
+*  true if the interrupt was pending, in which case the test runs its
+*  handler
+*
+*****************************************************************************/
+bool host_nvic_take_pending(IRQn_Type irqn)
+{
+    bool pending = host_nvic_pending[irqn];
+
+    host_nvic_pending[irqn] = false;
+    return pending;
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_GPIO_Write
+******************************************************************************
+* Summary:
+*  Drive a pin.
+*
+* Parameters:
+*  base: Port registers
+*  pin_num: Pin
+*  value: 0 or 1
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pin_num, uint32_t value)
+{
+    base->OUT = (base->OUT & ~(1u << pin_num)) | ((value & 1u) << pin_num);
+}
+
+
+/*****************************************************************************
+* Function Name: Cy_SysClk_DpllLpGetConfiguration
+******************************************************************************
+* Summary:
+*  Read the configuration of an audio DPLL: the one set in host_dpll_lp by
+*  the test, with the fractional part written to CONFIG2.
+*
+* Parameters:
+*  pathNum: Clock path of the DPLL
+*  config: Destination of the configuration
+*
+* Return:
+*  cy_en_sysclk_status_t: CY_SYSCLK_BAD_PARAM for a path without a DPLL
+*
+*****************************************************************************/
+cy_en_sysclk_status_t Cy_SysClk_DpllLpGetConfiguration(uint32_t pathNum, cy_stc_pll_manual_config_t *config)
+{
+    uint32_t instance = pathNum - SRSS_DPLL_LP_0_PATH_NUM;
+
+    if ((instance >= HOST_DPLL_LP_NUM) || (NULL == config->lpPllCfg))
+    {
+        return CY_SYSCLK_BAD_PARAM;
+    }
+
+    *config->lpPllCfg = host_dpll_lp[instance].host_config;
+    config->lpPllCfg->fracDiv = _FLD2VAL(CLK_DPLL_LP_CONFIG2_FRAC_DIV, host_dpll_lp[instance].CONFIG2);
+
+    return CY_SYSCLK_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/*****************************************************************************
+* File Name        : host_rtos.c
+*
+* Description      : This file contains the stubs of the FreeRTOS functions used by the audio
+*                    path, for the host build of the tests.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Tick count. The tests run in simulated time: only vTaskDelay() moves it. */
+static TickType_t host_ticks;
+
+
+/*****************************************************************************
+* Function Name: xTaskCreate
+******************************************************************************
+* Summary:
+*  Create a task. The tasks do not run on the host: the tests call the
+*  functions of the tasks themselves.
+*
+* Parameters:
+*  function: Body of the task
+*  name: Name of the task
+*  stack_depth: Stack size
+*  arg: Passed to the task
+*  priority: Priority of the task
+*  handle: Set to NULL if not NULL
+*
+* Return:
+*  BaseType_t: pdPASS
+*
+*****************************************************************************/
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    (void) function;
+    (void) name;
+    (void) stack_depth;
+    (void) arg;
+    (void) priority;
+
+    if (NULL != handle)
+    {
+        *handle = NULL;
+    }
+
+    return pdPASS;
+}
+
+
+/*****************************************************************************
+* Function Name: vTaskDelay
+******************************************************************************
+* Summary:
+*  Delay the calling task: returns at once on the host, with the tick
+*  count moved on by the delay.
+*
+* Parameters:
+*  ticks: Delay
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void vTaskDelay(TickType_t ticks)
+{
+    host_ticks += ticks;
+}
+
+
+/*****************************************************************************
+* Function Name: xTaskGetTickCount
+******************************************************************************
+* Summary:
+*  Return the tick count, in simulated time.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  TickType_t: Tick count
+*
+*****************************************************************************/
+TickType_t xTaskGetTickCount(void)
+{
+    return host_ticks;
+}
+
+
+/*****************************************************************************
+* Function Name: ulTaskNotifyTake
+******************************************************************************
+* Summary:
+*  Wait for a notification of the calling task: returns at once on the host.
+*
+* Parameters:
+*  clear_on_exit: Clear the notification count
+*  ticks_to_wait: Timeout
+*
+* Return:
+*  uint32_t: 0, no notification
+*
+*****************************************************************************/
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    (void) clear_on_exit;
+    (void) ticks_to_wait;
+
+    return 0u;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,758 @@
+/*****************************************************************************
+* File Name        : test_clock.c
+*
+* Description      : This file contains the host test of the clock trim loop
+*                    (audio_clock_trim.c) and the timestamp estimator
+*                    (audio_timestamp.c), on modelled USB, CPU and PDM
+*                    clocks in simulated time.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_clock_trim.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "audio_timestamp.h"
+#include "cybsp.h"
+#include "host_test.h"
+#include "rtos.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_NS_PER_MS              (1e6)
+#define TEST_NS_PER_S               (1e9)
+
+/* Service interval of the Audio IN endpoint, on the USB clock */
+#define TEST_PACKET_NS              ((double) (AUDIO_IN_EP_INTERVAL) * 125000.0)
+
+/* Capture path of the balanced latency profile: a queue target of two
+ * packets, and a PDM-PCM interrupt every 16 frames */
+#define TEST_QUEUE_TARGET           (2u * (AUDIO_IN_FRAMES_PER_PACKET))
+#define TEST_IRQ_FRAMES             (16u)
+
+/* The interrupt reads the FIFO a few us after the trigger. The packet
+ * requests run late by the scheduling of the USB stack: 20 us, plus up to
+ * 70 us of jitter. */
+#define TEST_IRQ_LATENCY_NS         (3000.0)
+#define TEST_REQUEST_LATENCY_NS     (20000.0)
+#define TEST_REQUEST_JITTER_NS      (20000.0)
+
+/* Period of the Audio App Task, which runs the loop */
+#define TEST_POLL_MS                (50u)
+
+/* Audio DPLL: 49.152 MHz from a 24 MHz reference, with a feedback divider
+ * of 98.304 */
+#define TEST_DPLL_INSTANCE          ((SRSS_DPLL_LP_1_PATH_NUM) - (SRSS_DPLL_LP_0_PATH_NUM))
+#define TEST_DPLL_FRAC_ONE          (1UL << 24)
+#define TEST_DPLL_FEEDBACK_DIV      (98u)
+#define TEST_DPLL_FRAC_DIV          (5100274u)
+#define TEST_DPLL_REFERENCE_DIV     (1u)
+#define TEST_DPLL_OUTPUT_DIV        (48u)
+
+/* Recording sessions of a minute, 5 s apart. The residual error and the
+ * packet size adjustments are measured over the end of each session. */
+#define TEST_MAX_SESSIONS           (2u)
+#define TEST_SESSION_MS             (60000u)
+#define TEST_WINDOW_MS              (20000u)
+#define TEST_PAUSE_MS               (5000u)
+
+/* Limits of a trim within range: the lock, the residual error, and the
+ * largest pitch step, well below the 5 cents or so that can be heard */
+#define TEST_LOCK_MAX_MS            (15000u)
+#define TEST_RESIDUAL_MAX_PPB       (500.0)
+#define TEST_STEP_MAX_CENTS         (1.0)
+#define TEST_ADJUSTMENTS_MAX        (2u)
+
+/* Once locked, the trims follow the noise of the measurements, and the
+ * rate of the estimator the jitter of the last few hundred packets */
+#define TEST_LOCKED_STEP_MAX_PPB    (5000.0)
+#define TEST_RATE_MAX_PPB           (10000.0)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Clocks of a scenario, as errors against their nominal frequency. The USB
+ * clock of the host is the reference. */
+typedef struct
+{
+    const char *name;
+    double cpu_ppm;                 /* CPU clock, counted by the cycle counter */
+    double pdm_ppm;                 /* Reference of the audio DPLL */
+    double drift_ppm_per_min;       /* Drift of the reference, as the board warms up */
+    bool trim;                      /* The DPLL is in fractional mode */
+    uint32_t sessions;
+} test_clocks_t;
+
+/* Result of a session */
+typedef struct
+{
+    audio_clock_trim_status_t trim;
+    audio_timestamp_status_t timestamp;
+    uint32_t settled_ms;            /* Time after which the PDM clock stays within AUDIO_CLOCK_TRIM_LOCK_PPB */
+    double residual_ppb;            /* PDM clock error against the USB clock, over the window */
+    double max_step_ppb;            /* Largest change of the PDM clock made by a trim */
+    uint32_t adjustments;           /* Packets of another size than nominal, over the window */
+    uint32_t underruns;
+} test_session_t;
+
+/* State of the simulation. The times are on the USB clock. */
+typedef struct
+{
+    const test_clocks_t *clocks;
+    uint32_t seed;
+    double time_ns;
+    double block_start_ns;          /* Start of the block of frames being captured */
+    double block_ns;                /* Its end, and the next PDM-PCM interrupt */
+    double request_ns;              /* Next packet request */
+    double poll_ns;                 /* Next run of the Audio App Task */
+    double session_ns;              /* Start of the session */
+    double unsettled_ns;            /* Last time the PDM clock was off by AUDIO_CLOCK_TRIM_LOCK_PPB or more */
+    double max_step_ppb;
+    uint32_t requests;              /* Packet requests of the session */
+    uint32_t head;                  /* Frames captured */
+    uint32_t tail;                  /* Frames sent */
+    uint32_t adjustments;
+    uint32_t underruns;
+    bool streaming;
+    bool primed;
+} test_sim_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static test_sim_t test_sim;
+
+/* The errors of the clocks are those of a crystal and of its drift. The
+ * DPLL can be trimmed by -0.3% to +0.7%, so the limit of the trim is
+ * AUDIO_CLOCK_TRIM_MAX_PPM. */
+static const test_clocks_t test_scenarios[] =
+{
+    /* The CPU and the DPLL share a crystal. A second session starts from
+     * the trim of the first. */
+    { .name = "one crystal",    .cpu_ppm = 100.0, .pdm_ppm = 100.0,  .trim = true,  .sessions = 2u },
+    { .name = "two crystals",   .cpu_ppm = -40.0, .pdm_ppm = 180.0,  .trim = true,  .sessions = 1u },
+    { .name = "near the limit", .cpu_ppm = 20.0,  .pdm_ppm = -450.0, .trim = true,  .sessions = 1u },
+    { .name = "warming up",     .cpu_ppm = 30.0,  .pdm_ppm = -60.0,  .drift_ppm_per_min = 3.0,
+      .trim = true,  .sessions = 1u },
+    { .name = "out of range",   .cpu_ppm = 0.0,   .pdm_ppm = 700.0,  .trim = true,  .sessions = 1u },
+    { .name = "no trim",        .cpu_ppm = -40.0, .pdm_ppm = 180.0,  .trim = false, .sessions = 1u },
+};
+
+
+/*****************************************************************************
+* Function Name: audio_in_get_progress
+******************************************************************************
+* Summary:
+*  Stand-in of the progress of the capture path of audio_in.c.
+*
+* Parameters:
+*  progress: Destination of the progress
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_progress(audio_in_progress_t *progress)
+{
+    progress->frames = test_sim.head;
+    progress->requests = test_sim.requests;
+    progress->streaming = test_sim.streaming;
+    progress->capturing = true;
+}
+
+
+/*****************************************************************************
+* Function Name: test_cycles
+******************************************************************************
+* Summary:
+*  Read the cycle counter, which runs on the CPU clock.
+*
+* Parameters:
+*  time_ns: USB time
+*
+* Return:
+*  uint32_t: Cycle count, 1 GHz nominal
+*
+*****************************************************************************/
+static uint32_t test_cycles(double time_ns)
+{
+    return (uint32_t) (uint64_t) (time_ns * (1.0 + (test_sim.clocks->cpu_ppm * 1e-6)));
+}
+
+
+/*****************************************************************************
+* Function Name: test_trim_ppb
+******************************************************************************
+* Summary:
+*  Trim of the DPLL, from the fractional part of its feedback divider.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  double: Trim in ppb
+*
+*****************************************************************************/
+static double test_trim_ppb(void)
+{
+    double nominal = ((double) TEST_DPLL_FEEDBACK_DIV * (double) TEST_DPLL_FRAC_ONE) + (double) TEST_DPLL_FRAC_DIV;
+    double divider = ((double) TEST_DPLL_FEEDBACK_DIV * (double) TEST_DPLL_FRAC_ONE) +
+                     (double) SRSS_CLK_DPLL_LP_CONFIG2(TEST_DPLL_INSTANCE);
+
+    return ((divider / nominal) - 1.0) * 1e9;
+}
+
+
+/*****************************************************************************
+* Function Name: test_pdm_error
+******************************************************************************
+* Summary:
+*  Error of the PDM clock against the USB clock: that of the reference of
+*  the DPLL, with its drift, and the trim.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  double: Relative error
+*
+*****************************************************************************/
+static double test_pdm_error(void)
+{
+    double reference_ppm = test_sim.clocks->pdm_ppm +
+                           ((test_sim.clocks->drift_ppm_per_min * test_sim.time_ns) / (60.0 * TEST_NS_PER_S));
+
+    return ((1.0 + (reference_ppm * 1e-6)) * (1.0 + (test_trim_ppb() * 1e-9))) - 1.0;
+}
+
+
+/*****************************************************************************
+* Function Name: test_frames
+******************************************************************************
+* Summary:
+*  Frames sampled by the microphones, including those of the block being
+*  captured.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  double: Frames since power up
+*
+*****************************************************************************/
+static double test_frames(void)
+{
+    return (double) test_sim.head + (((double) TEST_IRQ_FRAMES * (test_sim.time_ns - test_sim.block_start_ns)) /
+                                     (test_sim.block_ns - test_sim.block_start_ns));
+}
+
+
+/*****************************************************************************
+* Function Name: test_interrupt
+******************************************************************************
+* Summary:
+*  Run the PDM-PCM interrupt at the end of a block of frames: the frames
+*  enter the capture queue and the newest one anchors the timestamps. The
+*  next block is captured at the PDM clock as it is now.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_interrupt(void)
+{
+    double error = test_pdm_error();
+
+    test_sim.head += TEST_IRQ_FRAMES;
+    audio_timestamp_capture(test_sim.head - 1u, test_cycles(test_sim.time_ns + TEST_IRQ_LATENCY_NS));
+
+    if (test_sim.streaming && ((fabs(error) * 1e9) >= (double) AUDIO_CLOCK_TRIM_LOCK_PPB))
+    {
+        test_sim.unsettled_ns = test_sim.time_ns;
+    }
+
+    test_sim.block_start_ns = test_sim.block_ns;
+    test_sim.block_ns += ((double) TEST_IRQ_FRAMES * TEST_NS_PER_S) / ((double) AUDIO_IN_SAMPLE_FREQ * (1.0 + error));
+}
+
+
+/*****************************************************************************
+* Function Name: test_request
+******************************************************************************
+* Summary:
+*  Run a packet request of the Audio IN endpoint, as
+*  audio_in_endpoint_callback(): the first one of the session restarts the
+*  USB time and the capture queue, and the next ones advance the USB time
+*  and send the queue once it is primed. The packet size follows the queue
+*  level as in audio_in_packet_frames().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_request(void)
+{
+    uint32_t cycles = test_cycles(test_sim.time_ns);
+    uint32_t queue_level = test_sim.head - test_sim.tail;
+    uint32_t num_frames = AUDIO_IN_FRAMES_PER_PACKET;
+    uint32_t backlog;
+
+    if (0u == test_sim.requests)
+    {
+        audio_timestamp_start(cycles);
+        test_sim.tail = test_sim.head;
+        test_sim.primed = false;
+    }
+    else
+    {
+        audio_timestamp_usb_packet(cycles);
+
+        if ((!test_sim.primed) && (queue_level >= TEST_QUEUE_TARGET))
+        {
+            test_sim.primed = true;
+        }
+
+        if (test_sim.primed)
+        {
+            if (queue_level > (TEST_QUEUE_TARGET + AUDIO_IN_FRAMES_PER_PACKET))
+            {
+                backlog = queue_level - (TEST_QUEUE_TARGET + AUDIO_IN_FRAMES_PER_PACKET);
+                num_frames += 1u + ((backlog > AUDIO_IN_CATCHUP_FRAMES) ? AUDIO_IN_CATCHUP_FRAMES : backlog);
+            }
+            else if (queue_level < TEST_QUEUE_TARGET)
+            {
+                num_frames--;
+            }
+            else
+            {
+                /* Nominal size */
+            }
+
+            if (AUDIO_IN_FRAMES_PER_PACKET != num_frames)
+            {
+                test_sim.adjustments++;
+            }
+
+            if (queue_level < num_frames)
+            {
+                test_sim.underruns++;
+                num_frames = queue_level;
+            }
+            test_sim.tail += num_frames;
+        }
+    }
+
+    test_sim.requests++;
+    test_sim.request_ns = test_sim.session_ns + ((double) test_sim.requests * TEST_PACKET_NS) +
+                          TEST_REQUEST_LATENCY_NS +
+                          (fabs((double) host_random_gauss(&test_sim.seed)) * TEST_REQUEST_JITTER_NS);
+}
+
+
+/*****************************************************************************
+* Function Name: test_poll
+******************************************************************************
+* Summary:
+*  Run the loop from the Audio App Task, with the tick count on the CPU
+*  clock, and record the change of the PDM clock it makes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_poll(void)
+{
+    TickType_t ticks = (TickType_t) (uint64_t) ((test_sim.time_ns * (1.0 + (test_sim.clocks->cpu_ppm * 1e-6))) /
+                                                TEST_NS_PER_MS);
+    double trim_ppb = test_trim_ppb();
+
+    vTaskDelay(ticks - xTaskGetTickCount());
+    audio_clock_trim_poll();
+
+    if (fabs(test_trim_ppb() - trim_ppb) > test_sim.max_step_ppb)
+    {
+        test_sim.max_step_ppb = fabs(test_trim_ppb() - trim_ppb);
+    }
+
+    test_sim.poll_ns += ((double) TEST_POLL_MS * TEST_NS_PER_MS) / (1.0 + (test_sim.clocks->cpu_ppm * 1e-6));
+}
+
+
+/*****************************************************************************
+* Function Name: test_run
+******************************************************************************
+* Summary:
+*  Run the interrupts, the packet requests while the host records, and the
+*  loop, in the order of their times.
+*
+* Parameters:
+*  ms: Time to run
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_run(uint32_t ms)
+{
+    double end_ns = test_sim.time_ns + ((double) ms * TEST_NS_PER_MS);
+
+    for (;;)
+    {
+        double next_ns = test_sim.block_ns;
+
+        if (test_sim.streaming && (test_sim.request_ns < next_ns))
+        {
+            next_ns = test_sim.request_ns;
+        }
+        if (test_sim.poll_ns < next_ns)
+        {
+            next_ns = test_sim.poll_ns;
+        }
+
+        if (next_ns >= end_ns)
+        {
+            test_sim.time_ns = end_ns;
+            break;
+        }
+
+        test_sim.time_ns = next_ns;
+        if (next_ns == test_sim.block_ns)
+        {
+            test_interrupt();
+        }
+        else if (next_ns == test_sim.poll_ns)
+        {
+            test_poll();
+        }
+        else
+        {
+            test_request();
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_record
+******************************************************************************
+* Summary:
+*  Run a recording session of TEST_SESSION_MS and the pause after it, and
+*  measure the PDM clock and the packets over the last TEST_WINDOW_MS of
+*  the session.
+*
+* Parameters:
+*  result: Destination of the result
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_record(test_session_t *result)
+{
+    double window_frames;
+    double window_ns;
+    uint32_t window_adjustments;
+
+    test_sim.streaming = true;
+    test_sim.requests = 0u;
+    test_sim.session_ns = test_sim.time_ns;
+    test_sim.request_ns = test_sim.time_ns;
+    test_sim.unsettled_ns = test_sim.time_ns;
+    test_sim.max_step_ppb = 0.0;
+    test_sim.adjustments = 0u;
+    test_sim.underruns = 0u;
+
+    test_run(TEST_SESSION_MS - TEST_WINDOW_MS);
+
+    window_frames = test_frames();
+    window_ns = test_sim.time_ns;
+    window_adjustments = test_sim.adjustments;
+
+    test_run(TEST_WINDOW_MS);
+
+    window_frames = test_frames() - window_frames;
+    window_ns = test_sim.time_ns - window_ns;
+
+    audio_clock_trim_get_status(&result->trim);
+    audio_timestamp_get_status(&result->timestamp);
+    result->settled_ms = (uint32_t) ((test_sim.unsettled_ns - test_sim.session_ns) / TEST_NS_PER_MS);
+    result->residual_ppb = ((window_frames / (((double) AUDIO_IN_SAMPLE_FREQ * window_ns) / TEST_NS_PER_S)) - 1.0) * 1e9;
+    result->max_step_ppb = test_sim.max_step_ppb;
+    result->adjustments = test_sim.adjustments - window_adjustments;
+    result->underruns = test_sim.underruns;
+
+    test_sim.streaming = false;
+    test_run(TEST_PAUSE_MS);
+}
+
+
+/*****************************************************************************
+* Function Name: test_simulate
+******************************************************************************
+* Summary:
+*  Run the sessions of a scenario from power up, in a child process so
+*  that the loop and the estimator start from their reset state.
+*
+* Parameters:
+*  clocks: Scenario
+*  results: Destination of the result of each session
+*
+* Return:
+*  bool: true if the results were received
+*
+*****************************************************************************/
+static bool test_simulate(const test_clocks_t *clocks, test_session_t results[TEST_MAX_SESSIONS])
+{
+    size_t size = sizeof(test_session_t) * TEST_MAX_SESSIONS;
+    int fds[2];
+    int status = 0;
+    pid_t pid;
+    bool received;
+
+    memset(results, 0, size);
+
+    fflush(stdout);
+    if (0 != pipe(fds))
+    {
+        return false;
+    }
+
+    pid = fork();
+    if (0 == pid)
+    {
+        close(fds[0]);
+
+        host_dpll_lp[TEST_DPLL_INSTANCE].host_config.feedbackDiv = TEST_DPLL_FEEDBACK_DIV;
+        host_dpll_lp[TEST_DPLL_INSTANCE].host_config.referenceDiv = TEST_DPLL_REFERENCE_DIV;
+        host_dpll_lp[TEST_DPLL_INSTANCE].host_config.outputDiv = TEST_DPLL_OUTPUT_DIV;
+        host_dpll_lp[TEST_DPLL_INSTANCE].host_config.fracEn = clocks->trim;
+        host_dpll_lp[TEST_DPLL_INSTANCE].CONFIG2 = TEST_DPLL_FRAC_DIV;
+
+        memset(&test_sim, 0, sizeof(test_sim));
+        test_sim.clocks = clocks;
+        test_sim.seed = 1u;
+        test_sim.block_ns = ((double) TEST_IRQ_FRAMES * TEST_NS_PER_S) /
+                            ((double) AUDIO_IN_SAMPLE_FREQ * (1.0 + test_pdm_error()));
+
+        audio_timestamp_init();
+        audio_clock_trim_init();
+
+        /* The host starts recording once the device has enumerated */
+        test_run(TEST_PAUSE_MS);
+        for (uint32_t session = 0u; session < clocks->sessions; session++)
+        {
+            test_record(&results[session]);
+        }
+
+        fflush(stdout);
+        _exit((write(fds[1], results, size) == (ssize_t) size) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(fds[1]);
+    received = (pid > 0) && (read(fds[0], results, size) == (ssize_t) size);
+    close(fds[0]);
+
+    return (pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) &&
+           (EXIT_SUCCESS == WEXITSTATUS(status)) && received;
+}
+
+
+/*****************************************************************************
+* Function Name: test_cents
+******************************************************************************
+* Summary:
+*  Convert a change of the sampling clock to the pitch step it makes.
+*
+* Parameters:
+*  ppb: Change of the clock
+*
+* Return:
+*  double: Pitch step in cents
+*
+*****************************************************************************/
+static double test_cents(double ppb)
+{
+    return 1200.0 * log2(1.0 + (ppb * 1e-9));
+}
+
+
+/*****************************************************************************
+* Function Name: test_scenario
+******************************************************************************
+* Summary:
+*  Simulate a scenario and check the lock, the residual error, and the
+*  side effects on the audio: the pitch steps of the trims, and the packet
+*  size adjustments and underruns.
+*
+* Parameters:
+*  clocks: Scenario
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_scenario(const test_clocks_t *clocks)
+{
+    test_session_t results[TEST_MAX_SESSIONS];
+    double error_ppm = clocks->pdm_ppm;
+    bool received = test_simulate(clocks, results);
+
+    HOST_CHECK(received, "%s: CPU clock %+.0f ppm, PDM clock %+.0f ppm, %.0f ppm/min drift, simulated",
+               clocks->name, clocks->cpu_ppm, clocks->pdm_ppm, clocks->drift_ppm_per_min);
+    if (!received)
+    {
+        return;
+    }
+
+    for (uint32_t session = 0u; session < clocks->sessions; session++)
+    {
+        const test_session_t *result = &results[session];
+
+        char lock[32] = "not locked";
+        char settled[32] = "never";
+
+        if (0u != result->trim.locked)
+        {
+            snprintf(lock, sizeof(lock), "locked at %u ms", (unsigned) result->trim.lock_ms);
+        }
+        if (result->settled_ms < (TEST_SESSION_MS - TEST_WINDOW_MS))
+        {
+            snprintf(settled, sizeof(settled), "from %u ms", (unsigned) result->settled_ms);
+        }
+
+        printf("INFO: %s, session %u: %s, clocks within %d ppb %s, residual %+.3f ppm, "
+               "trim %+.3f ppm, %u trims since power up, %u limited\n",
+               clocks->name, (unsigned) (session + 1u), lock, AUDIO_CLOCK_TRIM_LOCK_PPB, settled,
+               result->residual_ppb * 1e-3, (double) result->trim.trim_ppb * 1e-3, (unsigned) result->trim.updates,
+               (unsigned) result->trim.saturations);
+        printf("INFO: %s, session %u: largest pitch step %.3f ppm (%.4f cents), %u packet size adjustments "
+               "in the last %u s, %u underruns, estimator rate %+.3f ppm, jitter %u ns rms\n",
+               clocks->name, (unsigned) (session + 1u), result->max_step_ppb * 1e-3, test_cents(result->max_step_ppb),
+               (unsigned) result->adjustments, (unsigned) (TEST_WINDOW_MS / 1000u), (unsigned) result->underruns,
+               (double) result->timestamp.rate_ppb * 1e-3, (unsigned) result->timestamp.jitter_rms_ns);
+
+        HOST_CHECK(0u == result->underruns, "%s, session %u: no underrun", clocks->name, (unsigned) (session + 1u));
+        HOST_CHECK(fabs((double) result->timestamp.rate_ppb - (clocks->cpu_ppm * 1e3)) <= TEST_RATE_MAX_PPB,
+                   "%s, session %u: estimator rate within %.0f ppm of the CPU clock", clocks->name,
+                   (unsigned) (session + 1u), TEST_RATE_MAX_PPB * 1e-3);
+
+        if (!clocks->trim)
+        {
+            /* The packet size adjustment takes up the whole error */
+            double expected = (error_ppm * 1e-6 * (double) AUDIO_IN_SAMPLE_FREQ * (double) TEST_WINDOW_MS) / 1000.0;
+
+            HOST_CHECK((0u == result->trim.available) && (0u == result->trim.updates),
+                       "%s: DPLL in integer mode, not trimmed", clocks->name);
+            HOST_CHECK(fabs(result->residual_ppb * 1e-3 - error_ppm) < 1.0,
+                       "%s: residual error of the PDM clock", clocks->name);
+            HOST_CHECK(fabs((double) result->adjustments - fabs(expected)) <= (0.05 * fabs(expected)) + 2.0,
+                       "%s: %u packet size adjustments for %.1f frames of drift", clocks->name,
+                       (unsigned) result->adjustments, fabs(expected));
+        }
+        else if (fabs(error_ppm) > (double) AUDIO_CLOCK_TRIM_MAX_PPM)
+        {
+            /* The trim is limited and the rest is left to the packet size
+             * adjustment */
+            double left_ppm = error_ppm - copysign((double) AUDIO_CLOCK_TRIM_MAX_PPM, error_ppm);
+
+            HOST_CHECK((0u == result->trim.locked) && (0u != result->trim.saturations),
+                       "%s: not locked, trims limited", clocks->name);
+            HOST_CHECK(abs(result->trim.trim_ppb) <= ((AUDIO_CLOCK_TRIM_MAX_PPM) * 1000),
+                       "%s: trim within AUDIO_CLOCK_TRIM_MAX_PPM", clocks->name);
+            HOST_CHECK(fabs((result->residual_ppb * 1e-3) - left_ppm) < 1.0,
+                       "%s: %+.3f ppm left after the trim, %+.3f ppm expected", clocks->name,
+                       result->residual_ppb * 1e-3, left_ppm);
+        }
+        else
+        {
+            HOST_CHECK((0u != result->trim.locked) && (result->trim.lock_ms <= TEST_LOCK_MAX_MS),
+                       "%s, session %u: locked within %u ms", clocks->name, (unsigned) (session + 1u),
+                       (unsigned) TEST_LOCK_MAX_MS);
+            HOST_CHECK(result->settled_ms <= result->trim.lock_ms,
+                       "%s, session %u: PDM clock within AUDIO_CLOCK_TRIM_LOCK_PPB at the lock", clocks->name,
+                       (unsigned) (session + 1u));
+            HOST_CHECK(fabs(result->residual_ppb) <= TEST_RESIDUAL_MAX_PPB,
+                       "%s, session %u: residual error within %.0f ppb", clocks->name, (unsigned) (session + 1u),
+                       TEST_RESIDUAL_MAX_PPB);
+            HOST_CHECK(test_cents(result->max_step_ppb) <= TEST_STEP_MAX_CENTS,
+                       "%s, session %u: pitch steps within %.1f cent", clocks->name, (unsigned) (session + 1u),
+                       TEST_STEP_MAX_CENTS);
+            HOST_CHECK(result->adjustments <= TEST_ADJUSTMENTS_MAX,
+                       "%s, session %u: at most %u packet size adjustments once locked", clocks->name,
+                       (unsigned) (session + 1u), (unsigned) TEST_ADJUSTMENTS_MAX);
+        }
+    }
+
+    if (clocks->sessions > 1u)
+    {
+        /* The trim is kept: the next session locks at its first
+         * measurements, with the small steps of a locked loop */
+        HOST_CHECK(results[1].trim.lock_ms < results[0].trim.lock_ms,
+                   "%s: session 2 locks sooner, in %u ms", clocks->name, (unsigned) results[1].trim.lock_ms);
+        HOST_CHECK(results[1].max_step_ppb <= TEST_LOCKED_STEP_MAX_PPB,
+                   "%s: session 2 steps within %.0f ppm", clocks->name, TEST_LOCKED_STEP_MAX_PPB * 1e-3);
+    }
+}
+
+
+int main(void)
+{
+    for (uint32_t i = 0u; i < (sizeof(test_scenarios) / sizeof(test_scenarios[0])); i++)
+    {
+        test_scenario(&test_scenarios[i]);
+    }
+
+    return host_report("test_clock");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,539 @@
+/*****************************************************************************
+* File Name        : test_factory.c
+*
+* Description      : This file contains the host test of the factory self-test
+*                    (audio_factory.c) on synthetic tones of known quality.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_factory.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "host_test.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_SAMPLE_RATE            (AUDIO_IN_SAMPLE_FREQ)
+#define TEST_SETTLE_FRAMES          (((TEST_SAMPLE_RATE) / 1000u) * (AUDIO_FACTORY_SETTLE_MS))
+#define TEST_MEASURE_FRAMES         (((TEST_SAMPLE_RATE) / 1000u) * (AUDIO_FACTORY_MEASURE_MS))
+
+/* Frames returned by a read of the capture queue, as after a drain period */
+#define TEST_READ_FRAMES            ((((TEST_SAMPLE_RATE) / 1000u) * (AUDIO_FACTORY_DRAIN_MS)) + 7u)
+
+/* Errors allowed on the measurements, in 1/100 dB, 1/100 degree, and 16-bit
+ * full scale units. The noise is random: its power over a capture is known
+ * to about 0.1 dB. */
+#define TEST_LEVEL_TOLERANCE        (5)
+#define TEST_NOISE_TOLERANCE        (20)
+#define TEST_PHASE_TOLERANCE        (5)
+#define TEST_DC_TOLERANCE           (1)
+
+/* Power of a full scale sine */
+#define TEST_FULL_SCALE_POWER       (0.5 * 32768.0 * 32768.0)
+
+/* Variance of the rounding of the samples to 16 bits */
+#define TEST_ROUNDING_POWER         (1.0 / 12.0)
+
+#define TEST_NO_HARMONIC            (-200.0)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Synthetic microphone signal: a tone, its second and third harmonics, a DC
+ * offset, and white noise */
+typedef struct
+{
+    double level_dbfs;              /* Tone level, a full scale sine is 0 dBFS */
+    double phase_deg;               /* Phase of the tone at the first frame */
+    double h2_dbc;                  /* Harmonics against the tone */
+    double h3_dbc;
+    double dc;                      /* DC offset, in 16-bit full scale units */
+    double noise_dbfs;              /* Noise level, TEST_NO_HARMONIC for none */
+} test_signal_t;
+
+/* Stand-in of the capture queue read by the factory test */
+typedef struct
+{
+    const test_signal_t *settle;    /* Signal of both microphones while they settle */
+    uint32_t tone_hz;
+    uint32_t frame;                 /* Frames read since the test started */
+    uint32_t stream_frame;          /* Frame at which a host stream starts */
+    bool enabled;
+    uint32_t seed;
+} test_capture_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* Unequal microphones: the right one is 1 dB quieter and lags by 10 degrees */
+static const test_signal_t test_left =
+{
+    .level_dbfs = -6.0, .phase_deg = 30.0, .h2_dbc = -40.0, .h3_dbc = -50.0, .dc = 120.0, .noise_dbfs = -70.0
+};
+static const test_signal_t test_right =
+{
+    .level_dbfs = -7.0, .phase_deg = 20.0, .h2_dbc = -45.0, .h3_dbc = TEST_NO_HARMONIC, .dc = -80.0,
+    .noise_dbfs = -66.0
+};
+
+/* Settling microphones: a large DC offset and no tone yet */
+static const test_signal_t test_settling =
+{
+    .level_dbfs = TEST_NO_HARMONIC, .phase_deg = 0.0, .h2_dbc = TEST_NO_HARMONIC, .h3_dbc = TEST_NO_HARMONIC,
+    .dc = 5000.0, .noise_dbfs = -40.0
+};
+
+static test_capture_t test_capture;
+
+static int16_t test_samples[(TEST_MEASURE_FRAMES) * (AUDIO_IN_NUM_CHANNELS)];
+
+
+/*****************************************************************************
+* Function Name: test_amplitude
+******************************************************************************
+* Summary:
+*  Convert a level to an amplitude in 16-bit full scale units.
+*
+* Parameters:
+*  dbfs: Level, a full scale sine is 0 dBFS
+*
+* Return:
+*  double: Amplitude
+*
+*****************************************************************************/
+static double test_amplitude(double dbfs)
+{
+    return 32768.0 * pow(10.0, dbfs / 20.0);
+}
+
+
+/*****************************************************************************
+* Function Name: test_sample
+******************************************************************************
+* Summary:
+*  Return a sample of a synthetic signal.
+*
+* Parameters:
+*  signal: Signal
+*  frame: Index of the frame
+*  tone_hz: Frequency of the tone
+*  seed: State of the noise generator
+*
+* Return:
+*  int16_t: Sample, rounded and saturated
+*
+*****************************************************************************/
+static int16_t test_sample(const test_signal_t *signal, uint32_t frame, uint32_t tone_hz, uint32_t *seed)
+{
+    double tone = test_amplitude(signal->level_dbfs);
+    double phase = ((2.0 * M_PI * (double) tone_hz * (double) frame) / (double) (TEST_SAMPLE_RATE)) +
+                   ((signal->phase_deg * M_PI) / 180.0);
+    double x = signal->dc + (tone * cos(phase)) +
+               (tone * pow(10.0, signal->h2_dbc / 20.0) * cos(2.0 * phase)) +
+               (tone * pow(10.0, signal->h3_dbc / 20.0) * cos(3.0 * phase)) +
+               ((test_amplitude(signal->noise_dbfs) / M_SQRT2) * (double) host_random_gauss(seed));
+
+    return host_saturate((float) x);
+}
+
+
+/*****************************************************************************
+* Function Name: test_fill
+******************************************************************************
+* Summary:
+*  Fill interleaved frames with the signals of the left and right
+*  microphones.
+*
+* Parameters:
+*  samples: Interleaved frames
+*  first_frame: Index of the first frame
+*  num_frames: Number of frames
+*  tone_hz: Frequency of the tone
+*  left, right: Signals
+*  seed: State of the noise generator
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_fill(int16_t *samples, uint32_t first_frame, uint32_t num_frames, uint32_t tone_hz,
+                      const test_signal_t *left, const test_signal_t *right, uint32_t *seed)
+{
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        samples[(i * AUDIO_IN_NUM_CHANNELS)] = test_sample(left, first_frame + i, tone_hz, seed);
+        samples[(i * AUDIO_IN_NUM_CHANNELS) + 1u] = test_sample(right, first_frame + i, tone_hz, seed);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_db
+******************************************************************************
+* Summary:
+*  Convert a power ratio to 1/100 dB, as reported by the factory test.
+*
+* Parameters:
+*  ratio: Power ratio
+*
+* Return:
+*  int32_t: Ratio in 1/100 dB
+*
+*****************************************************************************/
+static int32_t test_db(double ratio)
+{
+    return (int32_t) lrint(1000.0 * log10(ratio));
+}
+
+
+/*****************************************************************************
+* Function Name: test_check_channel
+******************************************************************************
+* Summary:
+*  Check the measurements of a channel against the values expected from its
+*  signal.
+*
+* Parameters:
+*  name: Name of the case and the channel
+*  channel: Measurements
+*  signal: Synthetic signal of the channel
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_check_channel(const char *name, const audio_factory_channel_t *channel, const test_signal_t *signal)
+{
+    double tone = TEST_FULL_SCALE_POWER * pow(10.0, signal->level_dbfs / 10.0);
+    double harmonics = tone * (pow(10.0, signal->h2_dbc / 10.0) + pow(10.0, signal->h3_dbc / 10.0));
+    double noise = (TEST_FULL_SCALE_POWER * pow(10.0, signal->noise_dbfs / 10.0)) + TEST_ROUNDING_POWER;
+    int32_t level = test_db(tone / TEST_FULL_SCALE_POWER);
+    int32_t snr = test_db(tone / noise);
+    int32_t thd = test_db(harmonics / tone);
+    int32_t thd_n = test_db((harmonics + noise) / tone);
+    int32_t noise_floor = test_db(noise / TEST_FULL_SCALE_POWER);
+
+    HOST_CHECK(abs(channel->level - level) <= TEST_LEVEL_TOLERANCE,
+               "%s: level %d, expected %d (1/100 dBFS)", name, channel->level, (int) level);
+    HOST_CHECK(abs(channel->snr - snr) <= TEST_NOISE_TOLERANCE,
+               "%s: SNR %d, expected %d (1/100 dB)", name, channel->snr, (int) snr);
+    HOST_CHECK(abs(channel->thd - thd) <= TEST_NOISE_TOLERANCE,
+               "%s: THD %d, expected %d (1/100 dB)", name, channel->thd, (int) thd);
+    HOST_CHECK(abs(channel->thd_n - thd_n) <= TEST_NOISE_TOLERANCE,
+               "%s: THD+N %d, expected %d (1/100 dB)", name, channel->thd_n, (int) thd_n);
+    HOST_CHECK(abs(channel->noise_floor - noise_floor) <= TEST_NOISE_TOLERANCE,
+               "%s: noise floor %d, expected %d (1/100 dBFS)", name, channel->noise_floor, (int) noise_floor);
+    HOST_CHECK(fabs((double) channel->dc_offset - signal->dc) <= (double) TEST_DC_TOLERANCE,
+               "%s: DC offset %d, expected %.0f", name, channel->dc_offset, signal->dc);
+}
+
+
+/*****************************************************************************
+* Function Name: test_check_result
+******************************************************************************
+* Summary:
+*  Check the measurements of both channels and their mismatch.
+*
+* Parameters:
+*  name: Name of the case
+*  result: Result of the analysis
+*  left, right: Synthetic signals of the channels
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_check_result(const char *name, const audio_factory_result_t *result,
+                              const test_signal_t *left, const test_signal_t *right)
+{
+    char label[64];
+    int32_t level_mismatch = (int32_t) lrint((left->level_dbfs - right->level_dbfs) * 100.0);
+    int32_t phase_mismatch = (int32_t) lrint((left->phase_deg - right->phase_deg) * 100.0);
+
+    HOST_CHECK(0u == result->errors, "%s: errors 0x%02x", name, (unsigned) result->errors);
+
+    snprintf(label, sizeof(label), "%s: left", name);
+    test_check_channel(label, &result->channel[0], left);
+    snprintf(label, sizeof(label), "%s: right", name);
+    test_check_channel(label, &result->channel[1], right);
+
+    HOST_CHECK(abs(result->level_mismatch - level_mismatch) <= TEST_LEVEL_TOLERANCE,
+               "%s: level mismatch %d, expected %d (1/100 dB)", name, result->level_mismatch, (int) level_mismatch);
+    HOST_CHECK(abs(result->phase_mismatch - phase_mismatch) <= TEST_PHASE_TOLERANCE,
+               "%s: phase mismatch %d, expected %d (1/100 degree)", name, result->phase_mismatch,
+               (int) phase_mismatch);
+}
+
+
+/*****************************************************************************
+* Stand-ins of the capture queue of audio_in.c: the reads return the
+* synthetic signals, a few drain periods at a time.
+*****************************************************************************/
+void audio_in_offline_enable(void)
+{
+    test_capture.enabled = true;
+}
+
+void audio_in_offline_disable(void)
+{
+    test_capture.enabled = false;
+}
+
+uint32_t audio_in_offline_read(uint16_t *buffer, uint32_t max_frames)
+{
+    uint32_t num_frames = (max_frames < TEST_READ_FRAMES) ? max_frames : TEST_READ_FRAMES;
+
+    if (!test_capture.enabled)
+    {
+        return 0u;
+    }
+
+    for (uint32_t i = 0u; i < num_frames; i++)
+    {
+        uint32_t frame = test_capture.frame + i;
+        bool settled = (frame >= TEST_SETTLE_FRAMES);
+
+        /* The tone phases count from the first measured frame */
+        frame = settled ? (frame - TEST_SETTLE_FRAMES) : 0u;
+        if (NULL != buffer)
+        {
+            buffer[(i * AUDIO_IN_NUM_CHANNELS)] = (uint16_t) test_sample(settled ? &test_left : test_capture.settle,
+                                                                         frame, test_capture.tone_hz,
+                                                                         &test_capture.seed);
+            buffer[(i * AUDIO_IN_NUM_CHANNELS) + 1u] = (uint16_t) test_sample(settled ? &test_right : test_capture.settle,
+                                                                              frame, test_capture.tone_hz,
+                                                                              &test_capture.seed);
+        }
+    }
+    test_capture.frame += num_frames;
+
+    return num_frames;
+}
+
+void audio_in_get_progress(audio_in_progress_t *progress)
+{
+    memset(progress, 0, sizeof(*progress));
+    progress->streaming = (test_capture.frame >= test_capture.stream_frame);
+    progress->capturing = test_capture.enabled;
+    progress->frames = test_capture.frame;
+}
+
+
+/*****************************************************************************
+* Function Name: test_analyze
+******************************************************************************
+* Summary:
+*  Check the analysis on unequal microphones, at the default tone, then at
+*  a tone and a length without a whole number of cycles.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_analyze(void)
+{
+    static const struct
+    {
+        const char *name;
+        uint32_t tone_hz;
+        uint32_t num_frames;
+    } cases[] =
+    {
+        { "1 kHz",  AUDIO_FACTORY_TONE_HZ, TEST_MEASURE_FRAMES },
+        { "997 Hz", 997u,                  TEST_MEASURE_FRAMES - 17u },
+        { "3 kHz",  3000u,                 TEST_MEASURE_FRAMES / 2u },
+    };
+    uint32_t seed = 1u;
+
+    for (uint32_t i = 0u; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        audio_factory_result_t result;
+
+        memset(&result, 0, sizeof(result));
+        test_fill(test_samples, 0u, cases[i].num_frames, cases[i].tone_hz, &test_left, &test_right, &seed);
+        audio_factory_analyze(test_samples, cases[i].num_frames, cases[i].tone_hz, TEST_SAMPLE_RATE, &result);
+
+        HOST_CHECK(cases[i].num_frames == result.frames, "%s: %u frames analyzed", cases[i].name,
+                   (unsigned) result.frames);
+        test_check_result(cases[i].name, &result, &test_left, &test_right);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_errors
+******************************************************************************
+* Summary:
+*  Check that a missing tone, a capture too short to fit, and a clipped
+*  tone are reported.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_errors(void)
+{
+    static const test_signal_t silent =
+    {
+        .level_dbfs = TEST_NO_HARMONIC, .phase_deg = 0.0, .h2_dbc = TEST_NO_HARMONIC,
+        .h3_dbc = TEST_NO_HARMONIC, .dc = 0.0, .noise_dbfs = -60.0
+    };
+    static const test_signal_t clipped =
+    {
+        .level_dbfs = 1.0, .phase_deg = 0.0, .h2_dbc = TEST_NO_HARMONIC, .h3_dbc = TEST_NO_HARMONIC,
+        .dc = 0.0, .noise_dbfs = -70.0
+    };
+    audio_factory_result_t result;
+    uint32_t seed = 2u;
+
+    /* The tone of the right microphone is missing */
+    memset(&result, 0, sizeof(result));
+    test_fill(test_samples, 0u, TEST_MEASURE_FRAMES, AUDIO_FACTORY_TONE_HZ, &test_left, &silent, &seed);
+    audio_factory_analyze(test_samples, TEST_MEASURE_FRAMES, AUDIO_FACTORY_TONE_HZ, TEST_SAMPLE_RATE, &result);
+    HOST_CHECK(AUDIO_FACTORY_ERROR_NO_TONE == result.errors, "no tone: errors 0x%02x, right level %d",
+               (unsigned) result.errors, result.channel[1].level);
+
+    /* Too few frames for a fit */
+    memset(&result, 0, sizeof(result));
+    audio_factory_analyze(test_samples, 16u, AUDIO_FACTORY_TONE_HZ, TEST_SAMPLE_RATE, &result);
+    HOST_CHECK(AUDIO_FACTORY_ERROR_NO_TONE == result.errors, "short capture: errors 0x%02x",
+               (unsigned) result.errors);
+
+    /* The left microphone reaches full scale */
+    memset(&result, 0, sizeof(result));
+    test_fill(test_samples, 0u, TEST_MEASURE_FRAMES, AUDIO_FACTORY_TONE_HZ, &clipped, &test_right, &seed);
+    audio_factory_analyze(test_samples, TEST_MEASURE_FRAMES, AUDIO_FACTORY_TONE_HZ, TEST_SAMPLE_RATE, &result);
+    HOST_CHECK(AUDIO_FACTORY_ERROR_CLIPPED == result.errors, "clipped: errors 0x%02x", (unsigned) result.errors);
+}
+
+
+/*****************************************************************************
+* Function Name: test_run
+******************************************************************************
+* Summary:
+*  Request a test and run it from the capture stand-in.
+*
+* Parameters:
+*  tone_hz: Tone of the request, 0 for the default
+*  stream_frame: Frame at which a host stream starts, UINT32_MAX for none
+*  result: Result of the test
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_run(uint32_t tone_hz, uint32_t stream_frame, audio_factory_result_t *result)
+{
+    test_capture.settle = &test_settling;
+    test_capture.tone_hz = (0u != tone_hz) ? tone_hz : AUDIO_FACTORY_TONE_HZ;
+    test_capture.frame = 0u;
+    test_capture.stream_frame = stream_frame;
+    test_capture.seed = 3u;
+
+    HOST_CHECK(audio_factory_request(tone_hz), "request of a %u Hz test accepted", (unsigned) test_capture.tone_hz);
+    HOST_CHECK(!audio_factory_request(tone_hz), "second request refused while pending");
+
+    audio_factory_poll();
+    audio_factory_get_result(result);
+
+    HOST_CHECK(AUDIO_FACTORY_DONE == result->state, "test done");
+    HOST_CHECK(!test_capture.enabled, "capture stopped");
+}
+
+
+/*****************************************************************************
+* Function Name: test_poll
+******************************************************************************
+* Summary:
+*  Check the test run by the Audio App Task: the settling audio is dropped,
+*  the measured audio analyzed, and a host stream aborts the test.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_poll(void)
+{
+    audio_factory_result_t result;
+
+    HOST_CHECK(!audio_factory_request(TEST_SAMPLE_RATE / 2u), "tone at the Nyquist frequency refused");
+
+    test_run(0u, UINT32_MAX, &result);
+    HOST_CHECK((AUDIO_FACTORY_TONE_HZ == result.tone_hz) && (TEST_MEASURE_FRAMES == result.frames),
+               "poll: %u Hz, %u frames analyzed", (unsigned) result.tone_hz, (unsigned) result.frames);
+    HOST_CHECK((TEST_SETTLE_FRAMES + TEST_MEASURE_FRAMES) == test_capture.frame, "poll: %u frames captured",
+               (unsigned) test_capture.frame);
+    test_check_result("poll", &result, &test_left, &test_right);
+
+    /* A host stream is recording */
+    test_run(1500u, 0u, &result);
+    HOST_CHECK(AUDIO_FACTORY_ERROR_BUSY == result.errors, "streaming: errors 0x%02x", (unsigned) result.errors);
+
+    /* A host stream starts during the measurement */
+    test_run(1500u, TEST_SETTLE_FRAMES + (TEST_MEASURE_FRAMES / 2u), &result);
+    HOST_CHECK(AUDIO_FACTORY_ERROR_BUSY == result.errors, "stream started: errors 0x%02x",
+               (unsigned) result.errors);
+    HOST_CHECK(test_capture.frame < (TEST_SETTLE_FRAMES + TEST_MEASURE_FRAMES), "stream started: aborted after %u frames",
+               (unsigned) test_capture.frame);
+}
+
+
+int main(void)
+{
+    test_analyze();
+    test_errors();
+    test_poll();
+
+    return host_report("test_factory");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,447 @@
+/*****************************************************************************
+* File Name        : test_ns.c
+*
+* Description      : This file contains the host regression test of the noise suppressor
+*                    of the CM55 (audio_ns.c) on recorded and synthetic noise.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_ns.h"
+#include "host_test.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Sampling rate of the synthetic signals, and frames per block as sent by
+ * the CM33 for one USB packet */
+#define TEST_SAMPLE_RATE            (16000u)
+#define TEST_BLOCK_FRAMES           (16u)
+
+/* Length of the signals, and the part left out of the measurements while
+ * the noise estimate converges */
+#define TEST_DURATION_S             (6u)
+#define TEST_SETTLE_S               (2u)
+
+/* RMS level of the synthetic noise, and of the tone over the noise */
+#define TEST_NOISE_RMS              (1000.0f)
+#define TEST_TONE_HZ                (1000.0f)
+#define TEST_TONE_SNR_DB            (15.0f)
+
+/* Bursts of the tone, each measured once the gains have settled */
+#define TEST_BURST_PERIOD_MS        (400u)
+#define TEST_BURST_MS               (160u)
+#define TEST_BURST_SKIP_MS          (40u)
+
+/* Pass criteria */
+#define TEST_MIN_ATTENUATION_DB     (5.0f)      /* Noise alone */
+#define TEST_MIN_TONE_NOISE_DB      (3.0f)      /* Noise under the tone */
+#define TEST_MAX_TONE_CHANGE_DB     (1.0f)      /* Level of the tone */
+#define TEST_MAX_IMPULSE_ERROR      (0.02f)     /* Relative, on an impulse in silence */
+
+#define TEST_PI                     (3.14159265358979)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+typedef struct
+{
+    const char *name;
+    int16_t *samples;               /* Interleaved */
+    uint32_t num_frames;
+    uint32_t num_channels;
+    uint32_t sample_rate;
+} test_noise_t;
+
+
+/*****************************************************************************
+* Function Name: test_run
+******************************************************************************
+* Summary:
+*  Run the suppressor from its reset state on a signal, one block at a time.
+*
+* Parameters:
+*  in: Interleaved input
+*  out: Interleaved output
+*  num_frames: Frames of the signal
+*  num_channels: Channels of the signal
+*
+* Return:
+*  uint64_t: Processing time, in ns
+*
+*****************************************************************************/
+static uint64_t test_run(const int16_t *in, int16_t *out, uint32_t num_frames, uint32_t num_channels)
+{
+    uint64_t start;
+    uint32_t block_frames;
+
+    audio_ns_reset();
+
+    start = host_time_ns();
+    for (uint32_t done = 0u; done < num_frames; done += block_frames)
+    {
+        block_frames = num_frames - done;
+        if (block_frames > TEST_BLOCK_FRAMES)
+        {
+            block_frames = TEST_BLOCK_FRAMES;
+        }
+        audio_ns_process(&in[done * num_channels], &out[done * num_channels], block_frames, num_channels);
+    }
+
+    return host_time_ns() - start;
+}
+
+
+/*****************************************************************************
+* Function Name: test_energy
+******************************************************************************
+* Summary:
+*  Return the energy of one channel of a signal from a given frame on.
+*
+* Parameters:
+*  samples: Interleaved signal
+*  first: First frame
+*  num_frames: Frames of the signal
+*  num_channels: Channels of the signal
+*  channel: Channel
+*
+* Return:
+*  double: Sum of squares
+*
+*****************************************************************************/
+static double test_energy(const int16_t *samples, uint32_t first, uint32_t num_frames,
+                          uint32_t num_channels, uint32_t channel)
+{
+    double sum = 0.0;
+
+    for (uint32_t n = first; n < num_frames; n++)
+    {
+        double sample = samples[(n * num_channels) + channel];
+
+        sum += sample * sample;
+    }
+
+    return sum;
+}
+
+
+/*****************************************************************************
+* Function Name: test_synthetic_noise
+******************************************************************************
+* Summary:
+*  Generate a stereo noise: white, or pink with the Paul Kellet filter.
+*
+* Parameters:
+*  noise: Filled with the signal
+*  name: Name of the signal
+*  pink: true for pink noise
+*  seed: Seed of the generator
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_synthetic_noise(test_noise_t *noise, const char *name, bool pink, uint32_t seed)
+{
+    uint32_t num_frames = TEST_DURATION_S * TEST_SAMPLE_RATE;
+    float state[2][7] = {{0.0f}};
+    float scale = pink ? (TEST_NOISE_RMS / 3.0f) : TEST_NOISE_RMS;
+
+    noise->name = name;
+    noise->num_frames = num_frames;
+    noise->num_channels = 2u;
+    noise->sample_rate = TEST_SAMPLE_RATE;
+    noise->samples = malloc(num_frames * 2u * sizeof(int16_t));
+
+    for (uint32_t n = 0u; n < num_frames; n++)
+    {
+        for (uint32_t ch = 0u; ch < 2u; ch++)
+        {
+            float white = host_random_gauss(&seed);
+            float *b = state[ch];
+            float sample = white;
+
+            if (pink)
+            {
+                b[0] = (0.99886f * b[0]) + (white * 0.0555179f);
+                b[1] = (0.99332f * b[1]) + (white * 0.0750759f);
+                b[2] = (0.96900f * b[2]) + (white * 0.1538520f);
+                b[3] = (0.86650f * b[3]) + (white * 0.3104856f);
+                b[4] = (0.55000f * b[4]) + (white * 0.5329522f);
+                b[5] = (-0.7616f * b[5]) - (white * 0.0168980f);
+                sample = b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + (white * 0.5362f);
+                b[6] = white * 0.115926f;
+            }
+
+            noise->samples[(n * 2u) + ch] = host_saturate(sample * scale);
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_noise
+******************************************************************************
+* Summary:
+*  Check the attenuation of a noise alone, then the level of a tone in the
+*  same noise and the attenuation of the noise under it.
+*
+* Parameters:
+*  noise: Noise
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_noise(const test_noise_t *noise)
+{
+    uint32_t num_frames = noise->num_frames;
+    uint32_t num_channels = noise->num_channels;
+    uint32_t num_samples = num_frames * num_channels;
+    uint32_t settle = TEST_SETTLE_S * noise->sample_rate;
+    uint32_t latency = AUDIO_NS_LATENCY_SAMPLES;
+    int16_t *in = malloc(num_samples * sizeof(int16_t));
+    int16_t *out = malloc(num_samples * sizeof(int16_t));
+    float *tone = malloc(num_frames * sizeof(float));
+    double omega = (2.0 * TEST_PI * TEST_TONE_HZ) / noise->sample_rate;
+    uint64_t elapsed;
+
+    if (settle >= (num_frames / 2u))
+    {
+        settle = num_frames / 2u;
+    }
+
+    /* Noise alone */
+    elapsed = test_run(noise->samples, out, num_frames, num_channels);
+
+    for (uint32_t ch = 0u; ch < num_channels; ch++)
+    {
+        double in_energy = test_energy(noise->samples, settle, num_frames - latency, num_channels, ch);
+        double out_energy = test_energy(out, settle + latency, num_frames, num_channels, ch);
+        double attenuation = 10.0 * log10((in_energy + 1.0) / (out_energy + 1.0));
+
+        HOST_CHECK(attenuation >= TEST_MIN_ATTENUATION_DB, "%s ch%u: noise attenuated by %.1f dB (min %.1f)",
+                   noise->name, (unsigned) ch, attenuation, (double) TEST_MIN_ATTENUATION_DB);
+    }
+
+    printf("INFO: %s: %.1f ns per sample, %.0fx real time at 48 ksps\n", noise->name,
+           (double) elapsed / num_samples, 1.0e9 / (((double) elapsed / num_frames) * 48000.0));
+
+    /* Bursts of a tone in the noise, at TEST_TONE_SNR_DB over the noise of
+     * each channel. A steady tone would be tracked as noise, like hum. */
+    for (uint32_t ch = 0u; ch < num_channels; ch++)
+    {
+        double noise_rms = sqrt(test_energy(noise->samples, 0u, num_frames, num_channels, ch) / num_frames);
+        double amplitude = noise_rms * sqrt(2.0) * pow(10.0, TEST_TONE_SNR_DB / 20.0);
+        uint32_t period = (TEST_BURST_PERIOD_MS * noise->sample_rate) / 1000u;
+        uint32_t length = (TEST_BURST_MS * noise->sample_rate) / 1000u;
+        uint32_t skip = (TEST_BURST_SKIP_MS * noise->sample_rate) / 1000u;
+        double tone_sum = 0.0;
+        double residual = 0.0;
+        double noise_in = 0.0;
+        uint32_t bursts = 0u;
+
+        memcpy(in, noise->samples, num_samples * sizeof(int16_t));
+        memset(tone, 0, num_frames * sizeof(float));
+        for (uint32_t n = settle; n < num_frames; n++)
+        {
+            if (((n - settle) % period) < length)
+            {
+                tone[n] = (float) (amplitude * sin(omega * n));
+            }
+            in[(n * num_channels) + ch] = host_saturate(tone[n] + noise->samples[(n * num_channels) + ch]);
+        }
+
+        test_run(in, out, num_frames, num_channels);
+
+        /* Fit the delayed tone in the output of each burst, after the gains
+         * have settled. The rest is the residual noise. */
+        for (uint32_t start = settle; (start + length + latency) <= num_frames; start += period)
+        {
+            double out_i = 0.0;
+            double out_q = 0.0;
+            uint32_t count = length - skip;
+
+            for (uint32_t n = start + skip; n < (start + length); n++)
+            {
+                double sample = out[((n + latency) * num_channels) + ch];
+
+                out_i += sample * sin(omega * n);
+                out_q += sample * cos(omega * n);
+            }
+            tone_sum += 2.0 * sqrt((out_i * out_i) + (out_q * out_q)) / count;
+            bursts++;
+
+            for (uint32_t n = start + skip; n < (start + length); n++)
+            {
+                double fit = (2.0 / count) * ((out_i * sin(omega * n)) + (out_q * cos(omega * n)));
+                double error = out[((n + latency) * num_channels) + ch] - fit;
+                double in_noise = noise->samples[(n * num_channels) + ch];
+
+                residual += error * error;
+                noise_in += in_noise * in_noise;
+            }
+        }
+
+        if (0u == bursts)
+        {
+            continue;
+        }
+
+        HOST_CHECK(fabs(20.0 * log10(tone_sum / (bursts * amplitude))) <= TEST_MAX_TONE_CHANGE_DB,
+                   "%s ch%u: tone level changed by %+.2f dB (max %.1f)", noise->name, (unsigned) ch,
+                   20.0 * log10(tone_sum / (bursts * amplitude)), (double) TEST_MAX_TONE_CHANGE_DB);
+        HOST_CHECK(10.0 * log10((noise_in + 1.0) / (residual + 1.0)) >= TEST_MIN_TONE_NOISE_DB,
+                   "%s ch%u: noise under the tone attenuated by %.1f dB (min %.1f)", noise->name,
+                   (unsigned) ch, 10.0 * log10((noise_in + 1.0) / (residual + 1.0)),
+                   (double) TEST_MIN_TONE_NOISE_DB);
+    }
+
+    free(in);
+    free(out);
+    free(tone);
+}
+
+
+/*****************************************************************************
+* Function Name: test_latency
+******************************************************************************
+* Summary:
+*  Check that an impulse in silence comes out unchanged, AUDIO_NS_LATENCY_SAMPLES
+*  later, on each channel.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_latency(void)
+{
+    uint32_t num_frames = TEST_SAMPLE_RATE;
+    uint32_t position[2] = { 5000u, 9001u };
+    int16_t *in = calloc(num_frames * 2u, sizeof(int16_t));
+    int16_t *out = calloc(num_frames * 2u, sizeof(int16_t));
+
+    in[position[0] * 2u] = 16000;
+    in[(position[1] * 2u) + 1u] = -16000;
+
+    test_run(in, out, num_frames, 2u);
+
+    for (uint32_t ch = 0u; ch < 2u; ch++)
+    {
+        uint32_t peak = 0u;
+        double error = 0.0;
+
+        for (uint32_t n = 0u; n < num_frames; n++)
+        {
+            if (abs(out[(n * 2u) + ch]) > abs(out[(peak * 2u) + ch]))
+            {
+                peak = n;
+            }
+            error += fabs((double) out[(n * 2u) + ch] -
+                          ((n >= AUDIO_NS_LATENCY_SAMPLES) ? in[((n - AUDIO_NS_LATENCY_SAMPLES) * 2u) + ch] : 0));
+        }
+
+        HOST_CHECK((peak - position[ch]) == AUDIO_NS_LATENCY_SAMPLES,
+                   "ch%u: impulse delayed by %u samples (expected %u)", (unsigned) ch,
+                   (unsigned) (peak - position[ch]), (unsigned) AUDIO_NS_LATENCY_SAMPLES);
+        HOST_CHECK((error / 16000.0) <= TEST_MAX_IMPULSE_ERROR, "ch%u: impulse error %.4f (max %.2f)",
+                   (unsigned) ch, error / 16000.0, (double) TEST_MAX_IMPULSE_ERROR);
+    }
+
+    free(in);
+    free(out);
+}
+
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test on the noise recordings given as 16-bit PCM WAV files, or
+*  on synthetic white and pink noise without arguments.
+*
+* Parameters:
+*  argc: Number of arguments
+*  argv: WAV files
+*
+* Return:
+*  int: 0 if all the checks passed
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    test_noise_t noise;
+
+    audio_ns_init();
+
+    test_latency();
+
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            noise.name = argv[i];
+            noise.samples = host_wav_read(argv[i], &noise.num_frames, &noise.num_channels, &noise.sample_rate);
+            HOST_CHECK(NULL != noise.samples, "%s: 16-bit PCM WAV with 1 or 2 channels", argv[i]);
+            if ((NULL != noise.samples) && (noise.num_frames > (2u * AUDIO_NS_LATENCY_SAMPLES)))
+            {
+                test_noise(&noise);
+            }
+            free(noise.samples);
+        }
+    }
+    else
+    {
+        test_synthetic_noise(&noise, "white noise", false, 0x12345678u);
+        test_noise(&noise);
+        free(noise.samples);
+
+        test_synthetic_noise(&noise, "pink noise", true, 0x9E3779B9u);
+        test_noise(&noise);
+        free(noise.samples);
+    }
+
+    return host_report("test_ns");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,512 @@
+/*****************************************************************************
+* File Name        : test_pool.c
+*
+* Description      : This file contains the host stress test of the packet pool
+*                    (audio_pool.c) with concurrent producers and consumers.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_pool.h"
+#include "audio.h"
+#include "host_test.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Producers stand for the Audio In Task and the Audio Tap Task, consumers
+ * for the stages holding on to packets, such as the spectrum analyzer */
+#define TEST_NUM_PRODUCERS          (2u)
+#define TEST_NUM_CONSUMERS          (AUDIO_POOL_MAX_CONSUMERS)
+#define TEST_PACKETS_PER_PRODUCER   (5000u)
+#define TEST_NUM_PACKETS            ((TEST_NUM_PRODUCERS) * (TEST_PACKETS_PER_PRODUCER))
+
+/* A consumer waits up to this long, before checking one packet out of
+ * TEST_DELAY_PERIOD, so that the pool runs empty now and then */
+#define TEST_MAX_DELAY_US           (200u)
+#define TEST_DELAY_PERIOD           (4u)
+
+/* Each queued packet holds a reference: a queue never holds more than the
+ * pool */
+#define TEST_QUEUE_SIZE             (AUDIO_POOL_NUM_PACKETS)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Consumer taking a reference to every published packet, and checking it
+ * later from its own thread */
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    audio_packet_t *queue[TEST_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    bool done;
+    uint32_t seed;
+    uint32_t overflows;                 /* Packets found with a full queue */
+    uint32_t corrupted;                 /* Packets changed while referenced */
+    uint32_t duplicates;                /* Packets received twice */
+    uint32_t unexpected;                /* Packets with a sequence out of the run */
+    uint8_t seen[TEST_NUM_PACKETS];
+} test_consumer_t;
+
+/* Producer allocating, filling, publishing, and releasing packets */
+typedef struct
+{
+    pthread_t thread;
+    uint32_t produced;
+    uint32_t alloc_failures;
+    uint32_t bad_refcount;              /* Packets allocated with other owners */
+} test_producer_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static test_consumer_t test_consumers[TEST_NUM_CONSUMERS];
+static test_producer_t test_producers[TEST_NUM_PRODUCERS];
+
+/* Sequence of the first packet of the stress run */
+static uint32_t test_first_sequence;
+
+
+/*****************************************************************************
+* Function Name: test_pattern
+******************************************************************************
+* Summary:
+*  Return the expected value of a sample of a packet.
+*
+* Parameters:
+*  sequence: Sequence of the packet
+*  index: Index of the sample
+*
+* Return:
+*  int16_t: Sample value
+*
+*****************************************************************************/
+static int16_t test_pattern(uint32_t sequence, uint32_t index)
+{
+    return (int16_t) (uint16_t) ((sequence * 7919u) + (index * 31u));
+}
+
+
+/*****************************************************************************
+* Function Name: test_fill
+******************************************************************************
+* Summary:
+*  Fill a packet with the pattern of its sequence.
+*
+* Parameters:
+*  packet: Packet to fill
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_fill(audio_packet_t *packet)
+{
+    packet->position = ~packet->sequence;
+    packet->num_frames = AUDIO_IN_FRAMES_PER_PACKET;
+    packet->num_channels = AUDIO_IN_NUM_CHANNELS;
+    packet->source = AUDIO_POOL_SOURCE_MIC;
+
+    for (uint32_t i = 0u; i < MAX_AUDIO_IN_PACKET_SIZE_WORDS; i++)
+    {
+        packet->samples[i] = test_pattern(packet->sequence, i);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_is_intact
+******************************************************************************
+* Summary:
+*  Check that a packet still holds the pattern of its sequence.
+*
+* Parameters:
+*  packet: Packet to check
+*
+* Return:
+*  bool: true if the packet is unchanged since test_fill()
+*
+*****************************************************************************/
+static bool test_is_intact(const audio_packet_t *packet)
+{
+    bool intact = (packet->position == ~packet->sequence);
+
+    for (uint32_t i = 0u; intact && (i < MAX_AUDIO_IN_PACKET_SIZE_WORDS); i++)
+    {
+        intact = (packet->samples[i] == test_pattern(packet->sequence, i));
+    }
+
+    return intact;
+}
+
+
+/*****************************************************************************
+* Function Name: test_consume
+******************************************************************************
+* Summary:
+*  Pool consumer: take a reference to the packet and queue it to the thread
+*  of the consumer.
+*
+* Parameters:
+*  packet: Published packet
+*  context: Consumer
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_consume(audio_packet_t *packet, void *context)
+{
+    test_consumer_t *consumer = (test_consumer_t *) context;
+
+    pthread_mutex_lock(&consumer->lock);
+
+    if ((consumer->head - consumer->tail) < TEST_QUEUE_SIZE)
+    {
+        audio_pool_retain(packet);
+        consumer->queue[consumer->head % TEST_QUEUE_SIZE] = packet;
+        consumer->head++;
+        pthread_cond_signal(&consumer->ready);
+    }
+    else
+    {
+        consumer->overflows++;
+    }
+
+    pthread_mutex_unlock(&consumer->lock);
+}
+
+
+/*****************************************************************************
+* Function Name: test_consumer_thread
+******************************************************************************
+* Summary:
+*  Check and release the packets queued to a consumer, after a random delay,
+*  until the end of the run.
+*
+* Parameters:
+*  arg: Consumer
+*
+* Return:
+*  void *: NULL
+*
+*****************************************************************************/
+static void *test_consumer_thread(void *arg)
+{
+    test_consumer_t *consumer = (test_consumer_t *) arg;
+    audio_packet_t *packet;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&consumer->lock);
+        while ((consumer->head == consumer->tail) && (!consumer->done))
+        {
+            pthread_cond_wait(&consumer->ready, &consumer->lock);
+        }
+        if (consumer->head == consumer->tail)
+        {
+            pthread_mutex_unlock(&consumer->lock);
+            break;
+        }
+        packet = consumer->queue[consumer->tail % TEST_QUEUE_SIZE];
+        consumer->tail++;
+        pthread_mutex_unlock(&consumer->lock);
+
+        if (0u == (host_random(&consumer->seed) % TEST_DELAY_PERIOD))
+        {
+            usleep(host_random(&consumer->seed) % TEST_MAX_DELAY_US);
+        }
+
+        if (!test_is_intact(packet))
+        {
+            consumer->corrupted++;
+        }
+
+        uint32_t index = packet->sequence - test_first_sequence;
+        if (index >= TEST_NUM_PACKETS)
+        {
+            consumer->unexpected++;
+        }
+        else if (0u != consumer->seen[index]++)
+        {
+            consumer->duplicates++;
+        }
+
+        audio_pool_release(packet);
+    }
+
+    return NULL;
+}
+
+
+/*****************************************************************************
+* Function Name: test_producer_thread
+******************************************************************************
+* Summary:
+*  Allocate, fill, publish, and release packets until TEST_PACKETS_PER_PRODUCER
+*  have been published, retrying while the pool is empty.
+*
+* Parameters:
+*  arg: Producer
+*
+* Return:
+*  void *: NULL
+*
+*****************************************************************************/
+static void *test_producer_thread(void *arg)
+{
+    test_producer_t *producer = (test_producer_t *) arg;
+    audio_packet_t *packet;
+
+    while (producer->produced < TEST_PACKETS_PER_PRODUCER)
+    {
+        packet = audio_pool_alloc();
+        if (NULL == packet)
+        {
+            producer->alloc_failures++;
+            sched_yield();
+            continue;
+        }
+
+        if (1u != packet->refcount)
+        {
+            producer->bad_refcount++;
+        }
+
+        test_fill(packet);
+        audio_pool_publish(packet);
+        audio_pool_release(packet);
+        producer->produced++;
+    }
+
+    return NULL;
+}
+
+
+/*****************************************************************************
+* Function Name: test_exhaustion
+******************************************************************************
+* Summary:
+*  Check the allocation of every packet of the pool, the refusal of one more,
+*  and the return of the packets with their last reference.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_exhaustion(void)
+{
+    audio_packet_t *packets[AUDIO_POOL_NUM_PACKETS];
+    audio_pool_stats_t stats;
+    bool distinct = true;
+    uint32_t num_allocated = 0u;
+
+    audio_pool_init();
+
+    for (uint32_t i = 0u; i < AUDIO_POOL_NUM_PACKETS; i++)
+    {
+        packets[i] = audio_pool_alloc();
+        if (NULL != packets[i])
+        {
+            num_allocated++;
+        }
+        for (uint32_t j = 0u; j < i; j++)
+        {
+            distinct = distinct && (packets[i] != packets[j]);
+        }
+    }
+    HOST_CHECK((AUDIO_POOL_NUM_PACKETS == num_allocated) && distinct,
+               "exhaustion: %u distinct packets allocated", (unsigned) num_allocated);
+    HOST_CHECK(NULL == audio_pool_alloc(), "exhaustion: allocation from an empty pool refused");
+
+    audio_pool_get_stats(&stats);
+    HOST_CHECK((AUDIO_POOL_NUM_PACKETS == stats.in_use) && (AUDIO_POOL_NUM_PACKETS == stats.high_water) &&
+               (1u == stats.alloc_failures),
+               "exhaustion: in use %u, high water %u, %u failure",
+               (unsigned) stats.in_use, (unsigned) stats.high_water, (unsigned) stats.alloc_failures);
+
+    /* A retained packet stays allocated until its last reference */
+    audio_pool_retain(packets[0]);
+    for (uint32_t i = 0u; i < AUDIO_POOL_NUM_PACKETS; i++)
+    {
+        audio_pool_release(packets[i]);
+    }
+    audio_pool_get_stats(&stats);
+    HOST_CHECK(1u == stats.in_use, "retain: retained packet kept after its first release");
+    audio_pool_release(packets[0]);
+
+    audio_pool_reset_stats();
+    audio_pool_get_stats(&stats);
+    HOST_CHECK((0u == stats.in_use) && (0u == stats.high_water) && (0u == stats.alloc_failures),
+               "exhaustion: every packet returned to the pool");
+}
+
+
+/*****************************************************************************
+* Function Name: test_concurrency
+******************************************************************************
+* Summary:
+*  Run producers and consumers in parallel threads, and check that no
+*  packet is reused while referenced, that every consumer receives every
+*  packet once, and that the pool counts balance at the end.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_concurrency(void)
+{
+    audio_packet_t *packet;
+    audio_pool_stats_t stats;
+    uint32_t alloc_failures = 0u;
+    uint32_t bad_refcount = 0u;
+    uint32_t overflows = 0u;
+    uint32_t corrupted = 0u;
+    uint32_t duplicates = 0u;
+    uint32_t unexpected = 0u;
+    uint32_t missing = 0u;
+
+    /* Sequences are given in allocation order: the run starts after this one */
+    packet = audio_pool_alloc();
+    test_first_sequence = packet->sequence + 1u;
+    audio_pool_release(packet);
+    audio_pool_reset_stats();
+
+    for (uint32_t i = 0u; i < TEST_NUM_CONSUMERS; i++)
+    {
+        test_consumer_t *consumer = &test_consumers[i];
+
+        memset(consumer, 0, sizeof(*consumer));
+        consumer->seed = 0x1234u + i;
+        pthread_mutex_init(&consumer->lock, NULL);
+        pthread_cond_init(&consumer->ready, NULL);
+        HOST_CHECK(audio_pool_add_consumer(test_consume, consumer), "consumer %u registered", (unsigned) i);
+        pthread_create(&consumer->thread, NULL, test_consumer_thread, consumer);
+    }
+    HOST_CHECK(!audio_pool_add_consumer(test_consume, NULL),
+               "consumer beyond AUDIO_POOL_MAX_CONSUMERS refused");
+
+    for (uint32_t i = 0u; i < TEST_NUM_PRODUCERS; i++)
+    {
+        memset(&test_producers[i], 0, sizeof(test_producers[i]));
+        pthread_create(&test_producers[i].thread, NULL, test_producer_thread, &test_producers[i]);
+    }
+    for (uint32_t i = 0u; i < TEST_NUM_PRODUCERS; i++)
+    {
+        pthread_join(test_producers[i].thread, NULL);
+        alloc_failures += test_producers[i].alloc_failures;
+        bad_refcount += test_producers[i].bad_refcount;
+    }
+
+    for (uint32_t i = 0u; i < TEST_NUM_CONSUMERS; i++)
+    {
+        test_consumer_t *consumer = &test_consumers[i];
+
+        pthread_mutex_lock(&consumer->lock);
+        consumer->done = true;
+        pthread_cond_signal(&consumer->ready);
+        pthread_mutex_unlock(&consumer->lock);
+        pthread_join(consumer->thread, NULL);
+
+        overflows += consumer->overflows;
+        corrupted += consumer->corrupted;
+        duplicates += consumer->duplicates;
+        unexpected += consumer->unexpected;
+        for (uint32_t j = 0u; j < TEST_NUM_PACKETS; j++)
+        {
+            missing += (0u == consumer->seen[j]) ? 1u : 0u;
+        }
+    }
+
+    audio_pool_get_stats(&stats);
+    printf("INFO: %u packets, %u consumers, pool of %u: high water %u, %u allocations refused\n",
+           (unsigned) TEST_NUM_PACKETS, (unsigned) TEST_NUM_CONSUMERS, (unsigned) AUDIO_POOL_NUM_PACKETS,
+           (unsigned) stats.high_water, (unsigned) stats.alloc_failures);
+
+    HOST_CHECK((0u == corrupted) && (0u == bad_refcount),
+               "concurrency: no packet reused while referenced (%u corrupted, %u reallocated)",
+               (unsigned) corrupted, (unsigned) bad_refcount);
+    HOST_CHECK((0u == missing) && (0u == duplicates) && (0u == unexpected) && (0u == overflows),
+               "concurrency: every consumer received every packet once (%u missing, %u duplicated)",
+               (unsigned) missing, (unsigned) duplicates);
+    HOST_CHECK(TEST_NUM_PACKETS == stats.published,
+               "concurrency: %u packets published", (unsigned) stats.published);
+    HOST_CHECK(alloc_failures == stats.alloc_failures,
+               "concurrency: %u refused allocations counted", (unsigned) alloc_failures);
+    HOST_CHECK((0u == stats.in_use) && (stats.high_water <= AUDIO_POOL_NUM_PACKETS),
+               "concurrency: pool balanced, in use %u, high water %u",
+               (unsigned) stats.in_use, (unsigned) stats.high_water);
+}
+
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the checks of the packet pool.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if all the checks passed
+*
+*****************************************************************************/
+int main(void)
+{
+    test_exhaustion();
+    test_concurrency();
+
+    return host_report("test_pool");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,738 @@
+/*****************************************************************************
+* File Name        : test_recorder.c
+*
+* Description      : This file contains the host test of the offline recorder
+*                    (audio_recorder.c) on the file storage backend, in
+*                    simulated time, and its throughput benchmark.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+/* The tasks of the recorder are static: the recorder is built into this
+ * test, which runs them in simulated time */
+#include "host_store_file.h"
+#include "audio_recorder.c"
+#include "host_test.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_FRAMES_PER_MS          ((AUDIO_IN_SAMPLE_FREQ) / 1000u)
+#define TEST_BUFFER_BYTES           ((RECORDER_BUFFER_FRAMES) * (AUDIO_IN_FRAME_SIZE_BYTES))
+
+/* The frames of session n count up from n times this */
+#define TEST_SESSION_FRAMES         (1UL << 24)
+
+/* Longest wait for the recorder to start, or to complete the log */
+#define TEST_TIMEOUT_MS             (10000u)
+
+/* Most segments of the stores of the test */
+#define TEST_MAX_SEGMENTS           (32u)
+
+/* Stores of the log tests: segments of 0.34 s */
+#define TEST_LOG_SEGMENTS           (8u)
+#define TEST_LOG_SEGMENT_BYTES      (65536u)
+#define TEST_LOG_SEGMENT_FRAMES     (((TEST_LOG_SEGMENT_BYTES) - (AUDIO_RECORDER_HEADER_BYTES)) / \
+                                     (AUDIO_IN_FRAME_SIZE_BYTES))
+
+/* Slow serial flash of the latency test: a segment of 1.4 s takes 1 s to
+ * erase, four times the buffer, and 128 ms to write */
+#define TEST_SLOW_SEGMENTS          (6u)
+#define TEST_SLOW_SEGMENT_BYTES     (262144u)
+#define TEST_SLOW_ERASE_MS          (1000u)
+#define TEST_SLOW_ERASE_STEP_US     (250u)
+#define TEST_SLOW_WRITE_US_PER_KIB  (500u)
+
+/* Benchmark: a minute of audio on segments of 1 MiB, every write flushed
+ * to the disk */
+#define TEST_BENCH_SEGMENTS         (16u)
+#define TEST_BENCH_SEGMENT_BYTES    (1048576u)
+#define TEST_BENCH_MS               (60000u)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Stand-in of the capture queue. The frames count up from the first frame
+ * of the session: the left channel holds the low 16 bits of the count, and
+ * the right channel the high 16 bits. */
+typedef struct
+{
+    bool enabled;
+    uint32_t first;                 /* First frame of the session */
+    uint32_t head;                  /* Next frame captured */
+    uint32_t tail;                  /* Next frame read */
+} test_capture_t;
+
+/* Result of a session, from the process that ran it */
+typedef struct
+{
+    audio_recorder_status_t status;
+    uint32_t captured;              /* Frames captured */
+} test_session_t;
+
+/* Session of the log read back */
+typedef struct
+{
+    uint32_t session;
+    uint32_t segments;
+    uint32_t first;                 /* First frame */
+    uint32_t frames;
+    uint32_t gaps;                  /* Frames missing after the first frame */
+    uint32_t disorders;             /* Frames that do not follow the previous one */
+    uint32_t dropped;               /* Dropped frames, from the last segment record */
+} test_log_session_t;
+
+/* Log read back */
+typedef struct
+{
+    uint32_t records;               /* Segments with a record */
+    uint32_t first_sequence;
+    uint32_t last_sequence;
+    bool contiguous;                /* No sequence missing from first to last */
+    bool headers_valid;             /* WAV headers match the records */
+    uint32_t erase_count_min;
+    uint32_t erase_count_max;
+    uint32_t num_sessions;
+    test_log_session_t sessions[TEST_MAX_SEGMENTS];
+} test_log_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static const char *test_path;
+static test_capture_t test_capture;
+
+/* Simulated time not yet counted in the tick count */
+static uint32_t test_time_us;
+
+
+/*****************************************************************************
+* Stand-ins of the capture queue of audio_in.c: the microphones capture
+* TEST_FRAMES_PER_MS frames per tick of simulated time.
+*****************************************************************************/
+void audio_in_offline_enable(void)
+{
+    test_capture.enabled = true;
+    test_capture.head = test_capture.first;
+    test_capture.tail = test_capture.first;
+}
+
+void audio_in_offline_disable(void)
+{
+    test_capture.enabled = false;
+}
+
+uint32_t audio_in_offline_read(uint16_t *buffer, uint32_t max_frames)
+{
+    uint32_t num_frames = test_capture.head - test_capture.tail;
+
+    if (num_frames > max_frames)
+    {
+        num_frames = max_frames;
+    }
+
+    if (NULL != buffer)
+    {
+        for (uint32_t i = 0u; i < num_frames; i++)
+        {
+            buffer[(i * AUDIO_IN_NUM_CHANNELS)] = (uint16_t) (test_capture.tail + i);
+            buffer[(i * AUDIO_IN_NUM_CHANNELS) + 1u] = (uint16_t) ((test_capture.tail + i) >> 16);
+        }
+    }
+    test_capture.tail += num_frames;
+
+    return num_frames;
+}
+
+
+/*****************************************************************************
+* Function Name: test_tick
+******************************************************************************
+* Summary:
+*  Run a tick of simulated time: the microphones capture, and the Audio Rec
+*  Task runs every AUDIO_RECORDER_DRAIN_MS.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_tick(void)
+{
+    vTaskDelay(1u);
+
+    if (test_capture.enabled)
+    {
+        test_capture.head += TEST_FRAMES_PER_MS;
+    }
+
+    if (0u == (xTaskGetTickCount() % (AUDIO_RECORDER_DRAIN_MS)))
+    {
+        audio_recorder_capture_poll();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_wait
+******************************************************************************
+* Summary:
+*  Run simulated time while the Audio Store Task waits, for its delay or
+*  for the device. The Audio Rec Task runs meanwhile, as it preempts the
+*  Audio Store Task on the target.
+*
+* Parameters:
+*  us: Time in us
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_wait(uint32_t us)
+{
+    host_dwt_advance(us * 1000u);
+
+    test_time_us += us;
+    while (test_time_us >= 1000u)
+    {
+        test_time_us -= 1000u;
+        test_tick();
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_run
+******************************************************************************
+* Summary:
+*  Run the Audio Store Task for a time, or until the recorder is in a
+*  state.
+*
+* Parameters:
+*  ms: Time to run
+*  state: State to wait for, or -1 to run for the whole time
+*
+* Return:
+*  bool: true if the recorder is in the state
+*
+*****************************************************************************/
+static bool test_run(uint32_t ms, int state)
+{
+    uint32_t start = xTaskGetTickCount();
+
+    while (((xTaskGetTickCount() - start) < ms) && (state != (int) recorder_state))
+    {
+        if (!audio_recorder_store_poll())
+        {
+            test_wait((AUDIO_RECORDER_DRAIN_MS) * 1000u);
+        }
+    }
+
+    return (state == (int) recorder_state);
+}
+
+
+/*****************************************************************************
+* Function Name: test_erase_store
+******************************************************************************
+* Summary:
+*  Start from an empty store.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_erase_store(void)
+{
+    int fd = open(test_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    HOST_CHECK(fd >= 0, "%s emptied", test_path);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_session
+******************************************************************************
+* Summary:
+*  Run a recording session from power up, in a child process so that the
+*  recorder starts from its reset state and continues the log left on the
+*  store. The recorder is armed, records for a time once the start delay
+*  is over, then is stopped and completes the log, or loses its power.
+*
+* Parameters:
+*  config: Store
+*  session: Number of the session, from 1
+*  record_ms: Recording time
+*  power_loss: true to end the session without stopping the recorder
+*  result: Destination of the result
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_session(const host_store_file_config_t *config, uint32_t session, uint32_t record_ms,
+                         bool power_loss, test_session_t *result)
+{
+    int fds[2];
+    int status = 0;
+    pid_t pid;
+    bool received;
+
+    memset(result, 0, sizeof(*result));
+
+    fflush(stdout);
+    if (0 != pipe(fds))
+    {
+        HOST_CHECK(false, "session %u: pipe", (unsigned) session);
+        return;
+    }
+
+    pid = fork();
+    if (0 == pid)
+    {
+        close(fds[0]);
+
+        test_capture.first = session * TEST_SESSION_FRAMES;
+        host_store_file_configure(config);
+        audio_recorder_init();
+        audio_recorder_arm();
+
+        if (test_run(TEST_TIMEOUT_MS, AUDIO_RECORDER_RECORDING))
+        {
+            (void) test_run(record_ms, -1);
+            if (!power_loss)
+            {
+                /* As audio_recorder_stop(), whose wait runs here */
+                recorder_arm_request = false;
+                recorder_stop_request = true;
+                (void) test_run(TEST_TIMEOUT_MS, AUDIO_RECORDER_IDLE);
+            }
+        }
+
+        audio_recorder_get_status(&result->status);
+        result->captured = test_capture.head - test_capture.first;
+
+        fflush(stdout);
+        _exit((write(fds[1], result, sizeof(*result)) == (ssize_t) sizeof(*result)) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(fds[1]);
+    received = (pid > 0) && (read(fds[0], result, sizeof(*result)) == (ssize_t) sizeof(*result));
+    close(fds[0]);
+    received = (pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) &&
+               (EXIT_SUCCESS == WEXITSTATUS(status)) && received;
+
+    HOST_CHECK(received, "session %u: %u frames captured, %u written in %u segments, %u dropped, %u errors",
+               (unsigned) session, (unsigned) result->captured, (unsigned) result->status.frames,
+               (unsigned) result->status.segments, (unsigned) result->status.dropped_frames,
+               (unsigned) result->status.errors);
+}
+
+
+/*****************************************************************************
+* Function Name: test_read_log
+******************************************************************************
+* Summary:
+*  Read the log back from the store: the segment records in the order of
+*  the log, and the audio of each session.
+*
+* Parameters:
+*  config: Store
+*  log: Destination of the log
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_read_log(const host_store_file_config_t *config, test_log_t *log)
+{
+    static recorder_wav_header_t headers[TEST_MAX_SEGMENTS];
+    uint32_t order[TEST_MAX_SEGMENTS];
+    uint16_t *audio = malloc(config->segment_bytes);
+    test_log_session_t *session = NULL;
+    recorder_wav_header_t *header;
+    uint32_t next = 0u;
+    uint32_t frame;
+    uint32_t index;
+
+    memset(log, 0, sizeof(*log));
+    log->erase_count_min = UINT32_MAX;
+    log->contiguous = true;
+    log->headers_valid = true;
+
+    host_store_file_configure(config);
+    if ((NULL == audio) || (!audio_store_file.init()))
+    {
+        free(audio);
+        return;
+    }
+
+    /* Records, sorted by sequence */
+    for (uint32_t segment = 0u; segment < config->num_segments; segment++)
+    {
+        if ((!audio_store_file.read(segment, 0u, &headers[segment], sizeof(headers[segment]))) ||
+            (AUDIO_RECORDER_MAGIC != headers[segment].segment.magic))
+        {
+            continue;
+        }
+
+        for (index = log->records; (index > 0u) &&
+             (headers[order[index - 1u]].segment.sequence > headers[segment].segment.sequence); index--)
+        {
+            order[index] = order[index - 1u];
+        }
+        order[index] = segment;
+        log->records++;
+    }
+
+    for (index = 0u; index < log->records; index++)
+    {
+        header = &headers[order[index]];
+
+        if (0u == index)
+        {
+            log->first_sequence = header->segment.sequence;
+        }
+        else if (header->segment.sequence != (log->last_sequence + 1u))
+        {
+            log->contiguous = false;
+        }
+        log->last_sequence = header->segment.sequence;
+
+        if (header->segment.erase_count < log->erase_count_min)
+        {
+            log->erase_count_min = header->segment.erase_count;
+        }
+        if (header->segment.erase_count > log->erase_count_max)
+        {
+            log->erase_count_max = header->segment.erase_count;
+        }
+
+        if ((0 != memcmp(header->riff_id, "RIFF", 4u)) || (0 != memcmp(header->data_id, "data", 4u)) ||
+            (header->data_size != (header->segment.frames * AUDIO_IN_FRAME_SIZE_BYTES)) ||
+            ((AUDIO_RECORDER_HEADER_BYTES + header->data_size) > config->segment_bytes) ||
+            (!audio_store_file.read(order[index], AUDIO_RECORDER_HEADER_BYTES, audio, header->data_size)))
+        {
+            log->headers_valid = false;
+            continue;
+        }
+
+        if ((NULL == session) || (session->session != header->segment.session))
+        {
+            session = &log->sessions[log->num_sessions++];
+            session->session = header->segment.session;
+            session->first = audio[0] | ((uint32_t) audio[1] << 16);
+            next = session->first;
+        }
+        session->segments++;
+        session->frames += header->segment.frames;
+        session->dropped = header->segment.dropped_frames;
+
+        for (uint32_t i = 0u; i < header->segment.frames; i++)
+        {
+            frame = audio[(i * AUDIO_IN_NUM_CHANNELS)] | ((uint32_t) audio[(i * AUDIO_IN_NUM_CHANNELS) + 1u] << 16);
+            if (frame < next)
+            {
+                session->disorders++;
+            }
+            else
+            {
+                session->gaps += frame - next;
+            }
+            next = frame + 1u;
+        }
+    }
+
+    free(audio);
+}
+
+
+/*****************************************************************************
+* Function Name: test_continuation
+******************************************************************************
+* Summary:
+*  Check that the log continues over power cycles: a session that stops, a
+*  session that loses its power while it records, and a session after it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_continuation(void)
+{
+    const host_store_file_config_t config =
+    {
+        .path = test_path, .num_segments = TEST_LOG_SEGMENTS, .segment_bytes = TEST_LOG_SEGMENT_BYTES
+    };
+    test_session_t sessions[3];
+    test_log_t log;
+
+    test_erase_store();
+    test_session(&config, 1u, 800u, false, &sessions[0]);
+    test_session(&config, 2u, 500u, true, &sessions[1]);
+    test_session(&config, 3u, 500u, false, &sessions[2]);
+
+    for (uint32_t index = 0u; index < 3u; index++)
+    {
+        audio_recorder_status_t *status = &sessions[index].status;
+        bool stopped = (1u != index);
+
+        HOST_CHECK((0u == status->errors) && (0u == status->dropped_frames) &&
+                   ((stopped ? AUDIO_RECORDER_IDLE : AUDIO_RECORDER_RECORDING) == status->state),
+                   "session %u: state %u, no error, no frame dropped", (unsigned) (index + 1u),
+                   (unsigned) status->state);
+        HOST_CHECK(stopped ? (status->frames == sessions[index].captured) :
+                   (status->frames == (status->segments * TEST_LOG_SEGMENT_FRAMES)),
+                   "session %u: %s", (unsigned) (index + 1u),
+                   stopped ? "every frame written" : "the segments written before the power loss complete");
+    }
+    HOST_CHECK((3u == sessions[0].status.segments) && (1u == sessions[1].status.segments) &&
+               (2u == sessions[2].status.segments), "3, 1 and 2 segments");
+
+    test_read_log(&config, &log);
+    HOST_CHECK((6u == log.records) && (1u == log.first_sequence) && (6u == log.last_sequence) && log.contiguous &&
+               log.headers_valid, "log: %u segments, sequence %u to %u", (unsigned) log.records,
+               (unsigned) log.first_sequence, (unsigned) log.last_sequence);
+    HOST_CHECK(3u == log.num_sessions, "log: %u sessions", (unsigned) log.num_sessions);
+
+    for (uint32_t index = 0u; (index < log.num_sessions) && (index < 3u); index++)
+    {
+        test_log_session_t *session = &log.sessions[index];
+
+        HOST_CHECK((index == session->session) && (((index + 1u) * TEST_SESSION_FRAMES) == session->first) &&
+                   (sessions[index].status.frames == session->frames) && (0u == session->gaps) &&
+                   (0u == session->disorders),
+                   "log: session %u, %u segments, %u frames from its first frame, in order",
+                   (unsigned) session->session, (unsigned) session->segments, (unsigned) session->frames);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_wear
+******************************************************************************
+* Summary:
+*  Check that the log wraps over the store, with the erases spread evenly,
+*  in a long session and in a session after a power cycle.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_wear(void)
+{
+    const host_store_file_config_t config =
+    {
+        .path = test_path, .num_segments = TEST_LOG_SEGMENTS, .segment_bytes = TEST_LOG_SEGMENT_BYTES
+    };
+    test_session_t sessions[2];
+    audio_recorder_status_t *status;
+    uint32_t segments = 0u;
+    test_log_t log;
+
+    test_erase_store();
+    test_session(&config, 1u, 20000u, false, &sessions[0]);
+    test_session(&config, 2u, 5000u, false, &sessions[1]);
+
+    for (uint32_t index = 0u; index < 2u; index++)
+    {
+        status = &sessions[index].status;
+        segments += status->segments;
+
+        HOST_CHECK((0u == status->errors) && (0u == status->dropped_frames) &&
+                   (status->frames == sessions[index].captured) &&
+                   (status->segments == (((sessions[index].captured - 1u) / TEST_LOG_SEGMENT_FRAMES) + 1u)),
+                   "session %u: %u segments on a store of %u", (unsigned) (index + 1u), (unsigned) status->segments,
+                   (unsigned) TEST_LOG_SEGMENTS);
+        HOST_CHECK((status->erase_count_max - status->erase_count_min) <= 1u,
+                   "session %u: erase counts %u to %u", (unsigned) (index + 1u), (unsigned) status->erase_count_min,
+                   (unsigned) status->erase_count_max);
+    }
+
+    /* The open segment and the spare hold no record at the end */
+    test_read_log(&config, &log);
+    HOST_CHECK(((TEST_LOG_SEGMENTS - 1u) == log.records) && (segments == log.last_sequence) && log.contiguous &&
+               log.headers_valid, "log: the last %u segments, sequence %u to %u", (unsigned) log.records,
+               (unsigned) log.first_sequence, (unsigned) log.last_sequence);
+    HOST_CHECK((log.erase_count_max - log.erase_count_min) <= 1u, "log: erase counts %u to %u",
+               (unsigned) log.erase_count_min, (unsigned) log.erase_count_max);
+    for (uint32_t index = 0u; index < log.num_sessions; index++)
+    {
+        HOST_CHECK((0u == log.sessions[index].gaps) && (0u == log.sessions[index].disorders),
+                   "log: session %u, %u frames in order", (unsigned) log.sessions[index].session,
+                   (unsigned) log.sessions[index].frames);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_latency
+******************************************************************************
+* Summary:
+*  Check on a slow flash, whose erase outlasts the buffer four times, that
+*  the erase in steps ahead of the log drops nothing. Without steps, the
+*  erase blocks the Audio Store Task: the capture goes on and the frames
+*  that do not fit are dropped and counted.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_latency(void)
+{
+    host_store_file_config_t config =
+    {
+        .path = test_path, .num_segments = TEST_SLOW_SEGMENTS, .segment_bytes = TEST_SLOW_SEGMENT_BYTES,
+        .erase_ms = TEST_SLOW_ERASE_MS, .erase_step_us = TEST_SLOW_ERASE_STEP_US,
+        .write_us_per_kib = TEST_SLOW_WRITE_US_PER_KIB, .wait = test_wait
+    };
+    test_session_t session;
+    audio_recorder_status_t *status = &session.status;
+    test_log_t log;
+
+    test_erase_store();
+    test_session(&config, 1u, 10000u, false, &session);
+    printf("INFO: erase steps: buffer max %u ms, write max %u us, erase max %u us\n",
+           (unsigned) (status->buffer_max_bytes / ((AUDIO_IN_FRAME_SIZE_BYTES) * TEST_FRAMES_PER_MS)),
+           (unsigned) status->write_max_us, (unsigned) status->erase_max_us);
+    HOST_CHECK((0u == status->errors) && (0u == status->dropped_frames) && (status->frames == session.captured),
+               "erase steps: every frame written");
+    HOST_CHECK(status->erase_max_us < (4u * TEST_SLOW_ERASE_STEP_US), "erase steps: longest erase step %u us",
+               (unsigned) status->erase_max_us);
+    HOST_CHECK(status->buffer_max_bytes < (TEST_BUFFER_BYTES / 4u), "erase steps: buffer max %u bytes of %u",
+               (unsigned) status->buffer_max_bytes, (unsigned) TEST_BUFFER_BYTES);
+
+    config.erase_step_us = 0u;
+    test_erase_store();
+    test_session(&config, 1u, 10000u, false, &session);
+    printf("INFO: whole erases: buffer max %u ms, write max %u us, erase max %u us, %u frames dropped\n",
+           (unsigned) (status->buffer_max_bytes / ((AUDIO_IN_FRAME_SIZE_BYTES) * TEST_FRAMES_PER_MS)),
+           (unsigned) status->write_max_us, (unsigned) status->erase_max_us, (unsigned) status->dropped_frames);
+    HOST_CHECK((0u == status->errors) && (AUDIO_RECORDER_IDLE == status->state) && (0u != status->dropped_frames) &&
+               ((status->frames + status->dropped_frames) == session.captured),
+               "whole erases: frames dropped and counted, recording went on");
+    HOST_CHECK(status->buffer_max_bytes == TEST_BUFFER_BYTES, "whole erases: buffer full");
+
+    test_read_log(&config, &log);
+    HOST_CHECK((1u == log.num_sessions) && (0u == log.sessions[0].disorders) &&
+               (log.sessions[0].gaps == log.sessions[0].dropped) &&
+               (log.sessions[0].dropped == status->dropped_frames),
+               "log: %u frames in order, a gap for each dropped frame", (unsigned) log.sessions[0].frames);
+}
+
+
+/*****************************************************************************
+* Function Name: test_benchmark
+******************************************************************************
+* Summary:
+*  Measure the sustained write throughput of the store: a minute of audio,
+*  every write flushed to the disk. The device time of the recorder is the
+*  time of the writes on the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_benchmark(void)
+{
+    const host_store_file_config_t config =
+    {
+        .path = test_path, .num_segments = TEST_BENCH_SEGMENTS, .segment_bytes = TEST_BENCH_SEGMENT_BYTES,
+        .sync = true
+    };
+    const double byte_rate = (double) (AUDIO_IN_SAMPLE_FREQ) * (AUDIO_IN_FRAME_SIZE_BYTES);
+    test_session_t session;
+    audio_recorder_status_t *status = &session.status;
+    uint64_t start;
+    double elapsed;
+    double throughput;
+
+    test_erase_store();
+    start = host_time_ns();
+    test_session(&config, 1u, TEST_BENCH_MS, false, &session);
+    elapsed = (double) (host_time_ns() - start) / 1e9;
+    throughput = (double) status->throughput_kib_s * 1024.0;
+
+    printf("INFO: %s: %.2f MiB/s of write time, %.0f times real time, write max %u us, "
+           "%.1f s for %u s of audio\n", test_path, throughput / 1048576.0, throughput / byte_rate,
+           (unsigned) status->write_max_us, elapsed, (unsigned) (TEST_BENCH_MS / 1000u));
+    HOST_CHECK((0u == status->errors) && (0u == status->dropped_frames) && (status->frames == session.captured),
+               "benchmark: every frame written");
+    HOST_CHECK(throughput >= byte_rate, "benchmark: sustains the %.0f KiB/s of the audio", byte_rate / 1024.0);
+}
+
+
+int main(int argc, char *argv[])
+{
+    test_path = (argc > 1) ? argv[1] : "store.bin";
+
+    test_continuation();
+    test_wear();
+    test_latency();
+    test_benchmark();
+
+    return host_report("test_recorder");
+}
+
+/* [] END OF FILE */
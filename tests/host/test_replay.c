@@ -0,0 +1,660 @@
+/*****************************************************************************
+* File Name        : test_replay.c
+*
+* Description      : This file contains the host replay of capture recordings
+*                    (audio_capture.c) through the capture path of audio_in.c,
+*                    with the packets compared with golden ones.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+/* The PDM-PCM interrupt handler is static: the capture path is built into
+ * this test */
+#include "audio_in.c"
+#include "host_test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_MAX_PACKETS            (4096u)
+
+/* Offset of the microphone clock from the USB clock: the capture queue
+ * drifts by a frame every 1000 packets, and the catch-up adjusts the packet
+ * sizes */
+#define TEST_CLOCK_PPM              (1000.0)
+
+/* The interrupt handler runs up to this many frames after the trigger */
+#define TEST_MAX_ISR_LATENCY        (4u)
+
+/* One request out of TEST_LATE_PERIOD is late by one period, and followed
+ * by the next one right away */
+#define TEST_LATE_PERIOD            (16u)
+
+/* Amplitude of the microphone signals */
+#define TEST_AMPLITUDE              (8000.0)
+
+
+/*****************************************************************************
+* Structures
+*****************************************************************************/
+/* Packets sent to the Audio IN endpoint */
+typedef struct
+{
+    uint32_t count;
+    uint32_t size[TEST_MAX_PACKETS];
+    uint8_t data[TEST_MAX_PACKETS][MAX_AUDIO_IN_PACKET_SIZE_BYTES];
+} test_packets_t;
+
+/* Recorded session */
+typedef struct
+{
+    const char *name;
+    U8 alt_setting;
+    uint32_t num_packets;           /* Requests of the host */
+    double clock_ppm;               /* Offset of the microphone clock */
+} test_session_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+/* The stereo session ends before the recording is full, the beamformed one
+ * after */
+static const test_session_t test_sessions[] =
+{
+    { "stereo",    AUDIO_IN_ALT_STEREO,    100u * (AUDIO_IN_PACKETS_PER_MS),  TEST_CLOCK_PPM },
+    { "beam mono", AUDIO_IN_ALT_BEAM_MONO, 400u * (AUDIO_IN_PACKETS_PER_MS), -TEST_CLOCK_PPM },
+    { "mono",      AUDIO_IN_ALT_MONO,      100u * (AUDIO_IN_PACKETS_PER_MS),  0.0 },
+};
+
+static test_packets_t test_live;
+static test_packets_t test_golden;
+static test_packets_t test_replayed;
+
+/* Defined by audio_capture.c, without a declaration in its interface */
+extern uint32_t audio_capture_buffer[AUDIO_CAPTURE_NUM_WORDS];
+
+
+/*****************************************************************************
+* Stand-ins of the modules the capture path calls, not built on the host.
+* The stages of the CM55 stay inactive.
+*****************************************************************************/
+TaskHandle_t rtos_audio_in_task;
+
+void audio_offload_init(void)
+{
+}
+
+void audio_offload_start(void)
+{
+}
+
+void audio_offload_stop(void)
+{
+}
+
+void audio_offload_restart(void)
+{
+}
+
+bool audio_offload_is_active(void)
+{
+    return false;
+}
+
+void audio_offload_apply_stages(void)
+{
+}
+
+uint32_t audio_offload_process(int16_t *samples, uint32_t num_frames, uint32_t num_channels)
+{
+    (void) samples;
+    (void) num_frames;
+    (void) num_channels;
+
+    return 0u;
+}
+
+void audio_boot_mark(audio_boot_stage_t stage)
+{
+    (void) stage;
+}
+
+void audio_watchdog_write_task_returned(void)
+{
+}
+
+
+/*****************************************************************************
+* Function Name: test_keep_packet
+******************************************************************************
+* Summary:
+*  Append a copy of a packet to a list.
+*
+* Parameters:
+*  packets: List
+*  data: Packet
+*  size: Size of the packet, in bytes
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_keep_packet(test_packets_t *packets, const uint8_t *data, uint32_t size)
+{
+    if ((packets->count < TEST_MAX_PACKETS) && (size <= MAX_AUDIO_IN_PACKET_SIZE_BYTES))
+    {
+        packets->size[packets->count] = size;
+        memcpy(packets->data[packets->count], data, size);
+        packets->count++;
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_output_packets
+******************************************************************************
+* Summary:
+*  Extract the packets sent while recording from the output events of the
+*  recording, as tools/capture_dump.py --packets does.
+*
+* Parameters:
+*  packets: List of the packets
+*
+* Return:
+*  bool: true if the recording is complete and well formed
+*
+*****************************************************************************/
+static bool test_output_packets(test_packets_t *packets)
+{
+    const audio_capture_header_t *header = (const audio_capture_header_t *) audio_capture_buffer;
+    uint32_t pos = AUDIO_CAPTURE_HEADER_WORDS;
+    uint32_t type;
+    uint32_t count;
+
+    packets->count = 0u;
+
+    if ((AUDIO_CAPTURE_MAGIC != header->magic) || (header->num_words > AUDIO_CAPTURE_NUM_WORDS))
+    {
+        return false;
+    }
+
+    while (pos < header->num_words)
+    {
+        type = audio_capture_buffer[pos] >> 24;
+        count = audio_capture_buffer[pos] & 0x00FFFFFFu;
+
+        if (AUDIO_CAPTURE_EVENT_FIFO == type)
+        {
+            pos += 2u + (2u * count);
+        }
+        else if (AUDIO_CAPTURE_EVENT_PACKET == type)
+        {
+            pos += 2u;
+        }
+        else if (AUDIO_CAPTURE_EVENT_OUTPUT == type)
+        {
+            test_keep_packet(packets, (const uint8_t *) &audio_capture_buffer[pos + 2u], count);
+            pos += 2u + ((count + 3u) / 4u);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return (pos == header->num_words);
+}
+
+
+/*****************************************************************************
+* Function Name: test_read_packets
+******************************************************************************
+* Summary:
+*  Read a golden file written by tools/capture_dump.py --packets: each
+*  packet is its size, a 32-bit little-endian word, followed by its bytes.
+*
+* Parameters:
+*  path: Golden file
+*  packets: List of the packets
+*
+* Return:
+*  bool: true if the file was read
+*
+*****************************************************************************/
+static bool test_read_packets(const char *path, test_packets_t *packets)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t size_bytes[4];
+    uint8_t data[MAX_AUDIO_IN_PACKET_SIZE_BYTES];
+    uint32_t size;
+    bool valid = (NULL != file);
+
+    packets->count = 0u;
+
+    while (valid && (1u == fread(size_bytes, sizeof(size_bytes), 1u, file)))
+    {
+        size = (uint32_t) size_bytes[0] | ((uint32_t) size_bytes[1] << 8) |
+               ((uint32_t) size_bytes[2] << 16) | ((uint32_t) size_bytes[3] << 24);
+        valid = (size <= sizeof(data)) && (packets->count < TEST_MAX_PACKETS) &&
+                ((0u == size) || (1u == fread(data, size, 1u, file)));
+        if (valid)
+        {
+            test_keep_packet(packets, data, size);
+        }
+    }
+
+    if (NULL != file)
+    {
+        fclose(file);
+    }
+
+    return valid;
+}
+
+
+/*****************************************************************************
+* Function Name: test_read_recording
+******************************************************************************
+* Summary:
+*  Restore a recording written by tools/capture_dump.py -o into the buffer.
+*
+* Parameters:
+*  path: Binary recording
+*
+* Return:
+*  bool: true if the file was read and fits the buffer
+*
+*****************************************************************************/
+static bool test_read_recording(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    size_t num_words;
+
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    memset(audio_capture_buffer, 0, sizeof(audio_capture_buffer));
+    num_words = fread(audio_capture_buffer, sizeof(uint32_t), AUDIO_CAPTURE_NUM_WORDS, file);
+    fclose(file);
+
+    return (num_words >= AUDIO_CAPTURE_HEADER_WORDS) &&
+           (((const audio_capture_header_t *) audio_capture_buffer)->num_words <= num_words);
+}
+
+
+/*****************************************************************************
+* Function Name: test_push_frame
+******************************************************************************
+* Summary:
+*  Push a frame of the synthetic microphone signals into the FIFOs: tones of
+*  different frequencies and levels on the left and right microphones, and
+*  some noise.
+*
+* Parameters:
+*  frame: Index of the frame
+*  seed: State of the noise generator
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_push_frame(uint32_t frame, uint32_t *seed)
+{
+    double t = (double) frame / (double) (AUDIO_IN_SAMPLE_FREQ);
+    float left = (float) (TEST_AMPLITUDE * sin(2.0 * M_PI * 440.0 * t)) + (200.0f * host_random_gauss(seed));
+    float right = (float) (0.5 * TEST_AMPLITUDE * sin(2.0 * M_PI * 1000.0 * t)) + (200.0f * host_random_gauss(seed));
+
+    /* The FIFO words are sign-extended samples */
+    host_pdm_write_fifo(CYBSP_PDM_HW, LEFT_CH_INDEX, (uint32_t) (int32_t) host_saturate(left));
+    host_pdm_write_fifo(CYBSP_PDM_HW, RIGHT_CH_INDEX, (uint32_t) (int32_t) host_saturate(right));
+}
+
+
+/*****************************************************************************
+* Function Name: test_record_session
+******************************************************************************
+* Summary:
+*  Record a session driven the way the hardware and the host drive it: the
+*  microphones fill the FIFOs at their own clock, the interrupt handler runs
+*  after the trigger with some latency, and the host requests a packet every
+*  period, sometimes late. The packets sent are kept as the reference.
+*
+* Parameters:
+*  session: Session to record
+*  live: Packets sent to the host after the first request
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_record_session(const test_session_t *session, test_packets_t *live)
+{
+    uint32_t seed = 0x5EED0000u + session->alt_setting;
+    double frames_per_packet = (double) (AUDIO_IN_FRAMES_PER_PACKET) * (1.0 + (session->clock_ppm * 1e-6));
+    double frames_due = 0.0;
+    uint32_t frame = 0u;
+    uint32_t latency = 0u;
+    bool late = false;
+    uint32_t requests;
+    const U8 *packet;
+    U32 packet_size;
+
+    live->count = 0u;
+
+    HOST_CHECK(audio_capture_command(AUDIO_CAPTURE_CMD_RECORD), "%s: recording armed", session->name);
+
+    audio_in_enable(session->alt_setting);
+
+    /* A PDM-PCM interrupt pended by the start runs once the USB interrupt
+     * returns */
+    if (host_nvic_take_pending(PDM_IRQ))
+    {
+        audio_in_pdm_interrupt_handler();
+    }
+
+    /* The first request starts the session and sends silence */
+    audio_in_endpoint_callback(NULL, &packet, &packet_size);
+
+    for (uint32_t n = 0u; n < session->num_packets; n++)
+    {
+        /* Frames captured during this period */
+        frames_due += frames_per_packet;
+        while (frames_due >= 1.0)
+        {
+            frames_due -= 1.0;
+            test_push_frame(frame++, &seed);
+
+            if ((0u == latency) &&
+                (Cy_PDM_PCM_Channel_GetNumInFifo(CYBSP_PDM_HW, RIGHT_CH_INDEX) >
+                 CYBSP_PDM_HW->host_trigger_level[RIGHT_CH_INDEX]))
+            {
+                latency = 1u + (host_random(&seed) % (TEST_MAX_ISR_LATENCY));
+            }
+            if ((0u != latency) && (0u == --latency))
+            {
+                audio_in_pdm_interrupt_handler();
+            }
+        }
+
+        /* A late request is followed by the next one right away */
+        requests = 1u;
+        if (late)
+        {
+            late = false;
+            requests = 2u;
+        }
+        else if (0u == (host_random(&seed) % (TEST_LATE_PERIOD)))
+        {
+            late = true;
+            requests = 0u;
+        }
+
+        for (uint32_t r = 0u; r < requests; r++)
+        {
+            audio_in_endpoint_callback(NULL, &packet, &packet_size);
+            test_keep_packet(live, packet, packet_size);
+        }
+    }
+
+    audio_in_disable();
+}
+
+
+/*****************************************************************************
+* Function Name: test_replay
+******************************************************************************
+* Summary:
+*  Replay the recording the way audio_in_replay() does, keeping the packets
+*  instead of their CRC-32 only.
+*
+* Parameters:
+*  replayed: Packets of the replay
+*
+* Return:
+*  bool: true if the recording was replayed
+*
+*****************************************************************************/
+static bool test_replay(test_packets_t *replayed)
+{
+    uint32_t alt_setting;
+    uint32_t queue_target;
+    U8 saved_alt_setting = audio_in_alt_setting;
+    uint32_t saved_queue_target = audio_in_queue_target;
+    const U8 *packet;
+    U32 packet_size;
+    uint32_t crc = 0u;
+    uint32_t event;
+
+    replayed->count = 0u;
+
+    if (!audio_capture_replay_begin(&alt_setting, &queue_target))
+    {
+        return false;
+    }
+
+    audio_in_alt_setting = (U8) alt_setting;
+    audio_in_queue_target = queue_target;
+    audio_in_start_recording = true;
+    audio_in_endpoint_callback(NULL, &packet, &packet_size);
+
+    for (event = audio_capture_replay_next(); 0u != event; event = audio_capture_replay_next())
+    {
+        if (AUDIO_CAPTURE_EVENT_FIFO == event)
+        {
+            audio_in_pdm_interrupt_handler();
+        }
+        else
+        {
+            audio_in_endpoint_callback(NULL, &packet, &packet_size);
+            crc = audio_capture_crc32(crc, packet, packet_size);
+            test_keep_packet(replayed, packet, packet_size);
+        }
+    }
+
+    audio_capture_replay_end(replayed->count, crc, 0u);
+
+    audio_in_is_recording = false;
+    audio_offload_stop();
+    audio_in_release_usb_packet(audio_in_usb_packets);
+    audio_in_release_usb_packet(audio_in_usb_packets);
+    audio_in_alt_setting = saved_alt_setting;
+    audio_in_queue_target = saved_queue_target;
+    audio_timestamp_init();
+
+    return true;
+}
+
+
+/*****************************************************************************
+* Function Name: test_compare
+******************************************************************************
+* Summary:
+*  Compare packets byte for byte with the golden ones, and print the first
+*  difference.
+*
+* Parameters:
+*  name: Name of the recording
+*  golden: Golden packets
+*  packets: Packets to check
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_compare(const char *name, const test_packets_t *golden, const test_packets_t *packets)
+{
+    uint32_t mismatches = 0u;
+    uint32_t first = golden->count;
+    uint32_t byte = 0u;
+
+    for (uint32_t n = 0u; (n < golden->count) && (n < packets->count); n++)
+    {
+        if ((golden->size[n] != packets->size[n]) ||
+            (0 != memcmp(golden->data[n], packets->data[n], golden->size[n])))
+        {
+            if (0u == mismatches)
+            {
+                first = n;
+                while ((byte < golden->size[n]) && (byte < packets->size[n]) &&
+                       (golden->data[n][byte] == packets->data[n][byte]))
+                {
+                    byte++;
+                }
+            }
+            mismatches++;
+        }
+    }
+
+    HOST_CHECK(golden->count == packets->count, "%s: %u packets replayed, %u golden",
+               name, (unsigned) packets->count, (unsigned) golden->count);
+    HOST_CHECK(0u == mismatches, "%s: %u packets differ from the golden ones", name, (unsigned) mismatches);
+    if (0u != mismatches)
+    {
+        printf("INFO: %s: first difference in packet %u (%u bytes, %u golden), byte %u\n", name,
+               (unsigned) first, (unsigned) packets->size[first], (unsigned) golden->size[first],
+               (unsigned) byte);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_sessions_replay
+******************************************************************************
+* Summary:
+*  Record sessions of every alternate setting, then check that their
+*  recordings hold the packets sent, that a replay sends the same packets
+*  byte for byte, and that audio_in_replay() matches the recording too.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_sessions_replay(void)
+{
+    audio_capture_status_t status;
+    const audio_capture_header_t *header = (const audio_capture_header_t *) audio_capture_buffer;
+    uint32_t min_size;
+    uint32_t max_size;
+
+    for (uint32_t i = 0u; i < (sizeof(test_sessions) / sizeof(test_sessions[0])); i++)
+    {
+        const test_session_t *session = &test_sessions[i];
+
+        test_record_session(session, &test_live);
+
+        HOST_CHECK(test_output_packets(&test_golden), "%s: recording complete and well formed", session->name);
+        HOST_CHECK(test_golden.count == header->packets, "%s: %u output events for %u packets recorded",
+                   session->name, (unsigned) test_golden.count, (unsigned) header->packets);
+        min_size = MAX_AUDIO_IN_PACKET_SIZE_BYTES;
+        max_size = 0u;
+        for (uint32_t n = 0u; n < test_golden.count; n++)
+        {
+            min_size = (test_golden.size[n] < min_size) ? test_golden.size[n] : min_size;
+            max_size = (test_golden.size[n] > max_size) ? test_golden.size[n] : max_size;
+        }
+        printf("INFO: %s: %u of %u packets recorded in %u words, %u to %u bytes\n", session->name,
+               (unsigned) test_golden.count, (unsigned) test_live.count, (unsigned) header->num_words,
+               (unsigned) min_size, (unsigned) max_size);
+
+        /* The output events hold the packets sent while recording */
+        test_live.count = (test_live.count < test_golden.count) ? test_live.count : test_golden.count;
+        test_compare(session->name, &test_live, &test_golden);
+
+        HOST_CHECK(test_replay(&test_replayed), "%s: replayed", session->name);
+        test_compare(session->name, &test_golden, &test_replayed);
+
+        audio_capture_get_status(&status);
+        HOST_CHECK(1u == status.match, "%s: replay CRC-32 matches the recording", session->name);
+
+        /* The replay of the firmware agrees */
+        HOST_CHECK(audio_in_replay(), "%s: audio_in_replay() ran", session->name);
+        audio_capture_get_status(&status);
+        HOST_CHECK((1u == status.match) && (status.packets == header->packets),
+                   "%s: audio_in_replay() matches the recording", session->name);
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_file_replay
+******************************************************************************
+* Summary:
+*  Replay a recording dumped from the target against its golden packets.
+*
+* Parameters:
+*  recording: Binary recording, from tools/capture_dump.py -o
+*  golden: Golden packets, from tools/capture_dump.py --packets
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_file_replay(const char *recording, const char *golden)
+{
+    HOST_CHECK(test_read_recording(recording), "%s read", recording);
+    HOST_CHECK(test_read_packets(golden, &test_golden), "%s read", golden);
+    printf("INFO: %u golden packets\n", (unsigned) test_golden.count);
+
+    HOST_CHECK(test_replay(&test_replayed), "%s replayed", recording);
+    test_compare(recording, &test_golden, &test_replayed);
+}
+
+
+int main(int argc, char *argv[])
+{
+    audio_in_init();
+
+    if (3 == argc)
+    {
+        test_file_replay(argv[1], argv[2]);
+    }
+    else
+    {
+        test_sessions_replay();
+    }
+
+    return host_report("test_replay");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,651 @@
+/*****************************************************************************
+* File Name        : test_vad.c
+*
+* Description      : This file contains the host test of the voice activity detector
+*                    (audio_vad.c) on labelled synthetic signals.
+*
+* Related Document : See README.md
+*
+******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_vad.h"
+#include "audio.h"
+#include "host_test.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_SAMPLE_RATE            (AUDIO_IN_SAMPLE_FREQ)
+#define TEST_BLOCK_FRAMES           (AUDIO_IN_FRAMES_PER_PACKET)
+#define TEST_FRAME_SAMPLES          (((TEST_SAMPLE_RATE) * (AUDIO_VAD_FRAME_MS)) / 1000u)
+#define TEST_HANGOVER_FRAMES        ((AUDIO_VAD_HANGOVER_MS) / (AUDIO_VAD_FRAME_MS))
+#define TEST_MAX_FRAMES             (4096u)
+
+/* Documented behavior of the detector: speech needs 6 dB over the noise
+ * floor and a speech-like spectrum, 15 dB is speech regardless, and the
+ * floor rises by about 3 dB/s */
+#define TEST_SNR_THRESHOLD_DB       (6.0f)
+#define TEST_SNR_STRONG_DB          (15.0f)
+#define TEST_FLOOR_RISE_DB_PER_S    (3.0f)
+
+/* RMS level of the background */
+#define TEST_BACKGROUND_RMS         (100.0f)
+
+/* Pole of the low-pass filter of the room noise, which varies little from
+ * one analysis frame to the next */
+#define TEST_NOISE_POLE             (0.9f)
+
+/* Frequency of the steady tone, and pitch of the voiced sound. All the
+ * tones of the signals are multiples of 100 Hz: they are orthogonal over an
+ * analysis frame, so that the energy of a frame is the sum of the energies
+ * of its signals. */
+#define TEST_STEADY_HZ              (400.0)
+#define TEST_PITCH_HZ               (100u)
+
+/* Labelled scenario: utterances and pauses, and the error rates allowed */
+#define TEST_NUM_UTTERANCES         (12u)
+#define TEST_SCENARIO_SNR_DB        (12.0f)
+#define TEST_MAX_MISS_RATE          (0.02f)
+#define TEST_MAX_FALSE_ALARM_RATE   (0.02f)
+
+#define TEST_PI                     (3.14159265358979)
+
+
+/*****************************************************************************
+* Enumerations
+*****************************************************************************/
+typedef enum
+{
+    TEST_SIGNAL_SILENCE,            /* Digital silence */
+    TEST_SIGNAL_NOISE,              /* Low-pass room noise */
+    TEST_SIGNAL_STEADY,             /* Tone, the same energy in every analysis frame */
+    TEST_SIGNAL_VOICED,             /* Harmonics of a pitch, shaped by formants */
+    TEST_SIGNAL_HUM,                /* 100 Hz hum of rectified mains and its third harmonic */
+    TEST_SIGNAL_HISS,               /* White noise */
+} test_signal_t;
+
+
+/*****************************************************************************
+* Static data
+*****************************************************************************/
+static uint32_t test_seed = 0x2545F491u;
+static float test_filter_state;
+static uint64_t test_time;
+
+/* Decision of every analysis frame of the current run */
+static bool test_decisions[TEST_MAX_FRAMES];
+static uint32_t test_num_frames;
+
+
+/*****************************************************************************
+* Function Name: test_sample
+******************************************************************************
+* Summary:
+*  Return the next sample of a test signal with unit RMS level.
+*
+* Parameters:
+*  signal: Signal
+*
+* Return:
+*  float: Sample
+*
+*****************************************************************************/
+static float test_sample(test_signal_t signal)
+{
+    double t = (double) test_time / TEST_SAMPLE_RATE;
+    float sample = 0.0f;
+
+    switch (signal)
+    {
+        case TEST_SIGNAL_NOISE:
+            /* One-pole low-pass at about 800 Hz, scaled to unit RMS */
+            test_filter_state = (TEST_NOISE_POLE * test_filter_state) +
+                                ((1.0f - TEST_NOISE_POLE) * host_random_gauss(&test_seed));
+            sample = test_filter_state * sqrtf((1.0f + TEST_NOISE_POLE) / (1.0f - TEST_NOISE_POLE));
+            break;
+
+        case TEST_SIGNAL_STEADY:
+            /* The noise floor of the detector is then exactly its energy. A
+             * cosine, orthogonal to the harmonic of the voiced sound. */
+            sample = (float) (sqrt(2.0) * cos(2.0 * TEST_PI * TEST_STEADY_HZ * t));
+            break;
+
+        case TEST_SIGNAL_VOICED:
+        {
+            double power = 0.0;
+
+            for (uint32_t k = 1u; (k * TEST_PITCH_HZ) < 4000u; k++)
+            {
+                double f = (double) (k * TEST_PITCH_HZ);
+                double formants = exp(-pow((f - 600.0) / 250.0, 2.0)) + (0.5 * exp(-pow((f - 1700.0) / 300.0, 2.0))) +
+                                  (0.25 * exp(-pow((f - 2600.0) / 350.0, 2.0)));
+
+                sample += (float) (formants * sin(2.0 * TEST_PI * f * t));
+                power += 0.5 * formants * formants;
+            }
+            sample /= (float) sqrt(power);
+            break;
+        }
+
+        case TEST_SIGNAL_HUM:
+            sample = (float) ((1.3 * sin(2.0 * TEST_PI * 100.0 * t)) + (0.5 * sin(2.0 * TEST_PI * 300.0 * t)));
+            break;
+
+        case TEST_SIGNAL_HISS:
+            sample = host_random_gauss(&test_seed);
+            break;
+
+        case TEST_SIGNAL_SILENCE:
+        default:
+            break;
+    }
+
+    return sample;
+}
+
+
+/*****************************************************************************
+* Function Name: test_reset
+******************************************************************************
+* Summary:
+*  Restart the detector and the record of its decisions.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_reset(void)
+{
+    audio_vad_init();
+    audio_vad_clear_status();
+    test_num_frames = 0u;
+    test_time = 0u;
+    test_filter_state = 0.0f;
+}
+
+
+/*****************************************************************************
+* Function Name: test_feed
+******************************************************************************
+* Summary:
+*  Feed the detector with packets of a foreground signal over the background,
+*  on both microphones, and record the decision of every analysis frame.
+*
+* Parameters:
+*  foreground: Foreground signal
+*  snr_db: Level of the foreground over the background, in dB
+*  background: Background signal, at TEST_BACKGROUND_RMS
+*  background_gain_db: Gain of the background, in dB
+*  num_frames: Frames to feed
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_feed(test_signal_t foreground, float snr_db, test_signal_t background,
+                      float background_gain_db, uint32_t num_frames)
+{
+    float background_rms = TEST_BACKGROUND_RMS * powf(10.0f, background_gain_db / 20.0f);
+    float foreground_rms = TEST_BACKGROUND_RMS * powf(10.0f, snr_db / 20.0f);
+    int16_t block[2u * TEST_BLOCK_FRAMES];
+    audio_vad_status_t status;
+
+    for (uint32_t done = 0u; done < num_frames; done += TEST_BLOCK_FRAMES)
+    {
+        for (uint32_t n = 0u; n < TEST_BLOCK_FRAMES; n++)
+        {
+            float sample = (background_rms * test_sample(background)) + (foreground_rms * test_sample(foreground));
+
+            block[2u * n] = host_saturate(sample);
+            block[(2u * n) + 1u] = block[2u * n];
+            test_time++;
+        }
+
+        audio_vad_process(block, TEST_BLOCK_FRAMES, 2u);
+
+        /* A block is shorter than an analysis frame: at most one decision */
+        audio_vad_get_status(&status);
+        if ((status.frames != test_num_frames) && (test_num_frames < TEST_MAX_FRAMES))
+        {
+            test_decisions[test_num_frames++] = audio_vad_is_speech();
+        }
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_ms
+******************************************************************************
+* Summary:
+*  Convert a duration to frames.
+*
+* Parameters:
+*  ms: Duration, in ms
+*
+* Return:
+*  uint32_t: Frames, a whole number of packets
+*
+*****************************************************************************/
+static uint32_t test_ms(uint32_t ms)
+{
+    return ((ms * TEST_SAMPLE_RATE) / 1000u / TEST_BLOCK_FRAMES) * TEST_BLOCK_FRAMES;
+}
+
+
+/*****************************************************************************
+* Function Name: test_count
+******************************************************************************
+* Summary:
+*  Count the speech decisions in a range of analysis frames.
+*
+* Parameters:
+*  first: First analysis frame
+*  last: Analysis frame past the range
+*
+* Return:
+*  uint32_t: Speech decisions
+*
+*****************************************************************************/
+static uint32_t test_count(uint32_t first, uint32_t last)
+{
+    uint32_t count = 0u;
+
+    for (uint32_t i = first; (i < last) && (i < test_num_frames); i++)
+    {
+        count += test_decisions[i] ? 1u : 0u;
+    }
+
+    return count;
+}
+
+
+/*****************************************************************************
+* Function Name: test_onset_hangover
+******************************************************************************
+* Summary:
+*  Check the delay of the decision at the start of speech, and the hangover
+*  after its end.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_onset_hangover(void)
+{
+    uint32_t onset;
+    uint32_t offset;
+    uint32_t first_speech = 0u;
+    uint32_t last_speech = 0u;
+
+    test_reset();
+
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(1000u));
+    onset = test_num_frames;
+    test_feed(TEST_SIGNAL_VOICED, 20.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(500u));
+    offset = test_num_frames;
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(1000u));
+
+    for (uint32_t i = 0u; i < test_num_frames; i++)
+    {
+        if (test_decisions[i])
+        {
+            first_speech = (0u == last_speech) ? i : first_speech;
+            last_speech = i;
+        }
+    }
+
+    HOST_CHECK(0u == test_count(0u, onset), "background alone: no speech");
+    HOST_CHECK(first_speech == onset, "onset: decided on the first analysis frame of speech (frame %u, expected %u)",
+               (unsigned) first_speech, (unsigned) onset);
+    HOST_CHECK((last_speech + 1u) == (offset + TEST_HANGOVER_FRAMES),
+               "hangover: speech held %u ms after the end (expected %u)",
+               (unsigned) (((last_speech + 1u) - offset) * AUDIO_VAD_FRAME_MS), (unsigned) AUDIO_VAD_HANGOVER_MS);
+    HOST_CHECK(test_count(onset, last_speech + 1u) == ((last_speech + 1u) - onset),
+               "speech held without gaps from onset to hangover end");
+
+    /* A pause shorter than the hangover does not end the speech */
+    test_reset();
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(1000u));
+    onset = test_num_frames;
+    test_feed(TEST_SIGNAL_VOICED, 20.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(300u));
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(AUDIO_VAD_HANGOVER_MS - 50u));
+    test_feed(TEST_SIGNAL_VOICED, 20.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(300u));
+    offset = test_num_frames;
+
+    {
+        audio_vad_status_t status;
+
+        audio_vad_get_status(&status);
+        HOST_CHECK(1u == status.onsets, "pause shorter than the hangover: %u onset (expected 1)",
+                   (unsigned) status.onsets);
+        HOST_CHECK(test_count(onset, offset) == (offset - onset), "pause shorter than the hangover: no gap");
+    }
+}
+
+
+/*****************************************************************************
+* Function Name: test_burst
+******************************************************************************
+* Summary:
+*  Feed a burst of a signal over a settled background and return whether
+*  any analysis frame of the burst was taken as speech.
+*
+* Parameters:
+*  foreground: Signal of the burst
+*  snr_db: Level of the burst over the background, in dB
+*  speech_frames: Set to the analysis frames of the burst taken as speech
+*  burst_frames: Set to the analysis frames of the burst
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_burst(test_signal_t foreground, float snr_db, uint32_t *speech_frames, uint32_t *burst_frames)
+{
+    uint32_t start;
+
+    test_reset();
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_STEADY, 0.0f, test_ms(1000u));
+    start = test_num_frames;
+    test_feed(foreground, snr_db, TEST_SIGNAL_STEADY, 0.0f, test_ms(200u));
+
+    *speech_frames = test_count(start, test_num_frames);
+    *burst_frames = test_num_frames - start;
+}
+
+
+/*****************************************************************************
+* Function Name: test_thresholds
+******************************************************************************
+* Summary:
+*  Check the energy threshold and the spectral check: bursts of voiced
+*  sound, hum and hiss just below and above the thresholds.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_thresholds(void)
+{
+    static const struct
+    {
+        test_signal_t signal;
+        const char *name;
+        float snr_db;
+        bool speech;
+    } cases[] =
+    {
+        /* The energy over the floor is the one of the burst plus the
+         * background: 4.1 dB and 9.5 dB for the voiced bursts */
+        { TEST_SIGNAL_VOICED, "voiced", TEST_SNR_THRESHOLD_DB - 4.0f, false },
+        { TEST_SIGNAL_VOICED, "voiced", TEST_SNR_THRESHOLD_DB + 3.0f, true  },
+        { TEST_SIGNAL_HUM,    "hum",    TEST_SNR_STRONG_DB - 3.0f,    false },  /* Below the spectrum range */
+        { TEST_SIGNAL_HISS,   "hiss",   TEST_SNR_STRONG_DB - 3.0f,    false },  /* Above the spectrum range */
+        { TEST_SIGNAL_HUM,    "hum",    TEST_SNR_STRONG_DB + 3.0f,    true  },  /* Strong: no spectral check */
+        { TEST_SIGNAL_HISS,   "hiss",   TEST_SNR_STRONG_DB + 3.0f,    true  },
+    };
+    uint32_t speech_frames;
+    uint32_t burst_frames;
+
+    for (uint32_t i = 0u; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        test_burst(cases[i].signal, cases[i].snr_db, &speech_frames, &burst_frames);
+
+        if (cases[i].speech)
+        {
+            HOST_CHECK(speech_frames == burst_frames, "%s at %+.0f dB: %u of %u frames speech (expected all)",
+                       cases[i].name, (double) cases[i].snr_db, (unsigned) speech_frames, (unsigned) burst_frames);
+        }
+        else
+        {
+            HOST_CHECK(0u == speech_frames, "%s at %+.0f dB: %u of %u frames speech (expected none)",
+                       cases[i].name, (double) cases[i].snr_db, (unsigned) speech_frames, (unsigned) burst_frames);
+        }
+    }
+
+    /* Digital silence, the noise floor stays at its minimum */
+    test_reset();
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_SILENCE, 0.0f, test_ms(500u));
+    HOST_CHECK(0u == test_count(0u, test_num_frames), "digital silence: no speech");
+}
+
+
+/*****************************************************************************
+* Function Name: test_floor
+******************************************************************************
+* Summary:
+*  Check the tracking of the noise floor: it follows a quieter background
+*  at once, and a louder one at about 3 dB/s.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_floor(void)
+{
+    float step_db = 10.0f;
+    float total_db;
+    uint32_t start;
+    uint32_t end;
+    uint32_t expected;
+    uint32_t speech_frames;
+
+    /* Fall: a loud background, then a quiet one with voiced sound 9 dB
+     * over it */
+    test_reset();
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_STEADY, 20.0f, test_ms(1000u));
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_STEADY, 0.0f, test_ms(500u));
+    start = test_num_frames;
+    test_feed(TEST_SIGNAL_VOICED, 9.0f, TEST_SIGNAL_STEADY, 0.0f, test_ms(200u));
+    speech_frames = test_count(start, test_num_frames);
+    HOST_CHECK(speech_frames == (test_num_frames - start),
+               "floor follows a 20 dB quieter background: %u of %u frames speech (expected all)",
+               (unsigned) speech_frames, (unsigned) (test_num_frames - start));
+
+    /* Rise: a steady source with a speech-like spectrum starts step_db over
+     * the background. It is taken as speech until the floor has risen within
+     * 6 dB of it, then the hangover runs. */
+    test_reset();
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_STEADY, 0.0f, test_ms(1000u));
+    start = test_num_frames;
+    test_feed(TEST_SIGNAL_VOICED, step_db, TEST_SIGNAL_STEADY, 0.0f, test_ms(3000u));
+
+    for (end = start; (end < test_num_frames) && test_decisions[end]; end++)
+    {
+    }
+
+    total_db = 10.0f * log10f(1.0f + powf(10.0f, step_db / 10.0f));
+    expected = (uint32_t) (((total_db - TEST_SNR_THRESHOLD_DB) / TEST_FLOOR_RISE_DB_PER_S) *
+                           (1000.0f / AUDIO_VAD_FRAME_MS)) + TEST_HANGOVER_FRAMES;
+    HOST_CHECK(((end - start) * 10u >= expected * 9u) && ((end - start) * 10u <= expected * 11u),
+               "floor rises on a steady source %.0f dB over the background: speech for %u ms "
+               "(expected %u ms +/- 10 %%)", (double) step_db, (unsigned) ((end - start) * AUDIO_VAD_FRAME_MS),
+               (unsigned) (expected * AUDIO_VAD_FRAME_MS));
+    HOST_CHECK(0u == test_count(end, test_num_frames), "steady source: no speech once the floor has risen");
+}
+
+
+/*****************************************************************************
+* Function Name: test_scenario
+******************************************************************************
+* Summary:
+*  Run utterances of random lengths separated by pauses longer than the
+*  hangover, and compare the decisions with the labels. A frame counts as
+*  missed if it is labelled speech and decided silence, and as a false alarm
+*  if it is decided speech outside the utterances and their hangovers.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_scenario(void)
+{
+    bool labels[TEST_MAX_FRAMES] = { false };
+    uint32_t seed = 0xC0FFEEu;
+    uint32_t speech = 0u;
+    uint32_t missed = 0u;
+    uint32_t silence = 0u;
+    uint32_t false_alarms = 0u;
+    uint32_t hold = 0u;
+    audio_vad_status_t status;
+
+    test_reset();
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(500u));
+
+    for (uint32_t i = 0u; i < TEST_NUM_UTTERANCES; i++)
+    {
+        uint32_t start = test_num_frames;
+
+        test_feed(TEST_SIGNAL_VOICED, TEST_SCENARIO_SNR_DB, TEST_SIGNAL_NOISE, 0.0f,
+                  test_ms(200u + (host_random(&seed) % 700u)));
+        for (uint32_t f = start; f < test_num_frames; f++)
+        {
+            labels[f] = true;
+        }
+        test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f,
+                  test_ms(AUDIO_VAD_HANGOVER_MS + 200u + (host_random(&seed) % 1000u)));
+    }
+
+    for (uint32_t f = 0u; f < test_num_frames; f++)
+    {
+        if (labels[f])
+        {
+            speech++;
+            missed += test_decisions[f] ? 0u : 1u;
+            /* The hangover runs from the frame after the end, which may
+             * hold the last of the speech */
+            hold = TEST_HANGOVER_FRAMES + 1u;
+        }
+        else if (hold > 0u)
+        {
+            hold--;
+        }
+        else
+        {
+            silence++;
+            false_alarms += test_decisions[f] ? 1u : 0u;
+        }
+    }
+
+    audio_vad_get_status(&status);
+    HOST_CHECK(TEST_NUM_UTTERANCES == status.onsets, "scenario: %u onsets (expected %u)", (unsigned) status.onsets,
+               (unsigned) TEST_NUM_UTTERANCES);
+    HOST_CHECK(missed <= (uint32_t) (speech * TEST_MAX_MISS_RATE), "scenario: %u of %u speech frames missed",
+               (unsigned) missed, (unsigned) speech);
+    HOST_CHECK(false_alarms <= (uint32_t) (silence * TEST_MAX_FALSE_ALARM_RATE),
+               "scenario: %u of %u silence frames taken as speech", (unsigned) false_alarms, (unsigned) silence);
+    HOST_CHECK(status.frames == test_num_frames, "status: %u frames counted (expected %u)", (unsigned) status.frames,
+               (unsigned) test_num_frames);
+}
+
+
+/*****************************************************************************
+* Function Name: test_gate
+******************************************************************************
+* Summary:
+*  Check that the gate mode gates silence only, and that the monitor mode
+*  never gates.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void test_gate(void)
+{
+    bool gated_silence;
+    bool gated_speech;
+
+    test_reset();
+    HOST_CHECK(!audio_vad_set_mode(AUDIO_VAD_MODE_COUNT), "invalid mode rejected");
+    HOST_CHECK(audio_vad_set_mode(AUDIO_VAD_MODE_GATE), "gate mode selected");
+
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(500u));
+    gated_silence = audio_vad_is_gated();
+    test_feed(TEST_SIGNAL_VOICED, 20.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(100u));
+    gated_speech = audio_vad_is_gated();
+    HOST_CHECK(gated_silence && (!gated_speech), "gate mode: silence gated, speech passed");
+
+    audio_vad_set_mode(AUDIO_VAD_MODE_MONITOR);
+    test_feed(TEST_SIGNAL_SILENCE, 0.0f, TEST_SIGNAL_NOISE, 0.0f, test_ms(1000u));
+    HOST_CHECK(!audio_vad_is_gated(), "monitor mode: silence not gated");
+}
+
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the checks of the voice activity detector.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 if all the checks passed
+*
+*****************************************************************************/
+int main(void)
+{
+    test_onset_hangover();
+    test_thresholds();
+    test_floor();
+    test_scenario();
+    test_gate();
+
+    return host_report("test_vad");
+}
+
+/* [] END OF FILE */
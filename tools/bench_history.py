@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+#
+# Collect the results of the capture path microbenchmarks (audio_bench.c)
+# from a debug UART log, append them to a history file keyed by the git
+# commit, and compare them with the previous entry.
+#
+# Build the CM33 application with AUDIO_BENCH_ENABLE=1 and capture the debug
+# UART after a reset: the benchmarks run once at startup. The host build of
+# the benchmarks prints the same lines: `make -C tests/host bench` runs it
+# and passes its output to this script.
+#
+# Usage: bench_history.py uart.log [--history bench_history.json] [--commit ID]
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this code example.
+
+import argparse
+import datetime
+import json
+import os
+import subprocess
+import sys
+
+FIELDS = ["kernel", "rate_hz", "channels", "frames", "cycles", "ns_per_packet", "ksamples_per_s"]
+
+
+def parse_log(lines):
+    """Return the benchmark results of the log, keyed by kernel/rate/channels."""
+    results = {}
+
+    for line in lines:
+        pos = line.find("APP_BENCH:")
+        if pos < 0:
+            continue
+        values = line[pos + len("APP_BENCH:"):].strip().split(",")
+        if len(values) != len(FIELDS) or values[0] == "kernel":
+            continue
+        row = dict(zip(FIELDS, [values[0]] + [int(v) for v in values[1:]]))
+        results["%s/%d/%d" % (row["kernel"], row["rate_hz"], row["channels"])] = row
+
+    if not results:
+        sys.exit("error: no APP_BENCH results found")
+    return results
+
+
+def current_commit():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"],
+                                       stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Track the capture path benchmarks across commits")
+    parser.add_argument("log", help="debug UART log holding the APP_BENCH lines")
+    parser.add_argument("--history", default="bench_history.json", help="history file, one JSON entry per line")
+    parser.add_argument("--commit", default=None, help="commit of the measured build, default: git HEAD")
+    args = parser.parse_args()
+
+    with open(args.log, "r", errors="replace") as f:
+        results = parse_log(f)
+
+    previous = None
+    if os.path.exists(args.history):
+        with open(args.history, "r") as f:
+            entries = [json.loads(line) for line in f if line.strip()]
+        if entries:
+            previous = entries[-1]
+
+    entry = {"commit": args.commit or current_commit(),
+             "date": datetime.datetime.now().isoformat(timespec="seconds"),
+             "results": results}
+
+    with open(args.history, "a") as f:
+        f.write(json.dumps(entry, sort_keys=True) + "\n")
+
+    print("%-24s %10s %10s %8s" % ("kernel/rate/channels", "ns/packet", "ksamples/s",
+                                   "vs " + previous["commit"] if previous else ""))
+    for key, row in results.items():
+        delta = ""
+        if previous and key in previous["results"] and previous["results"][key]["ns_per_packet"]:
+            old = previous["results"][key]["ns_per_packet"]
+            delta = "%+.1f %%" % (100.0 * (row["ns_per_packet"] - old) / old)
+        print("%-24s %10d %10d %8s" % (key, row["ns_per_packet"], row["ksamples_per_s"], delta))
+
+    print("Appended %d results of %s to %s" % (len(results), entry["commit"], args.history))
+
+
+if __name__ == "__main__":
+    main()
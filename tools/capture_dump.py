@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+#
+# Extract a PDM-PCM recording of the record/replay harness (audio_capture.c)
+# from a debug UART log and save it as a binary file.
+#
+# Build the CM33 application with AUDIO_CAPTURE_ENABLE=1, record a session
+# with the AUDIO_CTRL_CAPTURE control (command 1), then dump it (command 3)
+# while capturing the debug UART. The binary file keeps the recorded FIFO
+# words and the CRC-32 of the packets sent while recording, which serves
+# as the golden reference: restore it into another build with the debugger
+# and replay it (command 2) to check that the build produces the same
+# packets, bit for bit.
+#
+# The recording also holds every packet sent while recording. With
+# --packets, they are written to a golden file: for each packet, its size in
+# bytes as a 32-bit little-endian word, then its bytes. The host replay of
+# tests/host (test_replay) compares the packets of the host build with it,
+# byte for byte.
+#
+# Usage: capture_dump.py uart.log [-o capture.bin] [--packets packets.bin]
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this code example.
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x434D4450
+HEADER_WORDS = 8
+EVENT_FIFO = 1
+EVENT_PACKET = 2
+EVENT_OUTPUT = 3
+
+
+def parse_dump(lines):
+    """Return the words of the last complete dump found in the log."""
+    words = None
+    current = None
+
+    for line in lines:
+        pos = line.find("APP_CAPTURE:")
+        if pos < 0:
+            continue
+        fields = line[pos + len("APP_CAPTURE:"):].split()
+        if not fields:
+            continue
+
+        if fields[0] == "BEGIN":
+            current = []
+        elif current is None:
+            continue
+        elif fields[0] == "END":
+            words = current
+            current = None
+        else:
+            current.extend(int(field, 16) for field in fields)
+
+    if words is None or len(words) < HEADER_WORDS or words[0] != MAGIC:
+        sys.exit("error: no complete APP_CAPTURE dump found")
+    return words
+
+
+def output_packets(words):
+    """Return the packets of the output events of the recording."""
+    packets = []
+    pos = HEADER_WORDS
+
+    while pos + 2 <= words[1]:
+        event_type = words[pos] >> 24
+        count = words[pos] & 0xFFFFFF
+        pos += 2
+        if event_type == EVENT_FIFO:
+            pos += 2 * count
+        elif event_type == EVENT_OUTPUT:
+            data = struct.pack("<%dI" % ((count + 3) // 4), *words[pos:pos + (count + 3) // 4])
+            packets.append(data[:count])
+            pos += (count + 3) // 4
+    return packets
+
+
+def summarize(words):
+    """Print the header of the recording and count its events."""
+    num_words, alt_setting, packets, crc, duration, queue_target = words[1:7]
+    fifo_events = 0
+    frames = 0
+    requests = 0
+    outputs = 0
+    pos = HEADER_WORDS
+
+    while pos + 2 <= num_words:
+        event_type = words[pos] >> 24
+        count = words[pos] & 0xFFFFFF
+        pos += 2
+        if event_type == EVENT_FIFO:
+            fifo_events += 1
+            frames += count
+            pos += 2 * count
+        elif event_type == EVENT_PACKET:
+            requests += 1
+        elif event_type == EVENT_OUTPUT:
+            outputs += 1
+            pos += (count + 3) // 4
+        else:
+            sys.exit("error: unknown event 0x%08x at word %d" % (words[pos - 2], pos - 2))
+
+    print("Recording: %d words, alternate setting %d, queue target %d frames, %d Mcycles" %
+          (num_words, alt_setting, queue_target, duration // 1000000))
+    print("Events: %d FIFO drains with %d frames, %d packet requests, %d packets" %
+          (fifo_events, frames, requests, outputs))
+    print("Golden reference: %d packets, CRC32 0x%08x" % (packets, crc))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Extract a PDM-PCM recording from a UART log")
+    parser.add_argument("log", help="debug UART log holding an APP_CAPTURE dump")
+    parser.add_argument("-o", "--output", default="capture.bin", help="binary recording")
+    parser.add_argument("--packets", default=None, help="golden file of the packets sent while recording")
+    args = parser.parse_args()
+
+    with open(args.log, "r", errors="replace") as f:
+        words = parse_dump(f)
+
+    with open(args.output, "wb") as f:
+        f.write(struct.pack("<%dI" % len(words), *words))
+
+    summarize(words)
+
+    if args.packets:
+        packets = output_packets(words)
+        with open(args.packets, "wb") as f:
+            for packet in packets:
+                f.write(struct.pack("<I", len(packet)) + packet)
+        print("Wrote %d golden packets to %s" % (len(packets), args.packets))
+
+    print("Wrote %s. Load it into another build with the debugger, for example:" % args.output)
+    print("  (gdb) restore %s binary &audio_capture_buffer" % args.output)
+
+
+if __name__ == "__main__":
+    main()
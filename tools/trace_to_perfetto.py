@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#
+# Convert a trace dump of the audio trace recorder (audio_trace.c) into a
+# Chrome trace JSON file, viewable in https://ui.perfetto.dev or
+# chrome://tracing.
+#
+# Build the CM33 application with AUDIO_TRACE_ENABLE=1, capture the debug
+# UART to a file and request a dump with the AUDIO_CTRL_TRACE control
+# (SET_CUR with command 2). Lines not starting with "APP_TRACE:" are ignored,
+# so the whole UART log can be passed in.
+#
+# Usage: trace_to_perfetto.py uart.log [-o trace.json]
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this code example.
+
+import argparse
+import json
+import sys
+
+# Event types, see audio_trace.h
+TYPE_TASK_SWITCH = 1
+TYPE_ISR_ENTER = 2
+TYPE_ISR_EXIT = 3
+TYPE_BEGIN = 4
+TYPE_END = 5
+TYPE_MARK = 6
+
+ISR_NAMES = {1: "PDM ISR"}
+EVENT_NAMES = {1: "Audio IN callback", 2: "Underrun", 3: "CM55 exchange"}
+
+PID = 1
+TID_ISR = 1000
+TID_AUDIO = 2000
+
+
+def parse_dump(lines):
+    """Return (clock_hz, cycles_per_event, task names, events) of the last
+    complete dump found in the log."""
+    dump = None
+    current = None
+
+    for line in lines:
+        pos = line.find("APP_TRACE:")
+        if pos < 0:
+            continue
+        fields = line[pos + len("APP_TRACE:"):].split()
+        if not fields:
+            continue
+
+        if fields[0] == "BEGIN":
+            current = {"clock_hz": int(fields[1]), "cycles_per_event": int(fields[3]),
+                       "tasks": {}, "events": []}
+        elif current is None:
+            continue
+        elif fields[0] == "TASK":
+            current["tasks"][int(fields[1])] = " ".join(fields[2:])
+        elif fields[0] == "E":
+            current["events"].append((int(fields[1], 16), int(fields[2]),
+                                      int(fields[3]), int(fields[4])))
+        elif fields[0] == "END":
+            dump = current
+            current = None
+
+    if dump is None:
+        sys.exit("error: no complete APP_TRACE dump found")
+    return dump
+
+
+def convert(dump):
+    """Return the list of Chrome trace events of a dump."""
+    us_per_cycle = 1e6 / dump["clock_hz"]
+    trace = []
+    cycles = 0
+    previous = None
+    task = None
+    task_start = 0.0
+    tasks_seen = set()
+
+    def meta(tid, name):
+        trace.append({"ph": "M", "name": "thread_name", "pid": PID, "tid": tid,
+                      "args": {"name": name}})
+
+    trace.append({"ph": "M", "name": "process_name", "pid": PID, "args": {"name": "CM33"}})
+    meta(TID_ISR, "Interrupts")
+    meta(TID_AUDIO, "Audio events")
+
+    for timestamp, event_type, event_id, arg in dump["events"]:
+        # Unwrap the 32-bit cycle counter
+        if previous is not None:
+            cycles += (timestamp - previous) & 0xFFFFFFFF
+        previous = timestamp
+        ts = cycles * us_per_cycle
+
+        if event_type == TYPE_TASK_SWITCH:
+            if task is not None:
+                trace.append({"ph": "X", "name": dump["tasks"].get(task, "Task %d" % task),
+                              "pid": PID, "tid": task, "ts": task_start,
+                              "dur": ts - task_start})
+            if event_id not in tasks_seen:
+                tasks_seen.add(event_id)
+                meta(event_id, dump["tasks"].get(event_id, "Task %d" % event_id))
+            task = event_id
+            task_start = ts
+        elif event_type in (TYPE_ISR_ENTER, TYPE_ISR_EXIT):
+            trace.append({"ph": "B" if event_type == TYPE_ISR_ENTER else "E",
+                          "name": ISR_NAMES.get(event_id, "ISR %d" % event_id),
+                          "pid": PID, "tid": TID_ISR, "ts": ts})
+        elif event_type in (TYPE_BEGIN, TYPE_END):
+            trace.append({"ph": "B" if event_type == TYPE_BEGIN else "E",
+                          "name": EVENT_NAMES.get(event_id, "Event %d" % event_id),
+                          "pid": PID, "tid": TID_AUDIO, "ts": ts,
+                          "args": {"begin_arg" if event_type == TYPE_BEGIN else "end_arg": arg}})
+        elif event_type == TYPE_MARK:
+            trace.append({"ph": "i", "s": "t",
+                          "name": EVENT_NAMES.get(event_id, "Event %d" % event_id),
+                          "pid": PID, "tid": TID_AUDIO, "ts": ts, "args": {"arg": arg}})
+
+    return trace, cycles
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("log", help="debug UART log holding an APP_TRACE dump")
+    parser.add_argument("-o", "--output", default="trace.json", help="Chrome trace JSON file")
+    args = parser.parse_args()
+
+    with open(args.log, "r", errors="replace") as f:
+        dump = parse_dump(f)
+
+    trace, span_cycles = convert(dump)
+
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, f)
+
+    # Cost of the recorder over the captured span
+    events = len(dump["events"])
+    span_ms = span_cycles * 1e3 / dump["clock_hz"]
+    overhead = 100.0 * events * dump["cycles_per_event"] / span_cycles if span_cycles else 0.0
+    print("%d events over %.1f ms, %d cycles per event, trace overhead %.3f %% of the CPU"
+          % (events, span_ms, dump["cycles_per_event"], overhead))
+    print("Wrote %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()